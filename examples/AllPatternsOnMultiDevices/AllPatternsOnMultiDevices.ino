@@ -46,6 +46,11 @@
 
 #include <MatrixSnake.hpp>
 
+//#define USE_PARALLEL_OUTPUT // Sends the 5 strips at pin 3 to 7, which are all on port D of an Uno or Nano, in one pass
+#if defined(USE_PARALLEL_OUTPUT)
+#include <NeoPixelParallelGroup.hpp>
+#endif
+
 #if defined(__AVR__)
 #  if defined(DEBUG)
 #include "AvrTracing.hpp"
@@ -90,6 +95,9 @@ NeoPatterns bar24 = NeoPatterns(24, PIN_NEOPIXEL_BAR_24, NEO_GRB + NEO_KHZ800, &
 NeoPatterns ring12 = NeoPatterns(12, PIN_NEOPIXEL_RING_12, NEO_GRB + NEO_KHZ800, &allPatternsRandomHandler);
 NeoPatterns ring16 = NeoPatterns(16, PIN_NEOPIXEL_RING_16, NEO_GRB + NEO_KHZ800, &allPatternsRandomHandler);
 NeoPatterns ring24 = NeoPatterns(24, PIN_NEOPIXEL_RING_24, NEO_GRB + NEO_KHZ800, &allPatternsRandomHandler);
+#  if defined(USE_PARALLEL_OUTPUT)
+NeoPixelParallelGroup ParallelStrips;
+#  endif
 #endif
 
 /*
@@ -160,6 +168,16 @@ void setup() {
     ring12.begin(tBrightness, true); // This initializes the NeoPixel library.
     ring16.begin(tBrightness, true); // This initializes the NeoPixel library.
     ring24.begin(tBrightness, true); // This initializes the NeoPixel library.
+#if defined(USE_PARALLEL_OUTPUT) && !defined(ALL_PATTERN_ON_ONE_STRIP)
+    ParallelStrips.addNeoPixel(&bar16);
+    ParallelStrips.addNeoPixel(&bar24);
+    ParallelStrips.addNeoPixel(&ring12);
+    ParallelStrips.addNeoPixel(&ring16);
+    ParallelStrips.addNeoPixel(&ring24);
+    if (!ParallelStrips.begin()) {
+        Serial.println(F("Not enough memory for parallel output"));
+    }
+#endif
 
     delay(300); // to avoid partial patterns at power up
 
@@ -225,11 +243,23 @@ void loop() {
 #endif
     //    sBrightnessPrint.printIfChanged(tBrightness);
 
+#if defined(USE_PARALLEL_OUTPUT) && !defined(ALL_PATTERN_ON_ONE_STRIP)
+    // updateOrRedraw() does not call show(), all strips are shown together below
+    bool tMustShow = bar16.updateOrRedraw(DO_NO_REDRAW_IF_NO_UPDATE, tBrightness);
+    tMustShow |= bar24.updateOrRedraw(DO_NO_REDRAW_IF_NO_UPDATE, tBrightness);
+    tMustShow |= ring12.updateOrRedraw(DO_NO_REDRAW_IF_NO_UPDATE, tBrightness);
+    tMustShow |= ring16.updateOrRedraw(DO_NO_REDRAW_IF_NO_UPDATE, tBrightness);
+    tMustShow |= ring24.updateOrRedraw(DO_NO_REDRAW_IF_NO_UPDATE, tBrightness);
+    if (tMustShow) {
+        ParallelStrips.show();
+    }
+#else
     bar16.update(tBrightness);
     bar24.update(tBrightness);
     ring12.update(tBrightness);
     ring16.update(tBrightness);
     ring24.update(tBrightness);
+#endif
     if (NeoPixelMatrix.update(tBrightness)) {
         if (NeoPixelMatrix.ActivePattern == MATRIX_PATTERN_TICKER) {
             // change color of ticker after each update
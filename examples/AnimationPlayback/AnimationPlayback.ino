@@ -0,0 +1,112 @@
+/*
+ *  AnimationPlayback.cpp
+ *
+ *  Plays a pre-rendered animation from PROGMEM with the PlayAnimation pattern.
+ *  The animation is a red comet with a tail of 2 pixels running over a 16 pixel bar.
+ *  The first frame is a keyframe, all other frames are delta frames, which contain only the changed pixels.
+ *  See NeoAnimation.h for the format.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#include <Arduino.h>
+
+#define ENABLE_PATTERN_PLAY_ANIMATION
+#define ENABLE_PATTERN_RAINBOW_CYCLE
+#include <NeoPatterns.hpp>
+
+// Which pin on the Arduino is connected to the NeoPixels?
+#define PIN_NEOPIXEL_BAR_16          3
+
+const uint8_t CometAnimation[] PROGMEM = {
+        'N', 'A', NEO_ANIMATION_FORMAT_VERSION, 0, // Header, RGB palette
+        16, 0, // 16 pixels
+        16, 0, // 16 frames
+        40, 0, // 40 ms frame interval
+        4 - 1, // 4 palette colors
+        0, 0, 0, /**/255, 0, 0, /**/64, 0, 0, /**/16, 0, 0, // Palette: black, red, red / 4, red / 16
+        // Frames
+        NEO_ANIMATION_KEYFRAME, 0x40, 1, NEO_ANIMATION_END_OF_FRAME, // Literal of 1 pixel with palette index 1
+        0x44, 0x41, 2, 1, 0, // Delta frame, literal of 2 pixels
+        0x44, 0x42, 3, 2, 1, 0,
+        0x44, 0x43, 0, 3, 2, 1, 0,
+        0x44, 1, 0x43, 0, 3, 2, 1, 0, // Skip 1 pixel, literal of 4 pixels
+        0x44, 2, 0x43, 0, 3, 2, 1, 0,
+        0x44, 3, 0x43, 0, 3, 2, 1, 0,
+        0x44, 4, 0x43, 0, 3, 2, 1, 0,
+        0x44, 5, 0x43, 0, 3, 2, 1, 0,
+        0x44, 6, 0x43, 0, 3, 2, 1, 0,
+        0x44, 7, 0x43, 0, 3, 2, 1, 0,
+        0x44, 8, 0x43, 0, 3, 2, 1, 0,
+        0x44, 9, 0x43, 0, 3, 2, 1, 0,
+        0x44, 10, 0x43, 0, 3, 2, 1, 0,
+        0x44, 11, 0x43, 0, 3, 2, 1, 0,
+        0x44, 12, 0x43, 0, 3, 2, 1, 0 };
+
+// onComplete callback functions
+void AnimationAndRainbow(NeoPatterns *aLedsPtr);
+
+// The NeoPatterns instances
+NeoPatterns bar16 = NeoPatterns(16, PIN_NEOPIXEL_BAR_16, NEO_GRB + NEO_KHZ800, &AnimationAndRainbow);
+NeoAnimation Comet;
+
+void setup() {
+    Serial.begin(115200);
+#if defined(__AVR_ATmega32U4__) || defined(SERIAL_PORT_USBVIRTUAL) || defined(SERIAL_USB) /*stm32duino*/|| defined(USBCON) /*STM32_stm32*/ \
+    || defined(SERIALUSB_PID)  || defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_attiny3217)
+    delay(4000); // To be able to connect Serial monitor after reset or power up and before first print out. Do not wait for an attached Serial Monitor!
+#endif
+    // Just to know which program is running on my Arduino
+    Serial.println(F("START " __FILE__ " from " __DATE__ "\r\nUsing library version " VERSION_NEOPATTERNS));
+    bar16.printConnectionInfo(&Serial);
+
+    bar16.begin(); // This sets the pin.
+
+    if (!Comet.beginPGM(CometAnimation)) {
+        Serial.println(F("Invalid animation data"));
+    }
+    Comet.printInfo(&Serial);
+
+    AnimationAndRainbow(&bar16);
+}
+
+void loop() {
+    bar16.update();
+}
+
+/*
+ * Plays the comet animation 3 times and then a rainbow
+ */
+void AnimationAndRainbow(NeoPatterns *aLedsPtr) {
+    static bool sPlayAnimation = true;
+
+    if (sPlayAnimation) {
+        aLedsPtr->PlayAnimation(&Comet, 3);
+    } else {
+        aLedsPtr->RainbowCycle(10);
+    }
+    Serial.print(F("ActivePattern="));
+    aLedsPtr->printPatternName(aLedsPtr->ActivePattern, &Serial);
+    Serial.println();
+
+    sPlayAnimation = !sPlayAnimation;
+}
@@ -0,0 +1,93 @@
+/*
+ *  AnimationRecorder.cpp
+ *
+ *  Records the Fire pattern with NeoAnimationRecorder without waiting for the pattern interval,
+ *  prints compression ratio, decode time per frame and the animation as C array for PROGMEM,
+ *  and then plays the recorded animation from RAM with the PlayAnimation pattern.
+ *  The printed array can be copied into a sketch and played with NeoAnimation::beginPGM(), see example AnimationPlayback.
+ *
+ *  Recording requires heap for the animation, 2 bytes per pixel and 4 bytes per palette color.
+ *  So use an ESP32 or similar for long animations. On an Uno, only a short animation fits into RAM.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#include <Arduino.h>
+
+#define ENABLE_ANIMATION_RECORDER
+#define ENABLE_PATTERN_PLAY_ANIMATION
+#define ENABLE_PATTERN_FIRE
+#include <NeoPatterns.hpp>
+
+// Which pin on the Arduino is connected to the NeoPixels?
+#define PIN_NEOPIXEL_BAR_16          3
+
+#if defined(__AVR__)
+#define NUMBER_OF_FRAMES_TO_RECORD  20
+#else
+#define NUMBER_OF_FRAMES_TO_RECORD  200
+#endif
+#define FIRE_INTERVAL_MILLIS        30
+
+// The NeoPatterns instances
+NeoPatterns bar16 = NeoPatterns(16, PIN_NEOPIXEL_BAR_16, NEO_GRB + NEO_KHZ800);
+NeoAnimationRecorder Recorder;
+NeoAnimation RecordedFire;
+
+void setup() {
+    Serial.begin(115200);
+#if defined(__AVR_ATmega32U4__) || defined(SERIAL_PORT_USBVIRTUAL) || defined(SERIAL_USB) /*stm32duino*/|| defined(USBCON) /*STM32_stm32*/ \
+    || defined(SERIALUSB_PID)  || defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_attiny3217)
+    delay(4000); // To be able to connect Serial monitor after reset or power up and before first print out. Do not wait for an attached Serial Monitor!
+#endif
+    // Just to know which program is running on my Arduino
+    Serial.println(F("START " __FILE__ " from " __DATE__ "\r\nUsing library version " VERSION_NEOPATTERNS));
+    bar16.printConnectionInfo(&Serial);
+
+    bar16.begin(); // This sets the pin.
+
+    /*
+     * Record each frame shown by bar16. The initial frame is shown by Fire().
+     */
+    if (!Recorder.begin(&bar16, FIRE_INTERVAL_MILLIS, 32)) {
+        Serial.println(F("Not enough memory for recording"));
+        return;
+    }
+    bar16.Fire(NUMBER_OF_FRAMES_TO_RECORD - 1, FIRE_INTERVAL_MILLIS);
+    while (!bar16._update(true)) {
+        bar16.show();
+    }
+    if (!Recorder.end()) {
+        Serial.println(F("Recording failed"));
+    }
+
+    Recorder.printStatistics(&Serial, &bar16);
+    Recorder.printCHeader(&Serial, "FireAnimation");
+
+    if (RecordedFire.begin(Recorder.AnimationData)) {
+        bar16.PlayAnimation(&RecordedFire, 0); // 0 = endless
+    }
+}
+
+void loop() {
+    bar16.update();
+}
@@ -0,0 +1,115 @@
+/*
+ *  DmxReceiver.cpp
+ *
+ *  Receives Art-Net and E1.31 (sACN) from a lighting console or a PC program over WiFi and shows it on 2 strips.
+ *  Strip 1 with 340 pixels uses universe 1 and 2.
+ *  Strip 2 with 170 pixels is divided into 2 partial NeoPixel objects with 85 pixels, which use universe 3 and 4.
+ *  The slots are copied by NeoDmxReceiver from the received packet into back buffers. Once per frame,
+ *  they are copied into the pixel buffers and the strips are shown, i.e. after all 4 universes or a sync packet are received.
+ *  Every 10 seconds the receive statistics are printed.
+ *
+ *  ESP32 only, since it uses the AsyncUDP library.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#include <Arduino.h>
+
+#if !defined(ESP32)
+#error This example requires an ESP32
+#endif
+
+#include <WiFi.h>
+#include <AsyncUDP.h>
+
+#include <NeoPixel.hpp>
+#include <NeoDmxReceiver.hpp>
+
+#define WIFI_SSID       "your-ssid"
+#define WIFI_PASSWORD   "your-password"
+
+// Which pins on the ESP32 are connected to the NeoPixels?
+#define PIN_NEOPIXEL_STRIP_1    16
+#define PIN_NEOPIXEL_STRIP_2    17
+
+NeoPixel Strip1 = NeoPixel(340, PIN_NEOPIXEL_STRIP_1, NEO_GRB + NEO_KHZ800);
+NeoPixel Strip2 = NeoPixel(170, PIN_NEOPIXEL_STRIP_2, NEO_GRB + NEO_KHZ800);
+// Child segments of Strip2
+NeoPixel Strip2Left = NeoPixel(&Strip2, 0, 85, DISABLE_CALLING_SHOW_OF_PARENT);
+NeoPixel Strip2Right = NeoPixel(&Strip2, 85, 85, DISABLE_CALLING_SHOW_OF_PARENT);
+
+NeoDmxReceiver DmxReceiver;
+AsyncUDP ArtNetUdp;
+AsyncUDP E131Udp;
+
+void setup() {
+    Serial.begin(115200);
+    // Just to know which program is running on my Arduino
+    Serial.println(F("START " __FILE__ " from " __DATE__));
+
+    Strip1.begin(); // This sets the pin.
+    Strip2.begin();
+
+    DmxReceiver.addUniverse(1, &Strip1);
+    DmxReceiver.addUniverse(2, &Strip1, 170);
+    DmxReceiver.addUniverse(3, &Strip2Left);
+    DmxReceiver.addUniverse(4, &Strip2Right);
+
+    WiFi.mode(WIFI_STA);
+    WiFi.setSleep(false); // Power save mode delays received packets
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+    while (WiFi.status() != WL_CONNECTED) {
+        delay(500);
+        Serial.print('.');
+    }
+    Serial.println();
+    Serial.print(F("Send Art-Net or E1.31 unicast to "));
+    Serial.println(WiFi.localIP());
+
+    /*
+     * The callbacks run in the task of the network stack and copy the slots into the back buffers.
+     * show() copies the back buffers into the pixel buffers and is called in loop().
+     */
+    if (ArtNetUdp.listen(NEO_DMX_ART_NET_PORT)) {
+        ArtNetUdp.onPacket([](AsyncUDPPacket &aPacket) {
+            DmxReceiver.processPacket(aPacket.data(), aPacket.length());
+        });
+    }
+    if (E131Udp.listen(NEO_DMX_E131_PORT)) {
+        E131Udp.onPacket([](AsyncUDPPacket &aPacket) {
+            DmxReceiver.processPacket(aPacket.data(), aPacket.length());
+        });
+    }
+}
+
+void loop() {
+    static unsigned long sLastPrintMillis;
+
+    if (DmxReceiver.FrameIsComplete) {
+        DmxReceiver.show();
+    }
+
+    if (millis() - sLastPrintMillis > 10000) {
+        sLastPrintMillis = millis();
+        DmxReceiver.printStatistics(&Serial);
+    }
+}
@@ -0,0 +1,115 @@
+/*
+ *  MatrixInheritanceBenchmark.cpp
+ *
+ *  Measures the duration of setMatrixPixelColor(), FireMatrixUpdate() and SnowUpdate()
+ *  to compare the default virtual inheritance with ENABLE_NON_VIRTUAL_INHERITANCE.
+ *  Compile and run it once with and once without ENABLE_NON_VIRTUAL_INHERITANCE.
+ *  No show() is called, so no matrix needs to be attached.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#include <Arduino.h>
+
+//#define ENABLE_NON_VIRTUAL_INHERITANCE // Single inheritance chain without virtual base NeoPixel
+
+#define ENABLE_NO_MATRIX_AND_NEO_PATTERN_BY_DEFAULT
+#define ENABLE_MATRIX_PATTERN_FIRE
+#define ENABLE_MATRIX_PATTERN_SNOW
+#include <MatrixNeoPatterns.hpp>
+
+#define PIN_NEOPIXEL_MATRIX         8
+#define MATRIX_NUMBER_OF_COLUMNS    8
+#define MATRIX_NUMBER_OF_ROWS       8
+#define MATRIX_GEOMETRY             (NEO_MATRIX_BOTTOM | NEO_MATRIX_RIGHT | NEO_MATRIX_ROWS | NEO_MATRIX_ZIGZAG)
+
+#define NUMBER_OF_LOOPS             100
+
+MatrixNeoPatterns NeoPixelMatrix = MatrixNeoPatterns(MATRIX_NUMBER_OF_COLUMNS, MATRIX_NUMBER_OF_ROWS, PIN_NEOPIXEL_MATRIX,
+MATRIX_GEOMETRY, NEO_GRB + NEO_KHZ800, nullptr);
+
+void printMicrosPerLoop(const __FlashStringHelper *aName, unsigned long aStartMicros) {
+    unsigned long tMicros = micros() - aStartMicros;
+    Serial.print(aName);
+    Serial.print(F(": "));
+    Serial.print(tMicros / NUMBER_OF_LOOPS);
+    Serial.println(F(" us"));
+}
+
+void setup() {
+    pinMode(LED_BUILTIN, OUTPUT);
+
+    Serial.begin(115200);
+#if defined(__AVR_ATmega32U4__) || defined(SERIAL_PORT_USBVIRTUAL) || defined(SERIAL_USB) /*stm32duino*/|| defined(USBCON) /*STM32_stm32*/ \
+    || defined(SERIALUSB_PID)  || defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_attiny3217)
+    delay(4000); // To be able to connect Serial monitor after reset or power up and before first print out. Do not wait for an attached Serial Monitor!
+#endif
+    // Just to know which program is running on my Arduino
+    Serial.println(F("START " __FILE__ " from " __DATE__ "\r\nUsing library version " VERSION_NEOPATTERNS));
+#if defined(ENABLE_NON_VIRTUAL_INHERITANCE)
+    Serial.println(F("Non virtual inheritance"));
+#else
+    Serial.println(F("Virtual inheritance"));
+#endif
+    Serial.print(F("Size of MatrixNeoPatterns object="));
+    Serial.println(sizeof(MatrixNeoPatterns));
+
+    if (!NeoPixelMatrix.begin(&Serial)) {
+        while (true) {
+            digitalWrite(LED_BUILTIN, HIGH);
+            delay(500);
+            digitalWrite(LED_BUILTIN, LOW);
+            delay(500);
+        }
+    }
+}
+
+void loop() {
+    unsigned long tStartMicros = micros();
+    for (uint_fast8_t i = 0; i < NUMBER_OF_LOOPS; ++i) {
+        for (uint_fast8_t y = 0; y < MATRIX_NUMBER_OF_ROWS; ++y) {
+            for (uint_fast8_t x = 0; x < MATRIX_NUMBER_OF_COLUMNS; ++x) {
+                NeoPixelMatrix.setMatrixPixelColor(x, y, NeoPatterns::Wheel(x + y + i));
+            }
+        }
+    }
+    printMicrosPerLoop(F("setMatrixPixelColor() for all pixels"), tStartMicros);
+
+    NeoPixelMatrix.Fire(NUMBER_OF_LOOPS + 2, 0);
+    tStartMicros = micros();
+    for (uint_fast8_t i = 0; i < NUMBER_OF_LOOPS; ++i) {
+        NeoPixelMatrix.FireMatrixUpdate();
+    }
+    printMicrosPerLoop(F("FireMatrixUpdate()"), tStartMicros);
+    NeoPixelMatrix.FireMatrixStop();
+
+    NeoPixelMatrix.Snow(NUMBER_OF_LOOPS + 2, 0);
+    tStartMicros = micros();
+    for (uint_fast8_t i = 0; i < NUMBER_OF_LOOPS; ++i) {
+        NeoPixelMatrix.SnowUpdate();
+    }
+    printMicrosPerLoop(F("SnowUpdate()"), tStartMicros);
+    NeoPixelMatrix.SnowStop();
+
+    Serial.println();
+    delay(5000);
+}
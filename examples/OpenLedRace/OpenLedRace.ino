@@ -72,6 +72,7 @@
 #define ENABLE_PATTERN_SCANNER_EXTENDED
 #define ENABLE_PATTERN_COLOR_WIPE
 #define ENABLE_PATTERN_STRIPES
+#define CORRECT_ARDUINO_MILLIS_FOR_SHOW // Let the library compensate Arduino millis() for the time interrupt was disabled for show().
 #include "NeoPatterns.hpp"
 
 //#define TRACE
@@ -219,8 +220,6 @@ NeoPixel AccelerationCommonNeopixelBar = NeoPixel(8, 0, NEO_GRB + NEO_KHZ800);
  * Game loop timing
  */
 #define MILLISECONDS_PER_LOOP 20 // 50 fps
-// Required for correction of the millis() timer
-#define MILLIS_FOR_TRACK_TO_SHOW  (NUMBER_OF_TRACK_PIXELS / 33) // 33 pixels can be sent per ms. 9ms for 300 pixels.
 #define ANIMATION_INTERVAL_MILLIS 10000
 
 #define FULL_GRAVITY 100 // 100 is gravity for a vertical slope, 0 for a horizontal and 70 (sqrt(0,5)*100) for 45 degree.
@@ -282,8 +281,6 @@ bool isStartStopButtonPressed();
 bool checkAllCarInputs();
 void printConfigPinInfo(Print *aSerial, uint8_t aConfigPinNumber, const __FlashStringHelper *aConfigPinDescription);
 
-extern volatile unsigned long timer0_millis; // Used for ATmega328P to adjust for missed millis interrupts
-
 /*
  * Helper macro for getting a macro definition as string
  */
@@ -828,7 +825,6 @@ public:
                 digitalWrite(PIN_TIMING, HIGH);
 #endif
             if (TrackPtr->update()) {
-                timer0_millis += MILLIS_FOR_TRACK_TO_SHOW;
                 // restore bridge and loop pattern, which might be overwritten by scanner.
                 resetAndDrawTrack(false);
             }
@@ -1353,8 +1349,7 @@ void loop() {
             /*
              * Show track
              */
-            track.show(); // 9 Milliseconds for 300 Pixel
-            timer0_millis += MILLIS_FOR_TRACK_TO_SHOW; // compensate Arduino millis() for the time interrupt was disabled for track.show().
+            track.show(); // 9 Milliseconds for 300 Pixel. Arduino millis() is compensated by the library.
 
             /*
              * Manage sound. Must check for situation after winner
@@ -1583,7 +1578,6 @@ void resetAndDrawTrack(bool aDoAnimation) {
 void resetAndShowTrackWithoutCars() {
     resetAndDrawTrack(false);
     track.show();
-    timer0_millis += MILLIS_FOR_TRACK_TO_SHOW;
 }
 
 void resetAllCars() {
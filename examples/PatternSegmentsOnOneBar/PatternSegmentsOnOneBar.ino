@@ -0,0 +1,109 @@
+/*
+ *  PatternSegmentsOnOneBar.cpp
+ *
+ *  Runs 10 6-pixel patterns simultaneously on a 60 NeoPixel bar.
+ *  This is done by using one base NeoPatterns object, one partial NeoPatterns object as renderer
+ *  and 10 PatternSegment objects, which require only 50 bytes RAM each instead of 75 bytes for a NeoPatterns object.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#include <Arduino.h>
+
+#define ENABLE_PATTERN_COLOR_WIPE
+#define ENABLE_PATTERN_SCANNER_EXTENDED
+#define ENABLE_PATTERN_STRIPES
+#define ENABLE_PATTERN_FADE
+#include <PatternSegment.hpp>
+
+// Which pin on the Arduino is connected to the NeoPixels?
+#define PIN_NEOPIXEL        3
+
+#define NUMBER_OF_SEGMENTS  10
+#define SEGMENT_LENGTH      6
+
+// onComplete callback functions
+void SegmentPatterns(NeoPatterns *aLedsPtr);
+
+// construct the NeoPatterns instances
+NeoPatterns NeoPixelBar60 = NeoPatterns(NUMBER_OF_SEGMENTS * SEGMENT_LENGTH, PIN_NEOPIXEL, NEO_GRB + NEO_KHZ800);
+/*
+ * The renderer shares the pixel buffer of NeoPixelBar60 and draws the pattern of the selected segment.
+ */
+NeoPatterns SegmentRenderer = NeoPatterns(&NeoPixelBar60, 0, NUMBER_OF_SEGMENTS * SEGMENT_LENGTH, DISABLE_CALLING_SHOW_OF_PARENT);
+
+PatternSegment Segments[NUMBER_OF_SEGMENTS];
+
+void setup() {
+    pinMode(LED_BUILTIN, OUTPUT);
+
+    Serial.begin(115200);
+#if defined(__AVR_ATmega32U4__) || defined(SERIAL_PORT_USBVIRTUAL) || defined(SERIAL_USB) /*stm32duino*/|| defined(USBCON) /*STM32_stm32*/ \
+    || defined(SERIALUSB_PID)  || defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_attiny3217)
+    delay(4000); // To be able to connect Serial monitor after reset or power up and before first print out. Do not wait for an attached Serial Monitor!
+#endif
+    // Just to know which program is running on my Arduino
+    Serial.println(F("START " __FILE__ " from " __DATE__ "\r\nUsing library version " VERSION_NEOPATTERNS));
+    NeoPixelBar60.printConnectionInfo(&Serial);
+
+    NeoPixelBar60.begin(); // This sets the output pin.
+
+    /*
+     * Set the regions of the segments and start the patterns
+     */
+    for (uint_fast8_t i = 0; i < NUMBER_OF_SEGMENTS; ++i) {
+        Segments[i].init(&SegmentRenderer, i * SEGMENT_LENGTH, SEGMENT_LENGTH, &SegmentPatterns);
+        Segments[i].select()->Delay(i * 100); // Start the segments one after another
+    }
+    Serial.println(F("Started"));
+}
+
+void loop() {
+    if (updateAllPatternSegments()) {
+        NeoPixelBar60.show();
+    }
+}
+
+/*
+ * Callback handler for all segments. The completed segment is selected and aLedsPtr is the renderer.
+ */
+void SegmentPatterns(NeoPatterns *aLedsPtr) {
+    uint8_t tColorWheelIndex = random8();
+    uint8_t tInterval = random8(40, 201);
+
+    switch (random8(4)) {
+    case 0:
+        aLedsPtr->ColorWipe(NeoPatterns::Wheel(tColorWheelIndex), tInterval, CLEAR_PATTERN_BEFORE, tColorWheelIndex & DIRECTION_DOWN);
+        break;
+    case 1:
+        aLedsPtr->ScannerExtended(NeoPatterns::Wheel(tColorWheelIndex), 2, tInterval, 2,
+        FLAG_SCANNER_EXT_CYLON | FLAG_SCANNER_EXT_VANISH_COMPLETE);
+        break;
+    case 2:
+        aLedsPtr->Stripes(COLOR32_BLACK, 2, NeoPatterns::Wheel(tColorWheelIndex), 2, 3 * SEGMENT_LENGTH, tInterval,
+                tColorWheelIndex & DIRECTION_DOWN);
+        break;
+    default:
+        aLedsPtr->Fade(COLOR32_BLACK, NeoPatterns::Wheel(tColorWheelIndex), 32, tInterval / 4);
+        break;
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ *  PatternSequence.cpp
+ *
+ *  Shows the patterns of the AllPatternOnOneBar example on one 16 pixel bar, but the order of the patterns
+ *  is defined by the sequence in ShowSequence.h, which is stored in PROGMEM, and not by a completion callback.
+ *  Check the sequence on your PC with extras/SequenceValidator, before uploading it.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#include <Arduino.h>
+
+#define ENABLE_NEOPATTERNS_SEQUENCER
+#define ENABLE_CROSSFADE_TRANSITION // Required for SEQUENCE_CROSSFADE(), otherwise these steps are ignored
+#include <NeoPatterns.hpp>
+
+#include "ShowSequence.h"
+
+#define INFO // if not defined, no Serial related code should be linked
+
+// Which pin on the Arduino is connected to the NeoPixels?
+#define PIN_NEOPIXEL_BAR_16          3
+
+// Construct the NeoPatterns instances. The completion callback is set by startSequence().
+NeoPatterns bar16 = NeoPatterns(16, PIN_NEOPIXEL_BAR_16, NEO_GRB + NEO_KHZ800);
+
+void setup() {
+    pinMode(LED_BUILTIN, OUTPUT);
+
+#if defined(INFO)
+    Serial.begin(115200);
+
+#if defined(__AVR_ATmega32U4__) || defined(SERIAL_PORT_USBVIRTUAL) || defined(SERIAL_USB) /*stm32duino*/|| defined(USBCON) /*STM32_stm32*/ \
+    || defined(SERIALUSB_PID)  || defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_attiny3217)
+    delay(4000); // To be able to connect Serial monitor after reset or power up and before first print out. Do not wait for an attached Serial Monitor!
+#endif
+    // Just to know which program is running on my Arduino
+    Serial.println(F("START " __FILE__ " from " __DATE__ "\r\nUsing library version " VERSION_NEOPATTERNS));
+    bar16.printConnectionInfo(&Serial);
+#endif
+
+    bar16.begin(); // This initializes the NeoPixel library.
+    bar16.startSequence(ShowSequence); // The sequence is endless, so no handler for the end of the sequence is required
+
+#if defined(INFO)
+    Serial.println("started");
+#endif
+}
+
+void loop() {
+#if defined(INFO)
+    static uint8_t sLastActivePattern = PATTERN_NONE;
+    if (bar16.ActivePattern != sLastActivePattern) {
+        sLastActivePattern = bar16.ActivePattern;
+        Serial.print("ActivePattern=");
+        bar16.printPatternName(sLastActivePattern, &Serial);
+        Serial.println();
+    }
+#endif
+    bar16.update();
+    delay(10);
+}
@@ -0,0 +1,55 @@
+/*
+ *  ShowSequence.h
+ *
+ *  The sequence of the PatternSequence example. It is in a separate file to be checked by extras/SequenceValidator.
+ *  It shows the patterns of the AllPatternOnOneBar example, but without a hand-written completion handler.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _SHOW_SEQUENCE_H
+#define _SHOW_SEQUENCE_H
+
+const uint8_t ShowSequence[] PROGMEM = {
+/* 0 */ SEQUENCE_COLOR_WIPE(COLOR32(0, 0, 2), 50, CLEAR_PATTERN_BEFORE, DIRECTION_DOWN), // light blue
+/* 1 */ SEQUENCE_LOOP(0), // endless
+/* 2 */     SEQUENCE_SCANNER_EXTENDED(COLOR32_RED, 5, 60, 2, FLAG_SCANNER_EXT_CYLON, DIRECTION_UP),
+/* 3 */     SEQUENCE_CROSSFADE(500),
+/* 4 */     SEQUENCE_HEARTBEAT(COLOR32_ORANGE, 30, 2, false),
+/* 5 */     SEQUENCE_SCANNER_EXTENDED(COLOR32_GREEN, 7, 60, 2, FLAG_SCANNER_EXT_ROCKET | FLAG_SCANNER_EXT_START_AT_BOTH_ENDS, DIRECTION_DOWN),
+/* 6 */     SEQUENCE_RANDOM_ONE_OF(2), // Stripes or the old TheaterChase
+/* 7 */         SEQUENCE_STRIPES(COLOR32_BLUE, 5, COLOR32_YELLOW, 3, 32, 120, DIRECTION_UP),
+/* 8 */         SEQUENCE_STRIPES(COLOR32_BLUE, 1, COLOR32_YELLOW, 2, 32, 120, DIRECTION_DOWN),
+/* 9 */     SEQUENCE_CROSSFADE(500),
+/* 10 */    SEQUENCE_RAINBOW_CYCLE(15, DIRECTION_DOWN, 1),
+/* 11 */    SEQUENCE_CROSSFADE(500),
+/* 12 */    SEQUENCE_FADE(COLOR32_RED, COLOR32_BLUE, 64, 60),
+/* 13 */    SEQUENCE_LOOP(2), // Wipe in and out 2 times
+/* 14 */        SEQUENCE_COLOR_WIPE(COLOR32_GREEN_HALF, 60, CLEAR_PATTERN_BEFORE, DIRECTION_UP),
+/* 15 */        SEQUENCE_COLOR_WIPE(COLOR32_BLACK, 60, DO_NOT_CLEAR_PATTERN_BEFORE, DIRECTION_DOWN),
+/* 16 */    SEQUENCE_END_LOOP,
+/* 17 */    SEQUENCE_TWINKLE(COLOR32_SPECIAL, 4, 40, 50, CLEAR_PATTERN_BEFORE),
+/* 18 */    SEQUENCE_CROSSFADE(1000),
+/* 19 */    SEQUENCE_FIRE(120, 30, DIRECTION_UP),
+/* 20 */    SEQUENCE_DELAY(500),
+/* 21 */SEQUENCE_END_LOOP,
+/* 22 */SEQUENCE_END };
+
+#endif // _SHOW_SEQUENCE_H
@@ -0,0 +1,75 @@
+/*
+ *  SerialIngest.cpp
+ *
+ *  Shows frames received from a host over Serial with the SerialIngest pattern.
+ *  The frames are read with flow control directly into the pixel buffer. See NeoPatterns.h for the frame format.
+ *  Run extras/SerialIngest.py on the host to send a moving rainbow e.g. "python3 SerialIngest.py --port COM6 --pixels 16".
+ *  If no frame is received for 2 seconds, a rainbow cycle is shown until the host sends again.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#include <Arduino.h>
+
+#define ENABLE_PATTERN_SERIAL_INGEST
+#define ENABLE_PATTERN_RAINBOW_CYCLE
+#include <NeoPatterns.hpp>
+
+// Which pin on the Arduino is connected to the NeoPixels?
+#define PIN_NEOPIXEL_BAR_16          3
+
+#define INGEST_TIMEOUT_MILLIS     2000
+
+// onComplete callback functions
+void ShowRainbow(NeoPatterns *aLedsPtr);
+
+// The NeoPatterns instances
+NeoPatterns bar16 = NeoPatterns(16, PIN_NEOPIXEL_BAR_16, NEO_GRB + NEO_KHZ800, &ShowRainbow);
+
+void setup() {
+    Serial.begin(115200);
+#if defined(__AVR_ATmega32U4__) || defined(SERIAL_PORT_USBVIRTUAL) || defined(SERIAL_USB) /*stm32duino*/|| defined(USBCON) /*STM32_stm32*/ \
+    || defined(SERIALUSB_PID)  || defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_attiny3217)
+    delay(4000); // To be able to connect Serial monitor after reset or power up and before first print out. Do not wait for an attached Serial Monitor!
+#endif
+    // Just to know which program is running on my Arduino. The host script ignores these text bytes.
+    Serial.println(F("START " __FILE__ " from " __DATE__ "\r\nUsing library version " VERSION_NEOPATTERNS));
+
+    bar16.begin(); // This sets the pin.
+
+    bar16.SerialIngest(&Serial, INGEST_TIMEOUT_MILLIS);
+}
+
+void loop() {
+    if (bar16.ActivePattern != PATTERN_SERIAL_INGEST && Serial.available()) {
+        // Host sends again, the received byte is the start of a frame and is read by the pattern
+        bar16.SerialIngest(&Serial, INGEST_TIMEOUT_MILLIS);
+    }
+    bar16.update();
+}
+
+/*
+ * Called if no frame was received for INGEST_TIMEOUT_MILLIS and at the end of each rainbow cycle
+ */
+void ShowRainbow(NeoPatterns *aLedsPtr) {
+    aLedsPtr->RainbowCycle(10);
+}
@@ -0,0 +1,83 @@
+/*
+ *  Telemetry.cpp
+ *
+ *  Runs Fire, RainbowCycle and ScannerExtended on a 16 pixel bar and sends each shown frame
+ *  as binary telemetry stream over Serial, without stalling the patterns.
+ *  Start "python3 TelemetryViewer.py --port COM6" in the extras folder of the library to watch the bar and its timing on the PC.
+ *  Close the Arduino Serial Monitor before, since the port can only be opened once.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#include <Arduino.h>
+
+#define ENABLE_NEOPIXEL_TELEMETRY
+#define ENABLE_PATTERN_FIRE
+#define ENABLE_PATTERN_RAINBOW_CYCLE
+#define ENABLE_PATTERN_SCANNER_EXTENDED
+#include <NeoPatterns.hpp>
+#include <NeoPixelTelemetry.hpp>
+
+// Which pin on the Arduino is connected to the NeoPixels?
+#define PIN_NEOPIXEL_BAR_16          3
+
+// onComplete callback functions
+void ThreePatterns(NeoPatterns *aLedsPtr);
+
+// The NeoPatterns instances
+NeoPatterns bar16 = NeoPatterns(16, PIN_NEOPIXEL_BAR_16, NEO_GRB + NEO_KHZ800, &ThreePatterns);
+NeoPixelTelemetry Telemetry;
+
+void setup() {
+    Serial.begin(500000); // The default baudrate of TelemetryViewer.py
+    // No text output here, since the viewer expects the binary stream
+
+    bar16.begin(); // This sets the pin.
+
+    if (!Telemetry.begin(&bar16, &Serial)) {
+        // Not enough memory
+        digitalWrite(LED_BUILTIN, HIGH);
+    }
+    ThreePatterns(&bar16);
+}
+
+void loop() {
+    bar16.update();
+    Telemetry.poll(); // Sends the rest of the current frame
+}
+
+void ThreePatterns(NeoPatterns *aLedsPtr) {
+    static uint8_t sState = 0;
+
+    switch (sState) {
+    case 0:
+        aLedsPtr->Fire(300, 20);
+        break;
+    case 1:
+        aLedsPtr->RainbowCycle(10);
+        break;
+    default:
+        aLedsPtr->ScannerExtended(COLOR32_BLUE, 5, 40, 4, FLAG_SCANNER_EXT_ROCKET | FLAG_SCANNER_EXT_START_AT_BOTH_ENDS);
+        break;
+    }
+    sState = (sState + 1) % 3;
+}
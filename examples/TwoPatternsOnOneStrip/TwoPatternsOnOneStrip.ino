@@ -139,7 +139,7 @@ void setup() {
      * and adjust pixel buffer to the new length.
      * After this initialize the pixel regions with the parent object to also get the new length here
      */
-    uint16_t tActualNeopixelLength = NeoPatternsBackground.getAndAdjustActualNeopixelLenghtSimple();
+    uint16_t tActualNeopixelLength = NeoPatternsBackground.getAndAdjustActualNeopixelLenghtBisection();
     Serial.print(F("Actual neopixel length="));
     Serial.println(tActualNeopixelLength);
 
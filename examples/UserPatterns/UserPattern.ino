@@ -34,6 +34,7 @@
 
 #define ENABLE_PATTERN_USER_PATTERN1
 #define ENABLE_PATTERN_USER_PATTERN2
+#define ENABLE_PATTERN_REGISTRY // For any number of additional patterns, see AlternatePixels below
 #define ENABLE_PATTERN_COLOR_WIPE
 #define DEBUG
 
@@ -47,6 +48,17 @@
 // onComplete callback handler for all patterns
 void userPatternsHandler(NeoPatterns *aLedsPtr);
 
+/*
+ * Registered patterns
+ */
+void AlternatePixelsStart(NeoPatterns *aNeoPatterns);
+bool AlternatePixelsUpdate(NeoPatterns *aNeoPatterns, bool aDoUpdate);
+const char AlternatePixelsName[] PROGMEM = "Alternate pixels";
+
+const PatternRegistryEntryStruct RegisteredPatterns[] PROGMEM = { { &AlternatePixelsStart, &AlternatePixelsUpdate,
+        AlternatePixelsName } };
+#define PATTERN_ALTERNATE_PIXELS    (PATTERN_REGISTERED_FIRST + 0) // Index in RegisteredPatterns
+
 NeoPatterns bar16 = NeoPatterns(16, PIN_NEOPIXEL_BAR_16, NEO_GRB + NEO_KHZ800, &userPatternsHandler);
 
 void setup() {
@@ -62,6 +74,7 @@ void setup() {
     bar16.printConnectionInfo(&Serial);
 
     bar16.begin(); // This initializes the NeoPixel library.
+    NeoPatterns::registerPatterns(RegisteredPatterns, sizeof(RegisteredPatterns) / sizeof(PatternRegistryEntryStruct));
     bar16.ColorWipe(COLOR32(0, 0, 02), 50, CLEAR_PATTERN_BEFORE, DIRECTION_DOWN); // light Blue
 
     Serial.println("started");
@@ -200,6 +213,59 @@ bool UserPattern2Update(NeoPatterns *aNeoPatterns, bool aDoUpdate) {
     return false;
 }
 
+/*
+ * Sample implementation of a registered pattern
+ * Even and odd pixels alternate between aColor and aBackgroundColor
+ */
+void AlternatePixels(NeoPatterns *aNeoPatterns, color32_t aColor, color32_t aBackgroundColor, uint16_t aIntervalMillis,
+        uint16_t aRepetitions) {
+    aNeoPatterns->Interval = aIntervalMillis;
+    aNeoPatterns->Color1 = aColor;
+    aNeoPatterns->LongValue1.BackgroundColor = aBackgroundColor;
+    aNeoPatterns->TotalStepCounter = 2 * aRepetitions + 1; // + 1 for the final clear pattern
+    aNeoPatterns->Index = 0;
+
+    AlternatePixelsUpdate(aNeoPatterns, ONLY_REDRAW_PATTERN);
+    aNeoPatterns->showPatternInitially();
+// must be after showPatternInitially(), since it requires the old value do detect asynchronous calling
+    aNeoPatterns->ActivePattern = PATTERN_ALTERNATE_PIXELS;
+}
+
+/*
+ * Start with default parameters, used by startRegisteredPattern()
+ */
+void AlternatePixelsStart(NeoPatterns *aNeoPatterns) {
+    AlternatePixels(aNeoPatterns, COLOR32_GREEN_HALF, COLOR32_BLACK, 200, 5);
+}
+
+/*
+ * @return - true if pattern has ended, false if pattern has NOT ended
+ */
+bool AlternatePixelsUpdate(NeoPatterns *aNeoPatterns, bool aDoUpdate) {
+    if (aDoUpdate) {
+        if (aNeoPatterns->decrementTotalStepCounter()) {
+            return true;
+        }
+        aNeoPatterns->Index ^= 1;
+    }
+
+    /*
+     * Refresh pattern
+     */
+    if (aNeoPatterns->TotalStepCounter == 1) {
+        aNeoPatterns->clear(); // last pattern is clear
+    } else {
+        for (unsigned int i = 0; i < aNeoPatterns->numPixels(); i++) {
+            if ((i & 0x01) == (unsigned int) aNeoPatterns->Index) {
+                aNeoPatterns->setPixelColor(i, aNeoPatterns->Color1);
+            } else {
+                aNeoPatterns->setPixelColor(i, aNeoPatterns->LongValue1.BackgroundColor);
+            }
+        }
+    }
+    return false;
+}
+
 /*
  * Handler for testing your user patterns
  */
@@ -224,6 +290,17 @@ void userPatternsHandler(NeoPatterns *aLedsPtr) {
     case 1:
         Serial.println("Start user pattern 2");
         UserPattern2(aLedsPtr, NeoPatterns::Wheel(tColor), tDuration, tRepetitions, DIRECTION_UP);
+        break;
+
+    case 2:
+        Serial.print(F("Start registered pattern "));
+        aLedsPtr->printPatternName(PATTERN_ALTERNATE_PIXELS, &Serial);
+        Serial.println();
+        if (tRepetitions == 0) {
+            aLedsPtr->startRegisteredPattern(PATTERN_ALTERNATE_PIXELS); // with default parameters
+        } else {
+            AlternatePixels(aLedsPtr, NeoPatterns::Wheel(tColor), COLOR32_BLUE_QUARTER, tDuration * 2, 3);
+        }
         sState = -1; // Start from beginning
         break;
 
@@ -0,0 +1,255 @@
+/*
+ *  AnimationBenchmark.cpp
+ *
+ *  Host program, which measures the decode throughput of NeoAnimation for an animation file, which is memory mapped
+ *  like a file in a flash file system of an ESP32.
+ *  Without -f, the Fire pattern is recorded by NeoAnimationRecorder, written to AnimationBenchmark.bin and this file is mapped.
+ *  Then every decoded frame is compared with the frame shown during recording.
+ *  For every frame, redrawFrame() into a cleared pixel buffer must restore the decoded frame.
+ *
+ *  Build and run on Linux or macOS, mmap() is required:
+ *  g++ -O2 -I../HostArduino -I../../src AnimationBenchmark.cpp ../HostArduino/HostArduino.cpp -o AnimationBenchmark
+ *  ./AnimationBenchmark [-f <animation file>] [-n <pixels>] [-F <frames>] [-k <keyframe interval>] [-r <repetitions>] [-q]
+ *  -n, -F and -k are used for recording, the number of pixels of an animation file is taken from its header.
+ *  -q prints only the result.
+ *  The exit code is 1 if a decoded or redrawn frame differs.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+// Must be included before Arduino.h, which defines min(), max() and abs() as macros
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <Arduino.h>
+
+#define ENABLE_PATTERN_FIRE
+#define ENABLE_PATTERN_PLAY_ANIMATION
+#define ENABLE_ANIMATION_RECORDER
+#include "NeoPatterns.hpp"
+
+#define RECORDED_FILE_NAME  "AnimationBenchmark.bin"
+
+const char *sFileName = nullptr;
+int sNumberOfPixels = 144;
+int sNumberOfFrames = 500;
+int sKeyframeInterval = 32;
+int sRepetitions = 20;
+bool sQuiet = false;
+
+/*
+ * Frames shown during recording, in the byte order of the pixel buffer
+ */
+uint8_t *sShownFrames;
+uint16_t sNumberOfShownFrames;
+uint16_t sNumberOfBytesPerFrame;
+
+void recordShowHandler(const uint8_t *aPixels, uint16_t aNumberOfBytes, int16_t aPin) {
+    (void) aPin;
+    if (sNumberOfShownFrames < sNumberOfFrames && aNumberOfBytes == sNumberOfBytesPerFrame) {
+        memcpy(&sShownFrames[(unsigned long) sNumberOfShownFrames * sNumberOfBytesPerFrame], aPixels, aNumberOfBytes);
+        sNumberOfShownFrames++;
+    }
+}
+
+class FilePrint: public Print {
+public:
+    FILE *File;
+    size_t write(uint8_t aByte) override {
+        return fwrite(&aByte, 1, 1, File);
+    }
+    size_t write(const uint8_t *aBuffer, size_t aSize) override {
+        return fwrite(aBuffer, 1, aSize, File);
+    }
+};
+
+/*
+ * Records sNumberOfFrames frames of the Fire pattern and writes them to RECORDED_FILE_NAME
+ * @return false if recording or writing failed
+ */
+bool recordFire() {
+    NeoPatterns tFireBar(sNumberOfPixels, 6, NEO_GRB + NEO_KHZ800);
+    tFireBar.begin();
+    sNumberOfBytesPerFrame = tFireBar.numPixels() * tFireBar.getBytesPerPixel();
+    sShownFrames = (uint8_t*) malloc((unsigned long) sNumberOfFrames * sNumberOfBytesPerFrame);
+    sNumberOfShownFrames = 0;
+
+    NeoAnimationRecorder tRecorder;
+    if (sShownFrames == nullptr || !tRecorder.begin(&tFireBar, 30, sKeyframeInterval)) {
+        printf("Not enough memory for recording\n");
+        return false;
+    }
+    hostShowHandler = &recordShowHandler;
+    tFireBar.Fire(sNumberOfFrames, 30);
+    while (tRecorder.NumberOfFrames < sNumberOfFrames && tFireBar.ActivePattern != PATTERN_NONE) {
+        tFireBar.update();
+        delay(1);
+    }
+    hostShowHandler = nullptr;
+    if (!tRecorder.end()) {
+        printf("Recording failed\n");
+        return false;
+    }
+    if (!sQuiet) {
+        tRecorder.printStatistics(&Serial);
+    }
+    if (tRecorder.NumberOfNearestColorPixels != 0) {
+        // Frames with nearest colors cannot be compared
+        printf("%lu pixels got the nearest palette color, decoded frames are not compared\n",
+                (unsigned long) tRecorder.NumberOfNearestColorPixels);
+        sNumberOfShownFrames = 0;
+    }
+
+    FilePrint tFile;
+    tFile.File = fopen(RECORDED_FILE_NAME, "wb");
+    if (tFile.File == nullptr) {
+        perror(RECORDED_FILE_NAME);
+        return false;
+    }
+    tRecorder.writeAnimation(&tFile);
+    fclose(tFile.File);
+    sFileName = RECORDED_FILE_NAME;
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            sFileName = argv[++i];
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            sNumberOfPixels = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-F") == 0 && i + 1 < argc) {
+            sNumberOfFrames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-k") == 0 && i + 1 < argc) {
+            sKeyframeInterval = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            sRepetitions = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-q") == 0) {
+            sQuiet = true;
+        } else {
+            printf("Usage: %s [-f <animation file>] [-n <pixels>] [-F <frames>] [-k <keyframe interval>] [-r <repetitions>] [-q]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if (sFileName == nullptr && !recordFire()) {
+        return 1;
+    }
+
+    /*
+     * Map the file
+     */
+    int tFileDescriptor = open(sFileName, O_RDONLY);
+    struct stat tFileStat;
+    if (tFileDescriptor < 0 || fstat(tFileDescriptor, &tFileStat) != 0 || tFileStat.st_size == 0) {
+        perror(sFileName);
+        return 1;
+    }
+    const uint8_t *tMappedFile = (const uint8_t*) mmap(nullptr, tFileStat.st_size, PROT_READ, MAP_PRIVATE, tFileDescriptor, 0);
+    if (tMappedFile == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+
+    NeoAnimation tAnimation;
+    if (!tAnimation.begin(tMappedFile)) {
+        printf("%s is no valid animation\n", sFileName);
+        return 1;
+    }
+    printf("%s: %ld bytes, ", sFileName, (long) tFileStat.st_size);
+    tAnimation.printInfo(&Serial);
+
+    NeoPixel tBar(tAnimation.NumberOfPixels, 6, NEO_GRB + NEO_KHZ800);
+    tBar.begin();
+    uint16_t tNumberOfBytes = tBar.numPixels() * tBar.getBytesPerPixel();
+    uint8_t *tDecodedFrame = (uint8_t*) malloc(tNumberOfBytes);
+
+    /*
+     * Check decode and redraw of all frames
+     */
+    unsigned int tDecodeErrors = 0;
+    unsigned int tRedrawErrors = 0;
+    uint16_t tFrameIndex = 0;
+    while (tAnimation.decodeNextFrame(&tBar)) {
+        if (tFrameIndex < sNumberOfShownFrames
+                && memcmp(tBar.getPixels(), &sShownFrames[(unsigned long) tFrameIndex * tNumberOfBytes], tNumberOfBytes) != 0) {
+            if (!sQuiet && tDecodeErrors == 0) {
+                printf("Decoded frame %u differs from recorded frame\n", tFrameIndex);
+            }
+            tDecodeErrors++;
+        }
+        memcpy(tDecodedFrame, tBar.getPixels(), tNumberOfBytes);
+        tBar.clear();
+        tAnimation.redrawFrame(&tBar);
+        if (memcmp(tBar.getPixels(), tDecodedFrame, tNumberOfBytes) != 0) {
+            if (!sQuiet && tRedrawErrors == 0) {
+                printf("Redrawn frame %u differs from decoded frame\n", tFrameIndex);
+            }
+            tRedrawErrors++;
+        }
+        tFrameIndex++;
+    }
+    if (tFrameIndex != tAnimation.NumberOfFrames) {
+        printf("Only %u of %u frames decoded\n", tFrameIndex, tAnimation.NumberOfFrames);
+        tDecodeErrors++;
+    }
+
+    /*
+     * Benchmark. millis() and micros() are simulated, so the real time is measured.
+     */
+    unsigned long tNumberOfDecodedFrames = 0;
+    auto tStartTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < sRepetitions; ++i) {
+        tAnimation.rewind();
+        while (tAnimation.decodeNextFrame(&tBar)) {
+            tNumberOfDecodedFrames++;
+        }
+    }
+    double tDecodeNanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - tStartTime).count();
+
+    tStartTime = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < tNumberOfDecodedFrames; ++i) {
+        tAnimation.redrawFrame(&tBar);
+    }
+    double tRedrawNanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - tStartTime).count();
+
+    if (tNumberOfDecodedFrames > 0) {
+        double tNanosPerFrame = tDecodeNanos / tNumberOfDecodedFrames;
+        printf("Decode: %.0f ns per frame, %.1f ns per pixel, %.1f MB/s pixel data, %.1f MB/s animation data\n", tNanosPerFrame,
+                tNanosPerFrame / tBar.numPixels(), (tNumberOfDecodedFrames * (double) tNumberOfBytes * 1000.0) / tDecodeNanos,
+                ((double) tFileStat.st_size * sRepetitions * 1000.0) / tDecodeNanos);
+        printf("Redraw: %.0f ns per frame\n", tRedrawNanos / tNumberOfDecodedFrames);
+    }
+    printf("%u frames checked, %u decode errors, %u redraw errors\n", tFrameIndex, tDecodeErrors, tRedrawErrors);
+
+    tAnimation.end();
+    munmap((void*) tMappedFile, tFileStat.st_size);
+    close(tFileDescriptor);
+    free(tDecodedFrame);
+    free(sShownFrames);
+
+    bool tOK = (tDecodeErrors == 0 && tRedrawErrors == 0);
+    printf(tOK ? "OK\n" : "FAILED\n");
+    return tOK ? 0 : 1;
+}
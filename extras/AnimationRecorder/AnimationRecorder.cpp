@@ -0,0 +1,245 @@
+/*
+ *  AnimationRecorder.cpp
+ *
+ *  Host program, which runs a pattern or the pattern sequence of an example headless and records all shown frames
+ *  with NeoAnimationRecorder. The recording is written as C header with a PROGMEM array, which can be played
+ *  by NeoAnimation::beginPGM() and the PlayAnimation pattern, and optionally as binary file for NeoAnimation::begin().
+ *  Compression ratio and decode time per frame of the recording are printed.
+ *  Expensive patterns can be pre-rendered this way for MCUs, which are too slow to compute them.
+ *
+ *  Patterns (-p):
+ *  fire, bouncingball  The pattern on a bar of -n pixels.
+ *  random              The sequence of the AllPatternsOnOneBar example, i.e. allPatternsRandomHandler(), on a bar of -n pixels.
+ *  matrixfire, snow    The matrix pattern on a matrix of -c columns and -r rows.
+ *  snake               The snake autorun on a matrix of -c columns and -r rows.
+ *  demo                The sequence of the MatrixDemo example, i.e. MatrixAndSnakePatternsDemoHandler(), on a matrix.
+ *
+ *  Build and run on Linux, macOS or Windows with MinGW:
+ *  g++ -O2 -I../HostArduino -I../../src AnimationRecorder.cpp ../HostArduino/HostArduino.cpp -o AnimationRecorder
+ *  ./AnimationRecorder [-p <pattern>] [-n <pixels>] [-c <columns>] [-r <rows>] [-F <frames>] [-k <keyframe interval>]
+ *                      [-P <maximum palette colors>] [-i <frame interval ms>] [-a <array name>] [-o <header file>] [-b <binary file>]
+ *  Without -o, the header is written to <array name>.h.
+ *  The exit code is 1 if recording or writing failed.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+// Must be included before Arduino.h, which defines min(), max() and abs() as macros
+#include <chrono>
+#include <cstring>
+#include <string>
+
+#include <Arduino.h>
+
+/*
+ * All patterns are enabled by default, enable only the additional ones
+ */
+#define ENABLE_ANIMATION_RECORDER
+#include "MatrixSnake.hpp"
+
+const char *sPatternName = "fire";
+int sNumberOfPixels = 144;
+int sColumns = 8;
+int sRows = 8;
+int sNumberOfFrames = 500;
+int sKeyframeInterval = 32;
+int sMaximumNumberOfPaletteColors = 256;
+int sFrameIntervalMillis = 0; // 0 = interval of the pattern at the first frame
+const char *sArrayName = "RecordedAnimation";
+const char *sHeaderFileName = nullptr;
+const char *sBinaryFileName = nullptr;
+
+class FilePrint: public Print {
+public:
+    FILE *File;
+    size_t write(uint8_t aByte) override {
+        return fwrite(&aByte, 1, 1, File);
+    }
+    size_t write(const uint8_t *aBuffer, size_t aSize) override {
+        return fwrite(aBuffer, 1, aSize, File);
+    }
+};
+
+/*
+ * Starts the selected pattern
+ * @return false if the pattern name is unknown or the pattern does not fit to the object
+ */
+bool startPattern(NeoPatterns *aBar, MatrixSnake *aMatrix) {
+    if (aBar != nullptr) {
+        if (strcmp(sPatternName, "fire") == 0) {
+            aBar->Fire(30000, 30);
+        } else if (strcmp(sPatternName, "bouncingball") == 0) {
+            aBar->BouncingBall(COLOR32_GREEN, aBar->numPixels() - 1);
+        } else if (strcmp(sPatternName, "random") == 0) {
+            aBar->OnPatternComplete = &allPatternsRandomHandler;
+            allPatternsRandomHandler(aBar);
+        } else {
+            return false;
+        }
+        return true;
+    }
+    if (strcmp(sPatternName, "matrixfire") == 0) {
+        return aMatrix->Fire(30000, 30);
+    } else if (strcmp(sPatternName, "snow") == 0) {
+        return aMatrix->Snow(30000, 20);
+    } else if (strcmp(sPatternName, "snake") == 0) {
+        return initSnakeAutorun(aMatrix, 200, COLOR32_BLUE, 30000);
+    } else if (strcmp(sPatternName, "demo") == 0) {
+        aMatrix->OnPatternComplete = &MatrixAndSnakePatternsDemoHandler;
+        MatrixAndSnakePatternsDemoHandler(aMatrix);
+        return true;
+    }
+    return false;
+}
+
+/*
+ * Decodes all frames and prints the real decode time, since micros() is simulated
+ */
+void printDecodeTime(NeoAnimationRecorder *aRecorder, NeoPixel *aDecodeNeoPixel) {
+    NeoAnimation tAnimation;
+    if (!tAnimation.begin(aRecorder->AnimationData)) {
+        return;
+    }
+    long tNumberOfDecodedFrames = 0;
+    auto tStartTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; ++i) {
+        tAnimation.rewind();
+        while (tAnimation.decodeNextFrame(aDecodeNeoPixel)) {
+            tNumberOfDecodedFrames++;
+        }
+    }
+    double tDecodeNanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - tStartTime).count();
+    printf("Decode time per frame on this PC=%.0f ns\n", tDecodeNanos / tNumberOfDecodedFrames);
+}
+
+bool writeHeader(NeoAnimationRecorder *aRecorder) {
+    std::string tHeaderFileName = (sHeaderFileName != nullptr) ? sHeaderFileName : std::string(sArrayName) + ".h";
+    FilePrint tFile;
+    tFile.File = fopen(tHeaderFileName.c_str(), "w");
+    if (tFile.File == nullptr) {
+        perror(tHeaderFileName.c_str());
+        return false;
+    }
+    fprintf(tFile.File, "/*\n * %s\n *\n * Generated by extras/AnimationRecorder -p %s\n", tHeaderFileName.c_str(), sPatternName);
+    fprintf(tFile.File, " * Play it with Animation.beginPGM(%s); and PlayAnimation(&Animation);\n */\n\n", sArrayName);
+    fprintf(tFile.File, "#ifndef _%s_H\n#define _%s_H\n\n#include <Arduino.h>\n\n", sArrayName, sArrayName);
+    fflush(tFile.File);
+    aRecorder->printCHeader(&tFile, sArrayName);
+    fprintf(tFile.File, "\n#endif // _%s_H\n", sArrayName);
+    fclose(tFile.File);
+    printf("Header written to %s\n", tHeaderFileName.c_str());
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            sPatternName = argv[++i];
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            sNumberOfPixels = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            sColumns = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            sRows = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-F") == 0 && i + 1 < argc) {
+            sNumberOfFrames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-k") == 0 && i + 1 < argc) {
+            sKeyframeInterval = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-P") == 0 && i + 1 < argc) {
+            sMaximumNumberOfPaletteColors = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            sFrameIntervalMillis = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) {
+            sArrayName = argv[++i];
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            sHeaderFileName = argv[++i];
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            sBinaryFileName = argv[++i];
+        } else {
+            printf("Usage: %s [-p fire|bouncingball|random|matrixfire|snow|snake|demo] [-n <pixels>] [-c <columns>] [-r <rows>]\n"
+                    "       [-F <frames>] [-k <keyframe interval>] [-P <maximum palette colors>] [-i <frame interval ms>]\n"
+                    "       [-a <array name>] [-o <header file>] [-b <binary file>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    bool tIsBarPattern = (strcmp(sPatternName, "fire") == 0 || strcmp(sPatternName, "bouncingball") == 0
+            || strcmp(sPatternName, "random") == 0);
+    NeoPatterns *tBar = nullptr;
+    MatrixSnake *tMatrix = nullptr;
+    NeoPatterns *tRecordedPatterns;
+    if (tIsBarPattern) {
+        tBar = new NeoPatterns(sNumberOfPixels, 6, NEO_GRB + NEO_KHZ800);
+        tRecordedPatterns = tBar;
+    } else {
+        tMatrix = new MatrixSnake(sColumns, sRows, 6, NEO_MATRIX_BOTTOM | NEO_MATRIX_RIGHT | NEO_MATRIX_ROWS | NEO_MATRIX_PROGRESSIVE,
+        NEO_GRB + NEO_KHZ800);
+        tRecordedPatterns = tMatrix;
+    }
+    tRecordedPatterns->begin();
+    randomSeed(1);
+
+    NeoAnimationRecorder tRecorder;
+    if (!startPattern(tBar, tMatrix)) {
+        printf("Unknown pattern \"%s\" or pattern cannot be started\n", sPatternName);
+        return 1;
+    }
+    if (sFrameIntervalMillis == 0) {
+        sFrameIntervalMillis = tRecordedPatterns->Interval;
+    }
+    /*
+     * The first frame was shown by the init function of the pattern and is recorded from the pixel buffer
+     */
+    if (!tRecorder.begin(tRecordedPatterns, sFrameIntervalMillis, sKeyframeInterval, sMaximumNumberOfPaletteColors)) {
+        printf("Not enough memory for recording\n");
+        return 1;
+    }
+    tRecorder.recordFrame();
+    while (tRecorder.NumberOfFrames < sNumberOfFrames && !tRecorder.IsOutOfMemory && tRecordedPatterns->ActivePattern != PATTERN_NONE) {
+        if (tMatrix != nullptr) {
+            tMatrix->update();
+        } else {
+            tBar->update();
+        }
+        delay(1);
+    }
+    if (!tRecorder.end()) {
+        printf("Recording failed\n");
+        return 1;
+    }
+    tRecorder.printStatistics(&Serial);
+    printDecodeTime(&tRecorder, tRecordedPatterns);
+
+    if (!writeHeader(&tRecorder)) {
+        return 1;
+    }
+    if (sBinaryFileName != nullptr) {
+        FilePrint tFile;
+        tFile.File = fopen(sBinaryFileName, "wb");
+        if (tFile.File == nullptr) {
+            perror(sBinaryFileName);
+            return 1;
+        }
+        tRecorder.writeAnimation(&tFile);
+        fclose(tFile.File);
+        printf("Binary animation written to %s\n", sBinaryFileName);
+    }
+    return 0;
+}
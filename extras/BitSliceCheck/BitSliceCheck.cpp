@@ -0,0 +1,197 @@
+/*
+ *  BitSliceCheck.cpp
+ *
+ *  Host program, which checks the bit slices of NeoPixel::convertBytesToBitSlices(), transposeLaneBytesToBitSlices()
+ *  and NeoPixelParallelGroup::encodeBitSlices() against a reference encoding.
+ *  The reference takes bit (7 - (n % 8)) of byte (n / 8) of each lane as bit n of the data stream.
+ *  The slices are then sent to a port model, which executes the 3 port writes of NeoPixel::sendBitSlices() for each slice.
+ *  The bits decoded from the port model must be the original bytes and the pins not in the pin mask must never change.
+ *
+ *  Build and run on Linux, macOS or Windows with MinGW:
+ *  g++ -O2 -I../HostArduino -I../../src BitSliceCheck.cpp ../HostArduino/HostArduino.cpp -o BitSliceCheck
+ *  ./BitSliceCheck [-n <runs>] [-q]
+ *  -q prints only the result.
+ *  The exit code is 1 if an encoding differs from the reference.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#include <Arduino.h>
+
+#include "NeoPixelParallelGroup.hpp"
+
+#include <cstring>
+
+#define MAXIMUM_NUMBER_OF_BYTES (4 * 100) // 100 RGBW pixels
+
+long sNumberOfRuns = 1000;
+bool sQuiet = false;
+unsigned long sErrors = 0;
+
+/*
+ * Reference encoding: bit n of the data stream of each lane in one slice byte per bit, the lane is the bit position in the slice.
+ */
+void referenceEncoding(uint8_t *aLaneBytes[8], uint16_t aLaneNumberOfBytes[8], uint16_t aNumberOfBits, uint8_t *aBitSlices) {
+    for (uint16_t n = 0; n < aNumberOfBits; ++n) {
+        uint8_t tSlice = 0;
+        for (uint_fast8_t tLane = 0; tLane < 8; ++tLane) {
+            if (aLaneBytes[tLane] != nullptr && (n / 8) < aLaneNumberOfBytes[tLane]
+                    && (aLaneBytes[tLane][n / 8] & (1 << (7 - (n % 8))))) {
+                tSlice |= 1 << tLane;
+            }
+        }
+        aBitSlices[n] = tSlice;
+    }
+}
+
+/*
+ * Executes the port writes of NeoPixel::sendBitSlices() and decodes the bits of each lane of aPinMask.
+ * A lane sends a 1 bit, if it is still high after the second write.
+ * @return false if the first write did not set all lanes high, the third did not set all lanes low or another pin changed.
+ */
+bool sendToPortModel(uint8_t aPortValue, uint8_t aPinMask, const uint8_t *aBitSlices, uint16_t aNumberOfBitSlices,
+        uint8_t aDecodedLaneBytes[8][MAXIMUM_NUMBER_OF_BYTES]) {
+    uint8_t tHigh = aPortValue | aPinMask;
+    uint8_t tLow = aPortValue & ~aPinMask;
+    memset(aDecodedLaneBytes, 0, 8 * MAXIMUM_NUMBER_OF_BYTES);
+    for (uint16_t n = 0; n < aNumberOfBitSlices; ++n) {
+        uint8_t tPort = tHigh; // st port, high
+        if ((tPort & aPinMask) != aPinMask || (tPort & ~aPinMask) != (aPortValue & ~aPinMask)) {
+            return false;
+        }
+        tPort = aBitSlices[n] | tLow; // ld data, slice+; or data, low; st port, data
+        if ((tPort & ~aPinMask) != (aPortValue & ~aPinMask)) {
+            return false; // Slice contains a bit outside of the pin mask
+        }
+        for (uint_fast8_t tLane = 0; tLane < 8; ++tLane) {
+            if (tPort & (1 << tLane)) {
+                aDecodedLaneBytes[tLane][n / 8] |= 1 << (7 - (n % 8));
+            }
+        }
+        tPort = tLow; // st port, low
+        if ((tPort & aPinMask) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void check(bool aCondition, const char *aName, long aRun) {
+    if (!aCondition) {
+        sErrors++;
+        if (!sQuiet) {
+            printf("%s differs at run %ld\n", aName, aRun);
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            sNumberOfRuns = atol(argv[++i]);
+        } else if (strcmp(argv[i], "-q") == 0) {
+            sQuiet = true;
+        } else {
+            printf("Usage: %s [-n <runs>] [-q]\n", argv[0]);
+            return 2;
+        }
+    }
+    randomSeed(1);
+
+    static uint8_t sBitSlices[8 * MAXIMUM_NUMBER_OF_BYTES];
+    static uint8_t sReferenceBitSlices[8 * MAXIMUM_NUMBER_OF_BYTES];
+    static uint8_t sDecodedLaneBytes[8][MAXIMUM_NUMBER_OF_BYTES];
+
+    for (long tRun = 0; tRun < sNumberOfRuns; ++tRun) {
+        /*
+         * convertBytesToBitSlices() for one pixel of 3 or 4 bytes on a random pin
+         */
+        uint8_t tPixelBytes[4];
+        uint8_t tNumberOfBytes = 3 + random(2);
+        for (uint_fast8_t i = 0; i < tNumberOfBytes; ++i) {
+            tPixelBytes[i] = random(256);
+        }
+        uint8_t tLane = random(8);
+        uint8_t *tLaneBytes[8] = { nullptr };
+        uint16_t tLaneNumberOfBytes[8] = { 0 };
+        tLaneBytes[tLane] = tPixelBytes;
+        tLaneNumberOfBytes[tLane] = tNumberOfBytes;
+        NeoPixel::convertBytesToBitSlices(tPixelBytes, tNumberOfBytes, 1 << tLane, sBitSlices);
+        referenceEncoding(tLaneBytes, tLaneNumberOfBytes, tNumberOfBytes * 8, sReferenceBitSlices);
+        check(memcmp(sBitSlices, sReferenceBitSlices, tNumberOfBytes * 8) == 0, "convertBytesToBitSlices()", tRun);
+        uint8_t tPortValue = random(256);
+        check(sendToPortModel(tPortValue, 1 << tLane, sBitSlices, tNumberOfBytes * 8, sDecodedLaneBytes)
+                && memcmp(sDecodedLaneBytes[tLane], tPixelBytes, tNumberOfBytes) == 0, "Port model of convertBytesToBitSlices()", tRun);
+
+        /*
+         * transposeLaneBytesToBitSlices() for 8 random bytes
+         */
+        uint8_t tTransposeBytes[8];
+        uint8_t *tTransposeLaneBytes[8];
+        uint16_t tTransposeNumberOfBytes[8];
+        for (uint_fast8_t i = 0; i < 8; ++i) {
+            tTransposeBytes[i] = random(256);
+            tTransposeLaneBytes[i] = &tTransposeBytes[i];
+            tTransposeNumberOfBytes[i] = 1;
+        }
+        transposeLaneBytesToBitSlices(tTransposeBytes, sBitSlices);
+        referenceEncoding(tTransposeLaneBytes, tTransposeNumberOfBytes, 8, sReferenceBitSlices);
+        check(memcmp(sBitSlices, sReferenceBitSlices, 8) == 0, "transposeLaneBytesToBitSlices()", tRun);
+
+        /*
+         * encodeBitSlices() of a group of 1 to 8 strips with different lengths and random content.
+         * On the host, the lane of a strip is its index in the group.
+         */
+        NeoPixel *tStrips[8];
+        NeoPixelParallelGroup tGroup;
+        uint8_t tNumberOfStrips = 1 + random(8);
+        uint8_t tLaneMask = 0;
+        for (uint_fast8_t i = 0; i < 8; ++i) {
+            tLaneBytes[i] = nullptr;
+            tLaneNumberOfBytes[i] = 0;
+        }
+        for (uint_fast8_t i = 0; i < tNumberOfStrips; ++i) {
+            tStrips[i] = new NeoPixel(1 + random(MAXIMUM_NUMBER_OF_BYTES / 4), i, (random(2) ? NEO_GRBW : NEO_GRB) + NEO_KHZ800);
+            tStrips[i]->begin();
+            for (uint16_t j = 0; j < tStrips[i]->numPixels(); ++j) {
+                tStrips[i]->setPixelColor(j, random());
+            }
+            tGroup.addNeoPixel(tStrips[i]);
+            tLaneBytes[i] = tStrips[i]->getPixels();
+            tLaneNumberOfBytes[i] = tStrips[i]->numPixels() * tStrips[i]->getBytesPerPixel();
+            tLaneMask |= 1 << i;
+        }
+        tGroup.begin();
+        uint16_t tNumberOfBits = tGroup.MaximumNumberOfBytes * 8;
+        tGroup.encodeBitSlices(sBitSlices);
+        referenceEncoding(tLaneBytes, tLaneNumberOfBytes, tNumberOfBits, sReferenceBitSlices);
+        check(memcmp(sBitSlices, sReferenceBitSlices, tNumberOfBits) == 0, "encodeBitSlices()", tRun);
+        bool tDecodedIsEqual = sendToPortModel(random(256), tLaneMask, sBitSlices, tNumberOfBits, sDecodedLaneBytes);
+        for (uint_fast8_t i = 0; i < tNumberOfStrips; ++i) {
+            tDecodedIsEqual = tDecodedIsEqual && memcmp(sDecodedLaneBytes[i], tLaneBytes[i], tLaneNumberOfBytes[i]) == 0;
+            delete tStrips[i];
+        }
+        check(tDecodedIsEqual, "Port model of encodeBitSlices()", tRun);
+    }
+
+    printf("%ld runs, %lu errors\n", sNumberOfRuns, sErrors);
+    printf(sErrors == 0 ? "OK\n" : "FAILED\n");
+    return sErrors == 0 ? 0 : 1;
+}
@@ -0,0 +1,322 @@
+/*
+ *  DmxLoopbackBenchmark.cpp
+ *
+ *  Host build of NeoDmxReceiver, which measures the throughput in universes per second without hardware.
+ *  A sender thread sends Art-Net or E1.31 packets over the loopback interface and the main thread receives them
+ *  and processes them with NeoDmxReceiver::processPacket() into the back buffers.
+ *  A third thread takes the role of loop() and copies each completed frame with NeoDmxReceiver::copyFrame()
+ *  into a buffer of 170 RGB pixels per universe. Each copied universe is checked for slots of different frames.
+ *
+ *  Build and run on Linux or macOS:
+ *  g++ -O2 -pthread -I../../src DmxLoopbackBenchmark.cpp -o DmxLoopbackBenchmark
+ *  ./DmxLoopbackBenchmark [-u <universes>] [-f <frames>] [-r <frames per second, 0 = unlimited>] [-e] [-s]
+ *  -e sends E1.31 instead of Art-Net, -s sends a synchronization packet after each frame.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#define NEO_DMX_RECEIVER_MAX_UNIVERSES  32
+#include "NeoDmxReceiver.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#define PIXELS_PER_UNIVERSE     170
+#define SLOTS_PER_UNIVERSE      (PIXELS_PER_UNIVERSE * 3)
+#define SYNC_UNIVERSE           7962 // Any universe, which is not used for data
+
+int sNumberOfUniverses = 16;
+int sNumberOfFrames = 10000;
+int sFramesPerSecond = 0;
+bool sUseE131 = false;
+bool sUseSync = false;
+uint16_t sPort = NEO_DMX_ART_NET_PORT;
+
+std::atomic<bool> sIsReceiving;
+
+/*
+ * Slot values of a frame, to check the received content
+ */
+uint8_t getSlotValue(int aFrame, int aUniverse, int aSlot) {
+    return aFrame + aUniverse * 3 + aSlot;
+}
+
+uint16_t buildArtNetDmxPacket(uint8_t *aPacket, uint16_t aUniverse, uint8_t aSequence, int aFrame) {
+    memset(aPacket, 0, NEO_DMX_ART_NET_HEADER_SIZE);
+    memcpy(aPacket, "Art-Net", 8);
+    aPacket[8] = NEO_DMX_ART_NET_OPCODE_DMX & 0xFF;
+    aPacket[9] = NEO_DMX_ART_NET_OPCODE_DMX >> 8;
+    aPacket[11] = 14; // Protocol version
+    aPacket[12] = aSequence;
+    aPacket[14] = aUniverse & 0xFF;
+    aPacket[15] = aUniverse >> 8;
+    aPacket[16] = SLOTS_PER_UNIVERSE >> 8;
+    aPacket[17] = SLOTS_PER_UNIVERSE & 0xFF;
+    for (int i = 0; i < SLOTS_PER_UNIVERSE; ++i) {
+        aPacket[NEO_DMX_ART_NET_HEADER_SIZE + i] = getSlotValue(aFrame, aUniverse, i);
+    }
+    return NEO_DMX_ART_NET_HEADER_SIZE + SLOTS_PER_UNIVERSE;
+}
+
+uint16_t buildArtNetSyncPacket(uint8_t *aPacket) {
+    memset(aPacket, 0, NEO_DMX_ART_NET_SYNC_SIZE);
+    memcpy(aPacket, "Art-Net", 8);
+    aPacket[8] = NEO_DMX_ART_NET_OPCODE_SYNC & 0xFF;
+    aPacket[9] = NEO_DMX_ART_NET_OPCODE_SYNC >> 8;
+    aPacket[11] = 14;
+    return NEO_DMX_ART_NET_SYNC_SIZE;
+}
+
+void setE131Vector(uint8_t *aVectorPtr, uint32_t aVector) {
+    aVectorPtr[0] = aVector >> 24;
+    aVectorPtr[1] = aVector >> 16;
+    aVectorPtr[2] = aVector >> 8;
+    aVectorPtr[3] = aVector;
+}
+
+/*
+ * Sets the root layer and the flags and length of the framing layer
+ */
+void setE131RootLayer(uint8_t *aPacket, uint16_t aPacketLength, uint32_t aRootVector) {
+    memset(aPacket, 0, aPacketLength);
+    aPacket[1] = 0x10; // Preamble size
+    memcpy(&aPacket[4], "ASC-E1.17\0\0", 12);
+    uint16_t tFlagsAndLength = 0x7000 | (aPacketLength - 16);
+    aPacket[16] = tFlagsAndLength >> 8;
+    aPacket[17] = tFlagsAndLength & 0xFF;
+    setE131Vector(&aPacket[18], aRootVector);
+    tFlagsAndLength = 0x7000 | (aPacketLength - 38);
+    aPacket[38] = tFlagsAndLength >> 8;
+    aPacket[39] = tFlagsAndLength & 0xFF;
+}
+
+uint16_t buildE131DataPacket(uint8_t *aPacket, uint16_t aUniverse, uint8_t aSequence, int aFrame) {
+    uint16_t tPacketLength = NEO_DMX_E131_HEADER_SIZE + SLOTS_PER_UNIVERSE;
+    setE131RootLayer(aPacket, tPacketLength, NEO_DMX_E131_VECTOR_ROOT_DATA);
+    setE131Vector(&aPacket[40], NEO_DMX_E131_VECTOR_FRAME_DATA);
+    strcpy((char*) &aPacket[44], "DmxLoopbackBenchmark");
+    aPacket[108] = 100; // Priority
+    if (sUseSync) {
+        aPacket[109] = SYNC_UNIVERSE >> 8;
+        aPacket[110] = SYNC_UNIVERSE & 0xFF;
+    }
+    aPacket[111] = aSequence;
+    aPacket[113] = aUniverse >> 8;
+    aPacket[114] = aUniverse & 0xFF;
+    uint16_t tFlagsAndLength = 0x7000 | (tPacketLength - 115);
+    aPacket[115] = tFlagsAndLength >> 8;
+    aPacket[116] = tFlagsAndLength & 0xFF;
+    aPacket[117] = 0x02; // DMP vector
+    aPacket[118] = 0xA1; // Address and data type
+    aPacket[122] = 1;    // Address increment
+    aPacket[123] = (SLOTS_PER_UNIVERSE + 1) >> 8;
+    aPacket[124] = (SLOTS_PER_UNIVERSE + 1) & 0xFF;
+    // aPacket[125] is start code 0
+    for (int i = 0; i < SLOTS_PER_UNIVERSE; ++i) {
+        aPacket[NEO_DMX_E131_HEADER_SIZE + i] = getSlotValue(aFrame, aUniverse, i);
+    }
+    return tPacketLength;
+}
+
+uint16_t buildE131SyncPacket(uint8_t *aPacket, uint8_t aSequence) {
+    setE131RootLayer(aPacket, NEO_DMX_E131_SYNC_SIZE, NEO_DMX_E131_VECTOR_ROOT_EXTENDED);
+    setE131Vector(&aPacket[40], NEO_DMX_E131_VECTOR_EXTENDED_SYNC);
+    aPacket[44] = aSequence;
+    aPacket[45] = SYNC_UNIVERSE >> 8;
+    aPacket[46] = SYNC_UNIVERSE & 0xFF;
+    return NEO_DMX_E131_SYNC_SIZE;
+}
+
+void sendFrames() {
+    int tSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in tAddress = { };
+    tAddress.sin_family = AF_INET;
+    tAddress.sin_port = htons(sPort);
+    tAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    uint8_t tPacket[NEO_DMX_E131_HEADER_SIZE + NEO_DMX_MAX_SLOTS];
+    uint8_t tSequence = 0;
+    auto tStartTime = std::chrono::steady_clock::now();
+    for (int tFrame = 0; tFrame < sNumberOfFrames; ++tFrame) {
+        // Art-Net sequence is 1 to 255, E1.31 sequence is 0 to 255
+        tSequence++;
+        if (!sUseE131 && tSequence == 0) {
+            tSequence = 1;
+        }
+        for (int tUniverse = 1; tUniverse <= sNumberOfUniverses; ++tUniverse) {
+            uint16_t tLength;
+            if (sUseE131) {
+                tLength = buildE131DataPacket(tPacket, tUniverse, tSequence, tFrame);
+            } else {
+                tLength = buildArtNetDmxPacket(tPacket, tUniverse, tSequence, tFrame);
+            }
+            sendto(tSocket, tPacket, tLength, 0, (sockaddr*) &tAddress, sizeof(tAddress));
+        }
+        if (sUseSync) {
+            uint16_t tLength = sUseE131 ? buildE131SyncPacket(tPacket, tSequence) : buildArtNetSyncPacket(tPacket);
+            sendto(tSocket, tPacket, tLength, 0, (sockaddr*) &tAddress, sizeof(tAddress));
+        }
+        if (sFramesPerSecond != 0) {
+            std::this_thread::sleep_until(tStartTime + std::chrono::microseconds((tFrame + 1) * 1000000LL / sFramesPerSecond));
+        }
+    }
+    close(tSocket);
+}
+
+/*
+ * Like loop() of the DmxReceiver example, copies each completed frame.
+ * A universe with slots of different frames was written by processPacket() during copyFrame().
+ */
+void copyFrames(NeoDmxReceiver *aReceiver, uint8_t *aPixelBuffer, unsigned int *aNumberOfCopiedFrames, unsigned int *aNumberOfTornUniverses) {
+    while (sIsReceiving.load()) {
+        if (!aReceiver->FrameIsComplete.load() || !aReceiver->copyFrame()) {
+            std::this_thread::yield();
+            continue;
+        }
+        (*aNumberOfCopiedFrames)++;
+        for (int tUniverse = 1; tUniverse <= sNumberOfUniverses; ++tUniverse) {
+            uint8_t *tSlots = &aPixelBuffer[(tUniverse - 1) * SLOTS_PER_UNIVERSE];
+            uint8_t tFrame = tSlots[0] - getSlotValue(0, tUniverse, 0); // Frame number modulo 256
+            for (int i = 1; i < SLOTS_PER_UNIVERSE; ++i) {
+                if (tSlots[i] != getSlotValue(tFrame, tUniverse, i)) {
+                    (*aNumberOfTornUniverses)++;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int tOption;
+    while ((tOption = getopt(argc, argv, "u:f:r:es")) != -1) {
+        switch (tOption) {
+        case 'u':
+            sNumberOfUniverses = atoi(optarg);
+            break;
+        case 'f':
+            sNumberOfFrames = atoi(optarg);
+            break;
+        case 'r':
+            sFramesPerSecond = atoi(optarg);
+            break;
+        case 'e':
+            sUseE131 = true;
+            sPort = NEO_DMX_E131_PORT;
+            break;
+        case 's':
+            sUseSync = true;
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-u <universes>] [-f <frames>] [-r <frames per second>] [-e] [-s]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (sNumberOfUniverses < 1 || sNumberOfUniverses > NEO_DMX_RECEIVER_MAX_UNIVERSES) {
+        fprintf(stderr, "Number of universes must be 1 to %d\n", NEO_DMX_RECEIVER_MAX_UNIVERSES);
+        return 1;
+    }
+
+    /*
+     * One buffer like the pixel buffer of one long strip
+     */
+    uint8_t *tPixelBuffer = (uint8_t*) calloc(sNumberOfUniverses * SLOTS_PER_UNIVERSE, 1);
+    NeoDmxReceiver tReceiver;
+    for (int i = 0; i < sNumberOfUniverses; ++i) {
+        tReceiver.addUniverse(i + 1, &tPixelBuffer[i * SLOTS_PER_UNIVERSE], SLOTS_PER_UNIVERSE);
+    }
+
+    int tSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    int tReceiveBufferSize = 4 * 1024 * 1024;
+    setsockopt(tSocket, SOL_SOCKET, SO_RCVBUF, &tReceiveBufferSize, sizeof(tReceiveBufferSize));
+    timeval tTimeout = { 0, 500000 };
+    setsockopt(tSocket, SOL_SOCKET, SO_RCVTIMEO, &tTimeout, sizeof(tTimeout));
+    sockaddr_in tAddress = { };
+    tAddress.sin_family = AF_INET;
+    tAddress.sin_port = htons(sPort);
+    tAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(tSocket, (sockaddr*) &tAddress, sizeof(tAddress)) != 0) {
+        perror("bind");
+        return 1;
+    }
+
+    printf("Sending %d frames of %d universes %s%s over loopback port %d\n", sNumberOfFrames, sNumberOfUniverses,
+            sUseE131 ? "E1.31" : "Art-Net", sUseSync ? " with sync" : "", sPort);
+    unsigned int tNumberOfCopiedFrames = 0;
+    unsigned int tNumberOfTornUniverses = 0;
+    sIsReceiving.store(true);
+    std::thread tLoopThread(copyFrames, &tReceiver, tPixelBuffer, &tNumberOfCopiedFrames, &tNumberOfTornUniverses);
+    std::thread tSenderThread(sendFrames);
+
+    uint8_t tPacket[1500];
+    auto tStartTime = std::chrono::steady_clock::now();
+    auto tLastPacketTime = tStartTime;
+    double tProcessingSeconds = 0;
+    while (true) {
+        ssize_t tLength = recv(tSocket, tPacket, sizeof(tPacket), 0);
+        if (tLength <= 0) {
+            break; // Timeout after last packet
+        }
+        tLastPacketTime = std::chrono::steady_clock::now();
+        tReceiver.processPacket(tPacket, tLength);
+        tProcessingSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - tLastPacketTime).count();
+    }
+    tSenderThread.join();
+    sIsReceiving.store(false);
+    tLoopThread.join();
+    tReceiver.copyFrame(); // The last frame, if it was completed after the last check of the loop thread
+    close(tSocket);
+
+    double tSeconds = std::chrono::duration<double>(tLastPacketTime - tStartTime).count();
+    printf("Received universes=%u frames=%u incomplete frames=%u dropped=%u out of order=%u ignored=%u\n",
+            tReceiver.NumberOfReceivedUniverses, tReceiver.NumberOfFrames, tReceiver.NumberOfIncompleteFrames,
+            tReceiver.NumberOfDroppedPackets, tReceiver.NumberOfOutOfOrderPackets, tReceiver.NumberOfIgnoredPackets);
+    printf("%.0f universes per second, %.0f frames per second over loopback\n", tReceiver.NumberOfReceivedUniverses / tSeconds,
+            tReceiver.NumberOfFrames / tSeconds);
+    printf("processPacket() alone: %.0f universes per second, %.2f us per universe\n",
+            tReceiver.NumberOfReceivedUniverses / tProcessingSeconds, tProcessingSeconds * 1e6 / tReceiver.NumberOfReceivedUniverses);
+    printf("Copied frames=%u, torn universes=%u\n", tNumberOfCopiedFrames, tNumberOfTornUniverses);
+
+    /*
+     * Check content of last frame
+     */
+    int tErrors = tNumberOfTornUniverses;
+    int tLastFrame = sNumberOfFrames - 1;
+    if (tReceiver.NumberOfDroppedPackets == 0 && tReceiver.NumberOfReceivedUniverses > 0) {
+        for (int tUniverse = 1; tUniverse <= sNumberOfUniverses; ++tUniverse) {
+            for (int i = 0; i < SLOTS_PER_UNIVERSE; ++i) {
+                if (tPixelBuffer[(tUniverse - 1) * SLOTS_PER_UNIVERSE + i] != getSlotValue(tLastFrame, tUniverse, i)) {
+                    tErrors++;
+                }
+            }
+        }
+        printf("Last frame %s\n", tErrors == 0 ? "is correct" : "has errors");
+    }
+    free(tPixelBuffer);
+    return tErrors != 0;
+}
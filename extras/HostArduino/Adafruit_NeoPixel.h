@@ -0,0 +1,161 @@
+/*
+ *  Adafruit_NeoPixel.h
+ *
+ *  Minimal host emulation of the Adafruit_NeoPixel class for the host programs in extras.
+ *  It contains only the members used by the NeoPatterns library.
+ *  show() does not send anything, it calls hostShowHandler and advances the simulated time by the duration of sending the data.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _HOST_ADAFRUIT_NEOPIXEL_H
+#define _HOST_ADAFRUIT_NEOPIXEL_H
+
+#include "Arduino.h"
+
+typedef uint16_t neoPixelType;
+
+#define NEO_RGB  ((0 << 6) | (0 << 4) | (1 << 2) | (2))
+#define NEO_GRB  ((1 << 6) | (1 << 4) | (0 << 2) | (2))
+#define NEO_BRG  ((1 << 6) | (1 << 4) | (2 << 2) | (0))
+#define NEO_RGBW ((3 << 6) | (0 << 4) | (1 << 2) | (2))
+#define NEO_GRBW ((3 << 6) | (1 << 4) | (0 << 2) | (2))
+#define NEO_KHZ800 0x0000
+#define NEO_KHZ400 0x0100
+
+/*
+ * Called by show() with the pixel buffer and the pin if not nullptr
+ */
+extern void (*hostShowHandler)(const uint8_t *aPixels, uint16_t aNumberOfBytes, int16_t aPin);
+
+class Adafruit_NeoPixel {
+public:
+    Adafruit_NeoPixel(uint16_t aNumberOfPixels, int16_t aPin = 6, neoPixelType aType = NEO_GRB + NEO_KHZ800) :
+            begun(false), numLEDs(0), numBytes(0), brightness(0), pixels(NULL), endTime(0) {
+        updateType(aType);
+        updateLength(aNumberOfPixels);
+        setPin(aPin);
+    }
+    Adafruit_NeoPixel() :
+            is800KHz(true), begun(false), numLEDs(0), numBytes(0), pin(-1), brightness(0), pixels(NULL), rOffset(1), gOffset(0), bOffset(
+                    2), wOffset(1), endTime(0) {
+    }
+    ~Adafruit_NeoPixel() {
+        free(pixels);
+    }
+    void begin() {
+        begun = true;
+    }
+    void show() {
+        if (hostShowHandler != NULL) {
+            hostShowHandler(pixels, numBytes, pin);
+        }
+        // 30 us per RGB pixel at 800 kHz plus the reset time
+        hostAdvanceMicros((unsigned long) numBytes * (is800KHz ? 10 : 20) + 50);
+        endTime = micros();
+    }
+    void setPin(int16_t aPin) {
+        pin = aPin;
+    }
+    void setPixelColor(uint16_t aPixelIndex, uint8_t aRed, uint8_t aGreen, uint8_t aBlue) {
+        if (aPixelIndex < numLEDs) {
+            if (brightness) {
+                aRed = (aRed * brightness) >> 8;
+                aGreen = (aGreen * brightness) >> 8;
+                aBlue = (aBlue * brightness) >> 8;
+            }
+            uint8_t *tPixelPtr = &pixels[aPixelIndex * ((wOffset == rOffset) ? 3 : 4)];
+            if (wOffset != rOffset) {
+                tPixelPtr[wOffset] = 0;
+            }
+            tPixelPtr[rOffset] = aRed;
+            tPixelPtr[gOffset] = aGreen;
+            tPixelPtr[bOffset] = aBlue;
+        }
+    }
+    void setPixelColor(uint16_t aPixelIndex, uint32_t aColor) {
+        setPixelColor(aPixelIndex, (uint8_t) (aColor >> 16), (uint8_t) (aColor >> 8), (uint8_t) aColor);
+    }
+    void setBrightness(uint8_t aBrightness) {
+        brightness = aBrightness + 1;
+    }
+    void clear() {
+        memset(pixels, 0, numBytes);
+    }
+    void updateLength(uint16_t aNumberOfPixels) {
+        free(pixels);
+        numBytes = aNumberOfPixels * ((wOffset == rOffset) ? 3 : 4);
+        if ((pixels = (uint8_t*) calloc(numBytes, 1)) != NULL) {
+            numLEDs = aNumberOfPixels;
+        } else {
+            numLEDs = numBytes = 0;
+        }
+    }
+    void updateType(neoPixelType aType) {
+        wOffset = (aType >> 6) & 0b11;
+        rOffset = (aType >> 4) & 0b11;
+        gOffset = (aType >> 2) & 0b11;
+        bOffset = aType & 0b11;
+        is800KHz = (aType < 256);
+    }
+    bool canShow() {
+        return true;
+    }
+    uint8_t* getPixels() const {
+        return pixels;
+    }
+    uint8_t getBrightness() const {
+        return brightness - 1;
+    }
+    int16_t getPin() const {
+        return pin;
+    }
+    uint16_t numPixels() const {
+        return numLEDs;
+    }
+    static uint8_t sine8(uint8_t aValue) {
+        return (uint8_t) ((sin(aValue * 2 * M_PI / 256) + 1) * 127.5);
+    }
+    static uint8_t gamma8(uint8_t aValue) {
+        return (uint8_t) (pow(aValue / 255.0, 2.6) * 255 + 0.5);
+    }
+    static uint32_t Color(uint8_t aRed, uint8_t aGreen, uint8_t aBlue) {
+        return ((uint32_t) aRed << 16) | ((uint32_t) aGreen << 8) | aBlue;
+    }
+    static uint32_t Color(uint8_t aRed, uint8_t aGreen, uint8_t aBlue, uint8_t aWhite) {
+        return ((uint32_t) aWhite << 24) | ((uint32_t) aRed << 16) | ((uint32_t) aGreen << 8) | aBlue;
+    }
+
+protected:
+    bool is800KHz;
+    bool begun;
+    uint16_t numLEDs;
+    uint16_t numBytes;
+    int16_t pin;
+    uint8_t brightness;
+    uint8_t *pixels;
+    uint8_t rOffset;
+    uint8_t gOffset;
+    uint8_t bOffset;
+    uint8_t wOffset;
+    uint32_t endTime;
+};
+
+#endif // _HOST_ADAFRUIT_NEOPIXEL_H
@@ -0,0 +1,206 @@
+/*
+ *  Arduino.h
+ *
+ *  Minimal host emulation of the Arduino core, to run the NeoPatterns library in the host programs in extras.
+ *  It is NOT an Arduino core, it contains only the functions used by the library.
+ *  Time is simulated. millis() and micros() advance only by delay(), delayMicroseconds(), show() and hostAdvanceMicros(),
+ *  so the host programs are deterministic and run faster than real time.
+ *  ARDUINO is not defined, so code which requires the real Arduino core can be excluded by #if defined(ARDUINO).
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _HOST_ARDUINO_H
+#define _HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+class __FlashStringHelper;
+#define F(s) ((const __FlashStringHelper *) (s))
+#define pgm_read_byte(addr)     (*(const uint8_t *) (addr))
+#define pgm_read_word(addr)     (*(const uint16_t *) (addr))
+#define pgm_read_dword(addr)    (*(const uint32_t *) (addr))
+#define pgm_read_ptr(addr)      (*(void * const *) (addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+#define HEX 16
+#define DEC 10
+#define LOW     0
+#define HIGH    1
+#define INPUT           0
+#define OUTPUT          1
+#define INPUT_PULLUP    2
+#define A0      14
+#define A1      15
+#define A2      16
+#define A3      17
+#if !defined(LED_BUILTIN)
+#define LED_BUILTIN 13
+#endif
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define min(a,b) ((a)<(b)?(a):(b))
+#define max(a,b) ((a)>(b)?(a):(b))
+#define abs(x) ((x)>0?(x):-(x))
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long aMillis);
+void delayMicroseconds(unsigned int aMicros);
+void yield();
+long random(long aMax);
+long random(long aMin, long aMax);
+long random();
+void randomSeed(unsigned long aSeed);
+int digitalRead(uint8_t aPin);
+void digitalWrite(uint8_t aPin, uint8_t aValue);
+void pinMode(uint8_t aPin, uint8_t aMode);
+int analogRead(uint8_t aPin);
+void noInterrupts();
+void interrupts();
+inline char* utoa(unsigned aValue, char *aBuffer, int aRadix) {
+    sprintf(aBuffer, (aRadix == 16) ? "%x" : "%u", aValue);
+    return aBuffer;
+}
+
+/*
+ * Host extensions
+ */
+void hostAdvanceMicros(unsigned long aMicros);  // Simulates the time used by the program
+extern int (*hostAnalogReadHandler)(uint8_t aPin);  // Called by analogRead() if not nullptr, default returns 0
+extern void (*hostDigitalWriteHandler)(uint8_t aPin, uint8_t aValue); // Called by digitalWrite() if not nullptr
+
+class Print {
+public:
+    virtual ~Print() {
+    }
+    virtual size_t write(uint8_t aByte) {
+        return fwrite(&aByte, 1, 1, stdout);
+    }
+    virtual size_t write(const uint8_t *aBuffer, size_t aSize) {
+        for (size_t i = 0; i < aSize; i++) {
+            write(aBuffer[i]);
+        }
+        return aSize;
+    }
+    virtual int availableForWrite() {
+        return 64;
+    }
+    size_t print(const char *aString) {
+        return write((const uint8_t*) aString, strlen(aString));
+    }
+    size_t print(const __FlashStringHelper *aString) {
+        return print((const char*) aString);
+    }
+    size_t print(char aChar) {
+        return write((uint8_t) aChar);
+    }
+    size_t print(unsigned long aValue, int aBase = DEC) {
+        char tBuffer[24];
+        snprintf(tBuffer, sizeof(tBuffer), (aBase == HEX) ? "%lX" : "%lu", aValue);
+        return print(tBuffer);
+    }
+    size_t print(long aValue, int aBase = DEC) {
+        if (aBase == HEX) {
+            return print((unsigned long) aValue, HEX);
+        }
+        char tBuffer[24];
+        snprintf(tBuffer, sizeof(tBuffer), "%ld", aValue);
+        return print(tBuffer);
+    }
+    size_t print(unsigned int aValue, int aBase = DEC) {
+        return print((unsigned long) aValue, aBase);
+    }
+    size_t print(int aValue, int aBase = DEC) {
+        return print((long) aValue, aBase);
+    }
+    size_t print(unsigned char aValue, int aBase = DEC) {
+        return print((unsigned long) aValue, aBase);
+    }
+    size_t print(double aValue, int aDigits = 2) {
+        char tBuffer[32];
+        snprintf(tBuffer, sizeof(tBuffer), "%.*f", aDigits, aValue);
+        return print(tBuffer);
+    }
+    template<class T> size_t println(T aValue) {
+        size_t tLength = print(aValue);
+        return tLength + println();
+    }
+    template<class T> size_t println(T aValue, int aBase) {
+        size_t tLength = print(aValue, aBase);
+        return tLength + println();
+    }
+    size_t println() {
+        return print("\r\n");
+    }
+    void flush() {
+        fflush(stdout);
+    }
+};
+
+class Stream: public Print {
+public:
+    virtual int available() {
+        return 0;
+    }
+    virtual int read() {
+        return -1;
+    }
+    virtual int peek() {
+        return -1;
+    }
+    size_t readBytes(uint8_t *aBuffer, size_t aLength) {
+        size_t i = 0;
+        for (; i < aLength; i++) {
+            int tByte = read();
+            if (tByte < 0) {
+                break;
+            }
+            aBuffer[i] = tByte;
+        }
+        return i;
+    }
+    size_t readBytes(char *aBuffer, size_t aLength) {
+        return readBytes((uint8_t*) aBuffer, aLength);
+    }
+};
+
+class HardwareSerial: public Stream {
+public:
+    void begin(unsigned long aBaudrate) {
+        (void) aBaudrate;
+    }
+    operator bool() {
+        return true;
+    }
+};
+extern HardwareSerial Serial;
+
+#endif // _HOST_ARDUINO_H
@@ -0,0 +1,104 @@
+/*
+ *  HostArduino.cpp
+ *
+ *  Simulated time and pins of the host emulation of the Arduino core, see Arduino.h.
+ *  Compile it together with the host program, e.g. g++ -I../HostArduino -I../../src MyProgram.cpp ../HostArduino/HostArduino.cpp
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#include "Arduino.h"
+#include "Adafruit_NeoPixel.h"
+
+HardwareSerial Serial;
+
+int (*hostAnalogReadHandler)(uint8_t aPin) = NULL;
+void (*hostDigitalWriteHandler)(uint8_t aPin, uint8_t aValue) = NULL;
+void (*hostShowHandler)(const uint8_t *aPixels, uint16_t aNumberOfBytes, int16_t aPin) = NULL;
+
+static unsigned long sHostMicros = 0;
+
+void hostAdvanceMicros(unsigned long aMicros) {
+    sHostMicros += aMicros;
+}
+
+unsigned long micros() {
+    return sHostMicros;
+}
+
+unsigned long millis() {
+    return sHostMicros / 1000;
+}
+
+void delay(unsigned long aMillis) {
+    sHostMicros += aMillis * 1000;
+}
+
+void delayMicroseconds(unsigned int aMicros) {
+    sHostMicros += aMicros;
+}
+
+void yield() {
+}
+
+long random(long aMax) {
+    return (aMax > 0) ? rand() % aMax : 0;
+}
+
+long random(long aMin, long aMax) {
+    return (aMax > aMin) ? aMin + rand() % (aMax - aMin) : aMin;
+}
+
+long random() {
+    return rand();
+}
+
+void randomSeed(unsigned long aSeed) {
+    srand(aSeed);
+}
+
+int digitalRead(uint8_t aPin) {
+    (void) aPin;
+    return HIGH;
+}
+
+void digitalWrite(uint8_t aPin, uint8_t aValue) {
+    if (hostDigitalWriteHandler != NULL) {
+        hostDigitalWriteHandler(aPin, aValue);
+    }
+}
+
+void pinMode(uint8_t aPin, uint8_t aMode) {
+    (void) aPin;
+    (void) aMode;
+}
+
+int analogRead(uint8_t aPin) {
+    if (hostAnalogReadHandler != NULL) {
+        return hostAnalogReadHandler(aPin);
+    }
+    return 0;
+}
+
+void noInterrupts() {
+}
+
+void interrupts() {
+}
@@ -0,0 +1,234 @@
+/*
+ *  JitterBenchmark.cpp
+ *
+ *  Host program, which validates the jitter histograms and the late update statistics of NeoPatterns.
+ *  A RainbowCycle is updated from a simulated loop(), whose duration is random and sometimes much longer (spikes).
+ *  The delay of each update and each loop period are computed independently from the simulated time and recorded
+ *  in reference histograms. Their bins, halved like the library bins if one bin reaches 255, must be equal to the library bins.
+ *  The reference counts without halving are printed as the distribution over the whole run.
+ *
+ *  Build and run on Linux, macOS or Windows with MinGW:
+ *  g++ -O2 -I../HostArduino -I../../src JitterBenchmark.cpp ../HostArduino/HostArduino.cpp -o JitterBenchmark
+ *  ./JitterBenchmark [-i <interval ms>] [-d <maximum loop ms>] [-s <spike percent>] [-S <maximum spike ms>] [-n <loops>] [-c] [-q]
+ *  -c uses TIMING_POLICY_CATCH_UP instead of the default TIMING_POLICY_RESET_PHASE.
+ *  -q prints only the result.
+ *  The exit code is 1 if the library histograms or statistics differ from the reference.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#include <Arduino.h>
+
+#define ENABLE_PATTERN_RAINBOW_CYCLE
+#define ENABLE_NEOPATTERNS_STATISTICS
+#define ENABLE_NEOPATTERNS_JITTER_HISTOGRAM
+#include "NeoPatterns.hpp"
+
+#include <cstring>
+
+#define NUMBER_OF_PIXELS    60
+
+int sIntervalMillis = 20;
+int sMaximumLoopMillis = 8;
+int sSpikePercent = 2;
+int sMaximumSpikeMillis = 120;
+long sNumberOfLoops = 100000;
+bool sUseCatchUp = false;
+
+/*
+ * Reference histograms with the same bins as the library
+ */
+struct ReferenceHistogramStruct {
+    unsigned long Counts[JITTER_HISTOGRAM_SIZE];    // Without halving
+    unsigned int HalvedBins[JITTER_HISTOGRAM_SIZE]; // All bins are halved, if one bin reaches 255
+};
+
+uint_fast8_t getBinIndex(unsigned long aValue) {
+    uint_fast8_t tBinIndex = 0;
+    while (aValue != 0 && tBinIndex < (JITTER_HISTOGRAM_SIZE - 1)) {
+        aValue >>= 1;
+        tBinIndex++;
+    }
+    return tBinIndex;
+}
+
+void addToReferenceHistogram(ReferenceHistogramStruct *aHistogram, unsigned long aValue) {
+    uint_fast8_t tBinIndex = getBinIndex(aValue);
+    aHistogram->Counts[tBinIndex]++;
+    if (aHistogram->HalvedBins[tBinIndex] == 255) {
+        for (uint_fast8_t i = 0; i < JITTER_HISTOGRAM_SIZE; ++i) {
+            aHistogram->HalvedBins[i] >>= 1;
+        }
+    }
+    aHistogram->HalvedBins[tBinIndex]++;
+}
+
+/*
+ * Prints the library bins, the reference bins and the share of each bin over the whole run
+ * @return true if library and reference bins are equal
+ */
+bool compareHistograms(const char *aName, JitterHistogramStruct *aLibraryHistogram, ReferenceHistogramStruct *aReferenceHistogram,
+        bool aDoPrint) {
+    unsigned long tReferenceSum = 0;
+    for (uint_fast8_t i = 0; i < JITTER_HISTOGRAM_SIZE; ++i) {
+        tReferenceSum += aReferenceHistogram->Counts[i];
+    }
+    if (aDoPrint) {
+        printf("%s\n  Bin      Library  Reference  Count of run  Share of run %%\n", aName);
+    }
+    bool tIsEqual = true;
+    for (uint_fast8_t i = 0; i < JITTER_HISTOGRAM_SIZE; ++i) {
+        if (aLibraryHistogram->Bins[i] != aReferenceHistogram->HalvedBins[i]) {
+            tIsEqual = false;
+        }
+        if (aDoPrint) {
+            char tBinName[12];
+            if (i == JITTER_HISTOGRAM_SIZE - 1) {
+                snprintf(tBinName, sizeof(tBinName), ">=%d", 1 << (i - 1));
+            } else if (i < 2) {
+                snprintf(tBinName, sizeof(tBinName), "%d", i);
+            } else {
+                snprintf(tBinName, sizeof(tBinName), "%d-%d", 1 << (i - 1), (1 << i) - 1);
+            }
+            printf("  %-7s %7u %10u %13lu %15.2f\n", tBinName, aLibraryHistogram->Bins[i], aReferenceHistogram->HalvedBins[i],
+                    aReferenceHistogram->Counts[i], (tReferenceSum == 0) ? 0 : aReferenceHistogram->Counts[i] * 100.0 / tReferenceSum);
+        }
+    }
+    return tIsEqual;
+}
+
+int main(int argc, char *argv[]) {
+    bool tDoPrint = true;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            sIntervalMillis = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            sMaximumLoopMillis = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            sSpikePercent = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-S") == 0 && i + 1 < argc) {
+            sMaximumSpikeMillis = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            sNumberOfLoops = atol(argv[++i]);
+        } else if (strcmp(argv[i], "-c") == 0) {
+            sUseCatchUp = true;
+        } else if (strcmp(argv[i], "-q") == 0) {
+            tDoPrint = false;
+        } else {
+            printf("Usage: %s [-i <interval ms>] [-d <maximum loop ms>] [-s <spike percent>] [-S <maximum spike ms>] [-n <loops>] [-c] [-q]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    printf("Interval=%d ms, loop duration 0 to %d ms, %d%% spikes up to %d ms, %ld loops, %s\n", sIntervalMillis, sMaximumLoopMillis,
+            sSpikePercent, sMaximumSpikeMillis, sNumberOfLoops, sUseCatchUp ? "TIMING_POLICY_CATCH_UP" : "TIMING_POLICY_RESET_PHASE");
+
+    srand(42);
+    NeoPatterns tBar(NUMBER_OF_PIXELS, 3, NEO_GRB + NEO_KHZ800);
+    tBar.begin();
+    if (sUseCatchUp) {
+        tBar.setTimingPolicy(TIMING_POLICY_CATCH_UP);
+    }
+    tBar.RainbowCycle(sIntervalMillis, DIRECTION_UP, 100); // 25600 steps
+    /*
+     * Interval is compensated by the library for the show() duration or the "> Interval" check in update()
+     */
+    unsigned long tPeriodMillis = tBar.Interval + 1;
+    printf("Compensated interval=%u ms\n", tBar.Interval);
+    memset(&tBar.LateMillisHistogram, 0, sizeof(tBar.LateMillisHistogram));
+    memset(&NeoPatterns::LoopPeriodHistogram, 0, sizeof(NeoPatterns::LoopPeriodHistogram));
+    tBar.resetStatistics();
+
+    ReferenceHistogramStruct tLateReference;
+    ReferenceHistogramStruct tLoopPeriodReference;
+    memset(&tLateReference, 0, sizeof(tLateReference));
+    memset(&tLoopPeriodReference, 0, sizeof(tLoopPeriodReference));
+    unsigned long tReferenceLateSum = 0;
+    unsigned long tReferenceLateMax = 0;
+    unsigned long tReferenceLateCount = 0;
+    unsigned long tReferenceUpdateCount = 0;
+
+    /*
+     * The deadline of the first update is computed from the start of the pattern
+     */
+    unsigned long tDeadlineMillis = tBar.lastUpdate + tPeriodMillis;
+    unsigned long tLastLoopMillis = 0;
+
+    for (long tLoop = 0; tLoop < sNumberOfLoops && tBar.ActivePattern != PATTERN_NONE; ++tLoop) {
+        unsigned long tMillis = millis();
+        if (tLoop > 0) {
+            addToReferenceHistogram(&tLoopPeriodReference, tMillis - tLastLoopMillis);
+        }
+        tLastLoopMillis = tMillis;
+        NeoPatterns::recordLoopPeriod();
+
+        if (tBar.update()) {
+            unsigned long tLateMillis = tMillis - tDeadlineMillis;
+            addToReferenceHistogram(&tLateReference, tLateMillis);
+            tReferenceUpdateCount++;
+            if (tLateMillis > 0) {
+                tReferenceLateCount++;
+                tReferenceLateSum += tLateMillis;
+                if (tLateMillis > tReferenceLateMax) {
+                    tReferenceLateMax = tLateMillis;
+                }
+            }
+            if (sUseCatchUp) {
+                tDeadlineMillis += tPeriodMillis;
+                if ((long) (millis() - (tDeadlineMillis - tPeriodMillis)) > MAXIMUM_CATCH_UP_MILLIS) {
+                    tDeadlineMillis = millis() + tPeriodMillis; // too late, schedule is restarted
+                }
+            } else {
+                tDeadlineMillis = millis() + tPeriodMillis; // millis() after show()
+            }
+        }
+
+        /*
+         * The other work of loop()
+         */
+        unsigned long tLoopMicros = random(sMaximumLoopMillis * 1000L + 1);
+        if (random(100) < sSpikePercent) {
+            tLoopMicros += random(sMaximumSpikeMillis * 1000L + 1);
+        }
+        hostAdvanceMicros(tLoopMicros);
+    }
+
+    bool tIsOK = compareHistograms("Late ms of updates", &tBar.LateMillisHistogram, &tLateReference, tDoPrint);
+    if (!compareHistograms("Loop period ms", &NeoPatterns::LoopPeriodHistogram, &tLoopPeriodReference, tDoPrint)) {
+        tIsOK = false;
+    }
+    if (tDoPrint) {
+        tBar.printStatistics(&Serial);
+    }
+    printf("Updates=%lu late=%lu avg=%lu max=%lu ms\n", tReferenceUpdateCount, tReferenceLateCount,
+            (tReferenceLateCount == 0) ? 0 : tReferenceLateSum / tReferenceLateCount, tReferenceLateMax);
+
+    if (!tIsOK) {
+        printf("Histograms differ from reference\n");
+    }
+    if (tBar.Statistics.UpdateCount != tReferenceUpdateCount || tBar.Statistics.MissedDeadlineCount != (tReferenceLateCount & 0xFFFF)
+            || tBar.Statistics.LateMillisSum != tReferenceLateSum
+            || tBar.Statistics.LateMillisMax != ((tReferenceLateMax > 0xFFFF) ? 0xFFFF : tReferenceLateMax)) {
+        printf("Statistics differ from reference\n");
+        tIsOK = false;
+    }
+    printf(tIsOK ? "OK\n" : "FAILED\n");
+    return tIsOK ? 0 : 1;
+}
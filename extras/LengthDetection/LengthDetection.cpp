@@ -0,0 +1,189 @@
+/*
+ *  LengthDetection.cpp
+ *
+ *  Host program, which checks getAndAdjustActualNeopixelLenghtBisection() and getAndAdjustActualNeopixelLenghtSimple()
+ *  against a model of the strip and the ADC.
+ *  Only the first pixels of the allocated pixel buffer are connected. Each connected pixel drops VCC proportional to its brightness,
+ *  the result is disturbed by noise and rounded to the ADC resolution.
+ *  Dead pixels, which forward the data but do not light, are placed in groups of PIXELS_FOR_BISECTION_LENGTH_DETECTION - 1.
+ *  All connected lengths from 1 to the buffer length are checked with and without dead pixels.
+ *
+ *  Build and run on Linux, macOS or Windows with MinGW:
+ *  g++ -O2 -I../HostArduino -I../../src LengthDetection.cpp ../HostArduino/HostArduino.cpp -o LengthDetection
+ *  ./LengthDetection [-l <buffer length>] [-m <millivolt per pixel>] [-r <ADC resolution millivolt>] [-N <noise millivolt>] [-q]
+ *  -q prints only the result.
+ *  The exit code is 1 if the bisection result is not the connected length rounded up to the next even number.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#include <Arduino.h>
+
+/*
+ * Replaces ADCUtils.hpp, which requires the AVR ADC
+ */
+#define ADC_UTILS_ARE_AVAILABLE
+uint16_t getVCCVoltageMillivoltSimple(void);
+
+#include "NeoPixel.hpp"
+
+#include <cstring>
+
+#define VCC_MILLIVOLT   5000
+
+int sBufferLength = 300;
+int sMillivoltPerPixel = 60; // Drop for one white pixel
+int sResolutionMillivolt = 20;
+int sNoiseMillivolt = 4;
+bool sQuiet = false;
+
+/*
+ * Model of the connected strip
+ */
+uint16_t sConnectedLength;
+bool *sPixelIsDead;
+unsigned long sSumOfShownBrightness; // Sum of all bytes of the connected pixels of the last show()
+unsigned int sNumberOfShows;
+
+void modelShowHandler(const uint8_t *aPixels, uint16_t aNumberOfBytes, int16_t aPin) {
+    (void) aPin;
+    sSumOfShownBrightness = 0;
+    for (uint16_t i = 0; i < aNumberOfBytes / 3 && i < sConnectedLength; ++i) {
+        if (!sPixelIsDead[i]) {
+            sSumOfShownBrightness += aPixels[i * 3] + aPixels[(i * 3) + 1] + aPixels[(i * 3) + 2];
+        }
+    }
+    sNumberOfShows++;
+}
+
+uint16_t getVCCVoltageMillivoltSimple(void) {
+    long tMillivolt = VCC_MILLIVOLT - (long) ((sSumOfShownBrightness * sMillivoltPerPixel) / (3 * 255));
+    tMillivolt += random(-sNoiseMillivolt, sNoiseMillivolt + 1);
+    // Round to ADC resolution
+    tMillivolt = ((tMillivolt + (sResolutionMillivolt / 2)) / sResolutionMillivolt) * sResolutionMillivolt;
+    return tMillivolt;
+}
+
+/*
+ * @return the detected length and the number of show() in aNumberOfShows
+ */
+uint16_t runDetection(bool aUseBisection, unsigned int *aNumberOfShows) {
+    NeoPixel tStrip(sBufferLength, 6, NEO_GRB + NEO_KHZ800);
+    tStrip.begin();
+    sNumberOfShows = 0;
+    uint16_t tLength;
+    if (aUseBisection) {
+        tLength = tStrip.getAndAdjustActualNeopixelLenghtBisection();
+    } else {
+        tLength = tStrip.getAndAdjustActualNeopixelLenghtSimple();
+    }
+    *aNumberOfShows = sNumberOfShows;
+    if (tLength != 0 && tLength != tStrip.numPixels()) {
+        printf("Length %u differs from numPixels() %u\n", tLength, tStrip.numPixels());
+        return 0;
+    }
+    return tLength;
+}
+
+int main(int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+            sBufferLength = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            sMillivoltPerPixel = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            sResolutionMillivolt = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-N") == 0 && i + 1 < argc) {
+            sNoiseMillivolt = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-q") == 0) {
+            sQuiet = true;
+        } else {
+            printf("Usage: %s [-l <buffer length>] [-m <millivolt per pixel>] [-r <ADC resolution millivolt>] [-N <noise millivolt>] [-q]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    printf("Buffer length=%d, %d mV per white pixel, ADC resolution %d mV, noise +/-%d mV\n", sBufferLength, sMillivoltPerPixel,
+            sResolutionMillivolt, sNoiseMillivolt);
+
+    hostShowHandler = &modelShowHandler;
+    sPixelIsDead = (bool*) calloc(sBufferLength, sizeof(bool));
+    randomSeed(1);
+
+    unsigned int tBisectionErrors = 0;
+    unsigned int tSimpleErrors = 0;
+    unsigned int tEqualResults = 0;
+    unsigned int tNumberOfRuns = 0;
+    unsigned int tBisectionMaximumShows = 0;
+    unsigned int tSimpleMaximumShows = 0;
+    for (uint_fast8_t tWithDeadPixels = 0; tWithDeadPixels < 2; ++tWithDeadPixels) {
+        for (int tLength = 1; tLength <= sBufferLength; ++tLength) {
+            sConnectedLength = tLength;
+            memset(sPixelIsDead, 0, sBufferLength * sizeof(bool));
+            if (tWithDeadPixels) {
+                if (tLength < 4 * PIXELS_FOR_BISECTION_LENGTH_DETECTION) {
+                    continue;
+                }
+                // Groups of dead pixels at 1/3 and 2/3 of the strip, the last pixel is alive
+                for (uint_fast8_t i = 0; i < PIXELS_FOR_BISECTION_LENGTH_DETECTION - 1; ++i) {
+                    sPixelIsDead[(tLength / 3) + i] = true;
+                    sPixelIsDead[((2 * tLength) / 3) - 1 + i] = true;
+                }
+            }
+            uint16_t tExpectedLength = (tLength + 1) & ~0x01;
+            if (tExpectedLength > sBufferLength) {
+                tExpectedLength = sBufferLength;
+            }
+
+            unsigned int tBisectionShows;
+            uint16_t tBisectionLength = runDetection(true, &tBisectionShows);
+            unsigned int tSimpleShows;
+            uint16_t tSimpleLength = runDetection(false, &tSimpleShows);
+            tNumberOfRuns++;
+            if (tBisectionShows > tBisectionMaximumShows) {
+                tBisectionMaximumShows = tBisectionShows;
+            }
+            if (tSimpleShows > tSimpleMaximumShows) {
+                tSimpleMaximumShows = tSimpleShows;
+            }
+            if (tBisectionLength == tSimpleLength) {
+                tEqualResults++;
+            }
+            if (tSimpleLength < tLength) {
+                tSimpleErrors++; // Shorter length is an error, longer is only inefficient
+            }
+            if (tBisectionLength != tExpectedLength) {
+                tBisectionErrors++;
+            }
+            if (!sQuiet && (tBisectionLength != tExpectedLength || tSimpleLength < tLength)) {
+                printf("Connected=%3d dead pixels=%d bisection=%3u expected=%3u simple=%3u\n", tLength, tWithDeadPixels,
+                        tBisectionLength, tExpectedLength, tSimpleLength);
+            }
+        }
+    }
+    printf("%u runs\n", tNumberOfRuns);
+    printf("Bisection: %u wrong lengths, maximum %u show()\n", tBisectionErrors, tBisectionMaximumShows);
+    printf("Simple:    %u too short lengths, maximum %u show()\n", tSimpleErrors, tSimpleMaximumShows);
+    printf("Equal results: %u\n", tEqualResults);
+    free(sPixelIsDead);
+
+    printf(tBisectionErrors == 0 ? "OK\n" : "FAILED\n");
+    return tBisectionErrors == 0 ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+/*
+ *  RenderAtCheck.cpp
+ *
+ *  Host program, which checks renderAt() against the regular update.
+ *  For each pattern and parameter set, the pattern is updated step by step. After each step, a second object starts
+ *  the same pattern and calls setPatternStep() with this step. Index, Direction, number of bouncings and remaining steps
+ *  of both objects must be equal. Then the second object starts the pattern again and calls renderAt() with the time
+ *  of this step. Now also all pixels must be equal.
+ *  ScannerExtended is checked for all modes, both directions, with and without bouncings and for different lengths.
+ *
+ *  Build and run on Linux, macOS or Windows with MinGW:
+ *  g++ -O2 -I../HostArduino -I../../src RenderAtCheck.cpp ../HostArduino/HostArduino.cpp -o RenderAtCheck
+ *  ./RenderAtCheck [-v]
+ *  -v prints each checked parameter set.
+ *  The exit code is 1 if a difference is found.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include <Arduino.h>
+
+#define ENABLE_PATTERN_RAINBOW_CYCLE
+#define ENABLE_PATTERN_COLOR_WIPE
+#define ENABLE_PATTERN_FADE
+#define ENABLE_PATTERN_STRIPES
+#define ENABLE_PATTERN_SCANNER_EXTENDED
+#define ENABLE_NEOPATTERNS_RENDER_AT
+#include "NeoPatterns.hpp"
+
+#define INTERVAL_MILLIS             10
+
+bool sVerbose = false;
+unsigned long sNumberOfCheckedSteps = 0;
+unsigned int sNumberOfErrors = 0;
+
+/*
+ * Parameters of the pattern to check
+ */
+struct PatternParameterStruct {
+    uint8_t Pattern;
+    uint8_t Length;
+    uint16_t NumberOfBouncings;
+    uint8_t Mode;
+    uint8_t Direction;
+};
+
+void startPattern(NeoPatterns *aNeoPatterns, PatternParameterStruct *aParameters) {
+    aNeoPatterns->clear();
+    switch (aParameters->Pattern) {
+    case PATTERN_RAINBOW_CYCLE:
+        aNeoPatterns->RainbowCycle(INTERVAL_MILLIS, aParameters->Direction, 2);
+        break;
+    case PATTERN_COLOR_WIPE:
+        aNeoPatterns->ColorWipe(COLOR32_GREEN, INTERVAL_MILLIS, 0, aParameters->Direction);
+        break;
+    case PATTERN_FADE:
+        aNeoPatterns->Fade(COLOR32_RED, COLOR32_BLUE, 40, INTERVAL_MILLIS);
+        break;
+    case PATTERN_STRIPES:
+        aNeoPatterns->Stripes(COLOR32_RED, aParameters->Length, COLOR32_BLUE, aParameters->Length + 1, 50, INTERVAL_MILLIS,
+                aParameters->Direction);
+        break;
+    default:
+        aNeoPatterns->ScannerExtended(COLOR32_WHITE, aParameters->Length, INTERVAL_MILLIS, aParameters->NumberOfBouncings,
+                aParameters->Mode, aParameters->Direction);
+        break;
+    }
+}
+
+void printParameters(NeoPatterns *aNeoPatterns, PatternParameterStruct *aParameters) {
+    printf("%s pixels=%u length=%u bouncings=%u mode=0x%02X direction=%u",
+            PatternNamesArray[NeoPatterns::getPatternNamesIndex(aParameters->Pattern)],
+            aNeoPatterns->numPixels(), aParameters->Length, aParameters->NumberOfBouncings, aParameters->Mode,
+            aParameters->Direction);
+}
+
+/*
+ * @return nullptr or the name of the first different value
+ */
+const char* getDifference(NeoPatterns *aSteppedNeoPatterns, NeoPatterns *aRenderedNeoPatterns, bool aComparePixels) {
+    if (aSteppedNeoPatterns->Index != aRenderedNeoPatterns->Index) {
+        return "Index";
+    }
+    if (aSteppedNeoPatterns->Direction != aRenderedNeoPatterns->Direction) {
+        return "Direction";
+    }
+    if (aSteppedNeoPatterns->TotalStepCounter != aRenderedNeoPatterns->TotalStepCounter) {
+        return "TotalStepCounter";
+    }
+    if (aSteppedNeoPatterns->ActivePattern == PATTERN_SCANNER_EXTENDED
+            && aSteppedNeoPatterns->LongValue1.NumberOfBouncings != aRenderedNeoPatterns->LongValue1.NumberOfBouncings) {
+        return "NumberOfBouncings";
+    }
+    if (aComparePixels
+            && memcmp(aSteppedNeoPatterns->getPixels(), aRenderedNeoPatterns->getPixels(),
+                    aSteppedNeoPatterns->numPixels() * aSteppedNeoPatterns->BytesPerPixel) != 0) {
+        return "Pixels";
+    }
+    return nullptr;
+}
+
+/*
+ * @return true if setPatternStep() and renderAt() give the same result as the updates for all steps
+ */
+bool checkPattern(NeoPatterns *aSteppedNeoPatterns, NeoPatterns *aRenderedNeoPatterns, PatternParameterStruct *aParameters) {
+    startPattern(aSteppedNeoPatterns, aParameters);
+    uint16_t tNumberOfSteps = aSteppedNeoPatterns->StartTotalStepCounter;
+    if (sVerbose) {
+        printParameters(aSteppedNeoPatterns, aParameters);
+        printf(" steps=%u\n", tNumberOfSteps);
+    }
+    for (uint16_t tStep = 0; tStep < tNumberOfSteps; ++tStep) {
+        if (tStep > 0) {
+            // The last step is not processed, since it calls the completion callback
+            aSteppedNeoPatterns->_update(UPDATE_AND_DRAW_NEW_PATTERN);
+        }
+        sNumberOfCheckedSteps++;
+
+        // setPatternStep() sets only the state
+        startPattern(aRenderedNeoPatterns, aParameters);
+        aRenderedNeoPatterns->setPatternStep(tStep);
+        const char *tFunction = "setPatternStep()";
+        const char *tDifference = getDifference(aSteppedNeoPatterns, aRenderedNeoPatterns, false);
+        if (tDifference == nullptr) {
+            startPattern(aRenderedNeoPatterns, aParameters);
+            // Interval is compensated for the show() duration and may be smaller than INTERVAL_MILLIS
+            aRenderedNeoPatterns->renderAt((uint32_t) tStep * (aRenderedNeoPatterns->Interval + 1));
+            tFunction = "renderAt()";
+            tDifference = getDifference(aSteppedNeoPatterns, aRenderedNeoPatterns, true);
+        }
+        if (tDifference != nullptr) {
+            printParameters(aSteppedNeoPatterns, aParameters);
+            printf(": %s of %s differ at step %u. Index stepped=%d rendered=%d\n", tDifference, tFunction, tStep,
+                    aSteppedNeoPatterns->Index, aRenderedNeoPatterns->Index);
+            sNumberOfErrors++;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-v") == 0) {
+            sVerbose = true;
+        } else {
+            fprintf(stderr, "Usage: %s [-v]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const uint8_t tNumbersOfPixels[] = { 7, 8, 15, 24 };
+    for (uint8_t tNumberOfPixels : tNumbersOfPixels) {
+        /*
+         * Objects are allocated and never deleted, since they are members of the list of all NeoPatterns objects
+         */
+        NeoPatterns &tSteppedNeoPatterns = *new NeoPatterns(tNumberOfPixels, 1, NEO_GRB + NEO_KHZ800);
+        NeoPatterns &tRenderedNeoPatterns = *new NeoPatterns(tNumberOfPixels, 2, NEO_GRB + NEO_KHZ800);
+        tSteppedNeoPatterns.begin();
+        tRenderedNeoPatterns.begin();
+        PatternParameterStruct tParameters;
+        tParameters.Mode = 0;
+        tParameters.NumberOfBouncings = 0;
+
+        const uint8_t tPatterns[] = { PATTERN_RAINBOW_CYCLE, PATTERN_COLOR_WIPE, PATTERN_FADE, PATTERN_STRIPES };
+        for (uint8_t tPattern : tPatterns) {
+            tParameters.Pattern = tPattern;
+            tParameters.Length = 3;
+            for (tParameters.Direction = DIRECTION_UP; tParameters.Direction <= DIRECTION_DOWN; tParameters.Direction += DIRECTION_DOWN) {
+                checkPattern(&tSteppedNeoPatterns, &tRenderedNeoPatterns, &tParameters);
+            }
+        }
+
+        tParameters.Pattern = PATTERN_SCANNER_EXTENDED;
+        for (tParameters.Length = 1; tParameters.Length <= tNumberOfPixels; ++tParameters.Length) {
+            // All combinations of the mode flags
+            for (tParameters.Mode = 0; tParameters.Mode <= (FLAG_SCANNER_EXT_CYLON | FLAG_SCANNER_EXT_VANISH_COMPLETE
+                    | FLAG_SCANNER_EXT_START_AT_BOTH_ENDS); ++tParameters.Mode) {
+                if ((tParameters.Mode & FLAG_SCANNER_EXT_CYLON) && (2 * tParameters.Length) - 1 > tNumberOfPixels) {
+                    continue; // Cylon pattern does not fit on the strip
+                }
+                for (tParameters.NumberOfBouncings = 0; tParameters.NumberOfBouncings <= 3; ++tParameters.NumberOfBouncings) {
+                    for (tParameters.Direction = DIRECTION_UP; tParameters.Direction <= DIRECTION_DOWN; tParameters.Direction += DIRECTION_DOWN) {
+                        checkPattern(&tSteppedNeoPatterns, &tRenderedNeoPatterns, &tParameters);
+                    }
+                }
+            }
+        }
+    }
+
+    printf("%lu steps checked, %u differences\n", sNumberOfCheckedSteps, sNumberOfErrors);
+    return (sNumberOfErrors == 0) ? 0 : 1;
+}
@@ -0,0 +1,583 @@
+/*
+ *  SequenceValidator.cpp
+ *
+ *  Host program, which checks a pattern sequence for NeoPatterns::startSequence() and computes its nominal runtime.
+ *  The sequence is compiled into this program, so it is written with the same macros as for the Arduino.
+ *  The file must contain only the sequence array and may use the constants of Colors.h and the constants defined below.
+ *
+ *  Build and run on Linux, macOS or Windows with MinGW:
+ *  g++ -O2 -I../../src -DSEQUENCE_FILE='"../../examples/PatternSequence/ShowSequence.h"' -DSEQUENCE_NAME=ShowSequence \
+ *      SequenceValidator.cpp -o SequenceValidator
+ *  ./SequenceValidator [-n <number of pixels>] [-q]
+ *  -q suppresses the step listing.
+ *  The exit code is 1 if errors are found.
+ *
+ *  The runtime of a pattern is the number of its steps multiplied by its interval, so it does not include the time
+ *  for update() calls and show(). BouncingBall and registered patterns have no fixed runtime and are not included.
+ *  SEQUENCE_RANDOM_ONE_OF results in a minimum and a maximum runtime.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#include "NeoSequence.hpp"
+#include "Colors.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+/*
+ * Values from NeoPatterns.h, which requires the Arduino core
+ */
+#define DIRECTION_UP            0
+#define DIRECTION_LEFT          1
+#define DIRECTION_DOWN          2
+#define DIRECTION_RIGHT         3
+#define FLAG_SCANNER_EXT_ROCKET             0x00
+#define FLAG_SCANNER_EXT_CYLON              0x01
+#define FLAG_SCANNER_EXT_VANISH_COMPLETE    0x02
+#define FLAG_SCANNER_EXT_START_AT_BOTH_ENDS 0x04
+#define FLAG_DO_CLEAR                       0x00
+#define FLAG_DO_NOT_CLEAR                   0x10
+#define CLEAR_PATTERN_BEFORE                false
+#define DO_NOT_CLEAR_PATTERN_BEFORE         true
+#define EMBER_MODE_RANDOM                   0
+#define EMBER_MODE_GRADIENT                 1
+
+#if !defined(SEQUENCE_FILE)
+#define SEQUENCE_FILE "../../examples/PatternSequence/ShowSequence.h"
+#endif
+#if !defined(SEQUENCE_NAME)
+#define SEQUENCE_NAME ShowSequence
+#endif
+#include SEQUENCE_FILE
+
+#define STRINGIFY(aName) #aName
+#define TO_STRING(aName) STRINGIFY(aName)
+
+#define MAXIMUM_SIMULATED_STEPS 10000000L
+
+struct StepInfo {
+    uint16_t Offset;
+    uint8_t Opcode;
+    uint8_t LoopDepth;      // Static nesting depth of the step
+};
+
+std::vector<StepInfo> sSteps;   // All steps up to and including the first SEQUENCE_END
+uint16_t sNumberOfPixels = 16;
+int sNumberOfErrors = 0;
+int sNumberOfWarnings = 0;
+long sNumberOfSimulatedSteps = 0;
+bool sHasPatternWithUnknownRuntime = false;
+
+void printError(int aStepIndex, const char *aMessage) {
+    printf("Error at step %d: %s\n", aStepIndex, aMessage);
+    sNumberOfErrors++;
+}
+
+void printWarning(int aStepIndex, const char *aMessage) {
+    printf("Warning at step %d: %s\n", aStepIndex, aMessage);
+    sNumberOfWarnings++;
+}
+
+const char* getStepName(uint8_t aOpcode) {
+    if (aOpcode >= SEQUENCE_OPCODE_REGISTERED_FIRST && aOpcode <= SEQUENCE_OPCODE_REGISTERED_LAST) {
+        return "RegisteredPattern";
+    }
+    switch (aOpcode) {
+    case SEQUENCE_OPCODE_END:
+        return "End";
+    case SEQUENCE_OPCODE_RAINBOW_CYCLE:
+        return "RainbowCycle";
+    case SEQUENCE_OPCODE_COLOR_WIPE:
+        return "ColorWipe";
+    case SEQUENCE_OPCODE_FADE:
+        return "Fade";
+    case SEQUENCE_OPCODE_DELAY:
+        return "Delay";
+    case SEQUENCE_OPCODE_SCANNER_EXTENDED:
+        return "ScannerExtended";
+    case SEQUENCE_OPCODE_STRIPES:
+        return "Stripes";
+    case SEQUENCE_OPCODE_FLASH:
+        return "Flash";
+    case SEQUENCE_OPCODE_HEARTBEAT:
+        return "Heartbeat";
+    case SEQUENCE_OPCODE_FIRE:
+        return "Fire";
+    case SEQUENCE_OPCODE_TWINKLE:
+        return "Twinkle";
+    case SEQUENCE_OPCODE_BOUNCING_BALL:
+        return "BouncingBall";
+    case SEQUENCE_OPCODE_EMBER:
+        return "Ember";
+    case SEQUENCE_OPCODE_LOOP:
+        return "Loop";
+    case SEQUENCE_OPCODE_END_LOOP:
+        return "EndLoop";
+    case SEQUENCE_OPCODE_JUMP:
+        return "Jump";
+    case SEQUENCE_OPCODE_RANDOM_ONE_OF:
+        return "RandomOneOf";
+    case SEQUENCE_OPCODE_CROSSFADE:
+        return "Crossfade";
+    default:
+        return "?";
+    }
+}
+
+/*
+ * Same formulas for the number of steps as in the pattern functions of NeoPatterns.hpp
+ * @return Nominal runtime in milliseconds, 0 if the pattern has no steps and is skipped by the sequencer, -1 if unknown
+ */
+long getPatternRuntimeMillis(const uint8_t *aStepPtr) {
+    const uint8_t *tParameterPtr = aStepPtr + 1;
+    switch (aStepPtr[0]) {
+    case SEQUENCE_OPCODE_RAINBOW_CYCLE:
+        return 256L * tParameterPtr[2] * tParameterPtr[0];
+    case SEQUENCE_OPCODE_COLOR_WIPE:
+        return (long) sNumberOfPixels * readSequenceUInt16(tParameterPtr + 4);
+    case SEQUENCE_OPCODE_FADE:
+        return (readSequenceUInt16(tParameterPtr + 8) + 1L) * readSequenceUInt16(tParameterPtr + 10);
+    case SEQUENCE_OPCODE_DELAY:
+        return readSequenceUInt16(tParameterPtr);
+    case SEQUENCE_OPCODE_SCANNER_EXTENDED: {
+        long tLength = tParameterPtr[4];
+        uint8_t tMode = tParameterPtr[9];
+        long tSteps = sNumberOfPixels - tLength;
+        long tStepsForBounce = sNumberOfPixels - 1;
+        if (tMode & FLAG_SCANNER_EXT_VANISH_COMPLETE) {
+            tSteps += 2 * tLength;
+            if (tMode & FLAG_SCANNER_EXT_CYLON) {
+                tSteps += 2 * (tLength - 1);
+            }
+        }
+        if (tMode & FLAG_SCANNER_EXT_CYLON) {
+            tSteps -= tLength - 1;
+            tStepsForBounce = sNumberOfPixels - (2 * tLength - 1);
+        }
+        tSteps += tStepsForBounce * readSequenceUInt16(tParameterPtr + 7) + 1;
+        return tSteps * readSequenceUInt16(tParameterPtr + 5);
+    }
+    case SEQUENCE_OPCODE_STRIPES:
+        return (readSequenceUInt16(tParameterPtr + 10) + 1L) * readSequenceUInt16(tParameterPtr + 12);
+    case SEQUENCE_OPCODE_FLASH:
+        return (long) readSequenceUInt16(tParameterPtr + 12)
+                * (readSequenceUInt16(tParameterPtr + 4) + readSequenceUInt16(tParameterPtr + 10));
+    case SEQUENCE_OPCODE_HEARTBEAT:
+        return ((2L * 16 * (readSequenceUInt16(tParameterPtr + 6) + 1)) + 1 - (tParameterPtr[8] ? 1 : 0))
+                * readSequenceUInt16(tParameterPtr + 4);
+    case SEQUENCE_OPCODE_FIRE:
+        return (readSequenceUInt16(tParameterPtr) + 1L) * readSequenceUInt16(tParameterPtr + 2);
+    case SEQUENCE_OPCODE_TWINKLE:
+        return 2L * readSequenceUInt16(tParameterPtr + 7) * readSequenceUInt16(tParameterPtr + 5);
+    case SEQUENCE_OPCODE_EMBER: {
+        long tSteps = readSequenceUInt16(tParameterPtr + 4);
+        if (tSteps == 0) {
+            tSteps = 1;
+        }
+        return (tSteps + 1) * readSequenceUInt16(tParameterPtr + 6);
+    }
+    default:
+        return -1; // BouncingBall and registered patterns
+    }
+}
+
+/*
+ * @return true if the sequencer skips the pattern, since its TotalStepCounter is 0
+ */
+bool isPatternWithoutSteps(const uint8_t *aStepPtr) {
+    const uint8_t *tParameterPtr = aStepPtr + 1;
+    switch (aStepPtr[0]) {
+    case SEQUENCE_OPCODE_RAINBOW_CYCLE:
+        return tParameterPtr[2] == 0;
+    case SEQUENCE_OPCODE_COLOR_WIPE:
+        return sNumberOfPixels == 0;
+    case SEQUENCE_OPCODE_FLASH:
+        return readSequenceUInt16(tParameterPtr + 12) == 0;
+    case SEQUENCE_OPCODE_TWINKLE:
+        return readSequenceUInt16(tParameterPtr + 7) == 0;
+    default:
+        return false;
+    }
+}
+
+void checkPatternParameters(int aStepIndex, const uint8_t *aStepPtr) {
+    const uint8_t *tParameterPtr = aStepPtr + 1;
+    if (isPatternWithoutSteps(aStepPtr)) {
+        printWarning(aStepIndex, "Pattern has no steps, e.g. 0 repetitions, and is skipped");
+    }
+    switch (aStepPtr[0]) {
+    case SEQUENCE_OPCODE_FADE:
+        if (readSequenceUInt16(tParameterPtr + 8) > 0xFF) {
+            printWarning(aStepIndex, "Fade supports only 255 steps for the color computation");
+        }
+        break;
+    case SEQUENCE_OPCODE_SCANNER_EXTENDED:
+        if (tParameterPtr[4] == 0 || tParameterPtr[4] > sNumberOfPixels) {
+            printError(aStepIndex, "Scanner length must be between 1 and the number of pixels");
+        }
+        break;
+    case SEQUENCE_OPCODE_STRIPES:
+        if (tParameterPtr[4] + tParameterPtr[9] == 0) {
+            printError(aStepIndex, "Stripes must have a length");
+        }
+        break;
+    case SEQUENCE_OPCODE_BOUNCING_BALL:
+        if (readSequenceUInt16(tParameterPtr + 4) >= sNumberOfPixels) {
+            printError(aStepIndex, "Index of top pixel must be less than the number of pixels");
+        }
+        break;
+    }
+}
+
+/*
+ * Parses the sequence and checks the structure
+ */
+void parseSequence(const uint8_t *aSequence, size_t aSequenceSize) {
+    size_t tOffset = 0;
+    uint8_t tLoopDepth = 0;
+    while (true) {
+        int tStepIndex = sSteps.size();
+        if (tOffset >= aSequenceSize) {
+            printError(tStepIndex, "Missing SEQUENCE_END");
+            return;
+        }
+        uint8_t tOpcode = aSequence[tOffset];
+        uint8_t tStepLength = getSequenceStepLength(tOpcode);
+        if (tStepLength == 0) {
+            char tMessage[40];
+            snprintf(tMessage, sizeof(tMessage), "Unknown opcode 0x%02X", tOpcode);
+            printError(tStepIndex, tMessage);
+            return;
+        }
+        if (tOffset + tStepLength > aSequenceSize) {
+            printError(tStepIndex, "Step is truncated");
+            return;
+        }
+        if (tOpcode == SEQUENCE_OPCODE_END_LOOP) {
+            if (tLoopDepth == 0) {
+                printError(tStepIndex, "SEQUENCE_END_LOOP without SEQUENCE_LOOP");
+            } else {
+                tLoopDepth--;
+            }
+        }
+        sSteps.push_back( { (uint16_t) tOffset, tOpcode, tLoopDepth });
+        if (tOpcode == SEQUENCE_OPCODE_LOOP) {
+            tLoopDepth++;
+            if (tLoopDepth > SEQUENCE_MAX_LOOP_DEPTH) {
+                printError(tStepIndex, "Loops are nested deeper than SEQUENCE_MAX_LOOP_DEPTH");
+            }
+        }
+        tOffset += tStepLength;
+        if (tOpcode == SEQUENCE_OPCODE_END) {
+            break;
+        }
+    }
+    if (tLoopDepth != 0) {
+        printWarning(sSteps.size() - 1, "Loop is not closed by SEQUENCE_END_LOOP");
+    }
+    if (tOffset < aSequenceSize) {
+        printWarning(sSteps.size() - 1, "Bytes after the first SEQUENCE_END are ignored");
+    }
+
+    for (size_t i = 0; i < sSteps.size(); ++i) {
+        const uint8_t *tStepPtr = &aSequence[sSteps[i].Offset];
+        uint8_t tOpcode = sSteps[i].Opcode;
+        if (tOpcode == SEQUENCE_OPCODE_JUMP) {
+            uint8_t tTarget = tStepPtr[1];
+            if (tTarget >= sSteps.size()) {
+                printError(i, "Jump target is behind SEQUENCE_END");
+            } else if (sSteps[tTarget].LoopDepth != 0 || sSteps[tTarget].Opcode == SEQUENCE_OPCODE_END_LOOP) {
+                printError(i, "Jump target is inside a loop");
+            }
+        } else if (tOpcode == SEQUENCE_OPCODE_RANDOM_ONE_OF) {
+            uint8_t tNumberOfChoices = tStepPtr[1];
+            if (tNumberOfChoices == 0) {
+                printWarning(i, "SEQUENCE_RANDOM_ONE_OF(0) does nothing");
+            }
+            for (size_t j = i + 1; j <= i + tNumberOfChoices; ++j) {
+                if (j >= sSteps.size() - 1) {
+                    printError(i, "Not enough steps before SEQUENCE_END for SEQUENCE_RANDOM_ONE_OF");
+                    break;
+                }
+                if (!isSequencePatternStep(sSteps[j].Opcode) && sSteps[j].Opcode != SEQUENCE_OPCODE_JUMP) {
+                    printError(j, "Choice of SEQUENCE_RANDOM_ONE_OF must be a pattern or a jump");
+                }
+            }
+        } else if (isSequencePatternStep(tOpcode)) {
+            checkPatternParameters(i, tStepPtr);
+        }
+    }
+}
+
+void printStepListing(const uint8_t *aSequence) {
+    printf("Step Offset Instruction            Runtime\n");
+    for (size_t i = 0; i < sSteps.size(); ++i) {
+        const uint8_t *tStepPtr = &aSequence[sSteps[i].Offset];
+        uint8_t tOpcode = sSteps[i].Opcode;
+        char tInstruction[40];
+        snprintf(tInstruction, sizeof(tInstruction), "%*s%s", 2 * sSteps[i].LoopDepth, "", getStepName(tOpcode));
+        if (tOpcode == SEQUENCE_OPCODE_LOOP || tOpcode == SEQUENCE_OPCODE_JUMP || tOpcode == SEQUENCE_OPCODE_RANDOM_ONE_OF) {
+            snprintf(tInstruction + strlen(tInstruction), sizeof(tInstruction) - strlen(tInstruction), "(%u)", tStepPtr[1]);
+        } else if (tOpcode == SEQUENCE_OPCODE_CROSSFADE) {
+            snprintf(tInstruction + strlen(tInstruction), sizeof(tInstruction) - strlen(tInstruction), "(%u)",
+                    readSequenceUInt16(tStepPtr + 1));
+        } else if (tOpcode >= SEQUENCE_OPCODE_REGISTERED_FIRST) {
+            snprintf(tInstruction + strlen(tInstruction), sizeof(tInstruction) - strlen(tInstruction), "(%u)",
+                    tOpcode - SEQUENCE_OPCODE_REGISTERED_FIRST);
+        }
+        printf("%4zu %6u %-22s", i, sSteps[i].Offset, tInstruction);
+        if (isSequencePatternStep(tOpcode)) {
+            long tRuntime = getPatternRuntimeMillis(tStepPtr);
+            if (tRuntime < 0) {
+                printf(" unknown");
+            } else {
+                printf(" %ld ms", tRuntime);
+            }
+        }
+        printf("\n");
+    }
+}
+
+/*
+ * Result of a simulated run
+ */
+struct RuntimeStruct {
+    long MinMillis;
+    long MaxMillis;
+    bool IsEndless;     // The runtimes are up to the first repetition of an endless loop or a backward jump
+    bool IsAborted;     // Simulation was aborted
+};
+
+struct LoopState {
+    int StartStepIndex;
+    uint8_t RemainingRuns;
+};
+
+/*
+ * Runs the sequence from aStepIndex like NeoPatterns::startNextSequenceStep().
+ * Random choices of patterns add their minimum and maximum runtime, random choices of jumps are simulated separately.
+ * aJumpTargets contains the targets of all jumps done before, a second jump to one of them is an endless loop.
+ */
+RuntimeStruct simulate(const uint8_t *aSequence, int aStepIndex, std::vector<LoopState> aLoops, std::vector<int> aJumpTargets) {
+    RuntimeStruct tResult = { 0, 0, false, false };
+    int tControlSteps = 0;
+    int tStepIndex = aStepIndex;
+    bool tIsRepetition = false; // Set at the first repetition, the next pattern step ends the simulation
+    while (true) {
+        if (++sNumberOfSimulatedSteps > MAXIMUM_SIMULATED_STEPS) {
+            tResult.IsAborted = true;
+            return tResult;
+        }
+        if (tControlSteps >= SEQUENCE_MAX_CONTROL_STEPS) {
+            printError(tStepIndex, "Sequence ends here, since no pattern is started within SEQUENCE_MAX_CONTROL_STEPS steps");
+            return tResult;
+        }
+        const uint8_t *tStepPtr = &aSequence[sSteps[tStepIndex].Offset];
+        uint8_t tOpcode = tStepPtr[0];
+        if (tOpcode == SEQUENCE_OPCODE_END) {
+            return tResult;
+        }
+        tStepIndex++;
+        tControlSteps++;
+
+        if (tOpcode == SEQUENCE_OPCODE_RANDOM_ONE_OF) {
+            uint8_t tNumberOfChoices = tStepPtr[1];
+            if (tNumberOfChoices == 0) {
+                continue;
+            }
+            if (tIsRepetition) {
+                tResult.IsEndless = true;
+                return tResult;
+            }
+            long tMinMillis = 0x7FFFFFFF;
+            long tMaxMillis = 0;
+            bool tHasJump = false;
+            for (int i = tStepIndex; i < tStepIndex + tNumberOfChoices; ++i) {
+                if (sSteps[i].Opcode == SEQUENCE_OPCODE_JUMP) {
+                    tHasJump = true;
+                }
+                long tRuntime = getPatternRuntimeMillis(&aSequence[sSteps[i].Offset]);
+                if (tRuntime < 0) {
+                    tRuntime = 0;
+                }
+                if (tRuntime < tMinMillis) {
+                    tMinMillis = tRuntime;
+                }
+                if (tRuntime > tMaxMillis) {
+                    tMaxMillis = tRuntime;
+                }
+            }
+            if (tHasJump) {
+                /*
+                 * Each choice has its own continuation
+                 */
+                RuntimeStruct tCombined = { 0x7FFFFFFF, 0, false, false };
+                for (int i = tStepIndex; i < tStepIndex + tNumberOfChoices; ++i) {
+                    RuntimeStruct tChoiceResult;
+                    const uint8_t *tChoicePtr = &aSequence[sSteps[i].Offset];
+                    if (sSteps[i].Opcode == SEQUENCE_OPCODE_JUMP) {
+                        std::vector<int> tJumpTargets = aJumpTargets;
+                        int tTarget = tChoicePtr[1];
+                        bool tIsRepetition = false;
+                        for (int tOldTarget : tJumpTargets) {
+                            tIsRepetition |= (tOldTarget == tTarget);
+                        }
+                        if (tIsRepetition) {
+                            tChoiceResult = { 0, 0, true, false };
+                        } else {
+                            tJumpTargets.push_back(tTarget);
+                            tChoiceResult = simulate(aSequence, tTarget, std::vector<LoopState>(), tJumpTargets);
+                        }
+                    } else {
+                        tChoiceResult = simulate(aSequence, tStepIndex + tNumberOfChoices, aLoops, aJumpTargets);
+                        long tRuntime = getPatternRuntimeMillis(tChoicePtr);
+                        if (tRuntime > 0) {
+                            tChoiceResult.MinMillis += tRuntime;
+                            tChoiceResult.MaxMillis += tRuntime;
+                        }
+                    }
+                    tCombined.IsEndless |= tChoiceResult.IsEndless;
+                    tCombined.IsAborted |= tChoiceResult.IsAborted;
+                    if (tChoiceResult.MinMillis < tCombined.MinMillis) {
+                        tCombined.MinMillis = tChoiceResult.MinMillis;
+                    }
+                    if (tChoiceResult.MaxMillis > tCombined.MaxMillis) {
+                        tCombined.MaxMillis = tChoiceResult.MaxMillis;
+                    }
+                }
+                tResult.MinMillis += tCombined.MinMillis;
+                tResult.MaxMillis += tCombined.MaxMillis;
+                tResult.IsEndless |= tCombined.IsEndless;
+                tResult.IsAborted |= tCombined.IsAborted;
+                return tResult;
+            }
+            tResult.MinMillis += tMinMillis;
+            tResult.MaxMillis += tMaxMillis;
+            tStepIndex += tNumberOfChoices;
+            tControlSteps = 0;
+            continue;
+        }
+
+        switch (tOpcode) {
+        case SEQUENCE_OPCODE_LOOP:
+            if (aLoops.size() >= SEQUENCE_MAX_LOOP_DEPTH) {
+                return tResult; // The sequencer ends the sequence, the error is reported by parseSequence()
+            }
+            aLoops.push_back( { tStepIndex, tStepPtr[1] });
+            break;
+
+        case SEQUENCE_OPCODE_END_LOOP:
+            if (!aLoops.empty()) {
+                LoopState *tLoopPtr = &aLoops.back();
+                if (tLoopPtr->RemainingRuns == 0) {
+                    // Continue until the next pattern, to detect loops without patterns
+                    tIsRepetition = true;
+                    tStepIndex = tLoopPtr->StartStepIndex;
+                } else if (--tLoopPtr->RemainingRuns > 0) {
+                    tStepIndex = tLoopPtr->StartStepIndex;
+                } else {
+                    aLoops.pop_back();
+                }
+            }
+            break;
+
+        case SEQUENCE_OPCODE_JUMP: {
+            int tTarget = tStepPtr[1];
+            for (int tOldTarget : aJumpTargets) {
+                if (tOldTarget == tTarget) {
+                    tIsRepetition = true;
+                }
+            }
+            aJumpTargets.push_back(tTarget);
+            aLoops.clear();
+            tStepIndex = tTarget;
+            break;
+        }
+
+        case SEQUENCE_OPCODE_CROSSFADE:
+            break;
+
+        default: {
+            if (isPatternWithoutSteps(tStepPtr)) {
+                break;
+            }
+            if (tIsRepetition) {
+                tResult.IsEndless = true;
+                return tResult;
+            }
+            long tRuntime = getPatternRuntimeMillis(tStepPtr);
+            if (tRuntime < 0) {
+                sHasPatternWithUnknownRuntime = true;
+            } else {
+                tResult.MinMillis += tRuntime;
+                tResult.MaxMillis += tRuntime;
+            }
+            tControlSteps = 0;
+            break;
+        }
+        }
+    }
+}
+
+void printMillis(long aMillis) {
+    printf("%ld ms (%ld:%02ld.%03ld)", aMillis, aMillis / 60000, (aMillis / 1000) % 60, aMillis % 1000);
+}
+
+int main(int argc, char *argv[]) {
+    bool tDoListing = true;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            sNumberOfPixels = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-q") == 0) {
+            tDoListing = false;
+        } else {
+            printf("Usage: %s [-n <number of pixels>] [-q]\n", argv[0]);
+            return 2;
+        }
+    }
+    printf("Sequence %s, %zu bytes, %u pixels\n", TO_STRING(SEQUENCE_NAME), sizeof(SEQUENCE_NAME), sNumberOfPixels);
+
+    parseSequence(SEQUENCE_NAME, sizeof(SEQUENCE_NAME));
+    if (tDoListing) {
+        printStepListing(SEQUENCE_NAME);
+    }
+    if (sNumberOfErrors == 0) {
+        RuntimeStruct tRuntime = simulate(SEQUENCE_NAME, 0, std::vector<LoopState>(), std::vector<int>());
+        if (tRuntime.IsAborted) {
+            printf("Runtime simulation aborted after %ld steps\n", MAXIMUM_SIMULATED_STEPS);
+        } else {
+            printf(tRuntime.IsEndless ? "Endless sequence, runtime up to the first repetition: " : "Runtime: ");
+            printMillis(tRuntime.MinMillis);
+            if (tRuntime.MaxMillis != tRuntime.MinMillis) {
+                printf(" to ");
+                printMillis(tRuntime.MaxMillis);
+            }
+            printf("\n");
+        }
+        if (sHasPatternWithUnknownRuntime) {
+            printf("Runtime of BouncingBall and registered patterns is not included\n");
+        }
+    }
+    printf("%d errors, %d warnings\n", sNumberOfErrors, sNumberOfWarnings);
+    return (sNumberOfErrors == 0) ? 0 : 1;
+}
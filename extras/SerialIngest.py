@@ -0,0 +1,245 @@
+#!/usr/bin/env python3
+#
+# SerialIngest.py
+#
+# Sends frames to the SerialIngest pattern of NeoPatterns, see NeoPatterns.h for the frame format and the flow control.
+# As demo content, a moving rainbow is sent.
+#
+# Usage:
+#   python3 SerialIngest.py --port COM6 --pixels 16
+#   python3 SerialIngest.py --port /dev/ttyUSB0 --pixels 300 --baudrate 500000
+# Test on Linux without hardware:
+#   python3 SerialIngest.py --pty --pixels 16
+#   creates a pseudo terminal and prints its name, which must then be opened by the receiving program,
+#   e.g. by extras/SerialIngestReceiver, which runs the SerialIngest pattern of the library on the PC.
+#
+# Requires pyserial ("pip install pyserial") for real serial ports. On Linux, the termios module is used if pyserial is missing.
+#
+#  Copyright (C) 2026  Armin Joachimsmeyer
+#  armin.joachimsmeyer@gmail.com
+#
+#  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+#
+#  NeoPatterns is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+#  See the GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+#
+
+import argparse
+import colorsys
+import os
+import sys
+import time
+
+# Must match the values in NeoPatterns.h
+SERIAL_INGEST_START_BYTE = 0xC9
+SERIAL_INGEST_DATA_FRAME = 0xDA
+SERIAL_INGEST_END_BYTE = 0x36
+SERIAL_INGEST_CHECKSUM_SEED = 0x55
+SERIAL_INGEST_ACK = 0x06
+SERIAL_INGEST_NAK = 0x15
+SERIAL_INGEST_CREDIT = 0x11
+SERIAL_INGEST_CHUNK_SIZE = 16
+SERIAL_INGEST_WINDOW_SIZE = 2 * SERIAL_INGEST_CHUNK_SIZE
+
+ACK_TIMEOUT_SECONDS = 0.5
+START_TIMEOUT_SECONDS = 3  # Opening the port resets most Arduinos
+
+
+class PosixPort:
+    """Minimal replacement for serial.Serial based on a file descriptor"""
+
+    def __init__(self, aFileDescriptor):
+        self.fd = aFileDescriptor
+
+    @classmethod
+    def open(cls, aPortName, aBaudrate):
+        import termios
+        import tty
+        tFileDescriptor = os.open(aPortName, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(tFileDescriptor)
+        tAttributes = termios.tcgetattr(tFileDescriptor)
+        tSpeed = getattr(termios, 'B' + str(aBaudrate), termios.B115200)
+        tAttributes[4] = tAttributes[5] = tSpeed
+        termios.tcsetattr(tFileDescriptor, termios.TCSANOW, tAttributes)
+        return cls(tFileDescriptor)
+
+    @classmethod
+    def openPseudoTerminal(cls):
+        import tty
+        tMaster, tSlave = os.openpty()
+        tty.setraw(tMaster)
+        tty.setraw(tSlave)
+        print("Pseudo terminal is " + os.ttyname(tSlave))
+        return cls(tMaster)
+
+    def write(self, aBytes):
+        os.write(self.fd, aBytes)
+
+    def read(self, aTimeoutSeconds):
+        import select
+        tReadable, _, _ = select.select([self.fd], [], [], aTimeoutSeconds)
+        if tReadable:
+            return os.read(self.fd, 256)
+        return b''
+
+    def close(self):
+        os.close(self.fd)
+
+
+class PySerialPort:
+
+    def __init__(self, aPortName, aBaudrate):
+        import serial
+        self.serial = serial.Serial(aPortName, aBaudrate, timeout=0)
+
+    def write(self, aBytes):
+        self.serial.write(aBytes)
+
+    def read(self, aTimeoutSeconds):
+        self.serial.timeout = aTimeoutSeconds
+        tBytes = self.serial.read(max(1, self.serial.in_waiting))
+        return tBytes
+
+    def close(self):
+        self.serial.close()
+
+
+class SerialIngestSender:
+
+    def __init__(self, aPort):
+        self.port = aPort
+        self.bytesSent = 0  # Bytes sent since the device sent the first ACK
+        self.credits = 0
+        self.frameResponses = []  # Received ACK and NAK bytes
+        self.numberOfNaks = 0
+        self.numberOfTimeouts = 0
+
+    def processInput(self, aTimeoutSeconds):
+        for tByte in self.port.read(aTimeoutSeconds):
+            if tByte == SERIAL_INGEST_CREDIT:
+                self.credits += 1
+            elif tByte == SERIAL_INGEST_ACK or tByte == SERIAL_INGEST_NAK:
+                self.frameResponses.append(tByte)
+            # All other bytes e.g. the start message of the device are ignored
+
+    def waitForStart(self):
+        tEndTime = time.time() + START_TIMEOUT_SECONDS
+        while not self.frameResponses and time.time() < tEndTime:
+            self.processInput(0.1)
+        if not self.frameResponses:
+            print("No ACK received from device, start anyway")
+        # The device counts the bytes from its ACK
+        self.frameResponses = []
+        self.credits = 0
+        self.bytesSent = 0
+
+    @staticmethod
+    def encodeFrame(aPayload):
+        tLength = len(aPayload)
+        tChecksum = SERIAL_INGEST_CHECKSUM_SEED ^ (tLength >> 8) ^ (tLength & 0xFF)
+        for tByte in aPayload:
+            tChecksum ^= tByte
+        return bytes([SERIAL_INGEST_START_BYTE, SERIAL_INGEST_DATA_FRAME, tLength >> 8, tLength & 0xFF]) + bytes(aPayload) + bytes(
+            [tChecksum, SERIAL_INGEST_END_BYTE])
+
+    def sendFrame(self, aPayload):
+        """Sends the frame with flow control and returns True if it was acknowledged"""
+        tFrame = self.encodeFrame(aPayload)
+        tIndex = 0
+        while tIndex < len(tFrame):
+            tAllowedBytes = self.credits * SERIAL_INGEST_CHUNK_SIZE + SERIAL_INGEST_WINDOW_SIZE - self.bytesSent
+            if tAllowedBytes <= 0:
+                self.processInput(ACK_TIMEOUT_SECONDS)
+                if self.credits * SERIAL_INGEST_CHUNK_SIZE + SERIAL_INGEST_WINDOW_SIZE - self.bytesSent <= 0:
+                    # Lost credit, resynchronize with the next ACK or NAK
+                    self.numberOfTimeouts += 1
+                    self.credits = (self.bytesSent - SERIAL_INGEST_WINDOW_SIZE) // SERIAL_INGEST_CHUNK_SIZE + 1
+                continue
+            tChunk = tFrame[tIndex:tIndex + tAllowedBytes]
+            self.port.write(tChunk)
+            tIndex += len(tChunk)
+            self.bytesSent += len(tChunk)
+            self.processInput(0)
+
+        # The device shows the frame and then sends ACK or NAK
+        tEndTime = time.time() + ACK_TIMEOUT_SECONDS
+        while not self.frameResponses and time.time() < tEndTime:
+            self.processInput(0.01)
+        if not self.frameResponses:
+            self.numberOfTimeouts += 1
+            return False
+        if self.frameResponses.pop(0) == SERIAL_INGEST_NAK:
+            self.numberOfNaks += 1
+            return False
+        return True
+
+
+def rainbowFrame(aNumberOfPixels, aOffset, aByteOrder):
+    tPayload = []
+    for i in range(aNumberOfPixels):
+        tRed, tGreen, tBlue = colorsys.hsv_to_rgb(((i + aOffset) % aNumberOfPixels) / aNumberOfPixels, 1, 1)
+        tColor = {'R': int(tRed * 255), 'G': int(tGreen * 255), 'B': int(tBlue * 255), 'W': 0}
+        for tColorName in aByteOrder:
+            tPayload.append(tColor[tColorName])
+    return tPayload
+
+
+def main():
+    tParser = argparse.ArgumentParser(description='Sends a moving rainbow to the SerialIngest pattern of NeoPatterns')
+    tParser.add_argument('--port', help='Serial port e.g. COM6 or /dev/ttyUSB0')
+    tParser.add_argument('--pty', action='store_true', help='Create a pseudo terminal instead of opening a port (Linux only)')
+    tParser.add_argument('--baudrate', type=int, default=115200)
+    tParser.add_argument('--pixels', type=int, default=16)
+    tParser.add_argument('--byteorder', default='GRB', help='Byte order of the pixel type e.g. GRB for NEO_GRB or GRBW')
+    tParser.add_argument('--fps', type=float, default=30, help='Maximum frames per second')
+    tParser.add_argument('--frames', type=int, default=0, help='Number of frames to send, 0 for endless')
+    tArguments = tParser.parse_args()
+
+    if tArguments.pty:
+        tPort = PosixPort.openPseudoTerminal()
+    elif tArguments.port is None:
+        tParser.error('--port or --pty is required')
+    else:
+        try:
+            tPort = PySerialPort(tArguments.port, tArguments.baudrate)
+        except ImportError:
+            tPort = PosixPort.open(tArguments.port, tArguments.baudrate)
+
+    tSender = SerialIngestSender(tPort)
+    print("Waiting for device")
+    tSender.waitForStart()
+
+    tFrameCount = 0
+    tNumberOfShownFrames = 0
+    tStartTime = time.time()
+    try:
+        while tArguments.frames == 0 or tFrameCount < tArguments.frames:
+            tFrameStartTime = time.time()
+            tPayload = rainbowFrame(tArguments.pixels, tFrameCount, tArguments.byteorder)
+            if tSender.sendFrame(tPayload):
+                tNumberOfShownFrames += 1
+            tFrameCount += 1
+            tRemainingSeconds = (1 / tArguments.fps) - (time.time() - tFrameStartTime)
+            if tRemainingSeconds > 0:
+                time.sleep(tRemainingSeconds)
+    except KeyboardInterrupt:
+        pass
+    tSeconds = time.time() - tStartTime
+    print("Sent " + str(tFrameCount) + " frames, shown=" + str(tNumberOfShownFrames) + ", NAK=" + str(tSender.numberOfNaks)
+          + ", timeouts=" + str(tSender.numberOfTimeouts) + ", frames per second=" + "{:.1f}".format(tFrameCount / tSeconds))
+    tPort.close()
+    return 0 if tNumberOfShownFrames == tFrameCount else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,399 @@
+/*
+ *  SerialIngestReceiver.cpp
+ *
+ *  Host program, which runs the SerialIngest pattern of NeoPatterns as receiver on the PC, so the frame parser and
+ *  the flow control of the library can be tested without hardware.
+ *
+ *  With a pseudo terminal of extras/SerialIngest.py:
+ *  python3 SerialIngest.py --pty --pixels 16 --frames 300    prints e.g. "Pseudo terminal is /dev/pts/3"
+ *  ./SerialIngestReceiver -p /dev/pts/3 -n 16                 must be started within 3 seconds
+ *  The receiver ends, if no valid frame was received for the timeout of -t milliseconds.
+ *
+ *  As loopback self test (-s), an internal sender with the same flow control as SerialIngest.py sends random frames
+ *  over a simulated serial line with the baudrate of -b into a receive buffer of 64 bytes like on AVR.
+ *  The loop of the device, which polls the pattern, takes -l microseconds, e.g. for other patterns.
+ *  Bytes, which arrive while interrupts are disabled by show(), are lost, except 2 bytes, which fit into the UART.
+ *  Every -e percent frame is sent with a wrong checksum and must be answered with NAK.
+ *  With -r, the pattern is polled by updateOrRedraw() and the frame is shown by the loop, otherwise by update().
+ *  All other frames must be shown with unchanged payload and no byte may be lost.
+ *
+ *  Build and run on Linux or macOS:
+ *  g++ -O2 -I../HostArduino -I../../src SerialIngestReceiver.cpp ../HostArduino/HostArduino.cpp -o SerialIngestReceiver
+ *  ./SerialIngestReceiver [-p <pseudo terminal> | -s] [-n <pixels>] [-t <timeout ms>] [-f <frames>] [-b <baudrate>] [-e <error percent>]
+ *                       [-l <loop micros>] [-r] [-q]
+ *  -f, -b, -e, -l and -r are used for the self test. -q prints only the result.
+ *  The exit code is 1 if no frame was shown, or for the self test, if a frame or byte was lost or a payload differs.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+// Must be included before Arduino.h, which defines min(), max() and abs() as macros
+#include <cstring>
+#include <deque>
+#include <vector>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <Arduino.h>
+
+#define ENABLE_PATTERN_SERIAL_INGEST
+#include "NeoPatterns.hpp"
+
+#define RECEIVE_BUFFER_SIZE     64 // Of AVR HardwareSerial
+#define UART_FIFO_SIZE          2  // Bytes received while interrupts are disabled, which are not lost
+#define SENDER_TIMEOUT_MILLIS   500
+
+const char *sPseudoTerminalName = nullptr;
+bool sSelfTest = false;
+int sNumberOfPixels = 16;
+int sTimeoutMillis = 2000;
+long sNumberOfFrames = 1000;
+long sBaudrate = 115200;
+int sErrorPercent = 5;
+int sLoopMicros = 5000;
+bool sUseUpdateOrRedraw = false;
+bool sQuiet = false;
+
+/*
+ * Stream of the pseudo terminal
+ */
+class FileDescriptorStream: public Stream {
+public:
+    int FileDescriptor;
+    int available() override {
+        int tAvailable = 0;
+        if (ioctl(FileDescriptor, FIONREAD, &tAvailable) != 0) {
+            return 0;
+        }
+        return tAvailable;
+    }
+    int read() override {
+        uint8_t tByte;
+        if (::read(FileDescriptor, &tByte, 1) != 1) {
+            return -1;
+        }
+        return tByte;
+    }
+    size_t write(uint8_t aByte) override {
+        return ::write(FileDescriptor, &aByte, 1);
+    }
+};
+
+/*
+ * Model of the serial line for the self test
+ */
+struct WireByteStruct {
+    uint8_t Byte;
+    unsigned long ArrivalMicros;
+};
+std::deque<WireByteStruct> sWire;           // Bytes sent by the sender, which have not yet arrived
+unsigned long sLastArrivalMicros;
+std::deque<uint8_t> sReceiveBuffer;         // Receive buffer of the device
+std::deque<uint8_t> sResponses;             // Bytes sent by the device
+unsigned long sShowStartMicros;             // Interrupts are disabled from start to end of the last show()
+unsigned long sShowEndMicros;
+unsigned int sBytesReceivedDuringShow;
+unsigned long sNumberOfLostBytes;
+
+void deliverArrivedBytes() {
+    while (!sWire.empty() && (long) (micros() - sWire.front().ArrivalMicros) >= 0) {
+        WireByteStruct tWireByte = sWire.front();
+        sWire.pop_front();
+        if ((long) (tWireByte.ArrivalMicros - sShowStartMicros) >= 0 && (long) (tWireByte.ArrivalMicros - sShowEndMicros) < 0) {
+            if (++sBytesReceivedDuringShow > UART_FIFO_SIZE) {
+                sNumberOfLostBytes++;
+                continue;
+            }
+        }
+        if (sReceiveBuffer.size() >= RECEIVE_BUFFER_SIZE) {
+            sNumberOfLostBytes++;
+            continue;
+        }
+        sReceiveBuffer.push_back(tWireByte.Byte);
+    }
+}
+
+/*
+ * Device side of the simulated serial line
+ */
+class LoopbackStream: public Stream {
+public:
+    int available() override {
+        deliverArrivedBytes();
+        return sReceiveBuffer.size();
+    }
+    int read() override {
+        deliverArrivedBytes();
+        if (sReceiveBuffer.empty()) {
+            return -1;
+        }
+        uint8_t tByte = sReceiveBuffer.front();
+        sReceiveBuffer.pop_front();
+        return tByte;
+    }
+    size_t write(uint8_t aByte) override {
+        sResponses.push_back(aByte);
+        return 1;
+    }
+};
+
+/*
+ * Sender with the flow control of SerialIngest.py
+ */
+std::vector<uint8_t> sPayload;      // Of the frame, which is currently sent
+std::vector<uint8_t> sFrame;
+size_t sFrameIndex;                 // Next byte of sFrame to send
+bool sFrameIsCorrupted;
+unsigned long sBytesSent;
+unsigned long sCredits;
+bool sWaitForStart = true;
+bool sWaitForResponse;
+unsigned long sResponseTimeoutMillis;
+long sNumberOfSentFrames;
+long sNumberOfAcks;
+long sNumberOfExpectedNaks;
+long sNumberOfWrongResponses;
+long sNumberOfSenderTimeouts;
+
+/*
+ * Received frames
+ */
+long sNumberOfShownFrames;
+long sNumberOfPayloadErrors;
+
+void startNextFrame() {
+    sPayload.resize(sNumberOfPixels * 3);
+    for (size_t i = 0; i < sPayload.size(); ++i) {
+        sPayload[i] = random(256);
+    }
+    uint16_t tLength = sPayload.size();
+    uint8_t tChecksum = SERIAL_INGEST_CHECKSUM_SEED ^ (tLength >> 8) ^ (tLength & 0xFF);
+    sFrame.clear();
+    sFrame.push_back(SERIAL_INGEST_START_BYTE);
+    sFrame.push_back(SERIAL_INGEST_DATA_FRAME);
+    sFrame.push_back(tLength >> 8);
+    sFrame.push_back(tLength & 0xFF);
+    for (uint8_t tByte : sPayload) {
+        tChecksum ^= tByte;
+        sFrame.push_back(tByte);
+    }
+    sFrameIsCorrupted = (random(100) < sErrorPercent);
+    if (sFrameIsCorrupted) {
+        tChecksum ^= 0x01;
+    }
+    sFrame.push_back(tChecksum);
+    sFrame.push_back(SERIAL_INGEST_END_BYTE);
+    sFrameIndex = 0;
+    sNumberOfSentFrames++;
+}
+
+void processResponses() {
+    while (!sResponses.empty()) {
+        uint8_t tByte = sResponses.front();
+        sResponses.pop_front();
+        if (tByte == SERIAL_INGEST_CREDIT) {
+            sCredits++;
+        } else if (tByte == SERIAL_INGEST_ACK || tByte == SERIAL_INGEST_NAK) {
+            if (sWaitForStart) {
+                // The device counts the bytes from its first ACK
+                sWaitForStart = false;
+                sBytesSent = 0;
+                sCredits = 0;
+                startNextFrame();
+            } else if (sWaitForResponse) {
+                if (tByte == SERIAL_INGEST_ACK && !sFrameIsCorrupted) {
+                    sNumberOfAcks++;
+                } else if (tByte == SERIAL_INGEST_NAK && sFrameIsCorrupted) {
+                    sNumberOfExpectedNaks++;
+                } else {
+                    sNumberOfWrongResponses++;
+                }
+                sWaitForResponse = false;
+                if (sNumberOfSentFrames < sNumberOfFrames) {
+                    startNextFrame();
+                }
+            }
+        }
+    }
+}
+
+/*
+ * @return false if all frames are sent and answered
+ */
+bool pollSender() {
+    processResponses();
+    if (sWaitForStart) {
+        return true;
+    }
+    if (sWaitForResponse) {
+        if ((long) (millis() - sResponseTimeoutMillis) > 0) {
+            sNumberOfSenderTimeouts++;
+            sWaitForResponse = false;
+            if (sNumberOfSentFrames < sNumberOfFrames) {
+                startNextFrame();
+            }
+        }
+        return true;
+    }
+    if (sFrameIndex >= sFrame.size()) {
+        return false; // The last frame was answered
+    }
+    unsigned long tByteMicros = (10 * 1000000L) / sBaudrate;
+    while (sFrameIndex < sFrame.size() && (sCredits * SERIAL_INGEST_CHUNK_SIZE) + SERIAL_INGEST_WINDOW_SIZE > sBytesSent) {
+        // The sender does not wait for the UART, all bytes are queued at the baudrate
+        unsigned long tArrivalMicros = micros();
+        if ((long) (sLastArrivalMicros - tArrivalMicros) > 0) {
+            tArrivalMicros = sLastArrivalMicros;
+        }
+        tArrivalMicros += tByteMicros;
+        sLastArrivalMicros = tArrivalMicros;
+        sWire.push_back( { sFrame[sFrameIndex++], tArrivalMicros });
+        sBytesSent++;
+    }
+    if (sFrameIndex >= sFrame.size()) {
+        sWaitForResponse = true;
+        sResponseTimeoutMillis = millis() + SENDER_TIMEOUT_MILLIS;
+    }
+    return true;
+}
+
+void selfTestShowHandler(const uint8_t *aPixels, uint16_t aNumberOfBytes, int16_t aPin) {
+    (void) aPin;
+    sShowStartMicros = micros();
+    sShowEndMicros = sShowStartMicros + ((unsigned long) aNumberOfBytes * 10) + 50; // Like the show() of HostArduino
+    sBytesReceivedDuringShow = 0;
+    if (sWaitForStart) {
+        return; // The initial show() of the pattern
+    }
+    sNumberOfShownFrames++;
+    if (sFrameIsCorrupted || aNumberOfBytes != sPayload.size() || memcmp(aPixels, sPayload.data(), aNumberOfBytes) != 0) {
+        sNumberOfPayloadErrors++;
+    }
+}
+
+void pseudoTerminalShowHandler(const uint8_t *aPixels, uint16_t aNumberOfBytes, int16_t aPin) {
+    (void) aPin;
+    sNumberOfShownFrames++;
+    if (!sQuiet && (sNumberOfShownFrames % 100) == 0) {
+        printf("%ld frames shown, first pixel bytes=%02X %02X %02X\n", sNumberOfShownFrames, aPixels[0], aPixels[1], aPixels[2]);
+    }
+    (void) aNumberOfBytes;
+}
+
+int runSelfTest(NeoPatterns *aBar) {
+    LoopbackStream tStream;
+    hostShowHandler = &selfTestShowHandler;
+    randomSeed(1);
+    aBar->SerialIngest(&tStream, sTimeoutMillis);
+    unsigned long tStartMillis = millis();
+    while (pollSender() && aBar->ActivePattern == PATTERN_SERIAL_INGEST) {
+        if (sUseUpdateOrRedraw) {
+            if (aBar->updateOrRedraw(DO_NO_REDRAW_IF_NO_UPDATE)) {
+                aBar->show();
+            }
+        } else {
+            aBar->update();
+        }
+        hostAdvanceMicros(sLoopMicros);
+    }
+    unsigned long tMillis = millis() - tStartMillis;
+
+    printf("%ld frames sent in %lu ms at %ld baud, %ld ACK, %ld expected NAK\n", sNumberOfSentFrames, tMillis, sBaudrate, sNumberOfAcks,
+            sNumberOfExpectedNaks);
+    printf("%ld frames shown, %ld payload errors, %ld wrong responses, %ld sender timeouts, %lu lost bytes\n", sNumberOfShownFrames,
+            sNumberOfPayloadErrors, sNumberOfWrongResponses, sNumberOfSenderTimeouts, sNumberOfLostBytes);
+    if (tMillis > 0) {
+        printf("%.1f frames per second, %.0f%% of the baudrate used\n", (sNumberOfSentFrames * 1000.0) / tMillis,
+                (sBytesSent * 10 * 100000.0) / ((double) tMillis * sBaudrate));
+    }
+    bool tOK = (sNumberOfAcks + sNumberOfExpectedNaks == sNumberOfFrames && sNumberOfShownFrames == sNumberOfAcks
+            && sNumberOfPayloadErrors == 0 && sNumberOfLostBytes == 0);
+    printf(tOK ? "OK\n" : "FAILED\n");
+    return tOK ? 0 : 1;
+}
+
+int runPseudoTerminal(NeoPatterns *aBar) {
+    FileDescriptorStream tStream;
+    tStream.FileDescriptor = open(sPseudoTerminalName, O_RDWR | O_NOCTTY);
+    if (tStream.FileDescriptor < 0) {
+        perror(sPseudoTerminalName);
+        return 1;
+    }
+    struct termios tAttributes;
+    if (tcgetattr(tStream.FileDescriptor, &tAttributes) == 0) {
+        cfmakeraw(&tAttributes);
+        tcsetattr(tStream.FileDescriptor, TCSANOW, &tAttributes);
+    }
+    aBar->SerialIngest(&tStream, sTimeoutMillis);
+    hostShowHandler = &pseudoTerminalShowHandler; // After the initial show() of the pattern
+    while (aBar->ActivePattern == PATTERN_SERIAL_INGEST) {
+        aBar->update();
+        // Simulated time runs with the real time
+        usleep(100);
+        hostAdvanceMicros(100);
+    }
+    close(tStream.FileDescriptor);
+    printf("%ld frames shown\n", sNumberOfShownFrames);
+    bool tOK = (sNumberOfShownFrames > 0);
+    printf(tOK ? "OK\n" : "FAILED\n");
+    return tOK ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            sPseudoTerminalName = argv[++i];
+        } else if (strcmp(argv[i], "-s") == 0) {
+            sSelfTest = true;
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            sNumberOfPixels = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            sTimeoutMillis = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            sNumberOfFrames = atol(argv[++i]);
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            sBaudrate = atol(argv[++i]);
+        } else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc) {
+            sErrorPercent = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+            sLoopMicros = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-r") == 0) {
+            sUseUpdateOrRedraw = true;
+        } else if (strcmp(argv[i], "-q") == 0) {
+            sQuiet = true;
+        } else {
+            break;
+        }
+    }
+    if (sSelfTest == (sPseudoTerminalName != nullptr)) {
+        printf("Usage: %s [-p <pseudo terminal> | -s] [-n <pixels>] [-t <timeout ms>] [-f <frames>] [-b <baudrate>] [-e <error percent>] [-l <loop micros>] [-r] [-q]\n",
+                argv[0]);
+        return 2;
+    }
+
+    NeoPatterns tBar(sNumberOfPixels, 6, NEO_GRB + NEO_KHZ800);
+    tBar.begin();
+    if (sSelfTest) {
+        return runSelfTest(&tBar);
+    }
+    return runPseudoTerminal(&tBar);
+}
@@ -0,0 +1,215 @@
+#!/usr/bin/env python3
+#
+# TelemetryViewer.py
+#
+# Decodes the binary telemetry stream of NeoPixelTelemetry and renders the pixels and the frame timing in the terminal.
+# See NeoPixelTelemetry.h for the frame format.
+#
+# Usage:
+#   python3 TelemetryViewer.py --port COM6 --baudrate 500000
+#   python3 TelemetryViewer.py --port /dev/ttyUSB0 --baudrate 500000 --width 8   # 8x8 matrix
+#   python3 TelemetryViewer.py --file telemetry.bin                              # recorded stream
+# The terminal must support 24 bit colors (ANSI escape sequences).
+#
+# Requires pyserial ("pip install pyserial") for serial ports.
+#
+#  Copyright (C) 2026  Armin Joachimsmeyer
+#  armin.joachimsmeyer@gmail.com
+#
+#  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+#
+#  NeoPatterns is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+#  See the GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+#
+
+import argparse
+import struct
+import sys
+
+# Must match the values in NeoPixelTelemetry.h
+NEOPIXEL_TELEMETRY_KEYFRAME = 0x4B
+NEOPIXEL_TELEMETRY_DELTA_FRAME = 0x44
+NEOPIXEL_TELEMETRY_HEADER_SIZE = 16
+
+
+def cobsDecode(aEncoded):
+    """Returns the decoded bytes or None if the encoding is invalid"""
+    tDecoded = bytearray()
+    tIndex = 0
+    while tIndex < len(aEncoded):
+        tCode = aEncoded[tIndex]
+        if tCode == 0 or tIndex + tCode > len(aEncoded):
+            return None
+        tDecoded += aEncoded[tIndex + 1:tIndex + tCode]
+        tIndex += tCode
+        if tCode < 0xFF and tIndex < len(aEncoded):
+            tDecoded.append(0)
+    return bytes(tDecoded)
+
+
+class TelemetryDecoder:
+
+    def __init__(self):
+        self.pixelBytes = None  # None until the first keyframe is received
+        self.lastSequence = None
+        self.numberOfFrames = 0
+        self.numberOfErrors = 0  # Checksum or format errors and lost frames
+        self.numberOfSkippedFrames = 0  # Frames skipped by the device
+        self.numberOfStreamBytes = 0
+
+    def decodeFrame(self, aEncodedFrame):
+        """Returns the header as dictionary or None, if the frame is invalid or cannot be applied"""
+        self.numberOfStreamBytes += len(aEncodedFrame) + 1
+        tFrame = cobsDecode(aEncodedFrame)
+        if tFrame is None or len(tFrame) < NEOPIXEL_TELEMETRY_HEADER_SIZE + 1:
+            self.numberOfErrors += 1
+            return None
+        tChecksum = 0
+        for tByte in tFrame:
+            tChecksum ^= tByte
+        if tChecksum != 0:
+            self.numberOfErrors += 1
+            return None
+
+        (tType, tSequence, tNumberOfPixels, tBytesPerPixel, tBrightness, tMillis, tShowMicros, tSkippedFrames,
+         tEncodeMicros) = struct.unpack_from('<BBHBBLHHH', tFrame)
+        tHeader = {'type': chr(tType), 'sequence': tSequence, 'pixels': tNumberOfPixels, 'bytesPerPixel': tBytesPerPixel,
+                   'brightness': tBrightness, 'millis': tMillis, 'showMicros': tShowMicros, 'skipped': tSkippedFrames,
+                   'encodeMicros': tEncodeMicros, 'length': len(aEncodedFrame) + 1}
+        tBody = tFrame[NEOPIXEL_TELEMETRY_HEADER_SIZE:-1]
+        tNumberOfBytes = tNumberOfPixels * tBytesPerPixel
+
+        if self.lastSequence is not None and tSequence != (self.lastSequence + 1) & 0xFF:
+            self.numberOfErrors += 1
+            self.pixelBytes = None  # A frame was lost, wait for next keyframe
+        self.lastSequence = tSequence
+
+        if tType == NEOPIXEL_TELEMETRY_KEYFRAME:
+            if len(tBody) != tNumberOfBytes:
+                self.numberOfErrors += 1
+                return None
+            self.pixelBytes = bytearray(tBody)
+        elif tType == NEOPIXEL_TELEMETRY_DELTA_FRAME:
+            if self.pixelBytes is None or len(self.pixelBytes) != tNumberOfBytes:
+                return None
+            tIndex = 0
+            tPixelIndex = 0
+            while tIndex + 2 <= len(tBody):
+                tPixelIndex += tBody[tIndex]
+                tChangedBytes = tBody[tIndex + 1] * tBytesPerPixel
+                tStart = tPixelIndex * tBytesPerPixel
+                if tStart + tChangedBytes > tNumberOfBytes:
+                    self.numberOfErrors += 1
+                    self.pixelBytes = None
+                    return None
+                self.pixelBytes[tStart:tStart + tChangedBytes] = tBody[tIndex + 2:tIndex + 2 + tChangedBytes]
+                tPixelIndex += tBody[tIndex + 1]
+                tIndex += 2 + tChangedBytes
+        else:
+            self.numberOfErrors += 1
+            return None
+        self.numberOfFrames += 1
+        self.numberOfSkippedFrames += tSkippedFrames
+        return tHeader
+
+    def getRgbColors(self, aByteOrder):
+        tBytesPerPixel = len(aByteOrder)
+        tColors = []
+        for i in range(0, len(self.pixelBytes) - tBytesPerPixel + 1, tBytesPerPixel):
+            tColor = dict(zip(aByteOrder, self.pixelBytes[i:i + tBytesPerPixel]))
+            tWhite = tColor.get('W', 0)
+            tColors.append((min(255, tColor['R'] + tWhite), min(255, tColor['G'] + tWhite), min(255, tColor['B'] + tWhite)))
+        return tColors
+
+
+def render(aDecoder, aHeader, aByteOrder, aWidth, aFramesPerSecond):
+    tLines = ['\x1b[H']  # Cursor home
+    tColors = aDecoder.getRgbColors(aByteOrder)
+    tWidth = aWidth if aWidth > 0 else len(tColors)
+    for tRowStart in range(0, len(tColors), tWidth):
+        tLine = ''
+        for tRed, tGreen, tBlue in tColors[tRowStart:tRowStart + tWidth]:
+            tLine += '\x1b[48;2;{};{};{}m  '.format(tRed, tGreen, tBlue)
+        tLines.append(tLine + '\x1b[0m\x1b[K')
+    tLines.append('Frame {} {} {} pixels, brightness={}, {:.1f} frames/s, show={} us, encode={} us, skipped={}, {} bytes\x1b[K'.format(
+        aHeader['sequence'], aHeader['type'], aHeader['pixels'], aHeader['brightness'], aFramesPerSecond, aHeader['showMicros'],
+        aHeader['encodeMicros'], aDecoder.numberOfSkippedFrames, aHeader['length']))
+    tLines.append('Frames={} errors={} average stream bytes per frame={:.1f}\x1b[K'.format(
+        aDecoder.numberOfFrames, aDecoder.numberOfErrors, aDecoder.numberOfStreamBytes / max(1, aDecoder.numberOfFrames)))
+    sys.stdout.write('\n'.join(tLines) + '\n')
+    sys.stdout.flush()
+
+
+def main():
+    tParser = argparse.ArgumentParser(description='Renders the telemetry stream of NeoPixelTelemetry')
+    tParser.add_argument('--port', help='Serial port e.g. COM6 or /dev/ttyUSB0')
+    tParser.add_argument('--file', help='File with a recorded telemetry stream, - for stdin')
+    tParser.add_argument('--baudrate', type=int, default=500000)
+    tParser.add_argument('--byteorder', default='GRB', help='Byte order of the pixel type e.g. GRB for NEO_GRB or GRBW')
+    tParser.add_argument('--width', type=int, default=0, help='Pixels per row e.g. 8 for a 8x8 matrix, 0 for one row')
+    tParser.add_argument('--quiet', action='store_true', help='Print only the statistics at the end')
+    tArguments = tParser.parse_args()
+
+    if tArguments.file is not None:
+        tInput = sys.stdin.buffer if tArguments.file == '-' else open(tArguments.file, 'rb')
+        readChunk = lambda: tInput.read(4096)
+    elif tArguments.port is not None:
+        import serial
+        tSerial = serial.Serial(tArguments.port, tArguments.baudrate, timeout=0.1)
+        readChunk = lambda: tSerial.read(max(1, tSerial.in_waiting))
+    else:
+        tParser.error('--port or --file is required')
+
+    if not tArguments.quiet:
+        sys.stdout.write('\x1b[2J')  # Clear screen
+    tDecoder = TelemetryDecoder()
+    tBuffer = bytearray()
+    tFirstMillis = None
+    tFirstFrames = 0
+    tFramesPerSecond = 0.0
+    try:
+        while True:
+            tChunk = readChunk()
+            if tArguments.file is not None and not tChunk:
+                break
+            tBuffer += tChunk
+            while True:
+                tEnd = tBuffer.find(0)
+                if tEnd < 0:
+                    break
+                tEncodedFrame = bytes(tBuffer[:tEnd])
+                del tBuffer[:tEnd + 1]
+                if not tEncodedFrame:
+                    continue
+                tHeader = tDecoder.decodeFrame(tEncodedFrame)
+                if tHeader is None:
+                    continue
+                # Frame rate of the device, including the skipped frames
+                if tFirstMillis is None:
+                    tFirstMillis = tHeader['millis']
+                    tFirstFrames = tDecoder.numberOfFrames + tDecoder.numberOfSkippedFrames
+                elif tHeader['millis'] != tFirstMillis:
+                    tFramesPerSecond = (tDecoder.numberOfFrames + tDecoder.numberOfSkippedFrames - tFirstFrames) * 1000.0 / (
+                            tHeader['millis'] - tFirstMillis)
+                if not tArguments.quiet:
+                    render(tDecoder, tHeader, tArguments.byteorder, tArguments.width, tFramesPerSecond)
+    except KeyboardInterrupt:
+        pass
+    print('Frames={} errors={} skipped by device={} average stream bytes per frame={:.1f}'.format(
+        tDecoder.numberOfFrames, tDecoder.numberOfErrors, tDecoder.numberOfSkippedFrames,
+        tDecoder.numberOfStreamBytes / max(1, tDecoder.numberOfFrames)))
+    return 0 if tDecoder.numberOfErrors == 0 else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
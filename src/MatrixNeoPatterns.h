@@ -31,13 +31,14 @@
  *                                     ,o--> MatrixNeoPixel (virtual) \
  * MatrixSnake --> MatrixNeoPatterns  <                                o--> NeoPixel --> Adafruit_NeoPixel
  *                                     `o--> NeoPatterns    (virtual) /
+ *
+ * With ENABLE_NON_VIRTUAL_INHERITANCE we have a single inheritance chain without virtual base
+ * MatrixSnake --> MatrixNeoPatterns --> MatrixNeoPixel --> NeoPatterns --> NeoPixel --> Adafruit_NeoPixel
  */
 
 #ifndef _MATRIX_NEOPATTERNS_H
 #define _MATRIX_NEOPATTERNS_H
 
-#include "MatrixNeoPixel.h"
-
 #if (!(defined(ENABLE_MATRIX_PATTERN_TICKER) || defined(ENABLE_MATRIX_PATTERN_MOVE) || defined(ENABLE_MATRIX_PATTERN_MOVING_PICTURE) \
 || defined(ENABLE_MATRIX_PATTERN_FIRE) || defined(ENABLE_MATRIX_PATTERN_SNOW) \
 || defined(ENABLE_NO_MATRIX_AND_NEO_PATTERN_BY_DEFAULT) ))
@@ -51,6 +52,7 @@
 #endif
 
 #include "NeoPatterns.h"
+#include "MatrixNeoPixel.h" // must be after #include "NeoPatterns.h" because of ENABLE_NO_NEO_PATTERN_BY_DEFAULT
 
 #define MATRIX_PATTERN_TICKER           (LAST_NEO_PATTERN + 1)
 #define MATRIX_PATTERN_MOVE             (LAST_NEO_PATTERN + 2)
@@ -98,7 +100,11 @@ struct SnowFlakeInfoStruct {
 };
 
 // extension of NeoPattern Class approximately 85 byte / object
+#if defined(ENABLE_NON_VIRTUAL_INHERITANCE)
+class MatrixNeoPatterns: public MatrixNeoPixel { // MatrixNeoPixel is derived from NeoPatterns
+#else
 class MatrixNeoPatterns: public MatrixNeoPixel, public NeoPatterns {
+#endif
 public:
     MatrixNeoPatterns();
     void init();
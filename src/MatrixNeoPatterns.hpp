@@ -55,15 +55,23 @@
 #endif
 
 MatrixNeoPatterns::MatrixNeoPatterns() :  // @suppress("Class members should be properly initialized")
+#if defined(ENABLE_NON_VIRTUAL_INHERITANCE)
+        MatrixNeoPixel() {
+#else
         NeoPixel(), MatrixNeoPixel(), NeoPatterns() {
+#endif
     OnPatternComplete = nullptr;
 }
 
 // Constructor - calls base-class constructor to initialize strip
 MatrixNeoPatterns::MatrixNeoPatterns(uint8_t aColumns, uint8_t aRows, uint8_t aPin, uint8_t aMatrixGeometry, /* @suppress("Class members should be properly initialized") */
 neoPixelType aTypeOfPixel, void (*aPatternCompletionCallback)(NeoPatterns*)) :
+#if defined(ENABLE_NON_VIRTUAL_INHERITANCE)
+        MatrixNeoPixel(aColumns, aRows, aPin, aMatrixGeometry, aTypeOfPixel) {
+#else
         NeoPixel((aColumns * aRows), aPin, aTypeOfPixel), MatrixNeoPixel(aColumns, aRows, aPin, aMatrixGeometry, aTypeOfPixel), NeoPatterns(
                 (aColumns * aRows), aPin, aTypeOfPixel, nullptr) {
+#endif
 
     OnPatternComplete = aPatternCompletionCallback;
 }
@@ -92,8 +100,16 @@ bool MatrixNeoPatterns::update(uint8_t aBrightness) {
     return update();
 }
 bool MatrixNeoPatterns::update() {
-    if ((millis() - lastUpdate) > Interval) {
+    if (ActivePattern <= LAST_NEO_PATTERN || ActivePattern >= PATTERN_EXTENDED_FIRST) {
+        // Non matrix patterns are checked, scheduled and recorded by NeoPatterns::update()
+        return NeoPatterns::update();
+    }
+    if ((long) (getCompensatedMillis() - lastUpdate) > (long) Interval) {
         bool tPatternEnded = true;
+        uint8_t tPatternStartCount = getPatternStartCount();
+#if defined(_RECORD_UPDATE_TIMING)
+        unsigned long tStartMicros = startUpdateStatistics();
+#endif
 
         switch (ActivePattern) {
 #if defined(ENABLE_MATRIX_PATTERN_FIRE)
@@ -122,13 +138,21 @@ bool MatrixNeoPatterns::update() {
             break;
 #endif
         default:
-            NeoPatterns::update();
             break;
         }
+#if defined(_RECORD_UPDATE_TIMING)
+        tStartMicros = addUpdateStatistics(tStartMicros);
         if (!tPatternEnded) {
             show();
+            addShowStatistics(tStartMicros);
         }
-        lastUpdate = millis(); // must be after NeoPatterns::update() otherwise NeoPatterns like delay will not work.
+#else
+        if (!tPatternEnded) {
+            show();
+        }
+#endif
+        // Do not schedule a pattern, which was started by the completion callback
+        scheduleNextUpdate(tPatternStartCount);
         return true;
     }
     return false;
@@ -632,6 +656,8 @@ if (LayoutMappingFunction != nullptr) {
 #  if defined(WARN)
     Serial.print(F("moveArrayContent with one parameter does not support other than Z type mappings."));
 #  endif
+} else if (!_HAS_PIXEL_BUFFER) {
+    moveArrayContent(aDirection, COLOR32_BLACK); // Indexed pixel buffer, move by setMatrixPixelColor()
 } else
 #  endif
 {
@@ -679,7 +705,7 @@ if (LayoutMappingFunction != nullptr) {
  */
 void MatrixNeoPatterns::moveArrayContent(uint8_t aDirection, color32_t aBackgroundColor) {
 #if !defined(SUPPORT_ONLY_DEFAULT_GEOMETRY)
-if (Geometry == NEO_MATRIX_DEFAULT_GEOMETRY) {
+if (Geometry == NEO_MATRIX_DEFAULT_GEOMETRY && _HAS_PIXEL_BUFFER) {
 #endif
     /*
      * Use fast memmove() function here
@@ -995,6 +1021,9 @@ if (Direction != DIRECTION_NONE) {
         if (isLastChar) {
             show(); // show last vanished character and its padding
             if (OnPatternComplete != nullptr) {
+#if defined(ENABLE_NEOPATTERNS_STATISTICS)
+                Statistics.CompletionCallbackCount++;
+#endif
                 OnPatternComplete(this); // call the completion callback
             } else {
                 ActivePattern = PATTERN_NONE; // reset ActivePattern to enable polling for end of pattern.
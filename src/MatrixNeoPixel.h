@@ -32,12 +32,17 @@
  * MatrixSnake --> MatrixNeoPatterns  <                                o--> NeoPixel --> Adafruit_NeoPixel
  *                                     `o--> NeoPatterns    (virtual) /
  *
+ * With ENABLE_NON_VIRTUAL_INHERITANCE we have a single inheritance chain without virtual base
+ * MatrixSnake --> MatrixNeoPatterns --> MatrixNeoPixel --> NeoPatterns --> NeoPixel --> Adafruit_NeoPixel
  */
 
 #ifndef SRC_LIB_NEOPATTERNS_MATRIXNEOPIXEL_H_
 #define SRC_LIB_NEOPATTERNS_MATRIXNEOPIXEL_H_
 
 #include "NeoPixel.h"
+#if defined(ENABLE_NON_VIRTUAL_INHERITANCE)
+#include "NeoPatterns.h" // MatrixNeoPixel is derived from NeoPatterns
+#endif
 
 /*
  * If you have only default geometry (NEO_MATRIX_BOTTOM | NEO_MATRIX_RIGHT | NEO_MATRIX_ROWS | NEO_MATRIX_PROGRESSIVE),
@@ -46,6 +51,9 @@
  * This saves 560 bytes program memory and 3 bytes RAM.
  */
 //#define SUPPORT_ONLY_DEFAULT_GEOMETRY
+#if defined(SUPPORT_ONLY_DEFAULT_GEOMETRY) && defined(ENABLE_INDEXED_PIXEL_BUFFER)
+#error The matrix patterns require the generic geometry code for ENABLE_INDEXED_PIXEL_BUFFER, i.e. SUPPORT_ONLY_DEFAULT_GEOMETRY must not be defined.
+#endif
 //
 /*
  * Defines from Adafruit_NeoMatrix.h
@@ -82,7 +90,11 @@
 #define DO_PADDING          true
 #define DO_NO_PADDING       false
 
+#if defined(ENABLE_NON_VIRTUAL_INHERITANCE)
+class MatrixNeoPixel: public NeoPatterns {
+#else
 class MatrixNeoPixel: public virtual NeoPixel {
+#endif
 public:
     MatrixNeoPixel();
     void init();
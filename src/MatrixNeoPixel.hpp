@@ -31,7 +31,11 @@
 
 #include "MatrixNeoPixel.h"
 // include sources
+#if defined(ENABLE_NON_VIRTUAL_INHERITANCE)
+#include "NeoPatterns.hpp"
+#else
 #include "NeoPixel.hpp"
+#endif
 
 // This block must be located after the includes of other *.hpp files
 //#define LOCAL_DEBUG // This enables debug output only for this file - only for development
@@ -42,7 +46,11 @@
 const uint8_t heart8x8[] PROGMEM = { 0x66, 0xFF, 0xFF, 0xFF, 0x7E, 0x3C, 0x18, 0x00 };
 
 MatrixNeoPixel::MatrixNeoPixel() :
+#if defined(ENABLE_NON_VIRTUAL_INHERITANCE)
+        NeoPatterns() {
+#else
         NeoPixel() {
+#endif
 
     init();
 }
@@ -57,7 +65,11 @@ void MatrixNeoPixel::init() {
 }
 
 MatrixNeoPixel::MatrixNeoPixel(uint8_t aColumns, uint8_t aRows, uint8_t aPin, uint8_t aMatrixGeometry, uint8_t aTypeOfPixel) : // @suppress("Class members should be properly initialized")
+#if defined(ENABLE_NON_VIRTUAL_INHERITANCE)
+        NeoPatterns(aColumns * aRows, aPin, aTypeOfPixel) {
+#else
         NeoPixel(aColumns * aRows, aPin, aTypeOfPixel) {
+#endif
 
     Rows = aRows;
     Columns = aColumns;
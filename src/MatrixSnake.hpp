@@ -50,14 +50,22 @@ EEMEM uint16_t HighScoreEEPROM; // is reset if both right and left button are pr
 #endif
 
 MatrixSnake::MatrixSnake() : // @suppress("Class members should be properly initialized")
+#if defined(ENABLE_NON_VIRTUAL_INHERITANCE)
+        MatrixNeoPatterns() {
+#else
         NeoPixel(), MatrixNeoPatterns() {
+#endif
 }
 
 // Constructor - calls base-class constructor to initialize strip
 MatrixSnake::MatrixSnake(uint8_t aColumns, uint8_t aRows, uint8_t aPin, uint8_t aMatrixGeometry, uint8_t aTypeOfPixel, // @suppress("Class members should be properly initialized")
         void (*aPatternCompletionCallback)(NeoPatterns*)) :
+#if defined(ENABLE_NON_VIRTUAL_INHERITANCE)
+        MatrixNeoPatterns(aColumns, aRows, aPin, aMatrixGeometry, aTypeOfPixel, aPatternCompletionCallback) {
+#else
         NeoPixel(aColumns * aRows, aPin, aTypeOfPixel), MatrixNeoPatterns(aColumns, aRows, aPin, aMatrixGeometry, aTypeOfPixel,
                 aPatternCompletionCallback) {
+#endif
 }
 
 bool MatrixSnake::init(uint8_t aColumns, uint8_t aRows, uint8_t aPin, uint8_t aMatrixGeometry, uint8_t aTypeOfPixel,
@@ -86,12 +94,21 @@ bool MatrixSnake::update() {
         SnakeInputHandler();
     }
 
-    if ((millis() - lastUpdate) > Interval) {
+    if ((long) (getCompensatedMillis() - lastUpdate) > (long) Interval) {
         // time to update
         if (ActivePattern == SPECIAL_PATTERN_SNAKE) {
+            uint8_t tPatternStartCount = getPatternStartCount();
+#if defined(_RECORD_UPDATE_TIMING)
+            unsigned long tStartMicros = startUpdateStatistics();
+            SnakeUpdate();
+            tStartMicros = addUpdateStatistics(tStartMicros);
+            show();
+            addShowStatistics(tStartMicros);
+#else
             SnakeUpdate();
             show();
-            lastUpdate = millis(); // remember last time of update. Only required for snake here :-)
+#endif
+            scheduleNextUpdate(tPatternStartCount); // Only required for snake here :-) Skipped, if the completion callback started a new game
         } else {
             MatrixNeoPatterns::update();
         }
@@ -121,13 +138,14 @@ bool MatrixSnake::updateOrRedraw(bool aDoRedrawIfNoUpdate) {
         SnakeInputHandler();
     }
 
-    bool tDoUpdate = (millis() - lastUpdate) > Interval;
+    bool tDoUpdate = (long) (getCompensatedMillis() - lastUpdate) > (long) Interval;
     if (tDoUpdate || aDoRedrawIfNoUpdate) {
         if (ActivePattern == SPECIAL_PATTERN_SNAKE) {
+            uint8_t tPatternStartCount = getPatternStartCount();
             SnakeUpdate(tDoUpdate);
             show();
             if (tDoUpdate) {
-                lastUpdate = millis(); // remember last time of update. Only required for snake here :-)
+                scheduleNextUpdate(tPatternStartCount); // Only required for snake here :-) Skipped, if the completion callback started a new game
             }
         } else {
             MatrixNeoPatterns::update(); // no redraw available for matrix patterns
@@ -636,6 +654,9 @@ void MatrixSnake::SnakeUpdate(bool aDoUpdate) {
                 free(SnakePixelList);
                 SnakePixelList = nullptr;
                 ActivePattern = PATTERN_NONE; // reset ActivePattern to enable polling for end of pattern.
+#if defined(ENABLE_NEOPATTERNS_STATISTICS)
+                Statistics.CompletionCallbackCount++;
+#endif
                 OnPatternComplete(this); // call the completion callback, which is set e.g. to SnakeAutorunCompleteHandler for snake autorun
             }
         }
@@ -1097,6 +1118,9 @@ void MatrixAndSnakePatternsDemoHandler(NeoPatterns *aLedsPtr) {
         sState++;
         return;
     }
+#if defined(ENABLE_CROSSFADE_TRANSITION)
+    aLedsPtr->startCrossfade(); // Fade from the last frame of the old pattern to the new one
+#endif
 
     uint8_t tState = sState / 2;
     uint8_t tYOffset;
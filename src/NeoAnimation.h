@@ -0,0 +1,181 @@
+/*
+ * NeoAnimation.h
+ *
+ *  SUMMARY
+ *  Compact format for pre-rendered animations with palette, keyframes and delta frames,
+ *  and a decoder, which reads the animation sequentially from PROGMEM, RAM, a memory mapped file or a Stream
+ *  and decodes it frame by frame into the pixel buffer of a NeoPixel object.
+ *  Used by the PlayAnimation pattern of NeoPatterns.
+ *  With ENABLE_ANIMATION_RECORDER, NeoAnimationRecorder records all frames shown by a NeoPixel object in this format.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+/*
+ * Usage:
+ * #define ENABLE_PATTERN_PLAY_ANIMATION
+ * #include "NeoPatterns.hpp"
+ * const uint8_t FireAnimation[] PROGMEM = { 'N', 'A', 1, ... };
+ * NeoAnimation Animation;
+ * ...
+ * Animation.beginPGM(FireAnimation);
+ * Bar16.PlayAnimation(&Animation, 0); // 0 = endless
+ *
+ * Animation format, all 16 bit values are little endian:
+ * Offset Size  Content
+ *  0      2    'N', 'A'
+ *  2      1    Format version NEO_ANIMATION_FORMAT_VERSION
+ *  3      1    Flags, NEO_ANIMATION_FLAG_RGBW if palette colors have 4 bytes
+ *  4      2    Number of pixels of a frame
+ *  6      2    Number of frames, up to 32767
+ *  8      2    Frame interval in milliseconds
+ * 10      1    Number of palette colors - 1
+ * 11   3 or 4  Palette colors as R, G, B or R, G, B, W
+ * ...          Frames
+ *
+ * Each frame starts with NEO_ANIMATION_KEYFRAME or NEO_ANIMATION_DELTA_FRAME, followed by commands
+ * and ends with NEO_ANIMATION_END_OF_FRAME. Each command starts at the current pixel, which is 0 at frame start.
+ * 0x01 to 0x3F: Skip 1 to 63 pixels, they keep the color of the last frame.
+ * 0x40 to 0x7F: Literal. The next 1 to 64 bytes are the palette indexes of the next 1 to 64 pixels.
+ * 0x80 to 0xFF: Run. The next byte is the palette index of the next 1 to 128 pixels.
+ * A keyframe clears all pixels before decoding, so skipped pixels are black and the keyframe does not depend on the last frame.
+ * The first frame must be a keyframe.
+ */
+
+#ifndef _NEO_ANIMATION_H
+#define _NEO_ANIMATION_H
+
+#include "NeoPixel.h"
+
+#define NEO_ANIMATION_FORMAT_VERSION    1
+#define NEO_ANIMATION_HEADER_SIZE       11
+
+#define NEO_ANIMATION_FLAG_RGBW         0x01 // Palette colors have 4 bytes
+#define NEO_ANIMATION_FLAG_DATA_IN_PGM  0x80 // Internal flag of NeoAnimation::Flags, not part of the format
+
+#define NEO_ANIMATION_KEYFRAME          0x4B // 'K'
+#define NEO_ANIMATION_DELTA_FRAME       0x44 // 'D'
+
+#define NEO_ANIMATION_END_OF_FRAME      0x00
+#define NEO_ANIMATION_SKIP              0x00 // + 1 to 63 pixels
+#define NEO_ANIMATION_LITERAL           0x40 // + 0 to 63 for 1 to 64 pixels
+#define NEO_ANIMATION_RUN               0x80 // + 0 to 127 for 1 to 128 pixels
+#define NEO_ANIMATION_MAX_SKIP          0x3F
+#define NEO_ANIMATION_MAX_LITERAL       0x40
+#define NEO_ANIMATION_MAX_RUN           0x80
+
+#define NEO_ANIMATION_CACHED_BLACK      0xFF // Palette index in FrameIndexes for pixels cleared by a keyframe, only used with less than 256 palette colors
+
+/*
+ * SIZE = 27 bytes on AVR
+ * The palette indexes of the current frame are cached in NumberOfPixels bytes of heap for redrawFrame(), if available.
+ */
+class NeoAnimation {
+public:
+    NeoAnimation();
+    bool begin(const uint8_t *aAnimationData);
+    bool beginPGM(const uint8_t *aAnimationDataPGM);
+    bool begin(Stream *aAnimationStream);
+    void end();
+
+    bool rewind();
+    bool decodeNextFrame(NeoPixel *aNeoPixel);
+    void redrawFrame(NeoPixel *aNeoPixel);
+    void setCachedPixel(uint16_t aPixelIndex, uint8_t aPaletteIndex);
+    color32_t getPaletteColor(uint8_t aPaletteIndex);
+    void printInfo(Print *aSerial);
+
+    uint8_t readByte();
+    uint8_t readMemoryByte(const uint8_t *aDataPtr);
+    uint16_t readWord();
+    bool readHeader();
+
+    const uint8_t *DataPtr;         // Next byte to read, if data is in memory
+    const uint8_t *PalettePtr;      // Palette of data in memory
+    const uint8_t *FirstFramePtr;   // For rewind()
+    const uint8_t *KeyframePtr;     // Start of the last decoded keyframe, for redrawFrame() without FrameIndexes
+    Stream *DataStream;             // nullptr if data is in memory
+    uint8_t *FrameIndexes;          // Palette indexes of the current frame for redrawFrame(), nullptr if not available
+    color32_t *PaletteColors;       // Palette of stream data, allocated by begin(Stream*)
+    uint16_t NumberOfPixels;
+    uint16_t NumberOfFrames;
+    uint16_t FrameIntervalMillis;
+    uint16_t NumberOfPaletteColors;
+    uint16_t FrameIndex;            // Index of the next frame to decode
+    uint16_t KeyframeIndex;         // Index of the frame at KeyframePtr
+    uint8_t Flags;
+};
+
+#if defined(ENABLE_ANIMATION_RECORDER)
+/*
+ * Records all frames shown by one NeoPixel object into the animation format, e.g. to pre-render expensive patterns.
+ * Usage:
+ * NeoAnimationRecorder Recorder;
+ * Recorder.begin(&Bar16, 30, 32);  // 30 ms frame interval, keyframe every 32 frames
+ * ... run patterns, each show() of Bar16 records a frame ...
+ * Recorder.end();
+ * Recorder.printStatistics(&Serial, &Bar16);
+ * Recorder.printCHeader(&Serial, "FireAnimation");
+ *
+ * The shown pixel buffer content is recorded, i.e. with Brightness applied, so play it with maximum brightness.
+ * If a frame has more colors than the palette, the nearest palette color is recorded.
+ */
+class NeoAnimationRecorder: public NeoPixelShowHook {
+public:
+    NeoAnimationRecorder();
+    bool begin(NeoPixel *aNeoPixel, uint16_t aFrameIntervalMillis, uint16_t aKeyframeInterval = 0,
+            uint16_t aMaximumNumberOfPaletteColors = 256);
+    bool end();
+    void freeAnimationData();
+
+    static void recordShownFrame(NeoPixelShowHook *aShowHook, NeoPixel *aNeoPixel);
+    bool recordFrame();
+    uint8_t getPaletteIndex(color32_t aColor);
+    bool encodeFrame(bool aIsKeyframe);
+    bool appendByte(uint8_t aByte);
+
+    uint32_t getAnimationSize();
+    uint32_t getRawSize();
+    void writeAnimation(Print *aOutput);
+    void printCHeader(Print *aOutput, const char *aArrayName);
+    void printStatistics(Print *aOutput, NeoPixel *aDecodeNeoPixel = nullptr);
+
+    NeoPixel *RecordedNeoPixel;
+    uint8_t *LastFrameIndexes;      // Palette indexes of the last recorded frame
+    uint8_t *FrameIndexes;          // Palette indexes of the current frame
+    color32_t *PaletteColors;       // Entry 0 is black
+    uint8_t *AnimationData;         // Frames during recording, the complete animation after end()
+    uint32_t AnimationDataSize;
+    uint32_t AnimationDataCapacity;
+    uint32_t NumberOfNearestColorPixels; // Pixels, which got the nearest palette color
+    uint16_t NumberOfPixels;
+    uint16_t NumberOfFrames;
+    uint16_t FrameIntervalMillis;
+    uint16_t KeyframeInterval;      // 0 = only the first frame is a keyframe
+    uint16_t NumberOfPaletteColors;
+    uint16_t MaximumNumberOfPaletteColors;
+    uint8_t LastPaletteIndex;       // Cache for getPaletteIndex()
+    bool IsOutOfMemory;
+};
+#endif
+
+#endif // _NEO_ANIMATION_H
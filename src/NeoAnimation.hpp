@@ -0,0 +1,705 @@
+/*
+ * NeoAnimation.hpp
+ *
+ *  SUMMARY
+ *  Compact format for pre-rendered animations with palette, keyframes and delta frames,
+ *  and a decoder, which reads the animation sequentially from PROGMEM, RAM, a memory mapped file or a Stream
+ *  and decodes it frame by frame into the pixel buffer of a NeoPixel object.
+ *  Used by the PlayAnimation pattern of NeoPatterns.
+ *  With ENABLE_ANIMATION_RECORDER, NeoAnimationRecorder records all frames shown by a NeoPixel object in this format.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _NEO_ANIMATION_HPP
+#define _NEO_ANIMATION_HPP
+
+#include <Arduino.h>
+
+#include "NeoAnimation.h"
+
+// include sources
+#include "NeoPixel.hpp"
+
+// This block must be located after the includes of other *.hpp files
+//#define LOCAL_INFO  // This enables info output only for this file
+//#define LOCAL_DEBUG // This enables debug output only for this file - only for development
+#include "LocalDebugLevelStart.h"
+
+NeoAnimation::NeoAnimation() { // @suppress("Class members should be properly initialized")
+    DataStream = nullptr;
+    PaletteColors = nullptr;
+    FrameIndexes = nullptr;
+    NumberOfFrames = 0;
+}
+
+/*
+ * For animation data in RAM or in a memory mapped file
+ * @return false if header is invalid
+ */
+bool NeoAnimation::begin(const uint8_t *aAnimationData) {
+    end();
+    DataPtr = aAnimationData;
+    Flags = 0;
+    return readHeader();
+}
+
+/*
+ * For animation data in PROGMEM. On non AVR platforms, this is the same as begin().
+ * @return false if header is invalid
+ */
+bool NeoAnimation::beginPGM(const uint8_t *aAnimationDataPGM) {
+    end();
+    DataPtr = aAnimationDataPGM;
+    Flags = NEO_ANIMATION_FLAG_DATA_IN_PGM;
+    return readHeader();
+}
+
+/*
+ * For animation data read from a stream, e.g. a file. The palette is copied to an allocated array.
+ * A stream cannot be rewound, so the animation can be played only once.
+ * To repeat it, set the stream to the start of the animation, e.g. by File.seek(0), and call begin() again.
+ * @return false if header is invalid or not enough memory is available for the palette
+ */
+bool NeoAnimation::begin(Stream *aAnimationStream) {
+    end();
+    DataStream = aAnimationStream;
+    DataPtr = nullptr;
+    Flags = 0;
+    return readHeader();
+}
+
+/*
+ * Frees the palette of stream data and the cache of the current frame
+ */
+void NeoAnimation::end() {
+    free(PaletteColors);
+    PaletteColors = nullptr;
+    free(FrameIndexes);
+    FrameIndexes = nullptr;
+    DataStream = nullptr;
+    NumberOfFrames = 0;
+}
+
+uint8_t NeoAnimation::readMemoryByte(const uint8_t *aDataPtr) {
+#if defined(__AVR__)
+    if (Flags & NEO_ANIMATION_FLAG_DATA_IN_PGM) {
+        return pgm_read_byte(aDataPtr);
+    }
+#endif
+    return *aDataPtr;
+}
+
+/*
+ * A failed read of a stream returns NEO_ANIMATION_END_OF_FRAME, so a truncated frame ends the frame
+ */
+uint8_t NeoAnimation::readByte() {
+    if (DataStream != nullptr) {
+        int tByte = DataStream->read();
+        if (tByte < 0) {
+            return NEO_ANIMATION_END_OF_FRAME;
+        }
+        return tByte;
+    }
+    return readMemoryByte(DataPtr++);
+}
+
+uint16_t NeoAnimation::readWord() {
+    uint8_t tLowByte = readByte();
+    return tLowByte | (readByte() << 8);
+}
+
+/*
+ * Reads header and palette and positions the data at the first frame
+ * @return false if header is invalid
+ */
+bool NeoAnimation::readHeader() {
+    if (readByte() != 'N' || readByte() != 'A' || readByte() != NEO_ANIMATION_FORMAT_VERSION) {
+        NumberOfFrames = 0;
+        return false;
+    }
+    Flags |= readByte() & NEO_ANIMATION_FLAG_RGBW;
+    NumberOfPixels = readWord();
+    NumberOfFrames = readWord();
+    FrameIntervalMillis = readWord();
+    NumberOfPaletteColors = readByte() + 1;
+    uint8_t tBytesPerPaletteColor = (Flags & NEO_ANIMATION_FLAG_RGBW) ? 4 : 3;
+
+    if (DataStream != nullptr) {
+        PaletteColors = (color32_t*) malloc(NumberOfPaletteColors * sizeof(color32_t));
+        if (PaletteColors == nullptr) {
+            NumberOfFrames = 0;
+            return false;
+        }
+        for (uint_fast16_t i = 0; i < NumberOfPaletteColors; ++i) {
+            uint8_t tRed = readByte();
+            uint8_t tGreen = readByte();
+            uint8_t tBlue = readByte();
+            uint8_t tWhite = 0;
+            if (tBytesPerPaletteColor == 4) {
+                tWhite = readByte();
+            }
+            PaletteColors[i] = COLOR32_W(tRed, tGreen, tBlue, tWhite);
+        }
+    } else {
+        PalettePtr = DataPtr;
+        DataPtr += NumberOfPaletteColors * tBytesPerPaletteColor;
+        FirstFramePtr = DataPtr;
+        KeyframePtr = DataPtr;
+    }
+    FrameIndex = 0;
+    KeyframeIndex = 0;
+
+    /*
+     * Cache for redrawFrame(). With 256 palette colors, there is no free index for NEO_ANIMATION_CACHED_BLACK,
+     * then redrawFrame() decodes again from the last keyframe.
+     */
+    if (NumberOfPaletteColors < 256) {
+        FrameIndexes = (uint8_t*) malloc(NumberOfPixels);
+        if (FrameIndexes != nullptr) {
+            memset(FrameIndexes, NEO_ANIMATION_CACHED_BLACK, NumberOfPixels);
+        }
+    }
+
+#if defined(LOCAL_INFO)
+    printInfo(&Serial);
+#endif
+    return NumberOfFrames != 0;
+}
+
+/*
+ * Positions the data at the first frame
+ * @return false for stream data
+ */
+bool NeoAnimation::rewind() {
+    if (DataStream != nullptr) {
+        return false;
+    }
+    DataPtr = FirstFramePtr;
+    KeyframePtr = FirstFramePtr;
+    FrameIndex = 0;
+    KeyframeIndex = 0;
+    return NumberOfFrames != 0;
+}
+
+color32_t NeoAnimation::getPaletteColor(uint8_t aPaletteIndex) {
+    if (aPaletteIndex >= NumberOfPaletteColors) {
+        return COLOR32_BLACK;
+    }
+    if (DataStream != nullptr) {
+        return PaletteColors[aPaletteIndex];
+    }
+    if (Flags & NEO_ANIMATION_FLAG_RGBW) {
+        const uint8_t *tColorPtr = PalettePtr + (aPaletteIndex * 4);
+        return COLOR32_W(readMemoryByte(tColorPtr), readMemoryByte(tColorPtr + 1), readMemoryByte(tColorPtr + 2),
+                readMemoryByte(tColorPtr + 3));
+    }
+    const uint8_t *tColorPtr = PalettePtr + (aPaletteIndex * 3);
+    return COLOR32(readMemoryByte(tColorPtr), readMemoryByte(tColorPtr + 1), readMemoryByte(tColorPtr + 2));
+}
+
+/*
+ * Decodes the next frame into the pixel buffer. Does not call show().
+ * Pixels of the animation, which exceed the length of aNeoPixel are skipped.
+ * @return false if all frames are decoded or the frame type is invalid
+ */
+bool NeoAnimation::decodeNextFrame(NeoPixel *aNeoPixel) {
+    if (FrameIndex >= NumberOfFrames) {
+        return false;
+    }
+    const uint8_t *tFramePtr = DataPtr;
+    uint8_t tFrameType = readByte();
+    if (tFrameType == NEO_ANIMATION_KEYFRAME) {
+        KeyframePtr = tFramePtr;
+        KeyframeIndex = FrameIndex;
+        aNeoPixel->clear();
+        if (FrameIndexes != nullptr) {
+            memset(FrameIndexes, NEO_ANIMATION_CACHED_BLACK, NumberOfPixels);
+        }
+    } else if (tFrameType != NEO_ANIMATION_DELTA_FRAME) {
+#if defined(LOCAL_INFO)
+        Serial.print(F("Invalid frame type 0x"));
+        Serial.print(tFrameType, HEX);
+        Serial.print(F(" at frame "));
+        Serial.println(FrameIndex);
+#endif
+        FrameIndex = NumberOfFrames;
+        return false;
+    }
+
+    uint16_t tNumberOfPixels = aNeoPixel->numPixels();
+    uint16_t tPixelIndex = 0;
+    while (true) {
+        uint8_t tCommand = readByte();
+        if (tCommand == NEO_ANIMATION_END_OF_FRAME) {
+            break;
+        }
+        if (tCommand < NEO_ANIMATION_LITERAL) {
+            tPixelIndex += tCommand;
+        } else if (tCommand < NEO_ANIMATION_RUN) {
+            // Literal, one palette index per pixel
+            for (uint_fast8_t i = tCommand - (NEO_ANIMATION_LITERAL - 1); i > 0; --i) {
+                uint8_t tPaletteIndex = readByte();
+                color32_t tColor = getPaletteColor(tPaletteIndex);
+                if (tPixelIndex < tNumberOfPixels) {
+                    aNeoPixel->setPixelColor(tPixelIndex, tColor);
+                }
+                setCachedPixel(tPixelIndex, tPaletteIndex);
+                tPixelIndex++;
+            }
+        } else {
+            // Run of one palette index
+            uint8_t tPaletteIndex = readByte();
+            color32_t tColor = getPaletteColor(tPaletteIndex);
+            for (uint_fast8_t i = tCommand - (NEO_ANIMATION_RUN - 1); i > 0; --i) {
+                if (tPixelIndex < tNumberOfPixels) {
+                    aNeoPixel->setPixelColor(tPixelIndex, tColor);
+                }
+                setCachedPixel(tPixelIndex, tPaletteIndex);
+                tPixelIndex++;
+            }
+        }
+    }
+    FrameIndex++;
+    return true;
+}
+
+void NeoAnimation::setCachedPixel(uint16_t aPixelIndex, uint8_t aPaletteIndex) {
+    if (FrameIndexes != nullptr && aPixelIndex < NumberOfPixels) {
+        FrameIndexes[aPixelIndex] = aPaletteIndex;
+    }
+}
+
+/*
+ * Draws the last decoded frame again, e.g. after a brightness change.
+ * The frame is drawn from the cached palette indexes, so the cost depends only on the number of pixels.
+ * Without cache, all frames from the last keyframe are decoded for data in memory, so the cost depends on the keyframe distance,
+ * and for stream data, the pixel buffer is left unchanged.
+ */
+void NeoAnimation::redrawFrame(NeoPixel *aNeoPixel) {
+    if (FrameIndex == 0) {
+        return;
+    }
+    if (FrameIndexes != nullptr) {
+        uint16_t tNumberOfPixels = aNeoPixel->numPixels();
+        if (tNumberOfPixels > NumberOfPixels) {
+            // Pixels exceeding the animation are cleared by keyframes
+            aNeoPixel->clear();
+            tNumberOfPixels = NumberOfPixels;
+        }
+        for (uint_fast16_t i = 0; i < tNumberOfPixels; ++i) {
+            aNeoPixel->setPixelColor(i, getPaletteColor(FrameIndexes[i]));
+        }
+        return;
+    }
+    if (DataStream != nullptr) {
+        return;
+    }
+    uint16_t tFrameIndex = FrameIndex;
+    DataPtr = KeyframePtr;
+    FrameIndex = KeyframeIndex;
+    while (FrameIndex < tFrameIndex) {
+        decodeNextFrame(aNeoPixel);
+    }
+}
+
+void NeoAnimation::printInfo(Print *aSerial) {
+    aSerial->print(F("Animation with "));
+    aSerial->print(NumberOfFrames);
+    aSerial->print(F(" frames of "));
+    aSerial->print(NumberOfPixels);
+    aSerial->print(F(" pixels, interval="));
+    aSerial->print(FrameIntervalMillis);
+    aSerial->print(F(" ms, palette colors="));
+    aSerial->println(NumberOfPaletteColors);
+}
+
+#if defined(ENABLE_ANIMATION_RECORDER)
+NeoAnimationRecorder::NeoAnimationRecorder() { // @suppress("Class members should be properly initialized")
+    LastFrameIndexes = nullptr;
+    FrameIndexes = nullptr;
+    PaletteColors = nullptr;
+    AnimationData = nullptr;
+    AnimationDataSize = 0;
+    NumberOfFrames = 0;
+}
+
+/*
+ * Starts recording of all frames shown by aNeoPixel. Each recorder is a show hook, so multiple recorders can be active.
+ * @param aNeoPixel - Must not be a partial NeoPixel object. Frames shown by its partial objects are recorded too.
+ * @param aFrameIntervalMillis - Stored in the animation header as frame interval for playback
+ * @param aKeyframeInterval - Every aKeyframeInterval frame is a keyframe. 0 = only the first frame is a keyframe.
+ *                            Keyframes enlarge the animation, but reduce the cost of redrawFrame().
+ * @param aMaximumNumberOfPaletteColors - 2 to 256. Requires 4 bytes heap per color during recording.
+ * @return false if not enough memory is available
+ */
+bool NeoAnimationRecorder::begin(NeoPixel *aNeoPixel, uint16_t aFrameIntervalMillis, uint16_t aKeyframeInterval,
+        uint16_t aMaximumNumberOfPaletteColors) {
+    freeAnimationData();
+    aMaximumNumberOfPaletteColors = constrain(aMaximumNumberOfPaletteColors, 2, 256);
+    NumberOfPixels = aNeoPixel->numPixels();
+    LastFrameIndexes = (uint8_t*) malloc(NumberOfPixels);
+    FrameIndexes = (uint8_t*) malloc(NumberOfPixels);
+    PaletteColors = (color32_t*) malloc(aMaximumNumberOfPaletteColors * sizeof(color32_t));
+    if (LastFrameIndexes == nullptr || FrameIndexes == nullptr || PaletteColors == nullptr) {
+        freeAnimationData();
+        return false;
+    }
+    memset(LastFrameIndexes, 0, NumberOfPixels);
+    PaletteColors[0] = COLOR32_BLACK;
+    NumberOfPaletteColors = 1;
+    MaximumNumberOfPaletteColors = aMaximumNumberOfPaletteColors;
+    LastPaletteIndex = 0;
+
+    RecordedNeoPixel = aNeoPixel;
+    FrameIntervalMillis = aFrameIntervalMillis;
+    KeyframeInterval = aKeyframeInterval;
+    NumberOfNearestColorPixels = 0;
+    IsOutOfMemory = false;
+
+    NeoPixel::addShowHook(this, &recordShownFrame);
+    return true;
+}
+
+/*
+ * Stops recording and assembles the complete animation in AnimationData.
+ * @return false if no frame was recorded or not enough memory is available
+ */
+bool NeoAnimationRecorder::end() {
+    NeoPixel::removeShowHook(this);
+    free(LastFrameIndexes);
+    LastFrameIndexes = nullptr;
+    free(FrameIndexes);
+    FrameIndexes = nullptr;
+    if (NumberOfFrames == 0 || PaletteColors == nullptr) {
+        return false;
+    }
+
+    /*
+     * Insert header and palette in front of the frames
+     */
+    bool tIsRGBW = RecordedNeoPixel->getBytesPerPixel() == 4;
+    uint16_t tHeaderSize = NEO_ANIMATION_HEADER_SIZE + (NumberOfPaletteColors * (tIsRGBW ? 4 : 3));
+    uint8_t *tAnimationData = (uint8_t*) realloc(AnimationData, AnimationDataSize + tHeaderSize);
+    if (tAnimationData == nullptr) {
+        IsOutOfMemory = true;
+        return false;
+    }
+    memmove(tAnimationData + tHeaderSize, tAnimationData, AnimationDataSize);
+    AnimationData = tAnimationData;
+    AnimationDataSize += tHeaderSize;
+    AnimationDataCapacity = AnimationDataSize;
+
+    *tAnimationData++ = 'N';
+    *tAnimationData++ = 'A';
+    *tAnimationData++ = NEO_ANIMATION_FORMAT_VERSION;
+    *tAnimationData++ = tIsRGBW ? NEO_ANIMATION_FLAG_RGBW : 0;
+    *tAnimationData++ = NumberOfPixels;
+    *tAnimationData++ = NumberOfPixels >> 8;
+    *tAnimationData++ = NumberOfFrames;
+    *tAnimationData++ = NumberOfFrames >> 8;
+    *tAnimationData++ = FrameIntervalMillis;
+    *tAnimationData++ = FrameIntervalMillis >> 8;
+    *tAnimationData++ = NumberOfPaletteColors - 1;
+    for (uint_fast16_t i = 0; i < NumberOfPaletteColors; ++i) {
+        color32_t tColor = PaletteColors[i];
+        *tAnimationData++ = getRedPart(tColor);
+        *tAnimationData++ = getGreenPart(tColor);
+        *tAnimationData++ = getBluePart(tColor);
+        if (tIsRGBW) {
+            *tAnimationData++ = getWhitePart(tColor);
+        }
+    }
+    free(PaletteColors);
+    PaletteColors = nullptr;
+    return true;
+}
+
+void NeoAnimationRecorder::freeAnimationData() {
+    NeoPixel::removeShowHook(this);
+    free(LastFrameIndexes);
+    LastFrameIndexes = nullptr;
+    free(FrameIndexes);
+    FrameIndexes = nullptr;
+    free(PaletteColors);
+    PaletteColors = nullptr;
+    free(AnimationData);
+    AnimationData = nullptr;
+    AnimationDataSize = 0;
+    AnimationDataCapacity = 0;
+    NumberOfFrames = 0;
+}
+
+/*
+ * Called by NeoPixel::show() as show hook
+ */
+void NeoAnimationRecorder::recordShownFrame(NeoPixelShowHook *aShowHook, NeoPixel *aNeoPixel) {
+    NeoAnimationRecorder *tRecorder = static_cast<NeoAnimationRecorder*>(aShowHook);
+    if (tRecorder->RecordedNeoPixel == aNeoPixel) {
+        tRecorder->recordFrame();
+    }
+}
+
+/*
+ * Appends the current pixel buffer content as a new frame
+ * @return false if not enough memory is available or the maximum number of frames is reached
+ */
+bool NeoAnimationRecorder::recordFrame() {
+    if (IsOutOfMemory || LastFrameIndexes == nullptr || NumberOfFrames >= 0x7FFF) {
+        return false;
+    }
+    for (uint_fast16_t i = 0; i < NumberOfPixels; ++i) {
+        FrameIndexes[i] = getPaletteIndex(RecordedNeoPixel->getPixelColor(i));
+    }
+    bool tIsKeyframe = (NumberOfFrames == 0 || (KeyframeInterval != 0 && (NumberOfFrames % KeyframeInterval) == 0));
+    if (!encodeFrame(tIsKeyframe)) {
+        IsOutOfMemory = true;
+#if defined(LOCAL_INFO)
+        Serial.print(F("Out of memory at frame "));
+        Serial.println(NumberOfFrames);
+#endif
+        return false;
+    }
+    uint8_t *tIndexes = LastFrameIndexes;
+    LastFrameIndexes = FrameIndexes;
+    FrameIndexes = tIndexes;
+    NumberOfFrames++;
+    return true;
+}
+
+/*
+ * Black is always index 0. A new color is appended to the palette. If the palette is full, the nearest color is taken.
+ */
+uint8_t NeoAnimationRecorder::getPaletteIndex(color32_t aColor) {
+    if (aColor == COLOR32_BLACK) {
+        return 0;
+    }
+    if (PaletteColors[LastPaletteIndex] == aColor) {
+        return LastPaletteIndex;
+    }
+    for (uint_fast16_t i = 1; i < NumberOfPaletteColors; ++i) {
+        if (PaletteColors[i] == aColor) {
+            LastPaletteIndex = i;
+            return i;
+        }
+    }
+    if (NumberOfPaletteColors < MaximumNumberOfPaletteColors) {
+        PaletteColors[NumberOfPaletteColors] = aColor;
+        LastPaletteIndex = NumberOfPaletteColors;
+        NumberOfPaletteColors++;
+        return LastPaletteIndex;
+    }
+
+    NumberOfNearestColorPixels++;
+    uint8_t tPaletteIndex = 0;
+    uint16_t tMinimumDistance = 0xFFFF;
+    for (uint_fast16_t i = 0; i < NumberOfPaletteColors; ++i) {
+        color32_t tPaletteColor = PaletteColors[i];
+        uint16_t tDistance = abs((int16_t) getRedPart(tPaletteColor) - getRedPart(aColor))
+                + abs((int16_t) getGreenPart(tPaletteColor) - getGreenPart(aColor))
+                + abs((int16_t) getBluePart(tPaletteColor) - getBluePart(aColor))
+                + abs((int16_t) getWhitePart(tPaletteColor) - getWhitePart(aColor));
+        if (tDistance < tMinimumDistance) {
+            tMinimumDistance = tDistance;
+            tPaletteIndex = i;
+        }
+    }
+    return tPaletteIndex;
+}
+
+bool NeoAnimationRecorder::appendByte(uint8_t aByte) {
+    if (AnimationDataSize >= AnimationDataCapacity) {
+        uint32_t tNewCapacity = (AnimationDataCapacity == 0) ? 256 : AnimationDataCapacity * 2;
+        uint8_t *tAnimationData = (uint8_t*) realloc(AnimationData, tNewCapacity);
+        if (tAnimationData == nullptr) {
+            return false;
+        }
+        AnimationData = tAnimationData;
+        AnimationDataCapacity = tNewCapacity;
+    }
+    AnimationData[AnimationDataSize++] = aByte;
+    return true;
+}
+
+/*
+ * Pixels, which need not to be written, are skipped. These are the unchanged pixels of a delta frame and the black pixels of a keyframe.
+ * A sequence of 2 or more pixels with the same index is encoded as run, all other pixels as literals.
+ */
+#define _ANIMATION_PIXEL_IS_UNCHANGED(aPixelIndex) (FrameIndexes[aPixelIndex] == (aIsKeyframe ? 0 : LastFrameIndexes[aPixelIndex]))
+bool NeoAnimationRecorder::encodeFrame(bool aIsKeyframe) {
+    if (!appendByte(aIsKeyframe ? NEO_ANIMATION_KEYFRAME : NEO_ANIMATION_DELTA_FRAME)) {
+        return false;
+    }
+    uint16_t tPixelIndex = 0;
+    while (tPixelIndex < NumberOfPixels) {
+        if (_ANIMATION_PIXEL_IS_UNCHANGED(tPixelIndex)) {
+            uint8_t tSkip = 0;
+            while (tPixelIndex < NumberOfPixels && tSkip < NEO_ANIMATION_MAX_SKIP && _ANIMATION_PIXEL_IS_UNCHANGED(tPixelIndex)) {
+                tSkip++;
+                tPixelIndex++;
+            }
+            // Skips at the end of the frame are not required
+            if (tPixelIndex < NumberOfPixels && !appendByte(NEO_ANIMATION_SKIP + tSkip)) {
+                return false;
+            }
+            continue;
+        }
+
+        uint8_t tPaletteIndex = FrameIndexes[tPixelIndex];
+        uint16_t tRunLength = 1;
+        while (tPixelIndex + tRunLength < NumberOfPixels && tRunLength < NEO_ANIMATION_MAX_RUN
+                && FrameIndexes[tPixelIndex + tRunLength] == tPaletteIndex) {
+            tRunLength++;
+        }
+        if (tRunLength >= 2) {
+            if (!appendByte(NEO_ANIMATION_RUN + (tRunLength - 1)) || !appendByte(tPaletteIndex)) {
+                return false;
+            }
+            tPixelIndex += tRunLength;
+            continue;
+        }
+
+        /*
+         * Literal up to the next unchanged pixel or run of 3 pixels
+         */
+        uint16_t tLiteralStartIndex = tPixelIndex;
+        uint8_t tLiteralLength = 0;
+        while (tPixelIndex < NumberOfPixels && tLiteralLength < NEO_ANIMATION_MAX_LITERAL
+                && !_ANIMATION_PIXEL_IS_UNCHANGED(tPixelIndex)) {
+            if (tLiteralLength > 0 && tPixelIndex + 2 < NumberOfPixels && FrameIndexes[tPixelIndex] == FrameIndexes[tPixelIndex + 1]
+                    && FrameIndexes[tPixelIndex] == FrameIndexes[tPixelIndex + 2]) {
+                break;
+            }
+            tLiteralLength++;
+            tPixelIndex++;
+        }
+        if (!appendByte(NEO_ANIMATION_LITERAL + (tLiteralLength - 1))) {
+            return false;
+        }
+        for (uint_fast8_t i = 0; i < tLiteralLength; ++i) {
+            if (!appendByte(FrameIndexes[tLiteralStartIndex + i])) {
+                return false;
+            }
+        }
+    }
+    return appendByte(NEO_ANIMATION_END_OF_FRAME);
+}
+
+/*
+ * Size of the complete animation after end()
+ */
+uint32_t NeoAnimationRecorder::getAnimationSize() {
+    return AnimationDataSize;
+}
+
+/*
+ * Size of the pixel buffer content of all recorded frames
+ */
+uint32_t NeoAnimationRecorder::getRawSize() {
+    return (uint32_t) NumberOfFrames * NumberOfPixels * RecordedNeoPixel->getBytesPerPixel();
+}
+
+/*
+ * Writes the binary animation after end(), e.g. to a file, which can be played by NeoAnimation::begin(Stream*)
+ */
+void NeoAnimationRecorder::writeAnimation(Print *aOutput) {
+    aOutput->write(AnimationData, AnimationDataSize);
+}
+
+/*
+ * Prints the animation after end() as C array in PROGMEM, which can be played by NeoAnimation::beginPGM()
+ */
+void NeoAnimationRecorder::printCHeader(Print *aOutput, const char *aArrayName) {
+    aOutput->print(F("// "));
+    aOutput->print(NumberOfFrames);
+    aOutput->print(F(" frames of "));
+    aOutput->print(NumberOfPixels);
+    aOutput->print(F(" pixels recorded by NeoAnimationRecorder"));
+    aOutput->print(F("\nconst uint8_t "));
+    aOutput->print(aArrayName);
+    aOutput->print(F("[] PROGMEM = {"));
+    for (uint32_t i = 0; i < AnimationDataSize; ++i) {
+        if ((i % 16) == 0) {
+            aOutput->print(F("\n       "));
+        }
+        aOutput->print(F(" 0x"));
+        if (AnimationData[i] < 0x10) {
+            aOutput->print('0');
+        }
+        aOutput->print(AnimationData[i], HEX);
+        if (i + 1 < AnimationDataSize) {
+            aOutput->print(',');
+        }
+    }
+    aOutput->println(F(" };"));
+}
+
+/*
+ * Prints size and compression ratio of the animation after end().
+ * @param aDecodeNeoPixel - If not nullptr, all frames are decoded into the pixel buffer of aDecodeNeoPixel to measure the decode time
+ */
+void NeoAnimationRecorder::printStatistics(Print *aOutput, NeoPixel *aDecodeNeoPixel) {
+    aOutput->print(F("Recorded "));
+    aOutput->print(NumberOfFrames);
+    aOutput->print(F(" frames of "));
+    aOutput->print(NumberOfPixels);
+    aOutput->print(F(" pixels, palette colors="));
+    aOutput->print(NumberOfPaletteColors);
+    aOutput->print(F(", pixels with nearest color="));
+    aOutput->println(NumberOfNearestColorPixels);
+    if (IsOutOfMemory) {
+        aOutput->println(F("Recording stopped, out of memory"));
+    }
+    if (AnimationDataSize == 0) {
+        return;
+    }
+    uint32_t tRawSize = getRawSize();
+    aOutput->print(F("Raw size="));
+    aOutput->print(tRawSize);
+    aOutput->print(F(" animation size="));
+    aOutput->print(AnimationDataSize);
+    aOutput->print(F(" compression ratio="));
+    uint32_t tRatioTimes10 = (tRawSize * 10) / AnimationDataSize;
+    aOutput->print(tRatioTimes10 / 10);
+    aOutput->print('.');
+    aOutput->print(tRatioTimes10 % 10);
+    aOutput->print(F(" bytes per frame="));
+    aOutput->println(AnimationDataSize / NumberOfFrames);
+
+    if (aDecodeNeoPixel != nullptr) {
+        NeoAnimation tAnimation;
+        if (tAnimation.begin(AnimationData)) {
+            unsigned long tStartMicros = micros();
+            while (tAnimation.decodeNextFrame(aDecodeNeoPixel)) {
+                ;
+            }
+            unsigned long tDecodeMicros = micros() - tStartMicros;
+            aOutput->print(F("Decode time per frame="));
+            aOutput->print(tDecodeMicros / NumberOfFrames);
+            aOutput->println(F(" us"));
+        }
+    }
+}
+#endif // defined(ENABLE_ANIMATION_RECORDER)
+
+#include "LocalDebugLevelEnd.h"
+#endif // _NEO_ANIMATION_HPP
@@ -0,0 +1,188 @@
+/*
+ * NeoDmxReceiver.h
+ *
+ *  SUMMARY
+ *  Receives Art-Net and E1.31 (sACN) DMX packets and copies the DMX slots of each universe into a back buffer.
+ *  Sequence numbers are checked and dropped packets are counted.
+ *  Universe synchronization (ArtSync, E1.31 synchronization) or reception of all mapped universes completes a frame,
+ *  which is then copied by show() from the back buffers to the pixel buffers of NeoPixel or partial NeoPixel objects.
+ *  So the pixel buffers are never written by the network task and show() is called once per full frame.
+ *  The packet is parsed from the receive buffer of the network stack, e.g. AsyncUDPPacket::data() on ESP32.
+ *  Without Arduino, NeoPixel objects are not supported, but universes can be mapped to any buffer,
+ *  see extras/DmxLoopbackBenchmark for a host build.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+/*
+ * Usage:
+ * NeoPixel Strip340 = NeoPixel(340, 16, NEO_GRB + NEO_KHZ800);
+ * NeoDmxReceiver DmxReceiver;
+ * AsyncUDP ArtNetUdp;
+ * ...
+ * Strip340.begin();
+ * DmxReceiver.addUniverse(1, &Strip340);      // pixel 0 to 169
+ * DmxReceiver.addUniverse(2, &Strip340, 170); // pixel 170 to 339
+ * ArtNetUdp.listen(NEO_DMX_ART_NET_PORT);
+ * ArtNetUdp.onPacket([](AsyncUDPPacket &aPacket) {
+ *     DmxReceiver.processPacket(aPacket.data(), aPacket.length());
+ * });
+ * ...
+ * loop() {
+ *     if (DmxReceiver.FrameIsComplete) {
+ *         DmxReceiver.show();
+ *     }
+ * }
+ *
+ * processPacket() and show() can run in different tasks or on different cores, they are synchronized by a critical section.
+ * Each universe is mapped to whole pixels, i.e. 170 pixels for RGB and 128 pixels for RGBW.
+ * For a PatternSegment, use its parent NeoPixel object and PixelOffset as start pixel.
+ * Slot values are copied unchanged, Brightness is not applied.
+ * The Art-Net universe is the 15 bit Port-Address (Net, Sub-Net, Universe), the E1.31 universe is 1 to 63999.
+ */
+
+#ifndef _NEO_DMX_RECEIVER_H
+#define _NEO_DMX_RECEIVER_H
+
+#if defined(ARDUINO)
+#include "NeoPixel.h"
+#else
+#include <stdint.h>
+#include <mutex>
+#endif
+
+#if defined(__AVR__)
+/*
+ * There is no <atomic> for AVR. processPacket() can only be called from loop() there, so volatile is sufficient.
+ */
+template<typename T> struct NeoDmxAtomic {
+    volatile T Value;
+    T load() const {
+        return Value;
+    }
+    void store(T aValue) {
+        Value = aValue;
+    }
+    operator T() const {
+        return Value;
+    }
+};
+#else
+#include <atomic>
+template<typename T> using NeoDmxAtomic = std::atomic<T>;
+#endif
+
+#if !defined(NEO_DMX_RECEIVER_MAX_UNIVERSES)
+#define NEO_DMX_RECEIVER_MAX_UNIVERSES  16 // Maximum is 32, the bit width of ReceivedUniversesMask
+#endif
+
+#define NEO_DMX_ART_NET_PORT            6454
+#define NEO_DMX_E131_PORT               5568
+#define NEO_DMX_MAX_SLOTS               512
+
+/*
+ * Art-Net packet layout. All values are big endian, except the OpCode.
+ */
+#define NEO_DMX_ART_NET_OPCODE_DMX      0x5000
+#define NEO_DMX_ART_NET_OPCODE_SYNC     0x5200
+#define NEO_DMX_ART_NET_HEADER_SIZE     18 // Offset of the first slot in an ArtDmx packet
+#define NEO_DMX_ART_NET_SYNC_SIZE       14
+
+/*
+ * E1.31 packet layout
+ */
+#define NEO_DMX_E131_VECTOR_ROOT_DATA           0x00000004
+#define NEO_DMX_E131_VECTOR_ROOT_EXTENDED       0x00000008
+#define NEO_DMX_E131_VECTOR_FRAME_DATA          0x00000002
+#define NEO_DMX_E131_VECTOR_EXTENDED_SYNC       0x00000001
+#define NEO_DMX_E131_HEADER_SIZE                126 // Offset of the first slot after the start code in a data packet
+#define NEO_DMX_E131_SYNC_SIZE                  49
+#define NEO_DMX_E131_OPTION_PREVIEW_DATA        0x80
+#define NEO_DMX_E131_OPTION_STREAM_TERMINATED   0x40
+
+#define NEO_DMX_SEQUENCE_DISCARD_WINDOW         20 // Packets up to 19 sequence numbers older than the last one are discarded
+
+struct NeoDmxUniverse {
+    uint8_t *BackBuffer;            // Written by processPacket(), copied to the destination by copyFrame()
+    uint8_t *SlotBuffer;            // Destination of slot 1 for a plain buffer, nullptr for a NeoPixel object
+    uint16_t SlotBufferLength;      // Number of slots copied, at most NEO_DMX_MAX_SLOTS
+    uint16_t Universe;
+    uint8_t LastSequence;
+    bool LastSequenceIsValid;       // false until the first packet with a sequence number is received
+#if defined(ARDUINO)
+    NeoPixel *NeoPixelPtr;          // The object, whose parent is shown, nullptr for a plain buffer
+    uint16_t StartPixel;            // Relative to the PixelOffset of NeoPixelPtr
+#endif
+};
+
+class NeoDmxReceiver {
+public:
+    NeoDmxReceiver();
+    ~NeoDmxReceiver();
+#if defined(ARDUINO)
+    bool addUniverse(uint16_t aUniverse, NeoPixel *aNeoPixel, uint16_t aStartPixel = 0);
+    void show();
+    void printStatistics(Print *aOutput);
+#endif
+    bool addUniverse(uint16_t aUniverse, uint8_t *aSlotBuffer, uint16_t aSlotBufferLength);
+    void clearStatistics();
+
+    bool processPacket(const uint8_t *aPacket, uint16_t aLength);
+    bool copyFrame();
+
+    NeoDmxUniverse Universes[NEO_DMX_RECEIVER_MAX_UNIVERSES];
+    uint8_t NumberOfUniverses;
+    uint32_t AllUniversesMask;      // Bit n is set for Universes[n]
+    NeoDmxAtomic<uint32_t> ReceivedUniversesMask; // Universes received for the current frame
+    uint32_t UpdatedUniversesMask;  // Back buffers written since the last copyFrame(), only accessed in the critical section
+    uint16_t E131SyncUniverse;      // Synchronization address of the last E1.31 data packet, 0 if not synchronized
+    bool ArtNetSyncIsActive;        // Set by the first ArtSync packet
+    NeoDmxAtomic<bool> FrameIsComplete; // Set by processPacket(), reset by copyFrame() and show()
+
+    /*
+     * Statistics
+     */
+    uint32_t NumberOfReceivedUniverses;  // Data packets copied to a buffer
+    uint32_t NumberOfDroppedPackets;     // Missing sequence numbers
+    uint32_t NumberOfOutOfOrderPackets;  // Discarded because of an old or duplicate sequence number
+    uint32_t NumberOfIgnoredPackets;     // Invalid or unsupported packets, unmapped universes, preview data
+    uint32_t NumberOfFrames;
+    uint32_t NumberOfIncompleteFrames;   // Frames, which were started, but not all universes were received
+
+private:
+    /*
+     * Called by processPacket() in the critical section
+     */
+    bool processArtNetPacket(const uint8_t *aPacket, uint16_t aLength);
+    bool processE131Packet(const uint8_t *aPacket, uint16_t aLength);
+    bool processUniverseData(uint16_t aUniverse, uint8_t aSequence, bool aIsArtNet, const uint8_t *aSlots, uint16_t aNumberOfSlots);
+    bool processSync();
+    void setFrameComplete();
+
+#if defined(ESP32)
+    portMUX_TYPE CriticalSectionLock = portMUX_INITIALIZER_UNLOCKED;
+#elif !defined(ARDUINO)
+    std::mutex CriticalSectionLock;
+#endif
+};
+
+#endif // _NEO_DMX_RECEIVER_H
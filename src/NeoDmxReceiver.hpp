@@ -0,0 +1,415 @@
+/*
+ * NeoDmxReceiver.hpp
+ *
+ *  SUMMARY
+ *  Receives Art-Net and E1.31 (sACN) DMX packets and copies the DMX slots of each universe directly into the pixel buffer
+ *  of a NeoPixel object or a partial NeoPixel object. Sequence numbers are checked and dropped packets are counted.
+ *  Universe synchronization (ArtSync, E1.31 synchronization) or reception of all mapped universes completes a frame,
+ *  so show() is called once per full frame.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _NEO_DMX_RECEIVER_HPP
+#define _NEO_DMX_RECEIVER_HPP
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#endif
+#include <stdlib.h>
+#include <string.h>
+
+#include "NeoDmxReceiver.h"
+
+#if defined(ARDUINO)
+// include sources
+#include "NeoPixel.hpp"
+
+// This block must be located after the includes of other *.hpp files
+//#define LOCAL_INFO  // This enables info output only for this file
+//#define LOCAL_DEBUG // This enables debug output only for this file - only for development
+#include "LocalDebugLevelStart.h"
+#endif
+
+/*
+ * The critical section protects the back buffers against concurrent access by processPacket() and copyFrame().
+ * On ESP32, the spinlock also works if the network task runs on the other core.
+ */
+#if defined(ESP32)
+#define NEO_DMX_ENTER_CRITICAL()    portENTER_CRITICAL(&CriticalSectionLock)
+#define NEO_DMX_EXIT_CRITICAL()     portEXIT_CRITICAL(&CriticalSectionLock)
+#elif defined(ARDUINO)
+#define NEO_DMX_ENTER_CRITICAL()    noInterrupts()
+#define NEO_DMX_EXIT_CRITICAL()     interrupts()
+#else
+#define NEO_DMX_ENTER_CRITICAL()    CriticalSectionLock.lock()
+#define NEO_DMX_EXIT_CRITICAL()     CriticalSectionLock.unlock()
+#endif
+
+NeoDmxReceiver::NeoDmxReceiver() { // @suppress("Class members should be properly initialized")
+    NumberOfUniverses = 0;
+    AllUniversesMask = 0;
+    ReceivedUniversesMask.store(0);
+    UpdatedUniversesMask = 0;
+    E131SyncUniverse = 0;
+    ArtNetSyncIsActive = false;
+    FrameIsComplete.store(false);
+    clearStatistics();
+}
+
+NeoDmxReceiver::~NeoDmxReceiver() {
+    for (uint_fast8_t i = 0; i < NumberOfUniverses; ++i) {
+        free(Universes[i].BackBuffer);
+    }
+}
+
+void NeoDmxReceiver::clearStatistics() {
+    NumberOfReceivedUniverses = 0;
+    NumberOfDroppedPackets = 0;
+    NumberOfOutOfOrderPackets = 0;
+    NumberOfIgnoredPackets = 0;
+    NumberOfFrames = 0;
+    NumberOfIncompleteFrames = 0;
+}
+
+/*
+ * Maps the slots of aUniverse to the buffer. A universe can be mapped to more than one buffer.
+ * The slots are received into a back buffer of aSlotBufferLength bytes and copied to aSlotBuffer by copyFrame().
+ * Must be called before the first call of processPacket().
+ * @param aSlotBufferLength - Is clipped to NEO_DMX_MAX_SLOTS. Slots above aSlotBufferLength are ignored.
+ * @return false if NEO_DMX_RECEIVER_MAX_UNIVERSES universes are already mapped or no memory for the back buffer is available
+ */
+bool NeoDmxReceiver::addUniverse(uint16_t aUniverse, uint8_t *aSlotBuffer, uint16_t aSlotBufferLength) {
+    if (NumberOfUniverses >= NEO_DMX_RECEIVER_MAX_UNIVERSES) {
+        return false;
+    }
+    if (aSlotBufferLength > NEO_DMX_MAX_SLOTS) {
+        aSlotBufferLength = NEO_DMX_MAX_SLOTS;
+    }
+    NeoDmxUniverse *tUniverse = &Universes[NumberOfUniverses];
+    tUniverse->BackBuffer = (uint8_t*) calloc(aSlotBufferLength, 1);
+    if (tUniverse->BackBuffer == nullptr) {
+        return false;
+    }
+    tUniverse->SlotBuffer = aSlotBuffer;
+    tUniverse->SlotBufferLength = aSlotBufferLength;
+    tUniverse->Universe = aUniverse;
+    tUniverse->LastSequenceIsValid = false;
+#if defined(ARDUINO)
+    tUniverse->NeoPixelPtr = nullptr;
+#endif
+    AllUniversesMask |= 1UL << NumberOfUniverses;
+    NumberOfUniverses++;
+    return true;
+}
+
+#if defined(ARDUINO)
+/*
+ * Maps the slots of aUniverse to the pixels starting at aStartPixel of aNeoPixel.
+ * Only whole pixels are mapped, i.e. at most 170 RGB or 128 RGBW pixels.
+ * The object and aStartPixel are stored, not the address of the pixels. The address is determined by each copyFrame(),
+ * so the pixel buffer can be reallocated, e.g. by updateLength(), and pixels beyond a new length are skipped.
+ * @param aNeoPixel - Can be a partial NeoPixel object, then aStartPixel is relative to its PixelOffset.
+ * @return false if no universe can be added or aStartPixel is not a pixel of aNeoPixel
+ */
+bool NeoDmxReceiver::addUniverse(uint16_t aUniverse, NeoPixel *aNeoPixel, uint16_t aStartPixel) {
+    if (aStartPixel >= aNeoPixel->numPixels()) {
+        return false;
+    }
+    uint16_t tNumberOfPixels = aNeoPixel->numPixels() - aStartPixel;
+    if (tNumberOfPixels > NEO_DMX_MAX_SLOTS / aNeoPixel->getBytesPerPixel()) {
+        tNumberOfPixels = NEO_DMX_MAX_SLOTS / aNeoPixel->getBytesPerPixel();
+    }
+    if (!addUniverse(aUniverse, (uint8_t*) nullptr, tNumberOfPixels * aNeoPixel->getBytesPerPixel())) {
+        return false;
+    }
+    Universes[NumberOfUniverses - 1].NeoPixelPtr = aNeoPixel;
+    Universes[NumberOfUniverses - 1].StartPixel = aStartPixel;
+    return true;
+}
+
+/*
+ * Copies the frame to the pixel buffers with copyFrame() and calls show() once for each NeoPixel object, whose pixels are mapped.
+ * For partial objects, the parent object is shown, even if showing of the parent is disabled for the partial object.
+ * Must be called from loop(), not from the task, which calls processPacket().
+ */
+void NeoDmxReceiver::show() {
+    copyFrame();
+    for (uint_fast8_t i = 0; i < NumberOfUniverses; ++i) {
+        if (Universes[i].NeoPixelPtr == nullptr) {
+            continue;
+        }
+        NeoPixel *tParentNeoPixel = Universes[i].NeoPixelPtr->ParentNeoPixelObject;
+        bool tIsAlreadyShown = false;
+        for (uint_fast8_t j = 0; j < i; ++j) {
+            if (Universes[j].NeoPixelPtr != nullptr && Universes[j].NeoPixelPtr->ParentNeoPixelObject == tParentNeoPixel) {
+                tIsAlreadyShown = true;
+                break;
+            }
+        }
+        if (!tIsAlreadyShown) {
+            tParentNeoPixel->show();
+        }
+    }
+}
+
+void NeoDmxReceiver::printStatistics(Print *aOutput) {
+    aOutput->print(F("DMX universes="));
+    aOutput->print(NumberOfReceivedUniverses);
+    aOutput->print(F(" frames="));
+    aOutput->print(NumberOfFrames);
+    aOutput->print(F(" incomplete frames="));
+    aOutput->print(NumberOfIncompleteFrames);
+    aOutput->print(F(" dropped="));
+    aOutput->print(NumberOfDroppedPackets);
+    aOutput->print(F(" out of order="));
+    aOutput->print(NumberOfOutOfOrderPackets);
+    aOutput->print(F(" ignored="));
+    aOutput->println(NumberOfIgnoredPackets);
+}
+#endif // defined(ARDUINO)
+
+/*
+ * Copies the back buffers of the universes, which were received since the last call, to the mapped buffers
+ * and resets FrameIsComplete. The pixel buffer of a NeoPixel object is determined here, not when the packet is received.
+ * Is called by show(). Must be called from loop(), not from the task, which calls processPacket().
+ * @return false if no frame was completed since the last call. Then nothing is copied.
+ */
+bool NeoDmxReceiver::copyFrame() {
+    if (!FrameIsComplete.load()) {
+        return false;
+    }
+    NEO_DMX_ENTER_CRITICAL();
+    for (uint_fast8_t i = 0; i < NumberOfUniverses; ++i) {
+        if (!(UpdatedUniversesMask & (1UL << i))) {
+            continue;
+        }
+        NeoDmxUniverse *tUniverse = &Universes[i];
+        uint8_t *tDestination = tUniverse->SlotBuffer;
+        uint16_t tLength = tUniverse->SlotBufferLength;
+#if defined(ARDUINO)
+        NeoPixel *tNeoPixel = tUniverse->NeoPixelPtr;
+        if (tNeoPixel != nullptr) {
+            if (tNeoPixel->getPixels() == nullptr || tUniverse->StartPixel >= tNeoPixel->numPixels()) {
+                continue;
+            }
+            uint8_t tBytesPerPixel = tNeoPixel->getBytesPerPixel();
+            if (tLength > (tNeoPixel->numPixels() - tUniverse->StartPixel) * tBytesPerPixel) {
+                tLength = (tNeoPixel->numPixels() - tUniverse->StartPixel) * tBytesPerPixel;
+            }
+            tDestination = &tNeoPixel->getPixels()[(tNeoPixel->PixelOffset + tUniverse->StartPixel) * tBytesPerPixel];
+        }
+#endif
+        memcpy(tDestination, tUniverse->BackBuffer, tLength);
+    }
+    UpdatedUniversesMask = 0;
+    FrameIsComplete.store(false);
+    NEO_DMX_EXIT_CRITICAL();
+    return true;
+}
+
+/*
+ * Processes one UDP payload, which can be an Art-Net or an E1.31 packet.
+ * The slots are copied from aPacket to the back buffers of the mapped universes in a critical section.
+ * Can be called from the receive callback of the network stack, then show() must be called from loop().
+ * @return true if the packet completed a frame. FrameIsComplete is then set until copyFrame() or show() is called.
+ */
+bool NeoDmxReceiver::processPacket(const uint8_t *aPacket, uint16_t aLength) {
+    bool tFrameIsComplete = false;
+    NEO_DMX_ENTER_CRITICAL();
+    if (aLength >= NEO_DMX_ART_NET_SYNC_SIZE && memcmp(aPacket, "Art-Net", 8) == 0) {
+        tFrameIsComplete = processArtNetPacket(aPacket, aLength);
+    } else if (aLength >= NEO_DMX_E131_SYNC_SIZE && memcmp(&aPacket[4], "ASC-E1.17\0\0", 12) == 0) {
+        tFrameIsComplete = processE131Packet(aPacket, aLength);
+    } else {
+        NumberOfIgnoredPackets++;
+    }
+    NEO_DMX_EXIT_CRITICAL();
+    return tFrameIsComplete;
+}
+
+/*
+ * Sets FrameIsComplete after the last write to the back buffers of the frame
+ */
+void NeoDmxReceiver::setFrameComplete() {
+    NumberOfFrames++;
+    FrameIsComplete.store(true);
+}
+
+bool NeoDmxReceiver::processArtNetPacket(const uint8_t *aPacket, uint16_t aLength) {
+    uint16_t tOpCode = aPacket[8] | (aPacket[9] << 8);
+    if (tOpCode == NEO_DMX_ART_NET_OPCODE_DMX && aLength >= NEO_DMX_ART_NET_HEADER_SIZE) {
+        uint16_t tUniverse = ((aPacket[15] & 0x7F) << 8) | aPacket[14];
+        uint16_t tNumberOfSlots = (aPacket[16] << 8) | aPacket[17];
+        if (tNumberOfSlots > aLength - NEO_DMX_ART_NET_HEADER_SIZE) {
+            tNumberOfSlots = aLength - NEO_DMX_ART_NET_HEADER_SIZE;
+        }
+        return processUniverseData(tUniverse, aPacket[12], true, &aPacket[NEO_DMX_ART_NET_HEADER_SIZE], tNumberOfSlots);
+    }
+    if (tOpCode == NEO_DMX_ART_NET_OPCODE_SYNC) {
+        ArtNetSyncIsActive = true;
+        return processSync();
+    }
+    NumberOfIgnoredPackets++; // e.g. ArtPoll
+    return false;
+}
+
+/*
+ * Reads the 32 bit big endian vector at aVectorPtr
+ */
+static uint32_t getE131Vector(const uint8_t *aVectorPtr) {
+    return ((uint32_t) aVectorPtr[0] << 24) | ((uint32_t) aVectorPtr[1] << 16) | ((uint16_t) aVectorPtr[2] << 8) | aVectorPtr[3];
+}
+
+bool NeoDmxReceiver::processE131Packet(const uint8_t *aPacket, uint16_t aLength) {
+    uint32_t tRootVector = getE131Vector(&aPacket[18]);
+    uint32_t tFramingVector = getE131Vector(&aPacket[40]);
+    if (tRootVector == NEO_DMX_E131_VECTOR_ROOT_DATA && tFramingVector == NEO_DMX_E131_VECTOR_FRAME_DATA
+            && aLength >= NEO_DMX_E131_HEADER_SIZE) {
+        uint8_t tOptions = aPacket[112];
+        // aPacket[125] is the DMX start code, only 0 is used for dimmer values
+        if ((tOptions & (NEO_DMX_E131_OPTION_PREVIEW_DATA | NEO_DMX_E131_OPTION_STREAM_TERMINATED)) || aPacket[125] != 0) {
+            NumberOfIgnoredPackets++;
+            return false;
+        }
+        E131SyncUniverse = (aPacket[109] << 8) | aPacket[110];
+        uint16_t tUniverse = (aPacket[113] << 8) | aPacket[114];
+        // Property value count includes the start code
+        uint16_t tNumberOfSlots = ((aPacket[123] << 8) | aPacket[124]) - 1;
+        if (tNumberOfSlots > aLength - NEO_DMX_E131_HEADER_SIZE) {
+            tNumberOfSlots = aLength - NEO_DMX_E131_HEADER_SIZE;
+        }
+        return processUniverseData(tUniverse, aPacket[111], false, &aPacket[NEO_DMX_E131_HEADER_SIZE], tNumberOfSlots);
+    }
+    if (tRootVector == NEO_DMX_E131_VECTOR_ROOT_EXTENDED && tFramingVector == NEO_DMX_E131_VECTOR_EXTENDED_SYNC) {
+        uint16_t tSyncUniverse = (aPacket[45] << 8) | aPacket[46];
+        if (tSyncUniverse != 0 && tSyncUniverse == E131SyncUniverse) {
+            return processSync();
+        }
+    }
+    NumberOfIgnoredPackets++; // e.g. universe discovery
+    return false;
+}
+
+/*
+ * Checks the sequence number and copies the slots to the back buffers of all mappings of aUniverse.
+ * Without synchronization, the frame is complete if all mapped universes are received.
+ * @param aIsArtNet - For Art-Net, sequence number 0 disables the check and the sequence continues with 1 after 255.
+ */
+bool NeoDmxReceiver::processUniverseData(uint16_t aUniverse, uint8_t aSequence, bool aIsArtNet, const uint8_t *aSlots,
+        uint16_t aNumberOfSlots) {
+    bool tUniverseFound = false;
+    uint32_t tUniverseMask = 0;
+    for (uint_fast8_t i = 0; i < NumberOfUniverses; ++i) {
+        NeoDmxUniverse *tUniverse = &Universes[i];
+        if (tUniverse->Universe != aUniverse) {
+            continue;
+        }
+        if (!tUniverseFound) {
+            /*
+             * Check sequence only once per packet, even if the universe is mapped to more than one buffer
+             */
+            if (tUniverse->LastSequenceIsValid && !(aIsArtNet && aSequence == 0)) {
+                int8_t tSequenceDelta = aSequence - tUniverse->LastSequence;
+                if (aIsArtNet && aSequence < tUniverse->LastSequence) {
+                    tSequenceDelta--; // Art-Net skips 0 after 255
+                }
+                if (tSequenceDelta <= 0 && tSequenceDelta > -NEO_DMX_SEQUENCE_DISCARD_WINDOW) {
+                    NumberOfOutOfOrderPackets++;
+                    return false;
+                }
+                if (tSequenceDelta > 1) {
+                    NumberOfDroppedPackets += tSequenceDelta - 1;
+                }
+                // A big negative delta is taken as restart of the sender
+            }
+            tUniverseFound = true;
+            NumberOfReceivedUniverses++;
+        }
+        tUniverse->LastSequence = aSequence;
+        tUniverse->LastSequenceIsValid = !(aIsArtNet && aSequence == 0);
+        uint16_t tNumberOfSlots = aNumberOfSlots;
+        if (tNumberOfSlots > tUniverse->SlotBufferLength) {
+            tNumberOfSlots = tUniverse->SlotBufferLength;
+        }
+        memcpy(tUniverse->BackBuffer, aSlots, tNumberOfSlots);
+        tUniverseMask |= 1UL << i;
+    }
+
+    if (!tUniverseFound) {
+        NumberOfIgnoredPackets++;
+        return false;
+    }
+
+    UpdatedUniversesMask |= tUniverseMask;
+
+    uint32_t tReceivedUniversesMask = ReceivedUniversesMask.load();
+    if (tReceivedUniversesMask & tUniverseMask) {
+        /*
+         * Universe received twice, so universes or the sync packet of the last frame were lost.
+         * If the console stopped sending ArtSync, continue without synchronization.
+         */
+        NumberOfIncompleteFrames++;
+        if (aIsArtNet) {
+            ArtNetSyncIsActive = false;
+        }
+        bool tIsSynchronized = aIsArtNet ? ArtNetSyncIsActive : (E131SyncUniverse != 0);
+        if (!tIsSynchronized) {
+            // Show the incomplete frame, otherwise nothing is shown if a mapped universe is never received
+            ReceivedUniversesMask.store(tUniverseMask);
+            setFrameComplete();
+            return true;
+        }
+        tReceivedUniversesMask = 0;
+    }
+    tReceivedUniversesMask |= tUniverseMask;
+
+    bool tIsSynchronized = aIsArtNet ? ArtNetSyncIsActive : (E131SyncUniverse != 0);
+    if (!tIsSynchronized && tReceivedUniversesMask == AllUniversesMask) {
+        ReceivedUniversesMask.store(0);
+        setFrameComplete();
+        return true;
+    }
+    ReceivedUniversesMask.store(tReceivedUniversesMask);
+    return false;
+}
+
+/*
+ * Completes the frame, if at least one universe was received since the last frame
+ */
+bool NeoDmxReceiver::processSync() {
+    uint32_t tReceivedUniversesMask = ReceivedUniversesMask.load();
+    if (tReceivedUniversesMask == 0) {
+        return false;
+    }
+    if (tReceivedUniversesMask != AllUniversesMask) {
+        NumberOfIncompleteFrames++;
+    }
+    ReceivedUniversesMask.store(0);
+    setFrameComplete();
+    return true;
+}
+
+#if defined(ARDUINO)
+#include "LocalDebugLevelEnd.h"
+#endif
+#endif // _NEO_DMX_RECEIVER_HPP
@@ -44,14 +44,24 @@
 
 #include "NeoPixel.h"
 
+//#define ENABLE_PATTERN_PLAY_ANIMATION // Enables the PlayAnimation pattern for pre-rendered animations, see NeoAnimation.h. Must be enabled explicitly.
+#if defined(ENABLE_PATTERN_PLAY_ANIMATION) || defined(ENABLE_ANIMATION_RECORDER)
+#include "NeoAnimation.h"
+#endif
+//#define ENABLE_PATTERN_SERIAL_INGEST // Enables the SerialIngest pattern, which shows frames received from a Stream like Serial. Must be enabled explicitly.
+//#define ENABLE_NEOPATTERNS_SEQUENCER // Enables startSequence() for pattern sequences in PROGMEM, see NeoSequence.h. Requires 14 bytes RAM per object.
+#if defined(ENABLE_NEOPATTERNS_SEQUENCER)
+#include "NeoSequence.h"
+#endif
+
 #if !defined(__AVR__) && !defined(PROGMEM)
 #define PROGMEM
 #endif
 
-#define VERSION_NEOPATTERNS "3.4.1"
+#define VERSION_NEOPATTERNS "3.5.0"
 #define VERSION_NEOPATTERNS_MAJOR 3
-#define VERSION_NEOPATTERNS_MINOR 4
-#define VERSION_NEOPATTERNS_PATCH 1
+#define VERSION_NEOPATTERNS_MINOR 5
+#define VERSION_NEOPATTERNS_PATCH 0
 // The change log is at the bottom of the file
 
 /*
@@ -70,7 +80,8 @@ extern const char *const PatternNamesArray[] PROGMEM;
 || defined(ENABLE_PATTERN_SCANNER_EXTENDED) || defined(ENABLE_PATTERN_STRIPES) || defined(ENABLE_PATTERN_FLASH) \
 || defined(ENABLE_PATTERN_TWINKLE) || defined(ENABLE_PATTERN_PROCESS_SELECTIVE) \
 || defined(ENABLE_PATTERN_HEARTBEAT) || defined(ENABLE_PATTERN_FIRE) || defined(ENABLE_PATTERN_EMBER) || defined(ENABLE_PATTERN_BOUNCING_BALL) \
-|| defined(ENABLE_PATTERN_USER_PATTERN1) || defined(ENABLE_PATTERN_USER_PATTERN2)  \
+|| defined(ENABLE_PATTERN_USER_PATTERN1) || defined(ENABLE_PATTERN_USER_PATTERN2) || defined(ENABLE_PATTERN_REGISTRY) \
+|| defined(ENABLE_PATTERN_PLAY_ANIMATION) || defined(ENABLE_PATTERN_SERIAL_INGEST) \
 || defined(ENABLE_NO_NEO_PATTERN_BY_DEFAULT) ))
 #define ENABLE_PATTERN_RAINBOW_CYCLE
 #define ENABLE_PATTERN_COLOR_WIPE
@@ -89,7 +100,7 @@ extern const char *const PatternNamesArray[] PROGMEM;
 #   endif
 #endif
 
-// Pattern types supported: Can be used as index of PatternNamesArray
+// Pattern types supported: Up to LAST_NEO_PATTERN and for matrix patterns they can be used as index of PatternNamesArray
 #define PATTERN_NONE                0
 #define PATTERN_RAINBOW_CYCLE       1
 #define PATTERN_COLOR_WIPE          2
@@ -113,6 +124,64 @@ extern const char *const PatternNamesArray[] PROGMEM;
 
 #define LAST_NEO_PATTERN           PATTERN_USER_PATTERN2 // Used for enumeration of matrix patterns
 
+/*
+ * Patterns added after the matrix patterns. They have their own range above the matrix patterns,
+ * so that the numbers of the matrix patterns and of SPECIAL_PATTERN_SNAKE stay unchanged.
+ * Their names follow MatrixExtraPatternSnake in PatternNamesArray.
+ */
+#define PATTERN_EXTENDED_FIRST     0x40
+#define PATTERN_PLAY_ANIMATION     0x40
+#define PATTERN_SERIAL_INGEST      0x41
+#define PATTERN_EXTENDED_LAST      PATTERN_SERIAL_INGEST
+#define PATTERN_NAMES_INDEX_OF_EXTENDED_FIRST   22 // Index of the name of PATTERN_EXTENDED_FIRST in PatternNamesArray
+
+/*
+ * Pattern numbers of patterns provided by the registry of the main program, see registerPatterns().
+ * Entry n of the registry array has the pattern number PATTERN_REGISTERED_FIRST + n.
+ */
+#define PATTERN_REGISTERED_FIRST   0x80
+#define PATTERN_REGISTERED_LAST    0xFE
+
+#if defined(ENABLE_PATTERN_SERIAL_INGEST)
+/*
+ * Frame format of the SerialIngest pattern, similar to TPM2, but with checksum:
+ * SERIAL_INGEST_START_BYTE, SERIAL_INGEST_DATA_FRAME, payload length high byte, payload length low byte,
+ * payload, checksum, SERIAL_INGEST_END_BYTE.
+ * The payload contains the pixel bytes in the byte order of the pixel type, e.g. G, R, B for NEO_GRB, starting at pixel 0.
+ * Bytes exceeding the pixel buffer are ignored, pixels not contained in the payload keep their color.
+ * The checksum is SERIAL_INGEST_CHECKSUM_SEED XOR both length bytes XOR all payload bytes.
+ *
+ * Flow control:
+ * The device sends SERIAL_INGEST_CREDIT for each SERIAL_INGEST_CHUNK_SIZE bytes read from the stream.
+ * The host must not send more than SERIAL_INGEST_WINDOW_SIZE bytes, for which no credit was received.
+ * After the end byte of a frame, the host must wait for SERIAL_INGEST_ACK (frame shown) or SERIAL_INGEST_NAK (frame invalid),
+ * since interrupts are disabled during show() on AVR and received bytes would get lost.
+ * SERIAL_INGEST_ACK is also sent at the start of the pattern.
+ * The default window fits into the 64 byte receive buffer of AVR. See extras/SerialIngest.py for a host implementation.
+ */
+#define SERIAL_INGEST_START_BYTE    0xC9
+#define SERIAL_INGEST_DATA_FRAME    0xDA
+#define SERIAL_INGEST_END_BYTE      0x36
+#define SERIAL_INGEST_CHECKSUM_SEED 0x55
+#define SERIAL_INGEST_ACK           0x06 // ASCII ACK
+#define SERIAL_INGEST_NAK           0x15 // ASCII NAK
+#define SERIAL_INGEST_CREDIT        0x11 // ASCII XON
+#if !defined(SERIAL_INGEST_CHUNK_SIZE)
+#define SERIAL_INGEST_CHUNK_SIZE    16
+#endif
+#define SERIAL_INGEST_WINDOW_SIZE   (2 * SERIAL_INGEST_CHUNK_SIZE)
+
+// States of the frame parser
+#define SERIAL_INGEST_STATE_WAIT_FOR_START  0
+#define SERIAL_INGEST_STATE_FRAME_TYPE      1
+#define SERIAL_INGEST_STATE_LENGTH_HIGH     2
+#define SERIAL_INGEST_STATE_LENGTH_LOW      3
+#define SERIAL_INGEST_STATE_PAYLOAD         4
+#define SERIAL_INGEST_STATE_CHECKSUM        5
+#define SERIAL_INGEST_STATE_END             6
+#define SERIAL_INGEST_STATE_SHOW_PENDING    7 // Valid frame received, ACK is sent at the next receiveSerialIngestFrame()
+#endif
+
 /*
  * Values for Direction
  */
@@ -142,6 +211,20 @@ const char* DirectionToString(uint8_t aDirection);
 #define SHOW_ONLY_AT_PATTERN_UPDATE     true
 #define SHOW_ALSO_AT_PATTERN_START      false
 
+//#define DO_NOT_SUPPORT_TIMING_POLICIES // Disables setTimingPolicy() and the exact wall clock duration of the *Duration() functions.
+#if !defined(DO_NOT_SUPPORT_TIMING_POLICIES)
+#define SUPPORT_TIMING_POLICIES // Introduced to avoid double negations
+#endif
+/*
+ * Values for setTimingPolicy()
+ */
+#define TIMING_POLICY_RESET_PHASE   0x00 // Default. Next update is scheduled Interval after the end of the last update. A late update delays all following ones.
+#define TIMING_POLICY_CATCH_UP      PIXEL_FLAG_TIMING_DRIFT_FREE // Next update is scheduled Interval after the scheduled time of the last update. Missed steps are caught up by the next update() calls.
+#define TIMING_POLICY_SKIP_FRAMES   (PIXEL_FLAG_TIMING_DRIFT_FREE | PIXEL_FLAG_TIMING_SKIP_FRAMES) // Like CATCH_UP, but all due steps are processed by one update() and only the last one is shown.
+#if !defined(MAXIMUM_CATCH_UP_MILLIS)
+#define MAXIMUM_CATCH_UP_MILLIS     1000 // If an update is later than this, the schedule is restarted at millis()
+#endif
+
 // Definitions for parameter aEnableChildOverlay
 #define ENABLE_CHILD_OVERLAY            true
 #define DISABLE_CHILD_OVERLAY           false
@@ -158,10 +241,118 @@ const char* DirectionToString(uint8_t aDirection);
 #define DO_REDRAW_IF_NO_UPDATE          true
 #define DO_NO_REDRAW_IF_NO_UPDATE       false
 
+//#define ENABLE_NEOPATTERNS_STATISTICS // Records update, show and timing statistics for each NeoPatterns object. Requires 26 bytes RAM per object.
+#if defined(ENABLE_NEOPATTERNS_STATISTICS)
+struct NeoPatternsStatisticsStruct {
+    uint32_t UpdateCount;               // Number of scheduled updates
+    uint32_t UpdateMicrosSum;           // Time spent in _update() or the matrix pattern updates
+    uint16_t UpdateMicrosMax;
+    uint16_t ShowCount;                 // Number of show() called by an update function
+    uint32_t ShowMicrosSum;             // Time spent in this show() calls
+    uint16_t MissedDeadlineCount;       // Number of updates, which started later than lastUpdate + Interval + 1
+    uint16_t LateMillisMax;             // Maximum delay of an update relative to lastUpdate + Interval + 1
+    uint32_t LateMillisSum;
+    uint16_t CompletionCallbackCount;   // Number of completion callbacks fired
+};
+#endif
+
+//#define ENABLE_NEOPATTERNS_JITTER_HISTOGRAM // Records a log2 histogram of update delays for each NeoPatterns object and of the loop period. Requires 8 bytes RAM per object.
+#if defined(ENABLE_NEOPATTERNS_JITTER_HISTOGRAM)
+/*
+ * Bin 0 counts the value 0, bin 1 the value 1, bin n the values from 2^(n-1) to 2^n - 1 and the last bin all values >= 64.
+ * If one bin reaches 255, all bins are halved, so the distribution is kept.
+ */
+#define JITTER_HISTOGRAM_SIZE   8
+struct JitterHistogramStruct {
+    uint8_t Bins[JITTER_HISTOGRAM_SIZE];
+};
+void addToJitterHistogram(JitterHistogramStruct *aHistogram, unsigned long aValue);
+void printJitterHistogram(Print *aSerial, JitterHistogramStruct *aHistogram);
+#endif
+
+/*
+ * Do not enable it, if your program draws over a Stripes pattern between its updates.
+ * Partial objects and objects with child NeoPatterns objects always redraw the complete pattern.
+ */
+//#define ENABLE_INCREMENTAL_UPDATE // Enables shifting the pixel buffer for Stripes update instead of redrawing the pattern.
+#define BUFFER_BRIGHTNESS_INVALID   0xFFFF // Value of LongValue2.BufferBrightness, which forces a complete redraw
+
+//#define ENABLE_SCANNER_EXTENDED_TAIL_CACHE // ScannerExtended computes its dimmed tail pixels once at start and copies them at each update. Requires 5 bytes RAM per object and PatternLength * BytesPerPixel bytes heap.
+
+//#define ENABLE_NEOPATTERNS_RENDER_AT // Enables renderAt() and setPatternStep() for RainbowCycle, ColorWipe, Fade, Stripes, Flash, Heartbeat and ScannerExtended. Requires 7 bytes RAM per object.
+
+/*
+ * Streaming output for strips, whose pixel buffer does not fit into RAM. Requires an AVR with 16 MHz and 800 kHz strips.
+ * beginStreaming() frees the pixel buffer and NeoPixel::show() computes the color of each pixel by colorAt() while sending it.
+ * Only RainbowCycle, ColorWipe, Fade, Heartbeat, Stripes and Flash can be streamed. The update of any other pattern
+ * calls endStreaming(), which allocates the pixel buffer and thus falls back to the buffered output.
+ * Between two pixels, the data line is low while the next pixel is computed, which takes up to 40 us.
+ * Interrupts are disabled for the whole frame, so no interrupt service routine can extend this gap,
+ * but the strip must have a reset time of at least 50 us like the WS2812B.
+ */
+//#define ENABLE_STREAMING_OUTPUT // Requires 1 byte RAM per object.
+
+#if defined(ENABLE_NEOPATTERNS_STATISTICS) || defined(ENABLE_NEOPATTERNS_JITTER_HISTOGRAM)
+#define _RECORD_UPDATE_TIMING // Introduced to avoid double conditions at the update functions
+#endif
+
+#if defined(ENABLE_PATTERN_TWINKLE)
+/*
+ * One active pixel of the Twinkle and Sparkle pattern
+ */
+#define SPARKLE_PIXEL_UNUSED    0xFFFF
+#define SPARKLE_MAXIMUM_TRIES   4 // Number of random positions tried for a new pixel, which is not already active
+struct SparklePixelStruct {
+    uint16_t PixelIndex;        // SPARKLE_PIXEL_UNUSED if record is not used
+    uint8_t WheelPosition;      // Color if Color1 is COLOR32_SPECIAL
+    uint8_t Age;                // Number of updates since pixel was set
+};
+#endif
+
+//#define ENABLE_PATTERN_REGISTRY // Enables patterns of the main program registered by registerPatterns(). Requires 3 bytes RAM and around 200 bytes program memory.
+#if defined(ENABLE_PATTERN_REGISTRY)
+class NeoPatterns;
+/*
+ * One entry of the pattern registry, which must be located in PROGMEM.
+ * The pattern number is PATTERN_REGISTERED_FIRST + index of the entry and must be set by the init function as ActivePattern.
+ */
+struct PatternRegistryEntryStruct {
+    void (*InitFunction)(NeoPatterns *aNeoPatterns); // Starts the pattern with default parameters, used by startRegisteredPattern(). Can be nullptr.
+    bool (*UpdateFunction)(NeoPatterns *aNeoPatterns, bool aDoUpdate); // Like the built in *Update() functions
+    const char *NamePGM;                                // Name in PROGMEM, used by printPatternName()
+};
+#endif
+
+#if defined(ENABLE_STREAMING_OUTPUT) || defined(ENABLE_NEOPATTERNS_SEQUENCER)
+#define _SUPPORT_EXTENDED_PATTERN_STATE
+/*
+ * State of the streaming output and the sequencer.
+ * It is one struct, so that a PatternSegment can store and load it as a whole.
+ */
+struct ExtendedPatternStateStruct {
+#  if defined(ENABLE_NEOPATTERNS_SEQUENCER)
+    /*
+     * State of the sequence started by startSequence()
+     */
+    const uint8_t *SequencePGM;         // nullptr if no sequence is running
+    uint16_t SequenceOffset;            // Offset of the next step to execute
+    uint8_t SequenceLoopDepth;          // Number of active loops
+    SequenceLoopStruct SequenceLoops[SEQUENCE_MAX_LOOP_DEPTH];
+#  endif
+#  if defined(ENABLE_STREAMING_OUTPUT)
+    bool StreamingShowIsPending;        // The show() of showPatternInitially() is done by the next update(), since ActivePattern is not yet set
+#  endif
+};
+#endif
+
 // NeoPattern Class - derived from the NeoPixel and Adafruit_NeoPixel class
 // virtual to enable double inheritance of the NeoPixel functions and the NeoPatterns ones.
-// SIZE = 39 bytes + 28 from NeoPixel = 67
+// SIZE = 39 bytes + 3 for timing policies + 2 for Twinkle + 2 for ProcessSelectiveColor + 30 from NeoPixel = 76 with default options
+#if defined(ENABLE_NON_VIRTUAL_INHERITANCE)
+class NeoPatterns: public NeoPixel {
+#else
 class NeoPatterns: public virtual NeoPixel {
+#endif
 public:
     NeoPatterns();
     void init();
@@ -178,6 +369,21 @@ public:
     void _insertIntoNeopatternsList();
 
     void setCallback(void (*callback)(NeoPatterns*));
+#if defined(SUPPORT_TIMING_POLICIES)
+    void setTimingPolicy(uint8_t aTimingPolicy);
+#endif
+    void setDurationInterval(uint16_t aCompleteDurationMillis);
+    void resetDurationTiming();
+    void startSchedule();
+    uint8_t getPatternStartCount();
+    void scheduleNextUpdate();
+    void scheduleNextUpdate(uint8_t aPatternStartCountBeforeStep);
+    bool _updateAndSkipDueSteps();
+#if defined(ENABLE_NEOPATTERNS_RENDER_AT)
+    uint16_t getPatternStep();
+    bool setPatternStep(uint16_t aPatternStep);
+    bool renderAt(uint32_t aMillisSincePatternStart);
+#endif
 
     bool isActive();
     bool checkForUpdate();
@@ -189,11 +395,25 @@ public:
     bool updateOrRedraw(bool aDoRedrawIfNoUpdate);
     bool updateOrRedraw(bool aDoRedrawIfNoUpdate, uint8_t aBrightness);
 
+#if defined(ENABLE_STREAMING_OUTPUT)
+    bool beginStreaming(uint16_t aNumberOfPixels = 0);
+    bool endStreaming();
+    bool isStreaming();
+    static bool isStreamablePattern(uint8_t aPatternNumber);
+    color32_t colorAt(uint16_t aPixelIndex);
+    void showStreaming();
+    static void showStreamingOfNeoPixel(NeoPixel *aNeoPixel);
+    void encodePixelColorToBitSlices(color32_t aColor, uint8_t *aBitSlices);
+#endif
+
     void stop();
 
     void updateShowAndWaitForPatternToStop();
     void updateShowAndWaitForPatternToStop(uint8_t aBrightness);
     bool updateAndShowAlsoAllChildPatterns(bool aEnableChildOverlay = DISABLE_CHILD_OVERLAY);
+#if defined(ENABLE_INCREMENTAL_UPDATE)
+    bool hasChildPatterns();
+#endif
     bool updateAndShowAlsoAllChildPatterns(uint8_t aBrightness, bool aEnableChildOverlay = DISABLE_CHILD_OVERLAY);
     void updateAndShowAlsoAllChildPatternsAndWaitForPatternsToStop(bool aEnableChildOverlay = DISABLE_CHILD_OVERLAY);
     void updateAndShowAlsoAllChildPatternsAndWaitForPatternsToStop(uint8_t aBrightness, bool aEnableChildOverlay =
@@ -220,6 +440,8 @@ public:
             __attribute__ ((deprecated ("Renamed to updateAndShowAlsoAllChildPatternsAndWaitForPatternsToStop()")));
 
     void showPatternInitially();
+    void freePatternMemory();
+    void freePatternMemoryAtLastStep();
     bool decrementTotalStepCounter();
     void setCompensatedInterval(uint16_t aIntervalToCompensate);
     void setNextIndex();
@@ -234,7 +456,7 @@ public:
     void RainbowCycle(uint8_t aIntervalMillis, uint8_t aDirection = DIRECTION_UP, uint8_t aRepetitions = 1);
     void RainbowCycleD(uint8_t aCompleteDurationMillis, uint8_t aDirection = DIRECTION_UP, uint8_t aRepetitions = 1)
             __attribute__ ((deprecated ("Renamed to RainbowCycleDuration()")));
-    void RainbowCycleDuration(uint8_t aCompleteDurationMillis, uint8_t aDirection = DIRECTION_UP, uint8_t aRepetitions = 1);
+    void RainbowCycleDuration(uint16_t aCompleteDurationMillis, uint8_t aDirection = DIRECTION_UP, uint8_t aRepetitions = 1);
     bool RainbowCycleUpdate(bool aDoUpdate = UPDATE_AND_DRAW_NEW_PATTERN);
 #endif
 #if defined(ENABLE_PATTERN_COLOR_WIPE)
@@ -250,6 +472,7 @@ public:
     void Fade(color32_t aColorStart, color32_t aColorEnd, uint16_t aNumberOfSteps, uint16_t aIntervalMillis);
     void FadeDuration(color32_t aColorStart, color32_t aColorEnd, uint16_t aNumberOfSteps, uint16_t aCompleteDurationMillis);
     bool FadeUpdate(bool aDoUpdate = UPDATE_AND_DRAW_NEW_PATTERN);
+    color32_t getFadeColor();
 #endif
 
     /*
@@ -285,6 +508,11 @@ public:
     void ScannerExtendedDuration(color32_t aColor, uint8_t aLength, uint16_t aCompleteDurationMillis, uint16_t aNumberOfBouncings =
             0, uint8_t aMode = 0, uint8_t aDirection = DIRECTION_UP);
     bool ScannerExtendedUpdate(bool aDoUpdate = UPDATE_AND_DRAW_NEW_PATTERN);
+#  if defined(ENABLE_SCANNER_EXTENDED_TAIL_CACHE)
+    void computeScannerExtendedTailCache();
+    void freeScannerExtendedTailCache();
+    uint8_t drawScannerExtendedTailFromCache();
+#  endif
 #endif
 
 #if defined(ENABLE_PATTERN_HEARTBEAT)
@@ -295,13 +523,21 @@ public:
 #if defined(ENABLE_PATTERN_TWINKLE)
     void Twinkle(color32_t aColorSpecial, uint8_t aPercentageOfStripFilling, uint16_t aIntervalMillis, uint16_t aRepetitions,
             bool aDoNotClearBefore = CLEAR_PATTERN_BEFORE);
+    void Sparkle(color32_t aColorSpecial, uint8_t aFadeSteps, uint16_t aIntervalMillis, uint16_t aNumberOfSteps);
     bool TwinkleUpdate(bool aDoUpdate = UPDATE_AND_DRAW_NEW_PATTERN);
+    void allocateSparklePixelArray(uint16_t aArraySize);
+    void freeSparklePixelArray();
+    uint16_t getSparklePixelArraySize();
+    void updateSparklePixels(bool aDoUpdate);
+    void drawSparklePixel(struct SparklePixelStruct *aSparklePixelPtr);
 #endif
 
 #if defined(ENABLE_PATTERN_PROCESS_SELECTIVE)
     void ProcessSelectiveColor(color32_t aColorForSelection, color32_t (*aSingleLEDProcessingFunction)(NeoPatterns*),
             uint16_t aNumberOfSteps, uint16_t aIntervalMillis);
     bool ProcessSelectiveColorUpdate(bool aDoUpdate = UPDATE_AND_DRAW_NEW_PATTERN);
+    void createSelectionMask();
+    void freeSelectionMask();
 #endif
 
 #if defined(ENABLE_PATTERN_FIRE)
@@ -309,10 +545,14 @@ public:
     bool FireUpdate(bool aDoUpdate = UPDATE_AND_DRAW_NEW_PATTERN);
 #endif
 #if defined(ENABLE_PATTERN_EMBER)
+#define EMBER_MODE_RANDOM   0 // Start heat of each pixel is random between min and max heat
+#define EMBER_MODE_GRADIENT 1 // Start heat decreases from max heat at first pixel to min heat at last pixel
     void Ember(uint8_t aMinHeatValue, uint8_t aMaxHeatValue, uint8_t aMode, uint8_t aIncreaseIntervalFactor,
             uint16_t aNumberOfDecreasingSteps, uint16_t aIntervalMillis);
     void initEmberHeat(uint8_t aMinHeatValue, uint8_t aMaxHeatValue, uint8_t aMode);
     bool EmberUpdate(bool aDoUpdate = UPDATE_AND_DRAW_NEW_PATTERN);
+    uint8_t getEmberStartHeat(uint16_t aPixelIndex);
+    uint8_t getEmberNewTargetHeat(uint8_t aCeilingHeat);
 #endif
 
     void convertHeatToColor();
@@ -338,25 +578,79 @@ public:
 #if defined(ENABLE_PATTERN_USER_PATTERN2)
     bool Pattern2Update(bool aDoUpdate = UPDATE_AND_DRAW_NEW_PATTERN);
 #endif
+#if defined(ENABLE_PATTERN_PLAY_ANIMATION)
+    void PlayAnimation(NeoAnimation *aAnimation, uint8_t aRepetitions = 1, uint16_t aIntervalMillis = 0);
+    bool PlayAnimationUpdate(bool aDoUpdate = UPDATE_AND_DRAW_NEW_PATTERN);
+#endif
+#if defined(ENABLE_PATTERN_SERIAL_INGEST)
+    void SerialIngest(Stream *aStream, uint16_t aTimeoutMillis = 0);
+    bool SerialIngestUpdate(bool aDoUpdate = UPDATE_AND_DRAW_NEW_PATTERN);
+    bool receiveSerialIngestFrame();
+    bool checkSerialIngestTimeout();
+#endif
+#if defined(ENABLE_NEOPATTERNS_SEQUENCER)
+    void startSequence(const uint8_t *aSequencePGM, void (*aNextOnCompleteHandler)(NeoPatterns*) = nullptr);
+    bool isSequenceRunning();
+    bool startNextSequenceStep();
+    bool startSequencePattern(const uint8_t *aStepPGM);
+#endif
+#if defined(ENABLE_PATTERN_REGISTRY)
+    static void registerPatterns(const PatternRegistryEntryStruct *aPatternRegistryArrayPGM, uint8_t aNumberOfRegisteredPatterns);
+    static bool isRegisteredPattern(uint8_t aPatternNumber);
+    bool startRegisteredPattern(uint8_t aPatternNumber);
+    bool RegisteredPatternUpdate(bool aDoUpdate = UPDATE_AND_DRAW_NEW_PATTERN);
+#endif
 
     void ProcessSelectiveColorForAllPixel();
 
+    static uint8_t getPatternNamesIndex(uint8_t aPatternNumber);
 #if defined(__AVR__)
     void getPatternName(uint8_t aPatternNumber, char *aBuffer, uint8_t aBuffersize);
 #else
-    // use PatternNamesArray[aPatternNumber] on other platforms
+    // use PatternNamesArray[getPatternNamesIndex(aPatternNumber)] on other platforms
 #endif
     void printPatternName(uint8_t aPatternNumber, Print *aSerial);
     void printInfo(Print *aSerial, bool aFullInfo = true);
     void printPattern(Print *aSerial);
     void printlnPattern(Print *aSerial);
 
+#if defined(_RECORD_UPDATE_TIMING)
+    unsigned long startUpdateStatistics();
+    unsigned long addUpdateStatistics(unsigned long aStartMicros);
+    void addShowStatistics(unsigned long aStartMicros);
+#endif
+#if defined(ENABLE_NEOPATTERNS_STATISTICS)
+    void resetStatistics();
+    void printStatistics(Print *aSerial);
+    NeoPatternsStatisticsStruct Statistics;
+#endif
+#if defined(ENABLE_NEOPATTERNS_JITTER_HISTOGRAM)
+    void printJitterHistogram(Print *aSerial);
+    static void recordLoopPeriod();
+    JitterHistogramStruct LateMillisHistogram;          // Delay of the update relative to lastUpdate + Interval + 1
+    static JitterHistogramStruct LoopPeriodHistogram;   // Milliseconds between two calls of recordLoopPeriod()
+#endif
+
     /*
      * Internal control variables
      */
     uint8_t ActivePattern; // Number of pattern which is running. If no callback activated, set to PATTERN_NONE in decrementTotalStepCounter().
     uint16_t Interval;   // Milliseconds between updates
     unsigned long lastUpdate; // Milliseconds of last update of pattern. Set by decrementTotalStepCounter(), showPatternInitially() or XXXupdate()
+#if defined(SUPPORT_TIMING_POLICIES)
+    uint8_t IntervalFraction;       // 1/256 ms fraction of Interval, set by setDurationInterval()
+    uint8_t IntervalFractionSum;    // Sum of fractions for drift free scheduling
+    uint8_t PatternStartCounter;    // Incremented by startSchedule(), to detect a pattern started by the completion callback within a step
+#endif
+#if defined(ENABLE_NEOPATTERNS_RENDER_AT)
+    /*
+     * Values at pattern start, stored by showPatternInitially() for setPatternStep()
+     */
+    int16_t StartTotalStepCounter;
+    int16_t StartIndex;
+    uint16_t StartNumberOfBouncings; // ScannerExtended
+    int8_t StartDirection;
+#endif
 
     void (*OnPatternComplete)(NeoPatterns*); // Callback on completion of pattern. This should set aLedsPtr->ActivePattern = PATTERN_NONE; if no other pattern is started.
 
@@ -392,6 +686,8 @@ public:
         uint8_t Cooling;            // Fire: Cooling
         uint8_t NumberOfFlakes;     // Snow: Number of flakes
         uint8_t AverageNumberOfActivePixel;     // Twinkle: AverageNumberOfActivePixel
+        uint8_t MinHeatValue;       // Ember: Minimum heat value of a pixel
+        uint8_t IngestState;        // SerialIngest: State of the frame parser
     } ByteValue1;
 
     /*
@@ -401,12 +697,15 @@ public:
         uint8_t PatternLength;          // 2. length of a (stripes) pattern
         uint8_t SnakeAutorunStep;
         uint8_t ScannerIntervalMillis;  // for delay of multiple falling stars
+        uint8_t FadeSteps;              // Sparkle: Number of steps until a pixel is faded out, 0 for Twinkle
+        uint8_t MaxHeatValue;           // Ember: Maximum heat value of a pixel
+        uint8_t AnimationRepetitions;   // PlayAnimation: Remaining repetitions, 0 for endless
     } ByteValue2;
 
     union {
         color32_t BackgroundColor;
         color32_t Color2;               // second pattern color
-        uint8_t *PixelHeatArrayPtr;   // Allocated array for current heat values for Fire + Ember pattern
+        uint8_t *PixelHeatArrayPtr;   // Allocated array for current heat values for Fire and current + target heat value pairs for Ember pattern
         uint16_t StartIntervalMillis;   // BouncingBall: interval for first step
         uint16_t NumberOfBouncings;     // ScannerExtended: Number of bounces
         uint32_t LongValue;
@@ -416,12 +715,22 @@ public:
         color32_t ColorTmp;         // Temporary color for dim and lightenColor() and for FadeSelectiveColor, ProcessSelectiveColor.
         float TopPixelIndex;            // BouncingBall: float index of TopPixel
         uint16_t DeltaBrightnessShift8; // ScannerExtended: Delta for each step for
+        uint16_t BufferBrightness;      // Stripes: Brightness of the current pixel buffer content for incremental update
+        uint16_t WheelIndexHighResolutionDelta; // RainbowCycle: Wheel index delta between two pixels for colorAt()
         struct {
             uint16_t Interval1;             // Flash: interval for color1
             uint16_t Interval2;             // Flash: interval for color2
         } Intervals;
         uint32_t LongValue2;
-        uint8_t *PixelTargetHeatArrayPtr;   // Allocated array for target heat values for Ember pattern
+        struct {
+            uint16_t Seed;                      // Ember: Seed for the per pixel start heat
+            uint16_t NumberOfDecreasingSteps;   // Ember: Number of steps to cool down to black
+        } EmberValues;
+        struct {
+            uint16_t FrameLength;       // SerialIngest: Payload length of the current frame
+            uint8_t Checksum;           // SerialIngest: Checksum of the current frame
+            uint8_t UncreditedBytes;    // SerialIngest: Bytes read since the last SERIAL_INGEST_CREDIT
+        } IngestValues;
         void *Pointer2;
     } LongValue2;
 
@@ -429,23 +738,59 @@ public:
         // for ProcessSelectiveColor could not be member of the first 2 values, since these are used by the processing functions like fadeColor()
         uint32_t (*SingleLEDProcessingFunction)(NeoPatterns*);
         void *Pointer1;
-        uint8_t *PixelStartHeatArrayPtr;   // Allocated array for start heat values for Ember pattern
+        uint8_t IncreaseIntervalFactor; // Ember: Heat is only increased every IncreaseIntervalFactor step
+#if defined(ENABLE_PATTERN_PLAY_ANIMATION)
+        NeoAnimation *Animation;        // PlayAnimation: Animation to decode
+#endif
+#if defined(ENABLE_PATTERN_SERIAL_INGEST)
+        Stream *IngestStream;           // SerialIngest: Stream to read the frames from
+#endif
     } Pointer1; // can be 16 bit for AVR and 32 bit for other platforms
 
+#if defined(ENABLE_PATTERN_TWINKLE)
+    struct SparklePixelStruct *SparklePixelArrayPtr; // Twinkle + Sparkle: Allocated array of active pixels, freed by the next pattern
+#endif
+#if defined(ENABLE_PATTERN_PROCESS_SELECTIVE)
+    uint8_t *SelectionMaskPtr;      // ProcessSelectiveColor: Allocated bit array of the selected pixels
+#endif
+#if defined(ENABLE_SCANNER_EXTENDED_TAIL_CACHE)
+    /*
+     * Encoded pixels of the ScannerExtended tail. Allocated by ScannerExtended(), freed at its end or by the next pattern.
+     */
+    uint8_t *TailCachePtr;
+    uint8_t TailCacheSize;          // Number of pixels allocated for TailCachePtr
+    uint8_t TailCacheLength;        // Number of not black tail pixels in cache
+    uint8_t TailCacheBrightness;    // Brightness used for encoding the cache
+#endif
+
     /*
      * for multiple pattern extensions
      */
     uint16_t Repetitions;               // counter for multipleHandler
     void (*NextOnPatternCompleteHandler)(NeoPatterns*);  // Next callback after completion of multiple pattern
+#if defined(_SUPPORT_EXTENDED_PATTERN_STATE)
+    ExtendedPatternStateStruct ExtendedState;
+#endif
     /*
      * List of all NeoPatterns
      */
     NeoPatterns *NextNeoPatternsObject;
 
     static NeoPatterns *FirstNeoPatternsObject;
+
+#if defined(ENABLE_PATTERN_REGISTRY)
+    static const PatternRegistryEntryStruct *PatternRegistryArrayPGM;
+    static uint8_t NumberOfRegisteredPatterns;
+#endif
 };
 
 void stopAllPatterns();
+#if defined(ENABLE_NEOPATTERNS_STATISTICS)
+void printAllStatistics(Print *aSerial);
+#endif
+#if defined(ENABLE_NEOPATTERNS_JITTER_HISTOGRAM)
+void printAllJitterHistograms(Print *aSerial);
+#endif
 
 #define ENDLESS_HANDLER_POINTER ((void (*)(NeoPatterns*)) 1) // currently for initMultipleFallingStars()
 
@@ -461,6 +806,10 @@ void initMultipleFallingStars(NeoPatterns *aLedsPtr, color32_t aColor, uint8_t a
 void multipleFallingStarsCompleteHandler(NeoPatterns *aLedsPtr);
 #endif
 
+#if defined(ENABLE_NEOPATTERNS_SEQUENCER)
+void sequenceCompleteHandler(NeoPatterns *aLedsPtr);
+#endif
+
 #if defined(ENABLE_PATTERN_SCANNER_EXTENDED) && defined(ENABLE_PATTERN_RAINBOW_CYCLE) && defined(ENABLE_PATTERN_STRIPES) \
     && defined(ENABLE_PATTERN_FADE) && defined(ENABLE_PATTERN_COLOR_WIPE) && defined(ENABLE_PATTERN_HEARTBEAT)
 void allPatternsRandomHandler(NeoPatterns *aLedsPtr);
@@ -476,6 +825,38 @@ void __attribute__((weak)) UserPattern2(NeoPatterns *aNeoPatterns, color32_t aCo
 #endif
 
 /*
+ * Version 3.5.0 - 10/2026
+ * - Measured show() duration and compensation of millis() missed during show() for all pattern schedules.
+ * - Added ENABLE_NEOPATTERNS_STATISTICS and printStatistics().
+ * - Added ENABLE_NEOPATTERNS_JITTER_HISTOGRAM and printJitterHistogram().
+ * - Added timing policies TIMING_POLICY_CATCH_UP and TIMING_POLICY_SKIP_FRAMES.
+ * - *Duration() functions now complete in the requested wall clock time.
+ * - A pattern started by the completion callback or Delay() is no longer delayed by the schedule of the completed one.
+ * - Fixed RainbowCycleDuration(), which had only 8 bit duration and ignored aRepetitions.
+ * - Added ENABLE_NEOPATTERNS_RENDER_AT, renderAt() and setPatternStep().
+ * - Stripes update only shifts the pixel buffer and computes the new pixel, if ENABLE_INCREMENTAL_UPDATE is defined.
+ * - Added replicatePeriod(), which is used by setColor() for RGB and RGBW and by Stripes and Flash.
+ * - Added ENABLE_SCANNER_EXTENDED_TAIL_CACHE.
+ * - Twinkle only handles the active pixels, if started with clear. New pattern variant Sparkle with fading pixels.
+ * - ProcessSelectiveColor() selects the pixels only once at start. Requires 2 bytes RAM per object.
+ * - Implemented Ember pattern.
+ * - Added class PatternSegment.
+ * - Added ENABLE_NON_VIRTUAL_INHERITANCE.
+ * - Added ENABLE_PATTERN_REGISTRY, registerPatterns() and startRegisteredPattern() for any number of user patterns.
+ * - Added getAndAdjustActualNeopixelLenghtBisection().
+ * - Added class NeoPixelParallelGroup.
+ * - Added ENABLE_STREAMING_OUTPUT, beginStreaming() and colorAt() for output without pixel buffer.
+ * - Added ENABLE_INDEXED_PIXEL_BUFFER and beginIndexedPixelBuffer() for 4 or 8 bit palette indexed pixel buffers.
+ * - Added class NeoAnimation and pattern PlayAnimation for pre-rendered animations with keyframes and delta frames.
+ * - New pattern numbers PATTERN_PLAY_ANIMATION and PATTERN_SERIAL_INGEST start at PATTERN_EXTENDED_FIRST, the matrix pattern numbers are unchanged.
+ * - Added compile option ENABLE_ANIMATION_RECORDER and class NeoAnimationRecorder.
+ * - Added show hooks NeoPixel::addShowHook() and removeShowHook(), recorder and telemetry can be active at the same time.
+ * - Added pattern SerialIngest, which reads frames with flow control from a Stream directly into the pixel buffer.
+ * - Added class NeoDmxReceiver for Art-Net and E1.31 with back buffers, which are copied to the pixel buffers in loop().
+ * - Added compile option ENABLE_NEOPIXEL_TELEMETRY and class NeoPixelTelemetry.
+ * - Added compile option ENABLE_CROSSFADE_TRANSITION and function startCrossfade().
+ * - Added ENABLE_NEOPATTERNS_SEQUENCER and startSequence() for pattern sequences in PROGMEM and host tool extras/SequenceValidator.
+ *
  * Version 3.4.1 - 02/2026
  * . Minor improvements.
  *
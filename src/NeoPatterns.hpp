@@ -48,6 +48,12 @@
 
 // include sources
 #include "NeoPixel.hpp"
+#if defined(ENABLE_PATTERN_PLAY_ANIMATION) || defined(ENABLE_ANIMATION_RECORDER)
+#include "NeoAnimation.hpp"
+#endif
+#if defined(ENABLE_NEOPATTERNS_SEQUENCER)
+#include "NeoSequence.hpp"
+#endif
 
 // This block must be located after the includes of other *.hpp files
 //#define LOCAL_INFO  // This enables info output only for this file
@@ -68,8 +74,11 @@ const char PatternHeartbeat[] PROGMEM ="Heartbeat";
 const char PatternFire[] PROGMEM ="Fire";
 const char PatternTwinkle[] PROGMEM ="Twinkle";
 const char PatternBouncingBall[] PROGMEM ="Bouncing ball";
+const char PatternEmber[] PROGMEM ="Ember";
 const char PatternUserPattern1[] PROGMEM ="User pattern 1";
 const char PatternUserPattern2[] PROGMEM ="User pattern 2";
+const char PatternPlayAnimation[] PROGMEM ="Play animation";
+const char PatternSerialIngest[] PROGMEM ="Serial ingest";
 
 /*
  * Include known matrix patterns
@@ -81,11 +90,12 @@ const char MatrixPatternSnow[] PROGMEM ="Snow";
 const char MatrixExtraPatternSnake[] PROGMEM ="Snake";
 const char PatternUnknown[] PROGMEM ="Unknown";
 
-// ActivePattern can be used as index of PatternNamesArray
+// ActivePattern up to SPECIAL_PATTERN_SNAKE can be used as index of PatternNamesArray, for the others use getPatternNamesIndex()
 const char *const PatternNamesArray[] PROGMEM = { PatternNone, PatternRainbowCycle, PatternColorWipe, PatternFade, PatternDelay,
         PatternScannerExtended, PatternStripes, PatternFlash, PatternProcessSelectiveColor, PatternHeartbeat, PatternFire,
-        PatternTwinkle, PatternBouncingBall, PatternUserPattern1, PatternUserPattern2, MatrixPatternTicker, MatrixPatternMove,
-        MatrixPatternMovingPicture, PatternFire, MatrixPatternSnow, MatrixExtraPatternSnake, PatternUnknown };
+        PatternTwinkle, PatternBouncingBall, PatternEmber, PatternUserPattern1, PatternUserPattern2, MatrixPatternTicker,
+        MatrixPatternMove, MatrixPatternMovingPicture, PatternFire, MatrixPatternSnow, MatrixExtraPatternSnake, PatternPlayAnimation,
+        PatternSerialIngest, PatternUnknown };
 
 // array of update function pointer, not used since it needs 150 bytes more :-(
 //bool (NeoPatterns::*sUpdateFunctionPointerArray[])(
@@ -98,6 +108,13 @@ const char *const PatternNamesArray[] PROGMEM = { PatternNone, PatternRainbowCyc
  * Start of static list of all NeoPatterns object
  */
 NeoPatterns *NeoPatterns::FirstNeoPatternsObject = nullptr;
+#if defined(ENABLE_PATTERN_REGISTRY)
+const PatternRegistryEntryStruct *NeoPatterns::PatternRegistryArrayPGM = nullptr;
+uint8_t NeoPatterns::NumberOfRegisteredPatterns = 0;
+#endif
+#if defined(ENABLE_NEOPATTERNS_JITTER_HISTOGRAM)
+JitterHistogramStruct NeoPatterns::LoopPeriodHistogram;
+#endif
 /**********************************************************************************
  * Code inspired by https://learn.adafruit.com/multi-tasking-the-arduino-part-3?view=all
  * Changed and extended for added functionality
@@ -138,6 +155,31 @@ void NeoPatterns::init() {
     OnPatternComplete = nullptr;
     ActivePattern = PATTERN_NONE;
     LongValue1.PixelHeatArrayPtr = nullptr;
+#if defined(ENABLE_PATTERN_TWINKLE)
+    SparklePixelArrayPtr = nullptr;
+#endif
+#if defined(ENABLE_PATTERN_PROCESS_SELECTIVE)
+    SelectionMaskPtr = nullptr;
+#endif
+#if defined(ENABLE_SCANNER_EXTENDED_TAIL_CACHE)
+    TailCachePtr = nullptr;
+    TailCacheSize = 0;
+#endif
+#if defined(SUPPORT_TIMING_POLICIES)
+    PatternStartCounter = 0;
+#endif
+#if defined(ENABLE_STREAMING_OUTPUT)
+    ExtendedState.StreamingShowIsPending = false;
+#endif
+#if defined(ENABLE_NEOPATTERNS_SEQUENCER)
+    ExtendedState.SequencePGM = nullptr;
+#endif
+#if defined(ENABLE_NEOPATTERNS_STATISTICS)
+    resetStatistics();
+#endif
+#if defined(ENABLE_NEOPATTERNS_JITTER_HISTOGRAM)
+    memset(&LateMillisHistogram, 0, sizeof(LateMillisHistogram));
+#endif
     _insertIntoNeopatternsList();
 }
 
@@ -207,8 +249,351 @@ void NeoPatterns::setCallback(void (*callback)(NeoPatterns*)) {
     OnPatternComplete = callback;
 }
 
+#if defined(SUPPORT_TIMING_POLICIES)
+/*
+ * Must be called before the pattern is started, since it changes the interpretation of Interval.
+ * @param aTimingPolicy TIMING_POLICY_RESET_PHASE, TIMING_POLICY_CATCH_UP or TIMING_POLICY_SKIP_FRAMES
+ */
+void NeoPatterns::setTimingPolicy(uint8_t aTimingPolicy) {
+    PixelFlags = (PixelFlags & ~(PIXEL_FLAG_TIMING_DRIFT_FREE | PIXEL_FLAG_TIMING_SKIP_FRAMES)) | aTimingPolicy;
+}
+#endif
+
+/*
+ * Resets the *Duration() settings of the previous pattern. Called at each pattern start.
+ */
+void NeoPatterns::resetDurationTiming() {
+#if defined(SUPPORT_TIMING_POLICIES)
+    PixelFlags &= ~PIXEL_FLAG_TIMING_FOR_DURATION;
+    IntervalFraction = 0;
+    IntervalFractionSum = 0;
+#endif
+}
+
+/*
+ * Starts the schedule of a new pattern at the current time.
+ * The changed pattern start count tells the caller of a step, that the completion callback has started a new pattern.
+ */
+void NeoPatterns::startSchedule() {
+    lastUpdate = getCompensatedMillis();
+#if defined(SUPPORT_TIMING_POLICIES)
+    PatternStartCounter++;
+#endif
+}
+
+/*
+ * @return the value to be passed to scheduleNextUpdate(uint8_t) after the step
+ */
+uint8_t NeoPatterns::getPatternStartCount() {
+#if defined(SUPPORT_TIMING_POLICIES)
+    return PatternStartCounter;
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Schedules the next update, if no new pattern was started and the pattern has not ended since aPatternStartCountBeforeStep was taken.
+ * Otherwise scheduleNextUpdate() would delay the first update of the new pattern by one interval.
+ */
+void NeoPatterns::scheduleNextUpdate(uint8_t aPatternStartCountBeforeStep) {
+    if (ActivePattern != PATTERN_NONE && getPatternStartCount() == aPatternStartCountBeforeStep) {
+        scheduleNextUpdate();
+    }
+}
+
+/*
+ * Sets lastUpdate according to the timing policy. Must be called after show().
+ */
+void NeoPatterns::scheduleNextUpdate() {
+#if defined(SUPPORT_TIMING_POLICIES)
+    if (PixelFlags & (PIXEL_FLAG_TIMING_DRIFT_FREE | PIXEL_FLAG_TIMING_FOR_DURATION)) {
+        /*
+         * lastUpdate may be 1 ms in the future after adding the fraction overflow,
+         * therefore all checks of lastUpdate are signed.
+         */
+        unsigned long tPeriod = Interval + 1; // update requires more than Interval milliseconds
+        uint8_t tOldIntervalFractionSum = IntervalFractionSum;
+        IntervalFractionSum += IntervalFraction;
+        if (IntervalFractionSum < tOldIntervalFractionSum) {
+            tPeriod++; // fraction overflow
+        }
+        lastUpdate += tPeriod;
+        unsigned long tMillis = getCompensatedMillis();
+        if ((long) (tMillis - lastUpdate) > MAXIMUM_CATCH_UP_MILLIS) {
+            lastUpdate = tMillis; // we are too late, restart schedule
+        }
+        return;
+    }
+#endif
+    lastUpdate = getCompensatedMillis(); // remember last time of update
+}
+
+/*
+ * Updates the pattern and, for TIMING_POLICY_SKIP_FRAMES and *Duration() patterns,
+ * also processes all steps before, which are already due, without showing them.
+ * If ENABLE_NEOPATTERNS_RENDER_AT is defined, the due steps of the patterns supported by setPatternStep()
+ * are skipped by one jump and not processed one by one.
+ * The last processed step is scheduled by scheduleNextUpdate() of the caller.
+ * @return - true if pattern has ended, false if pattern has NOT ended
+ */
+bool NeoPatterns::_updateAndSkipDueSteps() {
+#if defined(SUPPORT_TIMING_POLICIES)
+    if (PixelFlags & (PIXEL_FLAG_TIMING_SKIP_FRAMES | PIXEL_FLAG_TIMING_FOR_DURATION)) {
+        /*
+         * Check if the step after the current one is also due and advance the schedule for each due step.
+         * scheduleNextUpdate() is much cheaper than computing the step.
+         */
+        uint8_t tSkippedSteps = 0;
+        while ((long) (getCompensatedMillis() - lastUpdate) > (2 * (long) Interval + 1) && tSkippedSteps < 0xFE) {
+            scheduleNextUpdate();
+            tSkippedSteps++;
+        }
+#  if defined(ENABLE_NEOPATTERNS_RENDER_AT)
+        /*
+         * Jump directly to the last skipped step. Not for Flash, since its interval changes at each step.
+         * The step after the jump must not be the last one, to call the completion callback as usual.
+         */
+        if (tSkippedSteps > 0 && (int16_t) tSkippedSteps < TotalStepCounter - 1
+#    if defined(ENABLE_PATTERN_FLASH)
+                && ActivePattern != PATTERN_FLASH
+#    endif
+                && setPatternStep(getPatternStep() + tSkippedSteps)) {
+            tSkippedSteps = 0;
+        }
+#  endif
+        while (tSkippedSteps > 0) {
+            if (_update(UPDATE_AND_DRAW_NEW_PATTERN)) {
+                return true;
+            }
+            tSkippedSteps--;
+        }
+    }
+#endif
+    return _update(UPDATE_AND_DRAW_NEW_PATTERN);
+}
+
+#if defined(ENABLE_NEOPATTERNS_RENDER_AT)
+/*
+ * @return number of steps processed since pattern start. 0 is the step drawn by the pattern initialization.
+ */
+uint16_t NeoPatterns::getPatternStep() {
+    return StartTotalStepCounter - TotalStepCounter;
+}
+
+/*
+ * Sets the internal state of the pattern to the state after aPatternStep steps from pattern start, without drawing it.
+ * The state is computed from the values stored at pattern start by showPatternInitially() and not by processing each step.
+ * The Heartbeat steps, which are skipped for black colors, are not considered, so its timing is approximate for dark colors.
+ * @return false if the active pattern is not supported, true otherwise.
+ */
+bool NeoPatterns::setPatternStep(uint16_t aPatternStep) {
+    int16_t tIndex;
+    switch (ActivePattern) {
+#  if defined(ENABLE_PATTERN_RAINBOW_CYCLE)
+    case PATTERN_RAINBOW_CYCLE:
+        tIndex = StartIndex + aPatternStep;
+        break;
+#  endif
+#  if defined(ENABLE_PATTERN_COLOR_WIPE)
+    case PATTERN_COLOR_WIPE:
+#  endif
+#  if defined(ENABLE_PATTERN_FADE)
+    case PATTERN_FADE:
+#  endif
+#  if defined(ENABLE_PATTERN_COLOR_WIPE) || defined(ENABLE_PATTERN_FADE)
+        if (Direction == DIRECTION_UP) {
+            tIndex = StartIndex + aPatternStep;
+        } else {
+            tIndex = StartIndex - aPatternStep;
+        }
+        break;
+#  endif
+#  if defined(ENABLE_PATTERN_STRIPES)
+    case PATTERN_STRIPES: {
+        uint16_t tPatternLength = ByteValue1.PatternLength + ByteValue2.PatternLength;
+        uint16_t tSteps = aPatternStep % tPatternLength;
+        if (Direction == DIRECTION_UP) {
+            tIndex = StartIndex + tSteps;
+            if (tIndex >= (int16_t) tPatternLength) {
+                tIndex -= tPatternLength;
+            }
+        } else {
+            tIndex = StartIndex - tSteps;
+            if (tIndex < 0) {
+                tIndex += tPatternLength;
+            }
+        }
+#    if defined(ENABLE_INCREMENTAL_UPDATE)
+        LongValue2.BufferBrightness = BUFFER_BRIGHTNESS_INVALID; // buffer content is not the one of the last step
+#    endif
+        break;
+    }
+#  endif
+#  if defined(ENABLE_PATTERN_FLASH)
+    case PATTERN_FLASH:
+        tIndex = StartIndex - aPatternStep; // odd index is second color
+        break;
+#  endif
+#  if defined(ENABLE_PATTERN_HEARTBEAT)
+    case PATTERN_HEARTBEAT: {
+        // 16 steps up from 8 to 248 and 16 steps down from 248 to 8
+        uint8_t tPhase = aPatternStep % 32;
+        if (tPhase < 16) {
+            Direction = DIRECTION_UP;
+            tIndex = 8 + (16 * tPhase);
+        } else {
+            Direction = DIRECTION_DOWN;
+            tIndex = 248 - (16 * (tPhase - 16));
+        }
+        break;
+    }
+#  endif
+#  if defined(ENABLE_PATTERN_SCANNER_EXTENDED)
+    case PATTERN_SCANNER_EXTENDED: {
+        /*
+         * Move the position in segments between two bouncings, with the same bouncing conditions as ScannerExtendedUpdate().
+         * The index of a bouncing is the index after the step, which is then moved back by 2.
+         * Cylon bounces at the index, where its pattern exceeds the strip, but also at the strip ends, e.g. if its pattern
+         * is as long as the strip.
+         */
+        int16_t tPatternLength = ByteValue1.PatternLength;
+        bool tIsCylon = PatternFlags & FLAG_SCANNER_EXT_CYLON;
+        tIndex = StartIndex;
+        int8_t tDirection = StartDirection;
+        uint16_t tNumberOfBouncings = StartNumberOfBouncings;
+        uint16_t tRemainingSteps = aPatternStep;
+        while (tRemainingSteps > 0) {
+            int16_t tBouncingIndex;
+            int16_t tStepsToBouncing;
+            if (tDirection == DIRECTION_UP) {
+                tBouncingIndex = numLEDs;
+                if (tIsCylon && tIndex <= (int16_t) numLEDs - tPatternLength) {
+                    tBouncingIndex = (numLEDs + 1) - tPatternLength;
+                }
+                tStepsToBouncing = tBouncingIndex - tIndex;
+            } else {
+                tBouncingIndex = -1;
+                if (tIsCylon && tIndex >= tPatternLength - 1) {
+                    tBouncingIndex = tPatternLength - 2;
+                }
+                tStepsToBouncing = tIndex - tBouncingIndex;
+            }
+            if (tNumberOfBouncings == 0 || tStepsToBouncing <= 0 || (int16_t) tRemainingSteps < tStepsToBouncing) {
+                // no bouncing before the requested step
+                if (tDirection == DIRECTION_UP) {
+                    tIndex += tRemainingSteps;
+                } else {
+                    tIndex -= tRemainingSteps;
+                }
+                break;
+            }
+            tRemainingSteps -= tStepsToBouncing;
+            // The bouncing step of ScannerExtendedUpdate(), including the cylon check after the bouncing at the strip end
+            if (tDirection == DIRECTION_UP) {
+                tIndex = tBouncingIndex - 2;
+                tDirection = DIRECTION_DOWN;
+                tNumberOfBouncings--;
+                if (tIsCylon && tIndex + tPatternLength == (int16_t) numLEDs + 1) {
+                    tIndex -= 2;
+                    tNumberOfBouncings--;
+                }
+            } else {
+                tIndex = tBouncingIndex + 2;
+                tDirection = DIRECTION_UP;
+                tNumberOfBouncings--;
+                if (tIsCylon && tIndex - tPatternLength == -2) {
+                    tIndex += 2;
+                    tNumberOfBouncings--;
+                }
+            }
+        }
+        Direction = tDirection;
+        LongValue1.NumberOfBouncings = tNumberOfBouncings;
+        if (!(PatternFlags & FLAG_DO_NOT_CLEAR)) {
+            clear(); // The update only clears the tail of the last step
+        }
+        break;
+    }
+#  endif
+    default:
+        return false;
+    }
+    Index = tIndex;
+    TotalStepCounter = StartTotalStepCounter - aPatternStep;
+    return true;
+}
+
+/*
+ * Draws the pattern as it looks aMillisSincePatternStart after its start and does not call show().
+ * The step is computed from the interval of the drift free schedule, i.e. TIMING_POLICY_CATCH_UP, TIMING_POLICY_SKIP_FRAMES
+ * or the *Duration() functions. For Flash, the two intervals of the pattern are used.
+ * The pattern state is set accordingly, so a following update() continues from this step.
+ * The completion callback is never called.
+ * Pixels of ColorWipe are only added, so rendering an earlier time requires a clear() before.
+ * @return true if aMillisSincePatternStart is at or after the end of the pattern or if pattern is not supported.
+ */
+bool NeoPatterns::renderAt(uint32_t aMillisSincePatternStart) {
+    uint32_t tPatternStep;
+#  if defined(ENABLE_PATTERN_FLASH)
+    if (ActivePattern == PATTERN_FLASH) {
+        uint32_t tCycleMillis = (uint32_t) LongValue2.Intervals.Interval1 + LongValue2.Intervals.Interval2;
+        if (tCycleMillis == 0) {
+            tCycleMillis = 1;
+        }
+        tPatternStep = 2 * (aMillisSincePatternStart / tCycleMillis);
+        if (aMillisSincePatternStart % tCycleMillis >= LongValue2.Intervals.Interval1) {
+            tPatternStep++;
+        }
+    } else
+#  endif
+    {
+        uint32_t tPeriodMillisShift8 = (uint32_t) (Interval + 1) << 8; // update requires more than Interval milliseconds
+#  if defined(SUPPORT_TIMING_POLICIES)
+        tPeriodMillisShift8 += IntervalFraction;
+#  endif
+        if (aMillisSincePatternStart < 0x1000000) {
+            tPatternStep = (aMillisSincePatternStart << 8) / tPeriodMillisShift8;
+        } else {
+            tPatternStep = aMillisSincePatternStart / (tPeriodMillisShift8 >> 8);
+        }
+    }
+
+    bool tPatternEnded = false;
+    if (tPatternStep >= (uint16_t) StartTotalStepCounter) {
+        tPatternStep = StartTotalStepCounter - 1;
+        tPatternEnded = true;
+    }
+#  if defined(ENABLE_PATTERN_SCANNER_EXTENDED)
+    if (ActivePattern == PATTERN_SCANNER_EXTENDED) {
+        /*
+         * The update clears only the last tail pixel, so after a bouncing, tail pixels are left for up to PatternLength steps.
+         * Therefore render the step PatternLength steps before and process the remaining steps by ScannerExtendedUpdate(),
+         * like update() does.
+         */
+        uint8_t tStepsToUpdate = ByteValue1.PatternLength;
+        if (tPatternStep < tStepsToUpdate) {
+            tStepsToUpdate = tPatternStep;
+        }
+        setPatternStep(tPatternStep - tStepsToUpdate);
+        ScannerExtendedUpdate(ONLY_REDRAW_PATTERN);
+        while (tStepsToUpdate > 0) {
+            ScannerExtendedUpdate(UPDATE_AND_DRAW_NEW_PATTERN);
+            tStepsToUpdate--;
+        }
+        return tPatternEnded;
+    }
+#  endif
+    if (!setPatternStep(tPatternStep)) {
+        return true;
+    }
+    _update(ONLY_REDRAW_PATTERN);
+    return tPatternEnded;
+}
+#endif
+
 bool NeoPatterns::checkForUpdate() {
-    if ((millis() - lastUpdate) > Interval) {
+    if ((long) (getCompensatedMillis() - lastUpdate) > (long) Interval) {
         return true;
     }
     return false;
@@ -249,6 +634,21 @@ bool NeoPatterns::updateAndShowAlsoAllChildPatterns(uint8_t aBrightness, bool aE
 #endif
     return updateAndShowAlsoAllChildPatterns(aEnableChildOverlay);
 }
+#if defined(ENABLE_INCREMENTAL_UPDATE)
+/*
+ * @return true if at least one other NeoPatterns object uses the pixel buffer of this object
+ */
+bool NeoPatterns::hasChildPatterns() {
+    for (NeoPatterns *tNextObjectPointer = NeoPatterns::FirstNeoPatternsObject; tNextObjectPointer != nullptr; tNextObjectPointer =
+            tNextObjectPointer->NextNeoPatternsObject) {
+        if (tNextObjectPointer != this && tNextObjectPointer->ParentNeoPixelObject == this) {
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
 /**
  * Must be called only for parent patterns i.e. where ParentNeoPixelObject == this
  * or equivalent PIXEL_FLAG_IS_PARTIAL_NEOPIXEL is NOT set in PixelFlags.
@@ -306,7 +706,13 @@ bool NeoPatterns::updateAndShowAlsoAllChildPatterns(bool aEnableChildOverlay) {
     }
 
     if (tNeedShow) {
+#if defined(ENABLE_NEOPATTERNS_STATISTICS)
+        unsigned long tStartMicros = micros();
+        show();
+        addShowStatistics(tStartMicros);
+#else
         show();
+#endif
     }
     return tAtLeastOnePatternIsActive;
 }
@@ -362,14 +768,58 @@ void NeoPatterns::updateAllPartialPatternsAndWaitForPatternsToStop() {
     updateAndShowAlsoAllChildPatternsAndWaitForPatternsToStop();
 }
 
+/*
+ * Frees the heap, which is allocated at pattern start by Twinkle, ProcessSelectiveColor and ScannerExtended with tail cache.
+ * Called by showPatternInitially(), since the pattern may be stopped by starting another pattern before its end.
+ */
+void NeoPatterns::freePatternMemory() {
+#if defined(ENABLE_PATTERN_TWINKLE)
+    freeSparklePixelArray();
+#endif
+#if defined(ENABLE_PATTERN_PROCESS_SELECTIVE)
+    freeSelectionMask();
+#endif
+#if defined(ENABLE_SCANNER_EXTENDED_TAIL_CACHE)
+    freeScannerExtendedTailCache();
+#endif
+}
+
+/*
+ * Called by the update of these patterns before decrementTotalStepCounter(),
+ * because the OnPatternComplete callback may start the next pattern, which then allocates its own memory.
+ */
+void NeoPatterns::freePatternMemoryAtLastStep() {
+    if (TotalStepCounter == 1) {
+        freePatternMemory();
+    }
+}
+
 /*
  * Checks for asynchronously calling and sets the timestamp of lastUpdate
  * The asynchronous call is detected by checking if the current pattern is not PATTERN_NONE
  */
 void NeoPatterns::showPatternInitially() {
+    // The previous pattern may have been stopped by starting this pattern
+    freePatternMemory();
+    resetDurationTiming();
+#if defined(ENABLE_NEOPATTERNS_RENDER_AT)
+    // Store start values for setPatternStep()
+    StartTotalStepCounter = TotalStepCounter;
+    StartIndex = Index;
+    StartDirection = Direction;
+    StartNumberOfBouncings = LongValue1.NumberOfBouncings;
+#endif
     if ((ActivePattern == PATTERN_NONE) || (PixelFlags & PIXEL_FLAG_SHOW_ONLY_AT_UPDATE) == 0) {
+#if defined(ENABLE_STREAMING_OUTPUT)
+        // colorAt() requires the new ActivePattern, which is set after showPatternInitially()
+        ExtendedState.StreamingShowIsPending = isStreaming();
+        if (!ExtendedState.StreamingShowIsPending) {
+            show();
+        }
+#else
         show();
-        lastUpdate = millis(); // to schedule the next update
+#endif
+        startSchedule(); // to schedule the next update
 #if defined(LOCAL_TRACE)
         printPin(&Serial);
         Serial.print(F("Init lastUpdate to "));
@@ -419,20 +869,55 @@ void NeoPatterns::forceUpdate(uint8_t aBrightness) {
     (void) aBrightness;
 #endif
     _update(UPDATE_AND_DRAW_NEW_PATTERN);
-    lastUpdate = millis(); // remember last time of update
+    lastUpdate = getCompensatedMillis(); // remember last time of update
 }
 
 bool NeoPatterns::update() {
     if (ActivePattern == PATTERN_NONE) {
         return false;
     }
-    if ((millis() - lastUpdate) > Interval) {
-        if (!_update(UPDATE_AND_DRAW_NEW_PATTERN)) {
+#if defined(ENABLE_PATTERN_SERIAL_INGEST)
+    if (ActivePattern == PATTERN_SERIAL_INGEST) {
+        /*
+         * Must be polled at each call and not only after Interval, which is the receive timeout
+         */
+        if (receiveSerialIngestFrame()) {
+            show();
+            return true;
+        }
+        return checkSerialIngestTimeout();
+    }
+#endif
+#if defined(ENABLE_STREAMING_OUTPUT)
+    if (ExtendedState.StreamingShowIsPending) {
+        ExtendedState.StreamingShowIsPending = false;
+        show(); // The initial show() of the pattern
+    }
+#endif
+    if ((long) (getCompensatedMillis() - lastUpdate) > (long) Interval) {
+        uint8_t tPatternStartCount = getPatternStartCount();
+#if defined(_RECORD_UPDATE_TIMING)
+        unsigned long tStartMicros = startUpdateStatistics();
+        bool tPatternEnded = _updateAndSkipDueSteps();
+        tStartMicros = addUpdateStatistics(tStartMicros);
+        if (!tPatternEnded) {
+            show();
+            addShowStatistics(tStartMicros);
+        }
+#else
+        if (!_updateAndSkipDueSteps()) {
             show();
         }
-        lastUpdate = millis(); // remember last time of update
+#endif
+        // Do not schedule a pattern, which was started by the completion callback
+        scheduleNextUpdate(tPatternStartCount);
         return true;
     }
+#if defined(ENABLE_CROSSFADE_TRANSITION)
+    if (CrossfadeBuffer != nullptr && (getCompensatedMillis() - LastCrossfadeShowMillis) >= CROSSFADE_REFRESH_MILLIS) {
+        show(); // Continue the transition, even if the pattern has a long interval
+    }
+#endif
     return false;
 }
 
@@ -458,24 +943,264 @@ bool NeoPatterns::updateOrRedraw(bool aDoRedrawIfNoUpdate, uint8_t aBrightness)
 }
 
 bool NeoPatterns::updateOrRedraw(bool aDoRedrawIfNoUpdate) {
-    bool tDoUpdate = (millis() - lastUpdate) > Interval;
+#if defined(ENABLE_PATTERN_SERIAL_INGEST)
+    if (ActivePattern == PATTERN_SERIAL_INGEST) {
+        // Like for update(), but a received frame is shown by the caller. A redraw is not required, the frame is still in the pixel buffer.
+        return (receiveSerialIngestFrame() || checkSerialIngestTimeout());
+    }
+#endif
+    bool tDoUpdate = (long) (getCompensatedMillis() - lastUpdate) > (long) Interval;
+    uint8_t tPatternStartCount = getPatternStartCount();
     if (tDoUpdate || aDoRedrawIfNoUpdate) {
         /*
          * If tDoUpdate is true, update pattern, otherwise only redraw the pattern
          */
-        _update(tDoUpdate);
+#if defined(_RECORD_UPDATE_TIMING)
+        if (tDoUpdate) {
+            unsigned long tStartMicros = startUpdateStatistics();
+            _updateAndSkipDueSteps();
+            addUpdateStatistics(tStartMicros);
+        } else {
+            _update(ONLY_REDRAW_PATTERN);
+        }
+#else
+        if (tDoUpdate) {
+            _updateAndSkipDueSteps();
+        } else {
+            _update(ONLY_REDRAW_PATTERN);
+        }
+#endif
     }
     if (tDoUpdate) {
-        lastUpdate = millis(); // remember last time of update
+        scheduleNextUpdate(tPatternStartCount);
     }
     return tDoUpdate;
 }
 
+#if defined(ENABLE_STREAMING_OUTPUT)
+/*
+ * Frees the pixel buffer, so show() computes and sends the pixels one by one.
+ * Must be called after begin(). Does not work for partial NeoPixel objects and matrix objects.
+ * @param aNumberOfPixels - Number of pixels of the strip, which may be more than the pixel buffer would fit into RAM.
+ *                          0 keeps the current number of pixels.
+ * @return false if streaming is not supported on this platform or for this object
+ */
+bool NeoPatterns::beginStreaming(uint16_t aNumberOfPixels) {
+#if defined(_SUPPORT_BIT_SLICE_OUTPUT)
+    if (PixelFlags & PIXEL_FLAG_IS_PARTIAL_NEOPIXEL) {
+        return false;
+    }
+#  if defined(ENABLE_CROSSFADE_TRANSITION)
+    endCrossfade(); // A transition requires the pixel buffer
+#  endif
+    free(pixels);
+    pixels = nullptr;
+    numBytes = 0;
+    if (aNumberOfPixels != 0) {
+        numLEDs = aNumberOfPixels;
+    }
+    StreamingShowFunction = &showStreamingOfNeoPixel;
+    return true;
+#else
+    (void) aNumberOfPixels;
+    return false;
+#endif
+}
+
+/*
+ * Allocates the pixel buffer again, which is cleared, and returns to buffered output.
+ * A running transition is ended by updateLength().
+ * @return false if the pixel buffer could not be allocated. Then the object stays in streaming mode with its number of pixels.
+ */
+bool NeoPatterns::endStreaming() {
+    if (isStreaming()) {
+        uint16_t tNumberOfPixels = numLEDs;
+        updateLength(tNumberOfPixels);
+        if (pixels == nullptr) {
+            // updateLength() has set the number of pixels to 0, which would end the streaming mode
+            numLEDs = tNumberOfPixels;
+            numBytes = 0;
+            return false;
+        }
+#if defined(LOCAL_DEBUG)
+        printPin(&Serial);
+        Serial.print(F("Streaming ended, pixel buffer of "));
+        Serial.print(numBytes);
+        Serial.println(F(" bytes allocated"));
+#endif
+    }
+    ExtendedState.StreamingShowIsPending = false;
+    return (pixels != nullptr);
+}
+
+bool NeoPatterns::isStreaming() {
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+    return (pixels == nullptr && numLEDs != 0 && IndexBuffer == nullptr);
+#else
+    return (pixels == nullptr && numLEDs != 0);
+#endif
+}
+
+/*
+ * @return true if the pattern can run without pixel buffer
+ */
+bool NeoPatterns::isStreamablePattern(uint8_t aPatternNumber) {
+    return (aPatternNumber == PATTERN_NONE || aPatternNumber == PATTERN_DELAY || aPatternNumber == PATTERN_RAINBOW_CYCLE
+            || aPatternNumber == PATTERN_COLOR_WIPE || aPatternNumber == PATTERN_FADE || aPatternNumber == PATTERN_HEARTBEAT
+            || aPatternNumber == PATTERN_STRIPES || aPatternNumber == PATTERN_FLASH);
+}
+
+/*
+ * Computes the color of one pixel of the current pattern step, which the *Update() function would have written to the pixel buffer.
+ * Pixels, which are not written by the pattern, like the not yet wiped pixels of ColorWipe, are black.
+ * Brightness is not applied, this is done by encodePixelColor().
+ */
+color32_t NeoPatterns::colorAt(uint16_t aPixelIndex) {
+    switch (ActivePattern) {
+#if defined(ENABLE_PATTERN_RAINBOW_CYCLE)
+    case PATTERN_RAINBOW_CYCLE: {
+        if (Direction != DIRECTION_UP) {
+            aPixelIndex = numLEDs - 1 - aPixelIndex; // see fillWithRainbow(Index, Direction)
+        }
+        uint16_t tWheelIndexHighResolution = ((uint8_t) Index) << 8;
+        tWheelIndexHighResolution += aPixelIndex * LongValue2.WheelIndexHighResolutionDelta;
+        return Wheel(tWheelIndexHighResolution >> 8);
+    }
+#endif
+#if defined(ENABLE_PATTERN_COLOR_WIPE)
+    case PATTERN_COLOR_WIPE:
+        if ((Direction == DIRECTION_UP && (int16_t) aPixelIndex <= Index)
+                || (Direction == DIRECTION_DOWN && (int16_t) aPixelIndex >= Index)) {
+            return Color1;
+        }
+        break;
+#endif
+#if defined(ENABLE_PATTERN_FADE)
+    case PATTERN_FADE:
+        return getFadeColor();
+#endif
+#if defined(ENABLE_PATTERN_HEARTBEAT)
+    case PATTERN_HEARTBEAT:
+        if (TotalStepCounter == 1 && (PatternFlags & FLAG_DO_NOT_CLEAR) == 0) {
+            break; // last step is cleared
+        }
+        return dimColorWithGamma5(Color1, Index);
+#endif
+#if defined(ENABLE_PATTERN_STRIPES)
+    case PATTERN_STRIPES:
+        // Index is the pattern index of pixel 0
+        if ((Index + aPixelIndex) % (ByteValue1.PatternLength + ByteValue2.PatternLength) < ByteValue1.PatternLength) {
+            return Color1;
+        }
+        return LongValue1.Color2;
+#endif
+#if defined(ENABLE_PATTERN_FLASH)
+    case PATTERN_FLASH:
+        if (Index & 0x01) {
+            if (Index == 1 && (PatternFlags & FLAG_END_WITH_BLACK)) {
+                break;
+            }
+            return LongValue1.Color2;
+        }
+        return Color1;
+#endif
+    default:
+        break;
+    }
+    return COLOR32_BLACK;
+}
+
+/*
+ * Set as NeoPixel::StreamingShowFunction by beginStreaming(), so every call of NeoPixel::show() streams,
+ * even if called by a NeoPixel pointer.
+ * NeoPixel is a virtual base class of NeoPatterns, so the NeoPatterns object is searched in the list of all NeoPatterns.
+ */
+void NeoPatterns::showStreamingOfNeoPixel(NeoPixel *aNeoPixel) {
+    NeoPatterns *tNeoPatterns = FirstNeoPatternsObject;
+    while (tNeoPatterns != nullptr) {
+        if (static_cast<NeoPixel*>(tNeoPatterns) == aNeoPixel) {
+            tNeoPatterns->showStreaming();
+            return;
+        }
+        tNeoPatterns = tNeoPatterns->NextNeoPatternsObject;
+    }
+}
+
+/*
+ * Computes each pixel by colorAt() and sends it immediately, so no pixel buffer is required.
+ * Interrupts are disabled for the whole frame, so the gap between two pixels is only the computing time of the next pixel.
+ * The millis() missed during computing and sending the frame are measured and credited to the schedules, see startFrameTiming().
+ * For Fade, Heartbeat and Flash, all pixels have the same color, which is computed only once.
+ */
+void NeoPatterns::showStreaming() {
+#if defined(_SUPPORT_BIT_SLICE_OUTPUT)
+    if (ActivePattern == PATTERN_NONE || ActivePattern == PATTERN_DELAY || !isStreamablePattern(ActivePattern)) {
+        return; // The strip keeps the last frame
+    }
+    bool tIsUniformPattern = (ActivePattern == PATTERN_FADE || ActivePattern == PATTERN_HEARTBEAT || ActivePattern == PATTERN_FLASH);
+    uint8_t tBitSlices[8 * 4]; // One byte for each bit of the encoded pixel
+    color32_t tColor = colorAt(0);
+    encodePixelColorToBitSlices(tColor, tBitSlices);
+
+    while (!canShow()) {
+        ; // Wait for reset / latch time of the last show()
+    }
+    uint8_t tOldSREG = SREG;
+    cli();
+#  if defined(_SUPPORT_FRAME_TIMING)
+    FrameTimingStruct tFrameTiming;
+    startFrameTiming(&tFrameTiming);
+#  endif
+    for (uint_fast16_t i = 0; i < numLEDs; i++) {
+        if (i > 0 && !tIsUniformPattern) {
+            color32_t tNewColor = colorAt(i);
+            if (tNewColor != tColor) {
+                tColor = tNewColor;
+                encodePixelColorToBitSlices(tColor, tBitSlices);
+            }
+        }
+        sendBitSlices(port, pinMask, tBitSlices, BytesPerPixel * 8);
+#  if defined(_SUPPORT_FRAME_TIMING)
+        pollFrameTiming(&tFrameTiming);
+#  endif
+    }
+#  if defined(_SUPPORT_FRAME_TIMING)
+    endFrameTiming(&tFrameTiming); // Credits the time for computing and sending the pixels
+#  endif
+    SREG = tOldSREG;
+    endTime = micros();
+#endif
+}
+
+/*
+ * Converts each bit of the encoded pixel to one byte, see convertBytesToBitSlices()
+ */
+void NeoPatterns::encodePixelColorToBitSlices(color32_t aColor, uint8_t *aBitSlices) {
+#if defined(_SUPPORT_BIT_SLICE_OUTPUT)
+    uint8_t tEncodedPixel[4];
+    encodePixelColor(tEncodedPixel, aColor);
+    convertBytesToBitSlices(tEncodedPixel, BytesPerPixel, pinMask, aBitSlices);
+#else
+    (void) aColor;
+    (void) aBitSlices;
+#endif
+}
+#endif // defined(ENABLE_STREAMING_OUTPUT)
+
 /*
  * @return - true if pattern has ended, false if pattern has NOT ended
  */
 bool NeoPatterns::_update(bool aDoUpdate) {
 
+#if defined(ENABLE_STREAMING_OUTPUT)
+    if (isStreaming() && !isStreamablePattern(ActivePattern)) {
+        // Fall back to the pixel buffer for patterns, which cannot be computed pixel by pixel
+        if (!endStreaming()) {
+            ActivePattern = PATTERN_NONE;
+            return true;
+        }
+    }
+#endif
     bool tPatternEnded = true; // to suppress show for ended pattern
     switch (ActivePattern) {
     case PATTERN_DELAY:
@@ -506,6 +1231,11 @@ bool NeoPatterns::_update(bool aDoUpdate) {
         tPatternEnded = FireUpdate(aDoUpdate);
         break;
 #endif
+#if defined(ENABLE_PATTERN_EMBER)
+    case PATTERN_EMBER:
+        tPatternEnded = EmberUpdate(aDoUpdate);
+        break;
+#endif
 #if defined(ENABLE_PATTERN_SCANNER_EXTENDED)
     case PATTERN_SCANNER_EXTENDED:
         tPatternEnded = ScannerExtendedUpdate(aDoUpdate);
@@ -545,8 +1275,23 @@ bool NeoPatterns::_update(bool aDoUpdate) {
     case PATTERN_BOUNCING_BALL:
         tPatternEnded = BouncingBallUpdate(aDoUpdate);
         break;
+#endif
+#if defined(ENABLE_PATTERN_PLAY_ANIMATION)
+    case PATTERN_PLAY_ANIMATION:
+        tPatternEnded = PlayAnimationUpdate(aDoUpdate);
+        break;
+#endif
+#if defined(ENABLE_PATTERN_SERIAL_INGEST)
+    case PATTERN_SERIAL_INGEST:
+        tPatternEnded = SerialIngestUpdate(aDoUpdate);
+        break;
 #endif
     default:
+#if defined(ENABLE_PATTERN_REGISTRY)
+        if (ActivePattern >= PATTERN_REGISTERED_FIRST) {
+            tPatternEnded = RegisteredPatternUpdate(aDoUpdate);
+        }
+#endif
         break;
     }
     return tPatternEnded;
@@ -578,6 +1323,9 @@ bool NeoPatterns::decrementTotalStepCounter() {
             Serial.print(F(": Call completion callback 0x"));
             Serial.println((__SIZE_TYPE__) (OnPatternComplete) << 1, HEX);
             Serial.flush();
+#endif
+#if defined(ENABLE_NEOPATTERNS_STATISTICS)
+            Statistics.CompletionCallbackCount++;
 #endif
             OnPatternComplete(this); // call the completion callback
 #if defined(LOCAL_DEBUG)
@@ -610,15 +1358,52 @@ bool NeoPatterns::decrementTotalStepCounter() {
  * At 800 kHz we have 1,25 us per bit and 30 us per pixel of 24 bit
  * this is 12 ms for 400 pixel
  * This update time must be subtracted from all aIntervalMillis parameters.
+ * If show() was already called, the measured show duration of the parent object is taken.
+ * For drift free timing policies, the show time does not delay the schedule,
+ * so only the 1 ms required by the "> Interval" check in update() is subtracted.
  */
 void NeoPatterns::setCompensatedInterval(uint16_t aIntervalToCompensate) {
+#if defined(SUPPORT_TIMING_POLICIES)
+    if (PixelFlags & PIXEL_FLAG_TIMING_DRIFT_FREE) {
+        Interval = (aIntervalToCompensate > 0) ? aIntervalToCompensate - 1 : 0;
+        return;
+    }
+#endif
+#if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+    uint8_t tCompensationForShowTime;
+    if (ParentNeoPixelObject->ShowDurationMicros != 0) {
+        tCompensationForShowTime = (ParentNeoPixelObject->ShowDurationMicros + 500) / 1000;
+    } else {
+        tCompensationForShowTime = ParentNeoPixelObject->getNumberOfPixels() / 33;
+    }
+#else
     uint8_t tCompensationForShowTime = ParentNeoPixelObject->getNumberOfPixels() / 33;
+#endif
     if (aIntervalToCompensate > tCompensationForShowTime) {
         Interval = aIntervalToCompensate - tCompensationForShowTime;
     } else {
         Interval = 0;
     }
 }
+/*
+ * Sets Interval for a pattern, which must end aCompleteDurationMillis after its start, even if updates are late.
+ * Must be called after the pattern is initialized, since it requires TotalStepCounter.
+ * The current pattern uses TIMING_POLICY_SKIP_FRAMES and an additional 1/256 ms fraction of Interval
+ * to avoid the rounding error of aCompleteDurationMillis / TotalStepCounter.
+ */
+void NeoPatterns::setDurationInterval(uint16_t aCompleteDurationMillis) {
+#if defined(SUPPORT_TIMING_POLICIES)
+    PixelFlags |= PIXEL_FLAG_TIMING_FOR_DURATION;
+    uint32_t tIntervalShift8 = ((uint32_t) aCompleteDurationMillis << 8) / TotalStepCounter;
+    uint16_t tInterval = tIntervalShift8 >> 8;
+    Interval = (tInterval > 0) ? tInterval - 1 : 0; // update requires more than Interval milliseconds
+    IntervalFraction = tIntervalShift8;
+    IntervalFractionSum = 0;
+#else
+    setCompensatedInterval(aCompleteDurationMillis / TotalStepCounter);
+#endif
+}
+
 /*
  * Decrement TotalSteps and call callback
  */
@@ -657,9 +1442,9 @@ bool NeoPatterns::decrementTotalStepCounterAndSetNextIndex() {
  * Initialize for a RainbowCycle
  * First of 256 steps is last pixel = Wheel(0) = RED going up over yellow and green to BLUE or backwards if DIRECTION_DOWN
  */
-void NeoPatterns::RainbowCycleDuration(uint8_t aCompleteDurationMillis, uint8_t aDirection, uint8_t aRepetitions) {
-    RainbowCycle(aCompleteDurationMillis, aDirection, aRepetitions);
-    setCompensatedInterval(aCompleteDurationMillis / 256);
+void NeoPatterns::RainbowCycleDuration(uint16_t aCompleteDurationMillis, uint8_t aDirection, uint8_t aRepetitions) {
+    RainbowCycle(0, aDirection, aRepetitions);
+    setDurationInterval(aCompleteDurationMillis);
 }
 
 /*
@@ -695,6 +1480,9 @@ bool NeoPatterns::RainbowCycleUpdate(bool aDoUpdate) {
     /*
      * Refresh pattern, Index is start position of color wheel
      */
+#if defined(ENABLE_STREAMING_OUTPUT)
+    LongValue2.WheelIndexHighResolutionDelta = 0x10000 / numLEDs; // like fillWithRainbow()
+#endif
     fillWithRainbow(Index, Direction);
     return false;
 }
@@ -712,7 +1500,7 @@ bool NeoPatterns::RainbowCycleUpdate(bool aDoUpdate) {
  */
 void NeoPatterns::ColorWipeDuration(color32_t aColor, uint16_t aCompleteDurationMillis, bool aDoNotClearBefore, uint8_t aDirection) {
     ColorWipe(aColor, aCompleteDurationMillis, aDoNotClearBefore, aDirection );
-    setCompensatedInterval(aCompleteDurationMillis / TotalStepCounter);
+    setDurationInterval(aCompleteDurationMillis);
 }
 void NeoPatterns::ColorWipe(color32_t aColor, uint16_t aIntervalMillis, bool aDoNotClearBefore, uint8_t aDirection) {
     Color1 = aColor;
@@ -764,6 +1552,8 @@ bool NeoPatterns::ColorWipeUpdate(bool aDoUpdate) {
 
 #if defined(ENABLE_PATTERN_TWINKLE)
 /*
+ * If aDoNotClearBefore is false, only the active pixels are handled at each update,
+ * otherwise every nth pixel of the strip is cleared at each update, to remove the old pixels.
  * @param aColorSpecial - If aColorSpecial == COLOR32_SPECIAL use random color
  */
 void NeoPatterns::Twinkle(color32_t aColorSpecial, uint8_t aAverageNumberOfActivePixel, uint16_t aIntervalMillis,
@@ -777,12 +1567,49 @@ void NeoPatterns::Twinkle(color32_t aColorSpecial, uint8_t aAverageNumberOfActiv
         aAverageNumberOfActivePixel = 1;
     }
     ByteValue1.AverageNumberOfActivePixel = aAverageNumberOfActivePixel;
+    ByteValue2.FadeSteps = 0;
     setCompensatedInterval(aIntervalMillis);
-    if( !aDoNotClearBefore){
+    if (aDoNotClearBefore) {
+        allocateSparklePixelArray(0); // old pixels must be removed by clearing every nth pixel
+    } else {
         clear();
+        allocateSparklePixelArray(getSparklePixelArraySize());
+    }
+    TwinkleUpdate(ONLY_REDRAW_PATTERN);
+    struct SparklePixelStruct *tSparklePixelArrayPtr = SparklePixelArrayPtr;
+    SparklePixelArrayPtr = nullptr; // Otherwise it is freed by showPatternInitially()
+    showPatternInitially();
+    SparklePixelArrayPtr = tSparklePixelArrayPtr;
+// must be after showPatternInitially(), since it requires the old value do detect asynchronous calling
+    ActivePattern = PATTERN_TWINKLE;
+#if defined(LOCAL_TRACE)
+    printInfo(&Serial, true);
+#endif
+}
+
+/*
+ * Twinkle with pixels, which fade out in aFadeSteps updates. At each update one new pixel is set.
+ * Requires 4 * aFadeSteps bytes heap. If not available, it runs as Twinkle without fading.
+ * @param aColorSpecial - If aColorSpecial == COLOR32_SPECIAL use random color
+ */
+void NeoPatterns::Sparkle(color32_t aColorSpecial, uint8_t aFadeSteps, uint16_t aIntervalMillis, uint16_t aNumberOfSteps) {
+    Color1 = aColorSpecial;
+    TotalStepCounter = aNumberOfSteps + 1; // + 1 step for the last pattern to show
+    Index = 0;
+
+    if (aFadeSteps == 0) {
+        aFadeSteps = 1;
     }
+    ByteValue1.AverageNumberOfActivePixel = aFadeSteps; // for Twinkle if no heap is available
+    ByteValue2.FadeSteps = aFadeSteps;
+    setCompensatedInterval(aIntervalMillis);
+    clear();
+    allocateSparklePixelArray(getSparklePixelArraySize());
     TwinkleUpdate(ONLY_REDRAW_PATTERN);
+    struct SparklePixelStruct *tSparklePixelArrayPtr = SparklePixelArrayPtr;
+    SparklePixelArrayPtr = nullptr; // Otherwise it is freed by showPatternInitially()
     showPatternInitially();
+    SparklePixelArrayPtr = tSparklePixelArrayPtr;
 // must be after showPatternInitially(), since it requires the old value do detect asynchronous calling
     ActivePattern = PATTERN_TWINKLE;
 #if defined(LOCAL_TRACE)
@@ -790,30 +1617,171 @@ void NeoPatterns::Twinkle(color32_t aColorSpecial, uint8_t aAverageNumberOfActiv
 #endif
 }
 
+/*
+ * Twinkle has on average AverageNumberOfActivePixel active pixels, so we reserve the double amount.
+ * Sparkle has exactly FadeSteps active pixels.
+ */
+uint16_t NeoPatterns::getSparklePixelArraySize() {
+    if (ByteValue2.FadeSteps != 0) {
+        return ByteValue2.FadeSteps;
+    }
+    return 2 * ByteValue1.AverageNumberOfActivePixel;
+}
+
+/*
+ * Sets SparklePixelArrayPtr to nullptr, if aArraySize is 0 or no heap is available
+ */
+void NeoPatterns::allocateSparklePixelArray(uint16_t aArraySize) {
+    freeSparklePixelArray(); // Twinkle was started again before its end
+    if (aArraySize == 0) {
+        return;
+    }
+    struct SparklePixelStruct *tSparklePixelPtr = (struct SparklePixelStruct*) malloc(aArraySize * sizeof(struct SparklePixelStruct));
+    SparklePixelArrayPtr = tSparklePixelPtr;
+    if (tSparklePixelPtr == nullptr) {
+#if defined(LOCAL_INFO)
+        printPin(&Serial);
+        Serial.println(F("Not enough heap for Twinkle pixel array"));
+#endif
+        return;
+    }
+    for (uint_fast16_t i = 0; i < aArraySize; i++) {
+        tSparklePixelPtr[i].PixelIndex = SPARKLE_PIXEL_UNUSED;
+    }
+}
+
+/*
+ * See freePatternMemory()
+ */
+void NeoPatterns::freeSparklePixelArray() {
+    if (SparklePixelArrayPtr != nullptr) {
+        free(SparklePixelArrayPtr);
+        SparklePixelArrayPtr = nullptr;
+    }
+}
+
 bool NeoPatterns::TwinkleUpdate(bool aDoUpdate) {
     if (aDoUpdate) {
+        freePatternMemoryAtLastStep();
         if (decrementTotalStepCounterAndSetNextIndex()) {
             return true;
         }
     }
 
-    /*
-     * Refresh pattern
-     * Remove every nth pixel, so we have n loops to remove all old pixel
-     */
-    for (uint16_t i = random8(ByteValue1.AverageNumberOfActivePixel); i < numLEDs; i += ByteValue1.AverageNumberOfActivePixel) {
-        clearPixel(i);
-    }
-    /*
-     * Set only one pixel
-     */
+    if (SparklePixelArrayPtr != nullptr) {
+        updateSparklePixels(aDoUpdate);
+        return false;
+    }
+
+    /*
+     * Refresh pattern
+     * Remove every nth pixel, so we have n loops to remove all old pixel
+     */
+    for (uint16_t i = random8(ByteValue1.AverageNumberOfActivePixel); i < numLEDs; i += ByteValue1.AverageNumberOfActivePixel) {
+        clearPixel(i);
+    }
+    /*
+     * Set only one pixel
+     */
+    color32_t tColor = Color1;
+    if (tColor == COLOR32_SPECIAL) {
+        tColor = NeoPatterns::Wheel(random8(MAX_WHEEL_POSITION));
+    }
+    setPixelColor(random(numLEDs), tColor);
+
+    return false;
+}
+
+/*
+ * Handles only the active pixels, so the time required does not depend on numLEDs.
+ * Twinkle removes each active pixel with a probability of 1 / AverageNumberOfActivePixel,
+ * which gives the same distribution as clearing every nth pixel of the strip.
+ * Sparkle dims each active pixel and removes it after FadeSteps updates.
+ * Then one new pixel is set at a position, which is not already active. If the array is full, a random active pixel is replaced.
+ * @param aDoUpdate - false just redraw current pixels and set the first pixel at pattern start
+ */
+void NeoPatterns::updateSparklePixels(bool aDoUpdate) {
+    struct SparklePixelStruct *tSparklePixelPtr = SparklePixelArrayPtr;
+    struct SparklePixelStruct *tUnusedSparklePixelPtr = nullptr;
+    uint16_t tArraySize = getSparklePixelArraySize();
+    uint8_t tFadeSteps = ByteValue2.FadeSteps;
+    bool tNoPixelIsActive = true;
+
+    for (uint_fast16_t i = 0; i < tArraySize; i++, tSparklePixelPtr++) {
+        if (tSparklePixelPtr->PixelIndex != SPARKLE_PIXEL_UNUSED) {
+            if (aDoUpdate) {
+                tSparklePixelPtr->Age++;
+                bool tRemovePixel;
+                if (tFadeSteps == 0) {
+                    tRemovePixel = (random8(ByteValue1.AverageNumberOfActivePixel) == 0);
+                } else {
+                    tRemovePixel = (tSparklePixelPtr->Age >= tFadeSteps);
+                }
+                if (tRemovePixel) {
+                    clearPixel(tSparklePixelPtr->PixelIndex);
+                    tSparklePixelPtr->PixelIndex = SPARKLE_PIXEL_UNUSED;
+                } else if (tFadeSteps != 0) {
+                    drawSparklePixel(tSparklePixelPtr); // Twinkle pixels are unchanged
+                }
+            } else {
+                drawSparklePixel(tSparklePixelPtr);
+            }
+        }
+        if (tSparklePixelPtr->PixelIndex == SPARKLE_PIXEL_UNUSED) {
+            if (tUnusedSparklePixelPtr == nullptr) {
+                tUnusedSparklePixelPtr = tSparklePixelPtr;
+            }
+        } else {
+            tNoPixelIsActive = false;
+        }
+    }
+
+    if (aDoUpdate || tNoPixelIsActive) {
+        /*
+         * Choose the position of the new pixel. Positions of active pixels are rejected, since their pixel
+         * would be removed by the older entry. If all tries hit an active pixel, no new pixel is set for this update.
+         */
+        uint16_t tNewPixelIndex;
+        uint_fast8_t tTries = SPARKLE_MAXIMUM_TRIES;
+        while (true) {
+            tNewPixelIndex = random(numLEDs);
+            tSparklePixelPtr = SparklePixelArrayPtr;
+            uint_fast16_t i = 0;
+            while (i < tArraySize && tSparklePixelPtr->PixelIndex != tNewPixelIndex) {
+                i++;
+                tSparklePixelPtr++;
+            }
+            if (i == tArraySize) {
+                break; // position is not active
+            }
+            if (--tTries == 0) {
+                return;
+            }
+        }
+        /*
+         * Set one new pixel
+         */
+        if (tUnusedSparklePixelPtr == nullptr) {
+            tUnusedSparklePixelPtr = &SparklePixelArrayPtr[random(tArraySize)];
+            clearPixel(tUnusedSparklePixelPtr->PixelIndex);
+        }
+        tUnusedSparklePixelPtr->PixelIndex = tNewPixelIndex;
+        tUnusedSparklePixelPtr->WheelPosition = random8(MAX_WHEEL_POSITION);
+        tUnusedSparklePixelPtr->Age = 0;
+        drawSparklePixel(tUnusedSparklePixelPtr);
+    }
+}
+
+void NeoPatterns::drawSparklePixel(struct SparklePixelStruct *aSparklePixelPtr) {
     color32_t tColor = Color1;
     if (tColor == COLOR32_SPECIAL) {
-        tColor = NeoPatterns::Wheel(random8(MAX_WHEEL_POSITION));
+        tColor = NeoPatterns::Wheel(aSparklePixelPtr->WheelPosition);
     }
-    setPixelColor(random(numLEDs), tColor);
-
-    return false;
+    uint8_t tFadeSteps = ByteValue2.FadeSteps;
+    if (tFadeSteps != 0) {
+        tColor = dimColorWithGamma5(tColor, ((uint16_t) (tFadeSteps - aSparklePixelPtr->Age) * MAX_BRIGHTNESS) / tFadeSteps);
+    }
+    setPixelColor(aSparklePixelPtr->PixelIndex, tColor);
 }
 #endif
 
@@ -824,7 +1792,7 @@ bool NeoPatterns::TwinkleUpdate(bool aDoUpdate) {
  */
 void NeoPatterns::FadeDuration(color32_t aColorStart, color32_t aColorEnd, uint16_t aNumberOfSteps, uint16_t aCompleteDurationMillis) {
     Fade( aColorStart,  aColorEnd,  aNumberOfSteps,  aCompleteDurationMillis);
-    setCompensatedInterval(aCompleteDurationMillis/TotalStepCounter);
+    setDurationInterval(aCompleteDurationMillis);
 }
 void NeoPatterns::Fade(color32_t aColorStart, color32_t aColorEnd, uint16_t aNumberOfSteps, uint16_t aIntervalMillis) {
     setCompensatedInterval(aIntervalMillis);
@@ -854,6 +1822,14 @@ bool NeoPatterns::FadeUpdate(bool aDoUpdate) {
     /*
      * Refresh pattern
      */
+    setColor(getFadeColor());
+    return false;
+}
+
+/*
+ * @return the color of the current Fade step
+ */
+color32_t NeoPatterns::getFadeColor() {
 // Calculate linear interpolation between Color1 and BackgroundColor
 // Optimize order of operations to minimize truncation error
     uint8_t tRed = ((getRedPart(Color1) * (ByteValue1.NumberOfSteps - Index)) + (getRedPart(LongValue1.Color2) * Index))
@@ -865,12 +1841,10 @@ bool NeoPatterns::FadeUpdate(bool aDoUpdate) {
 #if defined(_SUPPORT_RGBW)
     uint8_t tWhite = ((getWhitePart(Color1) * (ByteValue1.NumberOfSteps - Index)) + (getWhitePart(LongValue1.Color2) * Index))
             / ByteValue1.NumberOfSteps;
-    setColor(Color(tRed, tGreen, tBlue, tWhite));
+    return Color(tRed, tGreen, tBlue, tWhite);
 #else
-    setColor(Color(tRed, tGreen, tBlue));
+    return Color(tRed, tGreen, tBlue);
 #endif
-
-    return false;
 }
 #endif
 
@@ -978,7 +1952,7 @@ bool NeoPatterns::HeartbeatUpdate(bool aDoUpdate) {
 void NeoPatterns::ScannerExtendedDuration(color32_t aColor, uint8_t aLength, uint16_t aCompleteDurationMillis, uint16_t aNumberOfBouncings,
         uint8_t aMode, uint8_t aDirection) {
     ScannerExtended(aColor, aLength, aCompleteDurationMillis, aNumberOfBouncings, aMode, aDirection);
-    setCompensatedInterval(aCompleteDurationMillis / TotalStepCounter);
+    setDurationInterval(aCompleteDurationMillis);
 
 }
 void NeoPatterns::ScannerExtended(color32_t aColor, uint8_t aLength, uint16_t aIntervalMillis, uint16_t aNumberOfBouncings,
@@ -1027,20 +2001,108 @@ void NeoPatterns::ScannerExtended(color32_t aColor, uint8_t aLength, uint16_t aI
 
     TotalStepCounter += 1; // + 1 for last pattern
 
+#if defined(ENABLE_SCANNER_EXTENDED_TAIL_CACHE)
+    freeScannerExtendedTailCache(); // The cache of a previous scanner must not be used for drawing the initial pattern
+#endif
     ScannerExtendedUpdate(ONLY_REDRAW_PATTERN);
     showPatternInitially();
 // must be after showPatternInitially(), since it requires the old value do detect asynchronous calling
     ActivePattern = PATTERN_SCANNER_EXTENDED;
+#if defined(ENABLE_SCANNER_EXTENDED_TAIL_CACHE)
+    // must be after showPatternInitially(), since it frees the tail cache of the previous pattern
+    computeScannerExtendedTailCache();
+#endif
 #if defined(LOCAL_TRACE)
     printInfo(&Serial, true);
 #endif
 }
 
+#if defined(ENABLE_SCANNER_EXTENDED_TAIL_CACHE)
+/*
+ * Computes the dimmed tail pixels of the scanner in the byte order of the pixel buffer.
+ * Called at start of ScannerExtended() and if brightness has changed. The initial pattern is drawn without cache.
+ * If no heap is available, TailCacheSize is 0 and the tail is computed at each update.
+ */
+void NeoPatterns::computeScannerExtendedTailCache() {
+    uint8_t tPatternLength = ByteValue1.PatternLength;
+    if (TailCacheSize < tPatternLength) {
+        free(TailCachePtr);
+        TailCachePtr = (uint8_t*) malloc(tPatternLength * BytesPerPixel);
+        if (TailCachePtr == nullptr) {
+            TailCacheSize = 0;
+#  if defined(LOCAL_INFO)
+            printPin(&Serial);
+            Serial.println(F("Not enough heap for tail cache"));
+#  endif
+            return;
+        }
+        TailCacheSize = tPatternLength;
+    }
+
+    uint16_t tBrightnessHighResolution = 0xFFFF; // upper byte is the integer part used for dimColorWithGamma5, lower byte is the fractional part
+    uint8_t tPatternIndex;
+    for (tPatternIndex = 0; tPatternIndex < tPatternLength; ++tPatternIndex) {
+        color32_t tDimmedColor = dimColorWithGamma5(Color1, tBrightnessHighResolution >> 8);
+        if (tDimmedColor == 0) {
+            break;
+        }
+        encodePixelColor(&TailCachePtr[tPatternIndex * BytesPerPixel], tDimmedColor);
+        tBrightnessHighResolution -= LongValue2.DeltaBrightnessShift8;
+    }
+    TailCacheLength = tPatternIndex;
+#  if defined(SUPPORT_BRIGHTNESS)
+    TailCacheBrightness = Brightness;
+#  endif
+}
+
+/*
+ * See freePatternMemory()
+ */
+void NeoPatterns::freeScannerExtendedTailCache() {
+    if (TailCachePtr != nullptr) {
+        free(TailCachePtr);
+        TailCachePtr = nullptr;
+        TailCacheSize = 0;
+    }
+}
+
+/*
+ * Copies the cached tail pixels to the positions computed by ScannerExtendedUpdate().
+ * @return number of tail pixels drawn
+ */
+uint8_t NeoPatterns::drawScannerExtendedTailFromCache() {
+    uint8_t tPatternIndex;
+    for (tPatternIndex = 0; tPatternIndex < TailCacheLength; ++tPatternIndex) {
+        uint8_t *tEncodedPixelPtr = &TailCachePtr[tPatternIndex * BytesPerPixel];
+        int16_t tOffset;
+        if (Direction == DIRECTION_UP) {
+            tOffset = tPatternIndex;
+        } else {
+            tOffset = -tPatternIndex;
+        }
+        setEncodedPixelColor(Index - tOffset, tEncodedPixelPtr);
+        if (PatternFlags & FLAG_SCANNER_EXT_START_AT_BOTH_ENDS) {
+            // draw at other end too
+            setEncodedPixelColor((numLEDs - 1) - (Index - tOffset), tEncodedPixelPtr);
+        }
+        if (PatternFlags & FLAG_SCANNER_EXT_CYLON) {
+            // mirror pattern to + Offset
+            setEncodedPixelColor(Index + tOffset, tEncodedPixelPtr);
+            if (PatternFlags & FLAG_SCANNER_EXT_START_AT_BOTH_ENDS) {
+                setEncodedPixelColor((numLEDs - 1) - (Index + tOffset), tEncodedPixelPtr);
+            }
+        }
+    }
+    return tPatternIndex;
+}
+#endif
+
 /*
  * @return - true if pattern has ended, false if pattern has NOT ended
  */
 bool NeoPatterns::ScannerExtendedUpdate(bool aDoUpdate) {
     if (aDoUpdate) {
+        freePatternMemoryAtLastStep();
         if (decrementTotalStepCounterAndSetNextIndex()) {
             return true;
         }
@@ -1103,6 +2165,16 @@ bool NeoPatterns::ScannerExtendedUpdate(bool aDoUpdate) {
 #endif
 
     uint8_t tPatternIndex;
+#if defined(ENABLE_SCANNER_EXTENDED_TAIL_CACHE)
+#  if defined(SUPPORT_BRIGHTNESS)
+    if (TailCacheSize > 0 && TailCacheBrightness != Brightness) {
+        computeScannerExtendedTailCache();
+    }
+#  endif
+    if (TailCacheSize > 0 && _HAS_PIXEL_BUFFER) {
+        tPatternIndex = drawScannerExtendedTailFromCache();
+    } else
+#endif
     for (tPatternIndex = 0; tPatternIndex < ByteValue1.PatternLength; ++tPatternIndex) {
         uint8_t tBrightness = tBrightnessHighResolution >> 8;
         /*
@@ -1209,7 +2281,7 @@ bool NeoPatterns::ScannerExtendedUpdate(bool aDoUpdate) {
 void NeoPatterns::StripesDuration(color32_t aColor1, uint8_t aLength1, color32_t aColor2, uint8_t aLength2, uint16_t aNumberOfSteps,
         uint16_t aCompleteDurationMillis, uint8_t aDirection) {
     Stripes(aColor1, aLength1, aColor2, aLength2, aNumberOfSteps, aCompleteDurationMillis, aDirection);
-    setCompensatedInterval(aCompleteDurationMillis / TotalStepCounter);
+    setDurationInterval(aCompleteDurationMillis);
 }
 void NeoPatterns::Stripes(color32_t aColor1, uint8_t aLength1, color32_t aColor2, uint8_t aLength2, uint16_t aNumberOfSteps,
         uint16_t aIntervalMillis, uint8_t aDirection) {
@@ -1264,6 +2336,13 @@ void NeoPatterns::Stripes(color32_t aColor1, uint8_t aLength1, color32_t aColor2
  * @return - true if pattern has ended, false if pattern has NOT ended
  */
 bool NeoPatterns::StripesUpdate(bool aDoUpdate) {
+#if defined(ENABLE_INCREMENTAL_UPDATE)
+#  if defined(SUPPORT_BRIGHTNESS)
+    uint16_t tBrightness = Brightness;
+#  else
+    uint16_t tBrightness = 0;
+#  endif
+#endif
     if (aDoUpdate) {
         if (decrementTotalStepCounter()) {
             return true;
@@ -1283,13 +2362,47 @@ bool NeoPatterns::StripesUpdate(bool aDoUpdate) {
                 Index = ByteValue1.PatternLength + ByteValue2.PatternLength - 1;
             }
         }
+#if defined(ENABLE_INCREMENTAL_UPDATE)
+        if (LongValue2.BufferBrightness == tBrightness && _HAS_PIXEL_BUFFER && !(PixelFlags & PIXEL_FLAG_IS_PARTIAL_NEOPIXEL)
+                && !hasChildPatterns()) {
+            /*
+             * Pattern moves by one pixel, so move buffer content by one pixel like moveArrayContent() and compute only the new pixel.
+             * Index is the pattern index of pixel 0.
+             * Not for partial objects and parents of partial objects, since the pixels of the other objects would be moved too.
+             */
+            uint8_t *tPixelPtr = &pixels[PixelOffset * BytesPerPixel];
+            uint16_t tBytesToMove = (numLEDs - 1) * BytesPerPixel;
+            uint16_t tNewPixelIndex;
+            uint8_t tPatternIndex;
+            if (Direction == DIRECTION_UP) {
+                memmove(tPixelPtr, tPixelPtr + BytesPerPixel, tBytesToMove);
+                tNewPixelIndex = numLEDs - 1;
+                tPatternIndex = (Index + ((numLEDs - 1) % (ByteValue1.PatternLength + ByteValue2.PatternLength)))
+                        % (ByteValue1.PatternLength + ByteValue2.PatternLength);
+            } else {
+                memmove(tPixelPtr + BytesPerPixel, tPixelPtr, tBytesToMove);
+                tNewPixelIndex = 0;
+                tPatternIndex = Index;
+            }
+            if (tPatternIndex < ByteValue1.PatternLength) {
+                setPixelColor(tNewPixelIndex, Color1);
+            } else {
+                setPixelColor(tNewPixelIndex, LongValue1.Color2);
+            }
+            return false;
+        }
+#endif
     }
 
     /*
-     * Refresh pattern
+     * Refresh pattern. Draw only the first period and copy it over the rest of the pixels.
      */
+    uint16_t tPeriodPixels = ByteValue1.PatternLength + ByteValue2.PatternLength;
+    if (tPeriodPixels > numLEDs) {
+        tPeriodPixels = numLEDs;
+    }
     uint8_t tRunningIndex = Index;
-    for (uint_fast16_t i = 0; i < numLEDs; i++) {
+    for (uint_fast16_t i = 0; i < tPeriodPixels; i++) {
         if (tRunningIndex < ByteValue1.PatternLength) {
             // first color
             setPixelColor(i, Color1);
@@ -1303,6 +2416,10 @@ bool NeoPatterns::StripesUpdate(bool aDoUpdate) {
             tRunningIndex = 0;
         }
     }
+    replicatePeriod(tPeriodPixels);
+#if defined(ENABLE_INCREMENTAL_UPDATE)
+    LongValue2.BufferBrightness = tBrightness;
+#endif
     return false;
 }
 #endif
@@ -1350,14 +2467,14 @@ bool NeoPatterns::FlashUpdate(bool aDoUpdate) {
     if (Index & 0x01) {
         // second color
         if (Index == 1 && (PatternFlags & FLAG_END_WITH_BLACK)) {
-            fillRegion(COLOR32_BLACK, 0, numLEDs);
+            setColor(COLOR32_BLACK);
         } else {
-            fillRegion(LongValue1.Color2, 0, numLEDs);
+            setColor(LongValue1.Color2);
         }
         setCompensatedInterval(LongValue2.Intervals.Interval2);
     } else {
         // first color
-        fillRegion(Color1, 0, numLEDs);
+        setColor(Color1);
         setCompensatedInterval(LongValue2.Intervals.Interval1);
     }
     return false;
@@ -1482,6 +2599,256 @@ bool NeoPatterns::BouncingBallUpdate(bool aDoUpdate) {
 }
 #endif // defined(ENABLE_PATTERN_BOUNCING_BALL)
 
+#if defined(ENABLE_PATTERN_PLAY_ANIMATION)
+/*
+ * Plays a pre-rendered animation, see NeoAnimation.h. The animation must be started by aAnimation->begin*() before.
+ * One frame is decoded into the pixel buffer at each update, so only the pixel buffer, 27 bytes of the NeoAnimation object
+ * and the cache of one byte per pixel for redrawing are required.
+ * An animation read from a stream is played only once.
+ * @param aRepetitions - 0 for endless
+ * @param aIntervalMillis - 0 for the frame interval of the animation
+ */
+void NeoPatterns::PlayAnimation(NeoAnimation *aAnimation, uint8_t aRepetitions, uint16_t aIntervalMillis) {
+    Pointer1.Animation = aAnimation;
+    ByteValue2.AnimationRepetitions = aRepetitions;
+    TotalStepCounter = aAnimation->NumberOfFrames; // The first frame is shown initially, the last step is for the last frame to show
+    if (aIntervalMillis == 0) {
+        aIntervalMillis = aAnimation->FrameIntervalMillis;
+    }
+    setCompensatedInterval(aIntervalMillis);
+
+    aAnimation->rewind();
+    if (!aAnimation->decodeNextFrame(this)) {
+        TotalStepCounter = 1; // Invalid animation, end at next update
+    }
+    showPatternInitially();
+    // must be after showPatternInitially(), since it requires the old value do detect asynchronous calling
+    ActivePattern = PATTERN_PLAY_ANIMATION;
+#if defined(LOCAL_TRACE)
+    printInfo(&Serial, true);
+#endif
+}
+
+/*
+ * Decodes the next frame. At the end of the animation, the next repetition starts with the first frame.
+ * If not aDoUpdate, the current frame is drawn again from the cache of the NeoAnimation object.
+ * @return - true if pattern has ended, false if pattern has NOT ended
+ */
+bool NeoPatterns::PlayAnimationUpdate(bool aDoUpdate) {
+    NeoAnimation *tAnimation = Pointer1.Animation;
+    if (aDoUpdate) {
+        if (TotalStepCounter == 1 && ByteValue2.AnimationRepetitions != 1 && tAnimation->rewind()) {
+            // Start next repetition
+            if (ByteValue2.AnimationRepetitions != 0) {
+                ByteValue2.AnimationRepetitions--;
+            }
+            TotalStepCounter = tAnimation->NumberOfFrames + 1;
+        }
+        if (decrementTotalStepCounter()) {
+            return true;
+        }
+        if (!tAnimation->decodeNextFrame(this)) {
+            // Invalid or truncated data
+            TotalStepCounter = 1;
+            return decrementTotalStepCounter();
+        }
+    } else {
+        tAnimation->redrawFrame(this);
+    }
+    return false;
+}
+#endif // defined(ENABLE_PATTERN_PLAY_ANIMATION)
+
+#if defined(ENABLE_PATTERN_SERIAL_INGEST)
+/*
+ * Shows frames received from aStream, e.g. sent by a PC. See NeoPatterns.h for the frame format and the flow control.
+ * The payload is read directly into the pixel buffer, starting at pixel 0 of this (partial) NeoPixel object.
+ * If SUPPORT_BRIGHTNESS is enabled and Brightness is not MAX_BRIGHTNESS, Brightness is applied to the received bytes.
+ * Use update() or updateOrRedraw() to poll the stream as often as possible. update() shows each complete and valid frame immediately,
+ * for updateOrRedraw() returning true, show() must be called by the caller, like for all other patterns.
+ * @param aTimeoutMillis - The pattern ends, if no valid frame was received for aTimeoutMillis. 0 for endless.
+ */
+void NeoPatterns::SerialIngest(Stream *aStream, uint16_t aTimeoutMillis) {
+    Pointer1.IngestStream = aStream;
+    ByteValue1.IngestState = SERIAL_INGEST_STATE_WAIT_FOR_START;
+    LongValue2.IngestValues.UncreditedBytes = 0;
+    TotalStepCounter = 1; // Ends at timeout
+    Interval = aTimeoutMillis;
+
+    showPatternInitially();
+    // must be after showPatternInitially(), since it requires the old value do detect asynchronous calling
+    ActivePattern = PATTERN_SERIAL_INGEST;
+    aStream->write(SERIAL_INGEST_ACK); // Ready for the first frame
+#if defined(LOCAL_TRACE)
+    printInfo(&Serial, true);
+#endif
+}
+
+/*
+ * Receives available bytes. The frame is shown by the caller of _update(), if it is complete.
+ * If not aDoUpdate, nothing is done, since the pixel buffer still contains the last frame.
+ * @return - true if pattern has ended, false if pattern has NOT ended
+ */
+bool NeoPatterns::SerialIngestUpdate(bool aDoUpdate) {
+    if (aDoUpdate && !receiveSerialIngestFrame() && Interval != 0
+            && (long) (getCompensatedMillis() - lastUpdate) > (long) Interval) {
+        // No valid frame received within timeout
+        return decrementTotalStepCounter();
+    }
+    return false;
+}
+
+/*
+ * Pattern has ended, if no valid frame was received within the timeout
+ * @return true if pattern has ended
+ */
+bool NeoPatterns::checkSerialIngestTimeout() {
+    if (Interval != 0 && (long) (getCompensatedMillis() - lastUpdate) > (long) Interval) {
+        uint8_t tPatternStartCount = getPatternStartCount();
+        if (decrementTotalStepCounter()) {
+            // The completion callback may have started the next pattern, which must not be rescheduled
+            scheduleNextUpdate(tPatternStartCount);
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Reads all available bytes of the stream without waiting. The payload is read directly into the pixel buffer.
+ * Sends SERIAL_INGEST_CREDIT for each SERIAL_INGEST_CHUNK_SIZE bytes read and SERIAL_INGEST_NAK for an invalid frame.
+ * A complete and valid frame must be shown by the caller. SERIAL_INGEST_ACK for it is sent at the next call,
+ * i.e. after show(), so the host does not send the next frame while interrupts are disabled by show().
+ * An invalid frame is not shown, but the pixel buffer may contain parts of it.
+ * @return true if a complete and valid frame was received, which must be shown now
+ */
+bool NeoPatterns::receiveSerialIngestFrame() {
+    Stream *tStream = Pointer1.IngestStream;
+    if (ByteValue1.IngestState == SERIAL_INGEST_STATE_SHOW_PENDING) {
+        ByteValue1.IngestState = SERIAL_INGEST_STATE_WAIT_FOR_START;
+        tStream->write(SERIAL_INGEST_ACK);
+    }
+    uint16_t tPixelBufferLength = 0;
+    uint8_t *tPixelPtr = nullptr;
+    if (_HAS_PIXEL_BUFFER) {
+        tPixelBufferLength = numLEDs * BytesPerPixel;
+        tPixelPtr = &pixels[PixelOffset * BytesPerPixel];
+    }
+
+    while (true) {
+        uint8_t tFrameResponse = 0; // SERIAL_INGEST_ACK or SERIAL_INGEST_NAK after end of frame
+        int tAvailable = tStream->available();
+        if (tAvailable <= 0) {
+            return false;
+        }
+        /*
+         * Read at most up to the next credit
+         */
+        uint8_t tBytesToRead = SERIAL_INGEST_CHUNK_SIZE - LongValue2.IngestValues.UncreditedBytes;
+        if (tAvailable < tBytesToRead) {
+            tBytesToRead = tAvailable;
+        }
+        uint16_t tPayloadIndex = Index;
+        if (ByteValue1.IngestState == SERIAL_INGEST_STATE_PAYLOAD && tPayloadIndex < tPixelBufferLength) {
+            /*
+             * Read payload directly into the pixel buffer
+             */
+            uint16_t tRemainingBytes = LongValue2.IngestValues.FrameLength - tPayloadIndex;
+            if (tRemainingBytes > (uint16_t) (tPixelBufferLength - tPayloadIndex)) {
+                tRemainingBytes = tPixelBufferLength - tPayloadIndex;
+            }
+            if (tBytesToRead > tRemainingBytes) {
+                tBytesToRead = tRemainingBytes;
+            }
+            uint8_t *tBytePtr = &tPixelPtr[tPayloadIndex];
+            tBytesToRead = tStream->readBytes(tBytePtr, tBytesToRead);
+            uint8_t tChecksum = LongValue2.IngestValues.Checksum;
+            for (uint_fast8_t i = 0; i < tBytesToRead; ++i) {
+                uint8_t tByte = tBytePtr[i];
+                tChecksum ^= tByte;
+#if defined(SUPPORT_BRIGHTNESS)
+                if (Brightness != MAX_BRIGHTNESS) {
+                    tBytePtr[i] = (tByte * Brightness) >> 8;
+                }
+#endif
+            }
+            LongValue2.IngestValues.Checksum = tChecksum;
+            tPayloadIndex += tBytesToRead;
+            if (tPayloadIndex == LongValue2.IngestValues.FrameLength) {
+                ByteValue1.IngestState = SERIAL_INGEST_STATE_CHECKSUM;
+            }
+        } else {
+            /*
+             * Parse header and trailer and skip payload, which does not fit into pixel buffer
+             */
+            tBytesToRead = 1;
+            uint8_t tByte = tStream->read();
+            switch (ByteValue1.IngestState) {
+            case SERIAL_INGEST_STATE_WAIT_FOR_START:
+                if (tByte == SERIAL_INGEST_START_BYTE) {
+                    ByteValue1.IngestState = SERIAL_INGEST_STATE_FRAME_TYPE;
+                }
+                break;
+            case SERIAL_INGEST_STATE_FRAME_TYPE:
+                if (tByte == SERIAL_INGEST_DATA_FRAME) {
+                    ByteValue1.IngestState = SERIAL_INGEST_STATE_LENGTH_HIGH;
+                } else if (tByte != SERIAL_INGEST_START_BYTE) {
+                    ByteValue1.IngestState = SERIAL_INGEST_STATE_WAIT_FOR_START;
+                }
+                break;
+            case SERIAL_INGEST_STATE_LENGTH_HIGH:
+                LongValue2.IngestValues.FrameLength = tByte << 8;
+                LongValue2.IngestValues.Checksum = SERIAL_INGEST_CHECKSUM_SEED ^ tByte;
+                ByteValue1.IngestState = SERIAL_INGEST_STATE_LENGTH_LOW;
+                break;
+            case SERIAL_INGEST_STATE_LENGTH_LOW:
+                LongValue2.IngestValues.FrameLength |= tByte;
+                LongValue2.IngestValues.Checksum ^= tByte;
+                tPayloadIndex = 0;
+                ByteValue1.IngestState =
+                        (LongValue2.IngestValues.FrameLength == 0) ? SERIAL_INGEST_STATE_CHECKSUM : SERIAL_INGEST_STATE_PAYLOAD;
+                break;
+            case SERIAL_INGEST_STATE_PAYLOAD:
+                LongValue2.IngestValues.Checksum ^= tByte;
+                tPayloadIndex++;
+                if (tPayloadIndex == LongValue2.IngestValues.FrameLength) {
+                    ByteValue1.IngestState = SERIAL_INGEST_STATE_CHECKSUM;
+                }
+                break;
+            case SERIAL_INGEST_STATE_CHECKSUM:
+                LongValue2.IngestValues.Checksum ^= tByte; // is 0 now for a valid frame
+                ByteValue1.IngestState = SERIAL_INGEST_STATE_END;
+                break;
+            default: // SERIAL_INGEST_STATE_END
+                if (tByte == SERIAL_INGEST_END_BYTE && LongValue2.IngestValues.Checksum == 0) {
+                    tFrameResponse = SERIAL_INGEST_ACK;
+                } else {
+                    tFrameResponse = SERIAL_INGEST_NAK;
+                }
+                ByteValue1.IngestState = SERIAL_INGEST_STATE_WAIT_FOR_START;
+                break;
+            }
+        }
+        Index = tPayloadIndex;
+
+        LongValue2.IngestValues.UncreditedBytes += tBytesToRead;
+        if (LongValue2.IngestValues.UncreditedBytes >= SERIAL_INGEST_CHUNK_SIZE) {
+            LongValue2.IngestValues.UncreditedBytes = 0;
+            tStream->write(SERIAL_INGEST_CREDIT);
+        }
+
+        if (tFrameResponse == SERIAL_INGEST_ACK) {
+            lastUpdate = getCompensatedMillis();
+            // ACK is sent at the next call after show(), the host sends the next frame only after receiving it
+            ByteValue1.IngestState = SERIAL_INGEST_STATE_SHOW_PENDING;
+            return true;
+        } else if (tFrameResponse == SERIAL_INGEST_NAK) {
+            tStream->write(SERIAL_INGEST_NAK);
+        }
+    }
+}
+#endif // defined(ENABLE_PATTERN_SERIAL_INGEST)
+
 #if defined(ENABLE_PATTERN_FIRE)
 /********************************************************
  * The original Fire code is from: Fire2012 by Mark Kriegsman, July 2012
@@ -1551,40 +2918,226 @@ bool NeoPatterns::FireUpdate(bool aDoUpdate) {
             }
         }
 
-// Step 2.  Heat from each cell drifts 'up' and diffuses a little
-        for (uint_fast16_t k = numLEDs - 1; k >= 2; k--) {
-            heat[k] = (heat[k - 1] + heat[k - 2] + heat[k - 2]) / 3;
+// Step 2.  Heat from each cell drifts 'up' and diffuses a little
+        for (uint_fast16_t k = numLEDs - 1; k >= 2; k--) {
+            heat[k] = (heat[k - 1] + heat[k - 2] + heat[k - 2]) / 3;
+        }
+        LongUnion tRandom; // usage of Long union saves 20 bytes and is way faster
+        tRandom.Long = random();
+
+// Step 3.  Randomly ignite one new 'spark' of heat near the bottom
+        if (tRandom.UBytes[0] < SPARKING) {
+            uint8_t y = tRandom.UBytes[1] % (numLEDs / 4);
+            uint8_t tNewHeat = ((tRandom.UBytes[2] * (256 - 160)) >> 8) + 160; // random(160, 256); fastest version
+//            uint8_t tNewHeat = (tRandom.UBytes[2] % ((uint8_t)(255-160))) + 160; // random(160, 255); uint8_t is required here :-(
+//            uint8_t tNewHeat = (tRandom.UBytes[2] % 95) + 160; // random(160, 255);
+            if (heat[y] + tNewHeat < heat[y]) {
+                heat[y] = UINT8_MAX;
+            } else {
+                heat[y] += tNewHeat;
+            }
+        }
+    }
+    /*
+     * Refresh pattern
+     */
+// Step 4.  Map from heat cells to LED colors
+    for (uint_fast16_t j = 0; j < numLEDs; j++) {
+        if (Direction == DIRECTION_UP) {
+            setPixelColor(j, HeatColor(heat[j]));
+        } else {
+            setPixelColor((numLEDs - 1) - j, HeatColor(heat[j]));
+        }
+    }
+    return false;
+}
+#endif // #if defined(ENABLE_PATTERN_FIRE)
+
+#if defined(ENABLE_PATTERN_EMBER)
+/*
+ * Glowing embers, which randomly flicker between their start heat and a lower heat and cool down to black.
+ * Only one array of numLEDs byte pairs of current and target heat is allocated.
+ * The start heat of each pixel is not stored, but computed from a seed and the pixel index.
+ * @param aMinHeatValue, aMaxHeatValue - Range of the start heat values of the pixels
+ * @param aMode - EMBER_MODE_RANDOM or EMBER_MODE_GRADIENT
+ * @param aIncreaseIntervalFactor - Heat is increased only every aIncreaseIntervalFactor step, decreased at every step
+ * @param aNumberOfDecreasingSteps - Number of steps until all embers are black
+ */
+void NeoPatterns::Ember(uint8_t aMinHeatValue, uint8_t aMaxHeatValue, uint8_t aMode, uint8_t aIncreaseIntervalFactor,
+        uint16_t aNumberOfDecreasingSteps, uint16_t aIntervalMillis) {
+    if (ActivePattern == PATTERN_EMBER && LongValue1.PixelHeatArrayPtr != nullptr) {
+        // Ember was started again before its end
+        free(LongValue1.PixelHeatArrayPtr);
+    }
+    setCompensatedInterval(aIntervalMillis);
+    Index = 0;
+    if (aIncreaseIntervalFactor == 0) {
+        aIncreaseIntervalFactor = 1;
+    }
+    Pointer1.IncreaseIntervalFactor = aIncreaseIntervalFactor;
+    if (aNumberOfDecreasingSteps == 0) {
+        aNumberOfDecreasingSteps = 1;
+    }
+    LongValue2.EmberValues.NumberOfDecreasingSteps = aNumberOfDecreasingSteps;
+    TotalStepCounter = aNumberOfDecreasingSteps + 1;  // + 1 step for the last pattern to show
+
+    // Current and target heat of each pixel are stored as adjacent byte pair
+    LongValue1.PixelHeatArrayPtr = (uint8_t*) malloc(numLEDs * 2);
+    if (LongValue1.PixelHeatArrayPtr == nullptr) {
+#if defined(LOCAL_INFO)
+        printPin(&Serial);
+        Serial.println(F("Not enough heap for Ember heat array"));
+#endif
+        clear();
+        TotalStepCounter = 1; // Just show black and end pattern
+    } else {
+        initEmberHeat(aMinHeatValue, aMaxHeatValue, aMode);
+    }
+
+    EmberUpdate(ONLY_REDRAW_PATTERN);
+    showPatternInitially();
+// must be after showPatternInitially(), since it requires the old value do detect asynchronous calling
+    ActivePattern = PATTERN_EMBER;
+#if defined(LOCAL_TRACE)
+    printInfo(&Serial, true);
+#endif
+}
+
+/*
+ * Chooses a new seed and sets current and target heat of all pixels to their start heat
+ * Requires an allocated LongValue1.PixelHeatArrayPtr of numLEDs byte pairs
+ */
+void NeoPatterns::initEmberHeat(uint8_t aMinHeatValue, uint8_t aMaxHeatValue, uint8_t aMode) {
+    if (aMinHeatValue > aMaxHeatValue) {
+        aMinHeatValue = aMaxHeatValue;
+    }
+    ByteValue1.MinHeatValue = aMinHeatValue;
+    ByteValue2.MaxHeatValue = aMaxHeatValue;
+    PatternFlags = aMode;
+    LongValue2.EmberValues.Seed = (random8() << 8) | random8();
+
+    uint8_t *tHeatPtr = LongValue1.PixelHeatArrayPtr;
+    for (uint_fast16_t i = 0; i < numLEDs; i++) {
+        uint8_t tStartHeat = getEmberStartHeat(i);
+        *tHeatPtr++ = tStartHeat; // current heat
+        *tHeatPtr++ = tStartHeat; // target heat
+    }
+}
+
+/*
+ * The start heat is the maximum heat of a pixel. It is computed from the seed and the pixel index and therefore needs no storage.
+ * @return value between ByteValue1.MinHeatValue and ByteValue2.MaxHeatValue
+ */
+uint8_t NeoPatterns::getEmberStartHeat(uint16_t aPixelIndex) {
+    uint8_t tDeltaHeat = ByteValue2.MaxHeatValue - ByteValue1.MinHeatValue;
+    if (PatternFlags == EMBER_MODE_GRADIENT) {
+        if (numLEDs <= 1) {
+            return ByteValue2.MaxHeatValue;
+        }
+        return ByteValue2.MaxHeatValue - (uint8_t) (((uint32_t) tDeltaHeat * aPixelIndex) / (numLEDs - 1));
+    }
+    // EMBER_MODE_RANDOM, a 16 bit integer hash of seed and pixel index
+    uint16_t tHash = (aPixelIndex + 1) * 0x9E37;
+    tHash ^= LongValue2.EmberValues.Seed;
+    tHash ^= tHash >> 7;
+    tHash = APPLY_FASTLED_RAND16_2053(tHash) + FASTLED_RAND16_13849;
+    tHash ^= tHash >> 8;
+    return ByteValue1.MinHeatValue + (((uint16_t) (tHash & 0xFF) * (tDeltaHeat + 1)) >> 8);
+}
+
+/*
+ * @return value between aCeilingHeat / 2 and aCeilingHeat
+ */
+uint8_t NeoPatterns::getEmberNewTargetHeat(uint8_t aCeilingHeat) {
+    return aCeilingHeat - random8((aCeilingHeat / 2) + 1);
+}
+
+/*
+ * Current heat moves towards the target heat. If target is reached, a new random target below the ceiling is chosen.
+ * The ceiling of each pixel is its start heat, linearly decreasing with the remaining number of steps.
+ * Only pixels with changed heat are converted to color in the refresh loop.
+ */
+bool NeoPatterns::EmberUpdate(bool aDoUpdate) {
+    uint8_t *tHeatPtr = LongValue1.PixelHeatArrayPtr;
+
+    if (aDoUpdate) {
+        if (TotalStepCounter == 1 && tHeatPtr != nullptr) {
+            // The pointer is in a union, which is overwritten by the next pattern, so it cannot be freed by freePatternMemory()
+            free(tHeatPtr);
+            LongValue1.PixelHeatArrayPtr = nullptr;
         }
-        LongUnion tRandom; // usage of Long union saves 20 bytes and is way faster
-        tRandom.Long = random();
+        if (decrementTotalStepCounter()) {
+            return true;
+        }
+        if (tHeatPtr == nullptr) {
+            return false;
+        }
+        Index++;
+        bool tDoIncrease = (Index >= Pointer1.IncreaseIntervalFactor);
+        if (tDoIncrease) {
+            Index = 0;
+        }
+        // TotalStepCounter is now NumberOfDecreasingSteps down to 1, so we end with ceiling 0 at the last step
+        uint16_t tRemainingSteps = TotalStepCounter - 1;
+        uint16_t tNumberOfDecreasingSteps = LongValue2.EmberValues.NumberOfDecreasingSteps;
 
-// Step 3.  Randomly ignite one new 'spark' of heat near the bottom
-        if (tRandom.UBytes[0] < SPARKING) {
-            uint8_t y = tRandom.UBytes[1] % (numLEDs / 4);
-            uint8_t tNewHeat = ((tRandom.UBytes[2] * (256 - 160)) >> 8) + 160; // random(160, 256); fastest version
-//            uint8_t tNewHeat = (tRandom.UBytes[2] % ((uint8_t)(255-160))) + 160; // random(160, 255); uint8_t is required here :-(
-//            uint8_t tNewHeat = (tRandom.UBytes[2] % 95) + 160; // random(160, 255);
-            if (heat[y] + tNewHeat < heat[y]) {
-                heat[y] = UINT8_MAX;
+        uint32_t tLastColor = 0;
+        uint8_t tLastHeat = 0; // HeatColor(0) is black
+        for (uint_fast16_t i = 0; i < numLEDs; i++) {
+            uint8_t tCurrentHeat = *tHeatPtr;
+            uint8_t tTargetHeat = *(tHeatPtr + 1);
+            uint8_t tCeilingHeat = ((uint32_t) getEmberStartHeat(i) * tRemainingSteps) / tNumberOfDecreasingSteps;
+            if (tTargetHeat > tCeilingHeat) {
+                tTargetHeat = tCeilingHeat;
+            }
+
+            uint8_t tNewHeat = tCurrentHeat;
+            if (tCurrentHeat > tCeilingHeat) {
+                tNewHeat = tCeilingHeat;
+            } else if (tCurrentHeat > tTargetHeat) {
+                tNewHeat = tCurrentHeat - (((tCurrentHeat - tTargetHeat) >> 2) + 1);
+            } else if (tCurrentHeat < tTargetHeat) {
+                if (tDoIncrease) {
+                    tNewHeat = tCurrentHeat + (((tTargetHeat - tCurrentHeat) >> 2) + 1);
+                }
             } else {
-                heat[y] += tNewHeat;
+                // Target reached, choose new one
+                tTargetHeat = getEmberNewTargetHeat(tCeilingHeat);
+            }
+            *tHeatPtr++ = tNewHeat;
+            *tHeatPtr++ = tTargetHeat;
+
+            if (tNewHeat != tCurrentHeat) {
+                // Batch conversion, neighboring pixels often have the same heat
+                if (tNewHeat != tLastHeat) {
+                    tLastHeat = tNewHeat;
+                    tLastColor = HeatColor(tNewHeat);
+                }
+                setPixelColor(i, tLastColor);
             }
         }
+        return false;
     }
+
     /*
      * Refresh pattern
      */
-// Step 4.  Map from heat cells to LED colors
-    for (uint_fast16_t j = 0; j < numLEDs; j++) {
-        if (Direction == DIRECTION_UP) {
-            setPixelColor(j, HeatColor(heat[j]));
-        } else {
-            setPixelColor((numLEDs - 1) - j, HeatColor(heat[j]));
+    if (tHeatPtr != nullptr) {
+        uint32_t tLastColor = 0;
+        uint8_t tLastHeat = 0;
+        for (uint_fast16_t i = 0; i < numLEDs; i++) {
+            uint8_t tHeat = *tHeatPtr;
+            tHeatPtr += 2;
+            if (tHeat != tLastHeat) {
+                tLastHeat = tHeat;
+                tLastColor = HeatColor(tHeat);
+            }
+            setPixelColor(i, tLastColor);
         }
     }
     return false;
 }
-#endif // #if defined(ENABLE_PATTERN_FIRE)
+#endif // #if defined(ENABLE_PATTERN_EMBER)
 
 uint32_t NeoPatterns::HeatColorSimple(uint8_t aTemperature) {
     uint8_t tGreen = 0;
@@ -1733,8 +3286,9 @@ void NeoPatterns::printHeat(Print *aSerial, uint8_t *aHeatArrayPtr) {
 // Initialize for a delay -> just keep the old pattern displayed
 void NeoPatterns::Delay(uint16_t aMillis) {
     ActivePattern = PATTERN_DELAY;
+    resetDurationTiming();
     setCompensatedInterval(aMillis);
-    lastUpdate = millis(); // to schedule the end of the delay
+    startSchedule(); // to schedule the end of the delay
     TotalStepCounter = 1;
 }
 
@@ -1750,6 +3304,9 @@ bool NeoPatterns::DelayUpdate(bool aDoUpdate) {
 /*
  * call provided processing routine only for pixel which have color equal to ColorForSelection
  * the last resulting color is found in BackgroundColor
+ * The pixels are selected once at start and stored in a bit array, which requires numLEDs / 8 bytes heap.
+ * If no heap is available, the pixels are selected at each update by comparing with the last color,
+ * which only works if brightness is maximal.
  */
 void NeoPatterns::ProcessSelectiveColor(color32_t aColorForSelection, color32_t (*aSingleLEDProcessingFunction)(NeoPatterns*),
         uint16_t aNumberOfSteps, uint16_t aIntervalMillis) {
@@ -1760,10 +3317,14 @@ void NeoPatterns::ProcessSelectiveColor(color32_t aColorForSelection, color32_t
 // initialize temporary color
     LongValue2.ColorTmp = aColorForSelection;
     Pointer1.SingleLEDProcessingFunction = aSingleLEDProcessingFunction;
+    createSelectionMask();
 
 // call this direct, since it is called only at update
     ProcessSelectiveColorForAllPixel();
+    uint8_t *tSelectionMaskPtr = SelectionMaskPtr;
+    SelectionMaskPtr = nullptr; // Otherwise it is freed by showPatternInitially()
     showPatternInitially();
+    SelectionMaskPtr = tSelectionMaskPtr;
 // must be after showPatternInitially(), since it requires the old value do detect asynchronous calling
     ActivePattern = PATTERN_PROCESS_SELECTIVE;
 #if defined(LOCAL_TRACE)
@@ -1771,8 +3332,47 @@ void NeoPatterns::ProcessSelectiveColor(color32_t aColorForSelection, color32_t
 #endif
 }
 
+/*
+ * Sets SelectionMaskPtr to nullptr, if no heap or no pixel buffer is available.
+ * The pixel buffer contains the colors scaled with the current brightness, so Color1 is encoded the same way before comparing.
+ */
+void NeoPatterns::createSelectionMask() {
+    freeSelectionMask(); // ProcessSelectiveColor was started again before its end
+    if (!_HAS_PIXEL_BUFFER) {
+        return;
+    }
+    SelectionMaskPtr = (uint8_t*) calloc((numLEDs + 7) / 8, 1);
+    if (SelectionMaskPtr == nullptr) {
+#if defined(LOCAL_INFO)
+        printPin(&Serial);
+        Serial.println(F("Not enough heap for selection mask"));
+#endif
+        return;
+    }
+    uint8_t tEncodedSelectionColor[4];
+    encodePixelColor(tEncodedSelectionColor, Color1);
+    uint8_t *tPixelPtr = &pixels[PixelOffset * BytesPerPixel];
+    for (uint_fast16_t i = 0; i < numLEDs; i++) {
+        if (memcmp(tPixelPtr, tEncodedSelectionColor, BytesPerPixel) == 0) {
+            SelectionMaskPtr[i / 8] |= (1 << (i % 8));
+        }
+        tPixelPtr += BytesPerPixel;
+    }
+}
+
+/*
+ * See freePatternMemory()
+ */
+void NeoPatterns::freeSelectionMask() {
+    if (SelectionMaskPtr != nullptr) {
+        free(SelectionMaskPtr);
+        SelectionMaskPtr = nullptr;
+    }
+}
+
 bool NeoPatterns::ProcessSelectiveColorUpdate(bool aDoUpdate) {
     if (aDoUpdate) {
+        freePatternMemoryAtLastStep();
         if (decrementTotalStepCounter()) {
             // store last color
             LongValue1.Color2 = LongValue2.ColorTmp;
@@ -1791,6 +3391,28 @@ bool NeoPatterns::ProcessSelectiveColorUpdate(bool aDoUpdate) {
 void NeoPatterns::ProcessSelectiveColorForAllPixel() {
 
     color32_t tNewColor = Pointer1.SingleLEDProcessingFunction(this);
+#if defined(ENABLE_PATTERN_PROCESS_SELECTIVE)
+    uint8_t *tSelectionMaskPtr = SelectionMaskPtr;
+    if (tSelectionMaskPtr != nullptr && _HAS_PIXEL_BUFFER) {
+        /*
+         * Encode new color only once and copy it to all selected pixels
+         */
+        uint8_t tEncodedPixel[4];
+        encodePixelColor(tEncodedPixel, tNewColor);
+        for (uint_fast16_t i = 0; i < numLEDs; i += 8) {
+            uint8_t tSelectionMask = *tSelectionMaskPtr++;
+            // loop ends after the last selected pixel of these 8 pixels
+            for (uint_fast16_t j = i; tSelectionMask != 0; j++) {
+                if (tSelectionMask & 0x01) {
+                    setEncodedPixelColor(j, tEncodedPixel);
+                }
+                tSelectionMask >>= 1;
+            }
+        }
+        LongValue2.ColorTmp = tNewColor;
+        return;
+    }
+#endif
     for (uint_fast16_t i = 0; i < numLEDs; i++) {
         color32_t tOldColor = getPixelColor(i);
         if (tOldColor == LongValue2.ColorTmp) {
@@ -1856,12 +3478,37 @@ color32_t BrightenColor(NeoPatterns *aNeoPatternsPtr) {
 #endif
 }
 
+/*
+ * Returns the index of the name of the pattern in PatternNamesArray.
+ * Patterns of the extended range are stored after MatrixExtraPatternSnake, unknown numbers below PATTERN_REGISTERED_FIRST map to PatternUnknown.
+ */
+uint8_t NeoPatterns::getPatternNamesIndex(uint8_t aPatternNumber) {
+    if (aPatternNumber >= PATTERN_EXTENDED_FIRST && aPatternNumber <= PATTERN_EXTENDED_LAST) {
+        return (aPatternNumber - PATTERN_EXTENDED_FIRST) + PATTERN_NAMES_INDEX_OF_EXTENDED_FIRST;
+    }
+    if (aPatternNumber >= PATTERN_NAMES_INDEX_OF_EXTENDED_FIRST) {
+        // index of PatternUnknown
+        return (PATTERN_EXTENDED_LAST - PATTERN_EXTENDED_FIRST) + PATTERN_NAMES_INDEX_OF_EXTENDED_FIRST + 1;
+    }
+    return aPatternNumber;
+}
+
 #if defined(__AVR__)
 /*
- * Not required for non AVR platforms, it is then just PatternNamesArray[aPatternNumber]
+ * Not required for non AVR platforms, it is then just PatternNamesArray[getPatternNamesIndex(aPatternNumber)]
  */
 void NeoPatterns::getPatternName(uint8_t aPatternNumber, char *aBuffer, uint8_t aBuffersize) {
-    const char *aNameArrayPointerPGM = (char*) pgm_read_word(&PatternNamesArray[aPatternNumber]);
+    const char *aNameArrayPointerPGM;
+#if defined(ENABLE_PATTERN_REGISTRY)
+    if (aPatternNumber >= PATTERN_REGISTERED_FIRST) {
+        if (isRegisteredPattern(aPatternNumber)) {
+            aNameArrayPointerPGM = (char*) pgm_read_word(&PatternRegistryArrayPGM[aPatternNumber - PATTERN_REGISTERED_FIRST].NamePGM);
+        } else {
+            aNameArrayPointerPGM = PatternUnknown;
+        }
+    } else
+#endif
+    aNameArrayPointerPGM = (char*) pgm_read_word(&PatternNamesArray[getPatternNamesIndex(aPatternNumber)]);
     char tPGMChar;
     do {
         tPGMChar = pgm_read_byte(aNameArrayPointerPGM++);
@@ -1878,15 +3525,30 @@ void NeoPatterns::getPatternName(uint8_t aPatternNumber, char *aBuffer, uint8_t
  * call it e.g. printPatternName(&Serial);
  */
 void NeoPatterns::printPatternName(uint8_t aPatternNumber, Print *aSerial) {
+#if defined(ENABLE_PATTERN_REGISTRY)
+    if (aPatternNumber >= PATTERN_REGISTERED_FIRST) {
+        if (!isRegisteredPattern(aPatternNumber)) {
+            aSerial->print((const __FlashStringHelper*) PatternUnknown);
+            return;
+        }
+        const PatternRegistryEntryStruct *tEntryPGM = &PatternRegistryArrayPGM[aPatternNumber - PATTERN_REGISTERED_FIRST];
+#  if defined(__AVR__)
+        aSerial->print((const __FlashStringHelper*) pgm_read_word(&tEntryPGM->NamePGM));
+#  else
+        aSerial->print((const __FlashStringHelper*) tEntryPGM->NamePGM);
+#  endif
+        return;
+    }
+#endif
 #if defined(__AVR__)
-    const char *aNameArrayPointerPGM = (char*) pgm_read_word(&PatternNamesArray[aPatternNumber]);
+    const char *aNameArrayPointerPGM = (char*) pgm_read_word(&PatternNamesArray[getPatternNamesIndex(aPatternNumber)]);
 #if defined(LOCAL_TRACE)
     Serial.print(F("aNameArrayPointerPGM=0x"));
     Serial.println((unsigned int) aNameArrayPointerPGM, HEX);
 #endif
     aSerial->print((const __FlashStringHelper*) aNameArrayPointerPGM);
 #else
-    aSerial->print(PatternNamesArray[aPatternNumber]);
+    aSerial->print(PatternNamesArray[getPatternNamesIndex(aPatternNumber)]);
 #endif
 }
 
@@ -1953,6 +3615,183 @@ void NeoPatterns::printInfo(Print *aSerial, bool aFullInfo) {
     }
 }
 
+#if defined(_RECORD_UPDATE_TIMING)
+/*
+ * Must be called at the start of a scheduled update, before lastUpdate is set.
+ * Records the delay of the update relative to its deadline lastUpdate + Interval + 1.
+ * @return micros() for addUpdateStatistics()
+ */
+unsigned long NeoPatterns::startUpdateStatistics() {
+    /*
+     * Signed, since lastUpdate may be in the future for drift free schedules and an update may be forced before its deadline
+     */
+    long tSignedLateMillis = (long) (getCompensatedMillis() - lastUpdate) - (long) (Interval + 1);
+    unsigned long tLateMillis = (tSignedLateMillis > 0) ? tSignedLateMillis : 0;
+#if defined(ENABLE_NEOPATTERNS_JITTER_HISTOGRAM)
+    addToJitterHistogram(&LateMillisHistogram, tLateMillis);
+#endif
+#if defined(ENABLE_NEOPATTERNS_STATISTICS)
+    Statistics.UpdateCount++;
+    if (tLateMillis > 0) {
+        Statistics.MissedDeadlineCount++;
+        Statistics.LateMillisSum += tLateMillis;
+        if (tLateMillis > Statistics.LateMillisMax) {
+            Statistics.LateMillisMax = (tLateMillis > 0xFFFF) ? 0xFFFF : tLateMillis;
+        }
+    }
+#endif
+    return micros();
+}
+
+/*
+ * @return micros() for a following addShowStatistics()
+ */
+unsigned long NeoPatterns::addUpdateStatistics(unsigned long aStartMicros) {
+    unsigned long tNowMicros = micros();
+#if defined(ENABLE_NEOPATTERNS_STATISTICS)
+    unsigned long tUpdateMicros = tNowMicros - aStartMicros;
+    Statistics.UpdateMicrosSum += tUpdateMicros;
+    if (tUpdateMicros > Statistics.UpdateMicrosMax) {
+        Statistics.UpdateMicrosMax = (tUpdateMicros > 0xFFFF) ? 0xFFFF : tUpdateMicros;
+    }
+#else
+    (void) aStartMicros;
+#endif
+    return tNowMicros;
+}
+
+void NeoPatterns::addShowStatistics(unsigned long aStartMicros) {
+#if defined(ENABLE_NEOPATTERNS_STATISTICS)
+    Statistics.ShowCount++;
+#  if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+    // micros() is not reliable, if interrupts are disabled during show(), so take the measured value if greater
+    unsigned long tShowMicros = micros() - aStartMicros;
+    if (tShowMicros < ParentNeoPixelObject->ShowDurationMicros) {
+        tShowMicros = ParentNeoPixelObject->ShowDurationMicros;
+    }
+    Statistics.ShowMicrosSum += tShowMicros;
+#  else
+    Statistics.ShowMicrosSum += micros() - aStartMicros;
+#  endif
+#else
+    (void) aStartMicros;
+#endif
+}
+#endif // defined(_RECORD_UPDATE_TIMING)
+
+#if defined(ENABLE_NEOPATTERNS_STATISTICS)
+void NeoPatterns::resetStatistics() {
+    memset(&Statistics, 0, sizeof(Statistics));
+}
+
+/*
+ * Prints e.g. "Pin=6 Updates=1234 UpdateMicros avg=85 max=412 Shows=1230 ShowMicros avg=2410 Late=3 avg=1 max=2 ms Callbacks=5"
+ */
+void NeoPatterns::printStatistics(Print *aSerial) {
+    aSerial->print(F("Pin="));
+    printPin(aSerial);
+    aSerial->print(F("Updates="));
+    aSerial->print(Statistics.UpdateCount);
+    if (Statistics.UpdateCount != 0) {
+        aSerial->print(F(" UpdateMicros avg="));
+        aSerial->print(Statistics.UpdateMicrosSum / Statistics.UpdateCount);
+        aSerial->print(F(" max="));
+        aSerial->print(Statistics.UpdateMicrosMax);
+    }
+    aSerial->print(F(" Shows="));
+    aSerial->print(Statistics.ShowCount);
+    if (Statistics.ShowCount != 0) {
+        aSerial->print(F(" ShowMicros avg="));
+        aSerial->print(Statistics.ShowMicrosSum / Statistics.ShowCount);
+    }
+    aSerial->print(F(" Late="));
+    aSerial->print(Statistics.MissedDeadlineCount);
+    if (Statistics.MissedDeadlineCount != 0) {
+        aSerial->print(F(" avg="));
+        aSerial->print(Statistics.LateMillisSum / Statistics.MissedDeadlineCount);
+        aSerial->print(F(" max="));
+        aSerial->print(Statistics.LateMillisMax);
+        aSerial->print(F(" ms"));
+    }
+    aSerial->print(F(" Callbacks="));
+    aSerial->println(Statistics.CompletionCallbackCount);
+}
+
+void printAllStatistics(Print *aSerial) {
+    for (NeoPatterns *tNextObjectPointer = NeoPatterns::FirstNeoPatternsObject; tNextObjectPointer != nullptr; tNextObjectPointer =
+            tNextObjectPointer->NextNeoPatternsObject) {
+        tNextObjectPointer->printStatistics(aSerial);
+    }
+}
+#endif // defined(ENABLE_NEOPATTERNS_STATISTICS)
+
+#if defined(ENABLE_NEOPATTERNS_JITTER_HISTOGRAM)
+void addToJitterHistogram(JitterHistogramStruct *aHistogram, unsigned long aValue) {
+    uint_fast8_t tBinIndex = 0;
+    while (aValue != 0 && tBinIndex < (JITTER_HISTOGRAM_SIZE - 1)) {
+        aValue >>= 1;
+        tBinIndex++;
+    }
+    if (aHistogram->Bins[tBinIndex] == 0xFF) {
+        // halve all bins to keep the distribution
+        for (uint_fast8_t i = 0; i < JITTER_HISTOGRAM_SIZE; ++i) {
+            aHistogram->Bins[i] >>= 1;
+        }
+    }
+    aHistogram->Bins[tBinIndex]++;
+}
+
+/*
+ * Prints e.g. " 0:200 1:12 2-3:3 4-7:0 8-15:1 16-31:0 32-63:0 >=64:0"
+ */
+void printJitterHistogram(Print *aSerial, JitterHistogramStruct *aHistogram) {
+    for (uint_fast8_t i = 0; i < JITTER_HISTOGRAM_SIZE; ++i) {
+        aSerial->print(' ');
+        if (i == JITTER_HISTOGRAM_SIZE - 1) {
+            aSerial->print(F(">="));
+            aSerial->print(1 << (i - 1));
+        } else if (i < 2) {
+            aSerial->print(i);
+        } else {
+            aSerial->print(1 << (i - 1));
+            aSerial->print('-');
+            aSerial->print((1 << i) - 1);
+        }
+        aSerial->print(':');
+        aSerial->print(aHistogram->Bins[i]);
+    }
+    aSerial->println();
+}
+
+void NeoPatterns::printJitterHistogram(Print *aSerial) {
+    aSerial->print(F("Pin="));
+    printPin(aSerial);
+    aSerial->print(F("late ms"));
+    ::printJitterHistogram(aSerial, &LateMillisHistogram);
+}
+
+/*
+ * Call it once in loop() to record the loop period
+ */
+void NeoPatterns::recordLoopPeriod() {
+    static unsigned long sLastLoopMillis;
+    unsigned long tMillis = millis();
+    if (sLastLoopMillis != 0) {
+        addToJitterHistogram(&LoopPeriodHistogram, tMillis - sLastLoopMillis);
+    }
+    sLastLoopMillis = tMillis;
+}
+
+void printAllJitterHistograms(Print *aSerial) {
+    aSerial->print(F("Loop period ms"));
+    printJitterHistogram(aSerial, &NeoPatterns::LoopPeriodHistogram);
+    for (NeoPatterns *tNextObjectPointer = NeoPatterns::FirstNeoPatternsObject; tNextObjectPointer != nullptr; tNextObjectPointer =
+            tNextObjectPointer->NextNeoPatternsObject) {
+        tNextObjectPointer->printJitterHistogram(aSerial);
+    }
+}
+#endif // defined(ENABLE_NEOPATTERNS_JITTER_HISTOGRAM)
+
 /********************************************
  * Code for user provided pattern extensions
  ********************************************/
@@ -1971,6 +3810,68 @@ bool NeoPatterns::Pattern2Update(bool aDoUpdate) {
 }
 #endif
 
+#if defined(ENABLE_PATTERN_REGISTRY)
+/*
+ * Sets the registry of the patterns provided by the main program. There is only one registry for all NeoPatterns objects.
+ * Example:
+ * const PatternRegistryEntryStruct MyPatterns[] PROGMEM = { { &MyPatternStart, &MyPatternUpdate, MyPatternName }, ... };
+ * NeoPatterns::registerPatterns(MyPatterns, sizeof(MyPatterns) / sizeof(PatternRegistryEntryStruct));
+ * The pattern number of MyPatterns[n], which must be set as ActivePattern by its init function, is PATTERN_REGISTERED_FIRST + n.
+ * @param aPatternRegistryArrayPGM - Array of entries in PROGMEM
+ */
+void NeoPatterns::registerPatterns(const PatternRegistryEntryStruct *aPatternRegistryArrayPGM, uint8_t aNumberOfRegisteredPatterns) {
+    if (aNumberOfRegisteredPatterns > (PATTERN_REGISTERED_LAST - PATTERN_REGISTERED_FIRST) + 1) {
+        aNumberOfRegisteredPatterns = (PATTERN_REGISTERED_LAST - PATTERN_REGISTERED_FIRST) + 1;
+    }
+    PatternRegistryArrayPGM = aPatternRegistryArrayPGM;
+    NumberOfRegisteredPatterns = aNumberOfRegisteredPatterns;
+}
+
+bool NeoPatterns::isRegisteredPattern(uint8_t aPatternNumber) {
+    return (aPatternNumber >= PATTERN_REGISTERED_FIRST
+            && (uint8_t) (aPatternNumber - PATTERN_REGISTERED_FIRST) < NumberOfRegisteredPatterns);
+}
+
+/*
+ * Starts a registered pattern with the default parameters of its init function
+ * @return false if pattern is not registered or has no init function
+ */
+bool NeoPatterns::startRegisteredPattern(uint8_t aPatternNumber) {
+    if (!isRegisteredPattern(aPatternNumber)) {
+        return false;
+    }
+    const PatternRegistryEntryStruct *tEntryPGM = &PatternRegistryArrayPGM[aPatternNumber - PATTERN_REGISTERED_FIRST];
+#if defined(__AVR__)
+    void (*tInitFunction)(NeoPatterns*) = (void (*)(NeoPatterns*)) pgm_read_word(&tEntryPGM->InitFunction);
+#else
+    void (*tInitFunction)(NeoPatterns*) = tEntryPGM->InitFunction;
+#endif
+    if (tInitFunction == nullptr) {
+        return false;
+    }
+    tInitFunction(this);
+    return true;
+}
+
+/*
+ * Calls the update function of the registered pattern by index, no search or switch required
+ * @return - true if pattern has ended or is not registered, false if pattern has NOT ended
+ */
+bool NeoPatterns::RegisteredPatternUpdate(bool aDoUpdate) {
+    if (!isRegisteredPattern(ActivePattern)) {
+        ActivePattern = PATTERN_NONE; // e.g. registry was changed while pattern was running
+        return true;
+    }
+    const PatternRegistryEntryStruct *tEntryPGM = &PatternRegistryArrayPGM[ActivePattern - PATTERN_REGISTERED_FIRST];
+#if defined(__AVR__)
+    bool (*tUpdateFunction)(NeoPatterns*, bool) = (bool (*)(NeoPatterns*, bool)) pgm_read_word(&tEntryPGM->UpdateFunction);
+#else
+    bool (*tUpdateFunction)(NeoPatterns*, bool) = tEntryPGM->UpdateFunction;
+#endif
+    return tUpdateFunction(this, aDoUpdate);
+}
+#endif // defined(ENABLE_PATTERN_REGISTRY)
+
 /*****************************************************************
  * COMBINED PATTERN EXAMPLE
  * overwrites the OnComplete Handler pointer and sets it
@@ -2039,6 +3940,210 @@ void multipleFallingStarsCompleteHandler(NeoPatterns *aLedsPtr) {
 }
 #endif
 
+#if defined(ENABLE_NEOPATTERNS_SEQUENCER)
+/*
+ * Starts the first pattern of a sequence in PROGMEM, see NeoSequence.h.
+ * While the sequence is running, OnPatternComplete is sequenceCompleteHandler().
+ * At the end of the sequence, OnPatternComplete is set to aNextOnCompleteHandler, which is then called.
+ * If aNextOnCompleteHandler is nullptr, ActivePattern is set to PATTERN_NONE at the end of the sequence.
+ */
+void NeoPatterns::startSequence(const uint8_t *aSequencePGM, void (*aNextOnCompleteHandler)(NeoPatterns*)) {
+    ExtendedState.SequencePGM = aSequencePGM;
+    ExtendedState.SequenceOffset = 0;
+    ExtendedState.SequenceLoopDepth = 0;
+    OnPatternComplete = &sequenceCompleteHandler;
+    NextOnPatternCompleteHandler = aNextOnCompleteHandler;
+    startNextSequenceStep();
+}
+
+bool NeoPatterns::isSequenceRunning() {
+    return (ExtendedState.SequencePGM != nullptr && OnPatternComplete == &sequenceCompleteHandler);
+}
+
+/*
+ * Executes the control steps up to the next pattern step and starts this pattern.
+ * @return false if the sequence has ended
+ */
+bool NeoPatterns::startNextSequenceStep() {
+    for (uint_fast8_t i = 0; i < SEQUENCE_MAX_CONTROL_STEPS; ++i) {
+        const uint8_t *tStepPGM = &ExtendedState.SequencePGM[ExtendedState.SequenceOffset];
+        uint8_t tOpcode = pgm_read_byte(tStepPGM);
+        uint8_t tStepLength = getSequenceStepLength(tOpcode);
+        if (tOpcode == SEQUENCE_OPCODE_END || tStepLength == 0) {
+            break;
+        }
+        ExtendedState.SequenceOffset += tStepLength;
+        uint8_t tParameter = pgm_read_byte(tStepPGM + 1);
+
+        if (tOpcode == SEQUENCE_OPCODE_RANDOM_ONE_OF) {
+            if (tParameter == 0) {
+                continue;
+            }
+            /*
+             * Continue after the n steps, and replace the RANDOM_ONE_OF step by the chosen one
+             */
+            uint16_t tChosenOffset = skipSequenceSteps(ExtendedState.SequencePGM, ExtendedState.SequenceOffset, random(tParameter));
+            ExtendedState.SequenceOffset = skipSequenceSteps(ExtendedState.SequencePGM, ExtendedState.SequenceOffset, tParameter);
+            tStepPGM = &ExtendedState.SequencePGM[tChosenOffset];
+            tOpcode = pgm_read_byte(tStepPGM);
+            tParameter = pgm_read_byte(tStepPGM + 1);
+        }
+
+        switch (tOpcode) {
+        case SEQUENCE_OPCODE_LOOP:
+            if (ExtendedState.SequenceLoopDepth >= SEQUENCE_MAX_LOOP_DEPTH) {
+                ExtendedState.SequenceOffset = skipSequenceSteps(ExtendedState.SequencePGM, ExtendedState.SequenceOffset, 0xFF); // Invalid sequence, go to the end
+                break;
+            }
+            ExtendedState.SequenceLoops[ExtendedState.SequenceLoopDepth].StartOffset = ExtendedState.SequenceOffset;
+            ExtendedState.SequenceLoops[ExtendedState.SequenceLoopDepth].RemainingRuns = tParameter;
+            ExtendedState.SequenceLoopDepth++;
+            break;
+
+        case SEQUENCE_OPCODE_END_LOOP:
+            if (ExtendedState.SequenceLoopDepth > 0) {
+                SequenceLoopStruct *tLoopPtr = &ExtendedState.SequenceLoops[ExtendedState.SequenceLoopDepth - 1];
+                if (tLoopPtr->RemainingRuns == 0 || --tLoopPtr->RemainingRuns > 0) {
+                    ExtendedState.SequenceOffset = tLoopPtr->StartOffset; // endless or not the last run
+                } else {
+                    ExtendedState.SequenceLoopDepth--;
+                }
+            }
+            break;
+
+        case SEQUENCE_OPCODE_JUMP: {
+            int16_t tTargetOffset = getSequenceStepOffset(ExtendedState.SequencePGM, tParameter);
+            if (tTargetOffset < 0) {
+                ExtendedState.SequenceOffset = skipSequenceSteps(ExtendedState.SequencePGM, ExtendedState.SequenceOffset, 0xFF);
+            } else {
+                ExtendedState.SequenceOffset = tTargetOffset;
+            }
+            ExtendedState.SequenceLoopDepth = 0;
+            break;
+        }
+
+        case SEQUENCE_OPCODE_CROSSFADE:
+#if defined(ENABLE_CROSSFADE_TRANSITION)
+            startCrossfade(readSequenceUInt16(tStepPGM + 1));
+#endif
+            break;
+
+        default:
+            /*
+             * Pattern step. A pattern, which is not enabled or has no steps, is skipped.
+             * A pattern without steps would otherwise end at the next update without calling the completion callback.
+             */
+            if (startSequencePattern(tStepPGM) && TotalStepCounter > 0) {
+                return true;
+            }
+            break;
+        }
+    }
+
+    /*
+     * End of sequence
+     */
+    ExtendedState.SequencePGM = nullptr;
+    OnPatternComplete = NextOnPatternCompleteHandler;
+    if (OnPatternComplete != nullptr) {
+        OnPatternComplete(this);
+    } else {
+        ActivePattern = PATTERN_NONE;
+    }
+    return false;
+}
+
+/*
+ * Starts the pattern of a pattern step
+ * @return false if the pattern is not supported or not enabled
+ */
+bool NeoPatterns::startSequencePattern(const uint8_t *aStepPGM) {
+    uint8_t tOpcode = pgm_read_byte(aStepPGM);
+    const uint8_t *tParameterPGM = aStepPGM + 1;
+    switch (tOpcode) {
+#if defined(ENABLE_PATTERN_RAINBOW_CYCLE)
+    case SEQUENCE_OPCODE_RAINBOW_CYCLE:
+        RainbowCycle(pgm_read_byte(tParameterPGM), pgm_read_byte(tParameterPGM + 1), pgm_read_byte(tParameterPGM + 2));
+        return true;
+#endif
+#if defined(ENABLE_PATTERN_COLOR_WIPE)
+    case SEQUENCE_OPCODE_COLOR_WIPE:
+        ColorWipe(readSequenceUInt32(tParameterPGM), readSequenceUInt16(tParameterPGM + 4), pgm_read_byte(tParameterPGM + 6),
+                pgm_read_byte(tParameterPGM + 7));
+        return true;
+#endif
+#if defined(ENABLE_PATTERN_FADE)
+    case SEQUENCE_OPCODE_FADE:
+        Fade(readSequenceUInt32(tParameterPGM), readSequenceUInt32(tParameterPGM + 4), readSequenceUInt16(tParameterPGM + 8),
+                readSequenceUInt16(tParameterPGM + 10));
+        return true;
+#endif
+    case SEQUENCE_OPCODE_DELAY:
+        Delay(readSequenceUInt16(tParameterPGM));
+        return true;
+#if defined(ENABLE_PATTERN_SCANNER_EXTENDED)
+    case SEQUENCE_OPCODE_SCANNER_EXTENDED:
+        ScannerExtended(readSequenceUInt32(tParameterPGM), pgm_read_byte(tParameterPGM + 4), readSequenceUInt16(tParameterPGM + 5),
+                readSequenceUInt16(tParameterPGM + 7), pgm_read_byte(tParameterPGM + 9), pgm_read_byte(tParameterPGM + 10));
+        return true;
+#endif
+#if defined(ENABLE_PATTERN_STRIPES)
+    case SEQUENCE_OPCODE_STRIPES:
+        Stripes(readSequenceUInt32(tParameterPGM), pgm_read_byte(tParameterPGM + 4), readSequenceUInt32(tParameterPGM + 5),
+                pgm_read_byte(tParameterPGM + 9), readSequenceUInt16(tParameterPGM + 10), readSequenceUInt16(tParameterPGM + 12),
+                pgm_read_byte(tParameterPGM + 14));
+        return true;
+#endif
+#if defined(ENABLE_PATTERN_FLASH)
+    case SEQUENCE_OPCODE_FLASH:
+        Flash(readSequenceUInt32(tParameterPGM), readSequenceUInt16(tParameterPGM + 4), readSequenceUInt32(tParameterPGM + 6),
+                readSequenceUInt16(tParameterPGM + 10), readSequenceUInt16(tParameterPGM + 12), pgm_read_byte(tParameterPGM + 14));
+        return true;
+#endif
+#if defined(ENABLE_PATTERN_HEARTBEAT)
+    case SEQUENCE_OPCODE_HEARTBEAT:
+        Heartbeat(readSequenceUInt32(tParameterPGM), readSequenceUInt16(tParameterPGM + 4), readSequenceUInt16(tParameterPGM + 6),
+                pgm_read_byte(tParameterPGM + 8));
+        return true;
+#endif
+#if defined(ENABLE_PATTERN_FIRE)
+    case SEQUENCE_OPCODE_FIRE:
+        Fire(readSequenceUInt16(tParameterPGM), readSequenceUInt16(tParameterPGM + 2), pgm_read_byte(tParameterPGM + 4));
+        return true;
+#endif
+#if defined(ENABLE_PATTERN_TWINKLE)
+    case SEQUENCE_OPCODE_TWINKLE:
+        Twinkle(readSequenceUInt32(tParameterPGM), pgm_read_byte(tParameterPGM + 4), readSequenceUInt16(tParameterPGM + 5),
+                readSequenceUInt16(tParameterPGM + 7), pgm_read_byte(tParameterPGM + 9));
+        return true;
+#endif
+#if defined(ENABLE_PATTERN_BOUNCING_BALL)
+    case SEQUENCE_OPCODE_BOUNCING_BALL:
+        BouncingBall(readSequenceUInt32(tParameterPGM), readSequenceUInt16(tParameterPGM + 4), readSequenceUInt16(tParameterPGM + 6),
+                (int8_t) pgm_read_byte(tParameterPGM + 8), pgm_read_byte(tParameterPGM + 9));
+        return true;
+#endif
+#if defined(ENABLE_PATTERN_EMBER)
+    case SEQUENCE_OPCODE_EMBER:
+        Ember(pgm_read_byte(tParameterPGM), pgm_read_byte(tParameterPGM + 1), pgm_read_byte(tParameterPGM + 2),
+                pgm_read_byte(tParameterPGM + 3), readSequenceUInt16(tParameterPGM + 4), readSequenceUInt16(tParameterPGM + 6));
+        return true;
+#endif
+    default:
+#if defined(ENABLE_PATTERN_REGISTRY)
+        if (tOpcode >= SEQUENCE_OPCODE_REGISTERED_FIRST) {
+            return startRegisteredPattern(tOpcode);
+        }
+#endif
+        return false;
+    }
+}
+
+void sequenceCompleteHandler(NeoPatterns *aLedsPtr) {
+    aLedsPtr->startNextSequenceStep();
+}
+#endif // defined(ENABLE_NEOPATTERNS_SEQUENCER)
+
 const char* DirectionToString(uint8_t aDirection) {
     switch (aDirection) {
     case DIRECTION_UP:
@@ -2067,6 +4172,9 @@ const char* DirectionToString(uint8_t aDirection) {
 void allPatternsRandomHandler(NeoPatterns *aLedsPtr) {
     LongUnion tRandom; // usage of Long union saves 4 bytes and is way faster
     tRandom.Long = random();
+#if defined(ENABLE_CROSSFADE_TRANSITION)
+    aLedsPtr->startCrossfade(); // Fade from the last frame of the old pattern to the new one
+#endif
 
     uint8_t tDuration = ((tRandom.UBytes[2] * (81 - 40)) >> 8) + 40; // = random(40, 81); fastest version
 //    uint8_t tDuration = (tRandom.UBytes[2] % 41) + 40;  // = random(40, 81);
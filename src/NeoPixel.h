@@ -31,6 +31,8 @@
  * MatrixSnake --> MatrixNeoPatterns  <                                o--> NeoPixel --> Adafruit_NeoPixel
  *                                     `o--> NeoPatterns    (virtual) /
  *
+ * With ENABLE_NON_VIRTUAL_INHERITANCE we have a single inheritance chain without virtual base
+ * MatrixSnake --> MatrixNeoPatterns --> MatrixNeoPixel --> NeoPatterns --> NeoPixel --> Adafruit_NeoPixel
  */
 
 #ifndef _NEOPATTERNS_NEOPIXEL_H
@@ -61,6 +63,83 @@
 #define SUPPORT_NO_ZERO_BRIGHTNESS // Introduced to avoid double negations
 #  endif
 #endif
+
+//#define DO_NOT_SUPPORT_SHOW_TIME_COMPENSATION // Disables measuring the duration of show() and compensating the milliseconds, which millis() missed while interrupts were disabled by show().
+#if !defined(DO_NOT_SUPPORT_SHOW_TIME_COMPENSATION)
+#define SUPPORT_SHOW_TIME_COMPENSATION // Introduced to avoid double negations
+//#define CORRECT_ARDUINO_MILLIS_FOR_SHOW // Adds the missed milliseconds directly to timer0_millis of the Arduino AVR core, so millis() is correct for the whole program.
+#  if defined(CORRECT_ARDUINO_MILLIS_FOR_SHOW) && defined(ARDUINO_ARCH_AVR)
+#define _CORRECT_ARDUINO_MILLIS
+#  endif
+#endif
+
+/*
+ * beginIndexedPixelBuffer() replaces the pixel buffer by a buffer of 4 or 8 bit palette indexes and a palette of 16 or 256 colors.
+ * This requires 1/6 or 1/3 of the RAM of a RGB pixel buffer plus 112 or 1792 bytes for the palette.
+ * On AVR with 16 MHz, show() sends the pixels directly from the palette with interrupts disabled for the whole frame.
+ * On other platforms, a temporary buffer for the expanded pixels is allocated during show(), so the heap must have room for it.
+ * Brightness is applied to the palette, and show() expands the indexes to the encoded palette entries.
+ * A new color gets a palette entry, which is not used by any pixel. If the palette is full, the nearest palette color is taken.
+ * Partial NeoPixel objects and setEncodedPixelColor() are not supported.
+ */
+//#define ENABLE_INDEXED_PIXEL_BUFFER // Requires 12 bytes RAM per object.
+
+/*
+ * Enables the show hooks, which are called by show() with the object, whose pixel buffer is sent,
+ * and the class NeoAnimationRecorder in NeoAnimation.h, which uses a show hook to record all shown frames.
+ */
+//#define ENABLE_ANIMATION_RECORDER // Requires 2 bytes RAM on AVR.
+/*
+ * Enables the show hooks and the class NeoPixelTelemetry in NeoPixelTelemetry.h,
+ * which sends the shown frames of one NeoPixel object as compact binary stream for host visualization.
+ */
+//#define ENABLE_NEOPIXEL_TELEMETRY // Requires 2 bytes RAM on AVR.
+#if defined(ENABLE_ANIMATION_RECORDER) || defined(ENABLE_NEOPIXEL_TELEMETRY)
+#define _SUPPORT_SHOW_HOOK
+#endif
+
+/*
+ * startCrossfade() keeps the currently shown frame and blends it with the new content of the pixel buffer at each show(),
+ * until aDurationMillis have passed. Call it e.g. in an OnPatternComplete handler before starting the next pattern.
+ * The pixel buffer is not modified by the transition, the blended frame is sent from a second buffer.
+ * Both buffers are allocated only for the duration of the transition, from the heap
+ * or from a static pool of NEOPIXEL_CROSSFADE_SCRATCH_POOL_SIZE bytes, which is shared by all NeoPixel objects.
+ * Partial NeoPixel objects and the indexed pixel buffer are not supported.
+ */
+//#define ENABLE_CROSSFADE_TRANSITION // Requires 12 bytes RAM per object on AVR and 2 * pixel buffer size during the transition.
+//#define NEOPIXEL_CROSSFADE_SCRATCH_POOL_SIZE    (2 * 3 * 64) // Use a static pool instead of the heap, e.g. for 64 RGB pixels.
+#if !defined(CROSSFADE_DEFAULT_DURATION_MILLIS)
+#define CROSSFADE_DEFAULT_DURATION_MILLIS   400 // Used by allPatternsRandomHandler() and MatrixAndSnakePatternsDemoHandler()
+#endif
+#if !defined(CROSSFADE_REFRESH_MILLIS)
+#define CROSSFADE_REFRESH_MILLIS    20 // NeoPatterns::update() calls show() at least this often during a transition
+#endif
+
+/*
+ * With ENABLE_STREAMING_OUTPUT, NeoPatterns::beginStreaming() frees the pixel buffer, see NeoPatterns.h.
+ * Then all functions writing or reading the pixel buffer do nothing or use the indexed pixel buffer.
+ */
+#if defined(ENABLE_STREAMING_OUTPUT) || defined(ENABLE_INDEXED_PIXEL_BUFFER)
+#define _HAS_PIXEL_BUFFER       (pixels != nullptr)
+#else
+#define _HAS_PIXEL_BUFFER       true
+#endif
+
+#if defined(__AVR__) && (F_CPU == 16000000L)
+#define _SUPPORT_BIT_SLICE_OUTPUT // sendBitSlices() has 20 cycles per bit, which is 800 kHz at 16 MHz
+#endif
+#if defined(_SUPPORT_BIT_SLICE_OUTPUT) && defined(SUPPORT_SHOW_TIME_COMPENSATION)
+#define _SUPPORT_FRAME_TIMING // Measuring of frames, which are computed and sent with interrupts disabled
+#endif
+
+/*
+ * By default, NeoPatterns and MatrixNeoPixel inherit NeoPixel virtually, so MatrixNeoPatterns contains only one NeoPixel.
+ * Each access to a NeoPixel member like pixels, numLEDs or Brightness from pattern or matrix code then requires an indirection via the virtual base.
+ * ENABLE_NON_VIRTUAL_INHERITANCE changes the hierarchy to the single chain MatrixNeoPatterns -> MatrixNeoPixel -> NeoPatterns -> NeoPixel.
+ * This removes the indirection and saves the virtual base pointers, but each MatrixNeoPixel object then contains the pattern state of NeoPatterns.
+ */
+//#define ENABLE_NON_VIRTUAL_INHERITANCE
+
 #define MAX_BRIGHTNESS  0xFF
 #define MAX_WHEEL_POSITION  0xFF
 
@@ -82,8 +161,37 @@ uint8_t Blue(color32_t color) __attribute__ ((deprecated ("Renamed to getBluePar
 #define ENABLE_CALLING_SHOW_OF_PARENT   true
 #define DISABLE_CALLING_SHOW_OF_PARENT  false
 
+#if defined(_SUPPORT_SHOW_HOOK)
+class NeoPixel;
+/*
+ * Base class of the objects, which are called by show(), like NeoAnimationRecorder and NeoPixelTelemetry.
+ * All hooks added by NeoPixel::addShowHook() are called, so e.g. a recorder and a telemetry can be active at the same time.
+ * SIZE = 4 bytes on AVR
+ */
+class NeoPixelShowHook {
+public:
+    void (*ShowHookFunction)(NeoPixelShowHook *aShowHook, NeoPixel *aNeoPixel); // Called with the object, whose pixel buffer is sent
+    NeoPixelShowHook *NextShowHook;
+};
+#endif
+
+#if defined(_SUPPORT_FRAME_TIMING)
+/*
+ * State of the measuring of one frame, see NeoPixel::startFrameTiming()
+ */
+struct FrameTimingStruct {
+#  if defined(TIFR0)
+    uint8_t StartTimerCount;        // TCNT0 at start of frame
+    bool OverflowWasPending;        // The timer 0 overflow was before the start of frame
+    uint16_t NumberOfOverflows;     // The timer 0 overflows cleared during the frame
+#  else
+    unsigned long StartMicros;
+#  endif
+};
+#endif
+
 /*
- * SIZE = 6 + 22 from Adafruit_NeoPixel = 28
+ * SIZE = 6 + 2 for SUPPORT_SHOW_TIME_COMPENSATION + 22 from Adafruit_NeoPixel = 30
  */
 class NeoPixel: public Adafruit_NeoPixel {
 public:
@@ -102,18 +210,65 @@ public:
     void printPin(Print *aSerial);
 
     uint16_t getAndAdjustActualNeopixelLenghtSimple();
+    uint16_t getAndAdjustActualNeopixelLenghtBisection();
 
     // To enable more than one pattern on the same strip
     void setPixelBuffer(uint8_t *aNewPixelBufferPointer);
 
     // To move the start index of a NeoPixel object
     void setPixelOffsetForPartialNeoPixel(uint16_t aPixelOffset);
+    // To move and resize a NeoPixel object, e.g. for PatternSegment
+    void setPixelRegionForPartialNeoPixel(uint16_t aPixelOffset, uint16_t aNumberOfPixels);
     /*
      * Extensions to Adafruit_NeoPixel functions
      */
     void begin();
     void begin(uint8_t aBrightness, bool aEnableBrightnessNonZeroMode = false);
     void show();
+    bool isPixelBufferSentByShow();
+#if defined(ENABLE_CROSSFADE_TRANSITION)
+    ~NeoPixel();
+    void updateLength(uint16_t aNumberOfPixels);
+#endif
+    static unsigned long getCompensatedMillis();
+#if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+    void showAndMeasure();
+    static void addMicrosMissedByShow(uint32_t aMissedMicros);
+    void setShowDurationMicros(uint32_t aShowMicros);
+    uint16_t getShowDurationMicros();
+#endif
+    static void convertBytesToBitSlices(uint8_t *aBytes, uint8_t aNumberOfBytes, uint8_t aPinMask, uint8_t *aBitSlices);
+#if defined(_SUPPORT_BIT_SLICE_OUTPUT)
+    static void sendBitSlices(volatile uint8_t *aPortOutputRegister, uint8_t aPinMask, uint8_t *aBitSlices,
+            uint16_t aNumberOfBitSlices);
+#endif
+#if defined(_SUPPORT_FRAME_TIMING)
+    static void startFrameTiming(FrameTimingStruct *aFrameTiming);
+    static void pollFrameTiming(FrameTimingStruct *aFrameTiming);
+    void endFrameTiming(FrameTimingStruct *aFrameTiming);
+#endif
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+    bool beginIndexedPixelBuffer(uint8_t aBitsPerPixel = 4);
+    bool endIndexedPixelBuffer();
+    bool isIndexed();
+    uint16_t getIndexBufferSize();
+    void clearIndexedPixelBuffer();
+    uint8_t getPaletteIndex(color32_t aColor);
+    void releaseUnusedPaletteEntries();
+    void setPaletteColor(uint8_t aPaletteIndex, color32_t aColor);
+    void encodePalette();
+    void setPixelPaletteIndex(uint16_t aPixelIndex, uint8_t aPaletteIndex);
+    uint8_t getPixelPaletteIndex(uint16_t aPixelIndex);
+    void setIndexedPixelColor(uint16_t aPixelIndex, color32_t aColor);
+    color32_t getIndexedPixelColor(uint16_t aPixelIndex);
+    void showIndexed();
+#endif
+#if defined(ENABLE_CROSSFADE_TRANSITION)
+    bool startCrossfade(uint16_t aDurationMillis = CROSSFADE_DEFAULT_DURATION_MILLIS);
+    void endCrossfade();
+    bool isCrossfadeActive();
+    bool showCrossfade();
+#endif
     // Version with error message
     bool begin(Print *aSerial);
     bool begin(Print *aSerial, uint8_t aBrightness, bool aEnableBrightnessNonZeroMode = false);
@@ -137,6 +292,8 @@ public:
     void setPixelColor(uint16_t aPixelIndex, uint8_t aRed, uint8_t aGreen, uint8_t aBlue, uint8_t aWhite);
 #endif
     void setPixelColor(uint16_t aPixelIndex, color32_t aColor);
+    void encodePixelColor(uint8_t *aPixelPtr, color32_t aColor);
+    void setEncodedPixelColor(uint16_t aPixelIndex, uint8_t *aEncodedPixelPtr);
 
     void setBrightnessValue(uint8_t aBrightness)__attribute__ ((deprecated ("Renamed to setBrightness()")));
     void setBrightness(uint8_t aBrightness);                // Sets the brightness used by Neopixel drawing functions
@@ -146,6 +303,7 @@ public:
     void fillWithRainbow(uint8_t aRainbowWheelStartPos, bool aStartAtTop = false);
     void drawBar(uint16_t aBarLength, color32_t aColor, bool aDrawFromBottom = true);
     void fillRegion(color32_t aColor, uint16_t aRegionStartIndext, uint16_t aRegionLength);
+    void replicatePeriod(uint16_t aPeriodPixels);
     void copyRegion(uint16_t aSourcePixelIndex, uint16_t aTargetPixelIndex, uint16_t aLength, bool aDoReverseCopy);
     void drawBarFromColorArray(uint16_t aBarLength, color32_t *aColorArrayPtr, bool aDrawFromBottom = true);
 
@@ -178,6 +336,40 @@ public:
     uint16_t PixelOffset;           // The offset of the pattern on the parent pixel buffer to enable partial patterns overlays
     NeoPixel *ParentNeoPixelObject; // The parent (bigger) NeoPixel object which contains all pixels of this object or the object itself or "this" if no parent specified. Used for partial patterns overlays.
     uint8_t Brightness;             // NeoPixel effective brightness instead of the Adafruit brightness, which is stored as effective brightness + 1 :-(.
+#if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+    uint16_t ShowDurationMicros;    // Measured duration of the last show() of this object, saturated at 0xFFFF. Partial objects use the value of ParentNeoPixelObject.
+    static unsigned long MillisMissedByShow;        // Sum of all milliseconds, which millis() missed during show(). Added by getCompensatedMillis().
+    static uint16_t MicrosMissedByShowRemainder;    // The not yet credited part of the missed time
+#endif
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+    color32_t *PaletteColors;       // Start of the allocated palette and index buffer, nullptr if not in indexed mode. Entry 0 is black.
+    uint8_t *EncodedPalette;        // Palette entries with Brightness applied in the byte order of the strip
+    uint8_t *IndexBuffer;           // One palette index per pixel, 2 pixels per byte for 4 bit indexes
+    uint16_t NumberOfPaletteColors; // Number of used palette entries, free entries above 0 are black
+    uint8_t PaletteBitsPerPixel;    // 4 or 8
+    uint8_t EncodedPaletteBrightness; // Brightness used for EncodedPalette
+    uint8_t LastPaletteIndex;       // Cache for getPaletteIndex()
+    bool PaletteIsFull;             // A new color did not fit into the palette since the last show() or clear(), so unused entries were already released
+#endif
+#if defined(ENABLE_CROSSFADE_TRANSITION)
+    uint8_t *CrossfadeBuffer;       // The outgoing frame followed by the blended frame, nullptr if no transition is active
+    unsigned long CrossfadeStartMillis;
+    unsigned long LastCrossfadeShowMillis;
+    uint16_t CrossfadeDurationMillis;
+#  if defined(NEOPIXEL_CROSSFADE_SCRATCH_POOL_SIZE)
+    static uint8_t CrossfadeScratchPool[NEOPIXEL_CROSSFADE_SCRATCH_POOL_SIZE];
+    static bool CrossfadeScratchPoolIsUsed; // Only one transition at a time can use the pool
+#  endif
+#endif
+#if defined(_SUPPORT_SHOW_HOOK)
+    static void addShowHook(NeoPixelShowHook *aShowHook, void (*aShowHookFunction)(NeoPixelShowHook *aShowHook, NeoPixel *aNeoPixel));
+    static void removeShowHook(NeoPixelShowHook *aShowHook);
+    static void callShowHooks(NeoPixel *aNeoPixel);
+    static NeoPixelShowHook *FirstShowHook; // List of hooks called by show() before the pixel buffer is sent
+#endif
+#if defined(ENABLE_STREAMING_OUTPUT)
+    static void (*StreamingShowFunction)(NeoPixel *aNeoPixel); // Called by show() instead of sending the pixel buffer, if it was freed by NeoPatterns::beginStreaming()
+#endif
 };
 
 #define PIXEL_FLAG_IS_PARTIAL_NEOPIXEL                  0x01 // enables partial patterns overlays and uses show() of ParentNeoPixelObject
@@ -189,6 +381,11 @@ public:
  */
 #define PIXEL_FLAG_SHOW_ONLY_AT_UPDATE                  0x04
 #define PIXEL_FLAG_USE_NON_ZERO_BRIGHTNESS              0x08 // Pixel is set to zero, only if brightness or input color is zero, otherwise it is clipped at e.g. 0x000100
+// Flags for NeoPattern timing policies, see setTimingPolicy()
+#define PIXEL_FLAG_TIMING_DRIFT_FREE                    0x10 // Next update is scheduled at lastUpdate + Interval + 1 instead of millis() + Interval + 1
+#define PIXEL_FLAG_TIMING_SKIP_FRAMES                   0x20 // All due steps are processed by one update, but only the last one is shown
+#define PIXEL_FLAG_TIMING_FOR_DURATION                  0x40 // Set by the *Duration() functions for the current pattern. Implies drift free and skip frames.
+#define PIXEL_FLAGS_TIMING_MASK                         (PIXEL_FLAG_TIMING_DRIFT_FREE | PIXEL_FLAG_TIMING_SKIP_FRAMES | PIXEL_FLAG_TIMING_FOR_DURATION)
 // Used for some demo handler
 #define PIXEL_FLAG_GEOMETRY_CIRCLE                      0x80 // in contrast to bar
 
@@ -33,6 +33,24 @@
 
 #include "NeoPixel.h"
 
+#if defined(_SUPPORT_SHOW_HOOK)
+NeoPixelShowHook *NeoPixel::FirstShowHook = nullptr;
+#endif
+#if defined(ENABLE_STREAMING_OUTPUT)
+void (*NeoPixel::StreamingShowFunction)(NeoPixel *aNeoPixel) = nullptr;
+#endif
+#if defined(ENABLE_CROSSFADE_TRANSITION) && defined(NEOPIXEL_CROSSFADE_SCRATCH_POOL_SIZE)
+uint8_t NeoPixel::CrossfadeScratchPool[NEOPIXEL_CROSSFADE_SCRATCH_POOL_SIZE];
+bool NeoPixel::CrossfadeScratchPoolIsUsed = false;
+#endif
+#if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+unsigned long NeoPixel::MillisMissedByShow = 0;
+uint16_t NeoPixel::MicrosMissedByShowRemainder = 0;
+#  if defined(_CORRECT_ARDUINO_MILLIS)
+extern volatile unsigned long timer0_millis; // Arduino AVR core variable, which is returned by millis()
+#  endif
+#endif
+
 NeoPixel::NeoPixel() :  // @suppress("Class members should be properly initialized")
         Adafruit_NeoPixel() {
 
@@ -43,6 +61,16 @@ NeoPixel::NeoPixel() :  // @suppress("Class members should be properly initializ
     PixelFlags = 0;
     numBytes = 0;
     Brightness = MAX_BRIGHTNESS;
+#if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+    ShowDurationMicros = 0;
+#endif
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+    PaletteColors = nullptr;
+    IndexBuffer = nullptr;
+#endif
+#if defined(ENABLE_CROSSFADE_TRANSITION)
+    CrossfadeBuffer = nullptr;
+#endif
 }
 
 NeoPixel::NeoPixel(uint16_t aNumberOfPixels, uint8_t aPin, neoPixelType aTypeOfPixel) : // @suppress("Class members should be properly initialized")
@@ -55,6 +83,16 @@ NeoPixel::NeoPixel(uint16_t aNumberOfPixels, uint8_t aPin, neoPixelType aTypeOfP
     ParentNeoPixelObject = this;
     PixelFlags = 0;
     Brightness = MAX_BRIGHTNESS;
+#if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+    ShowDurationMicros = 0;
+#endif
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+    PaletteColors = nullptr;
+    IndexBuffer = nullptr;
+#endif
+#if defined(ENABLE_CROSSFADE_TRANSITION)
+    CrossfadeBuffer = nullptr;
+#endif
 }
 
 /*
@@ -62,7 +100,7 @@ NeoPixel::NeoPixel(uint16_t aNumberOfPixels, uint8_t aPin, neoPixelType aTypeOfP
  */
 void NeoPixel::AdafruitNeoPixelIinit(uint16_t aNumberOfPixels, uint16_t aPin, neoPixelType aTypeOfPixel) {
     Adafruit_NeoPixel::updateType(aTypeOfPixel);
-    Adafruit_NeoPixel::updateLength(aNumberOfPixels);
+    updateLength(aNumberOfPixels);
     Adafruit_NeoPixel::setPin(aPin);
 }
 
@@ -79,6 +117,9 @@ bool NeoPixel::init(uint16_t aNumberOfPixels, uint8_t aPin, neoPixelType aTypeOf
     PixelOffset = 0;  // 8 byte Flash
     ParentNeoPixelObject = this;
     PixelFlags = 0;
+#if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+    ShowDurationMicros = 0;
+#endif
     return (numLEDs != 0);
 }
 
@@ -108,6 +149,16 @@ NeoPixel::NeoPixel(NeoPixel *aParentNeoPixelObject, uint16_t aPixelOffset, uint1
 #endif
     PixelOffset = aPixelOffset;
     Brightness = MAX_BRIGHTNESS;
+#if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+    ShowDurationMicros = 0;
+#endif
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+    PaletteColors = nullptr; // A partial NeoPixel uses the pixel buffer of its parent and has no own indexed pixel buffer
+    IndexBuffer = nullptr;
+#endif
+#if defined(ENABLE_CROSSFADE_TRANSITION)
+    CrossfadeBuffer = nullptr;
+#endif
     PixelFlags = PIXEL_FLAG_IS_PARTIAL_NEOPIXEL | PIXEL_FLAG_DISABLE_SHOW_OF_PARENT_PIXEL_OBJECT;
     if (aEnableShowOfParentPixel) {
         PixelFlags = PIXEL_FLAG_IS_PARTIAL_NEOPIXEL;
@@ -139,6 +190,16 @@ void NeoPixel::init(NeoPixel *aParentNeoPixelObject, uint16_t aPixelOffset, uint
 #endif
     PixelOffset = aPixelOffset;
     Brightness = MAX_BRIGHTNESS;
+#if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+    ShowDurationMicros = 0;
+#endif
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+    PaletteColors = nullptr;
+    IndexBuffer = nullptr;
+#endif
+#if defined(ENABLE_CROSSFADE_TRANSITION)
+    CrossfadeBuffer = nullptr;
+#endif
     PixelFlags = PIXEL_FLAG_IS_PARTIAL_NEOPIXEL;
     if (!aEnableShowOfParentPixel) {
         PixelFlags = PIXEL_FLAG_IS_PARTIAL_NEOPIXEL | PIXEL_FLAG_DISABLE_SHOW_OF_PARENT_PIXEL_OBJECT;
@@ -242,6 +303,10 @@ void NeoPixel::printInfo(Print *aSerial) {
 
     aSerial->print(F(" PixelFlags=0x"));
     aSerial->print(PixelFlags, HEX);
+#if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+    aSerial->print(F(" ShowMicros="));
+    aSerial->print(ParentNeoPixelObject->ShowDurationMicros);
+#endif
     aSerial->print(F(" &ParentNeoPixelObject=0x"));
     aSerial->print((uintptr_t) ParentNeoPixelObject, HEX);
     aSerial->print(F(" &NeoPixel=0x"));
@@ -258,8 +323,55 @@ void NeoPixel::printContent(Print *aSerial) {
     aSerial->println();
 }
 
+#if defined(_SUPPORT_SHOW_HOOK)
+/*
+ * Appends aShowHook to the list of hooks, which are called by show().
+ * If aShowHook is already in the list, only its function is changed.
+ */
+void NeoPixel::addShowHook(NeoPixelShowHook *aShowHook,
+        void (*aShowHookFunction)(NeoPixelShowHook *aShowHook, NeoPixel *aNeoPixel)) {
+    aShowHook->ShowHookFunction = aShowHookFunction;
+    NeoPixelShowHook **tNextShowHookPtr = &FirstShowHook;
+    while (*tNextShowHookPtr != nullptr) {
+        if (*tNextShowHookPtr == aShowHook) {
+            return;
+        }
+        tNextShowHookPtr = &(*tNextShowHookPtr)->NextShowHook;
+    }
+    aShowHook->NextShowHook = nullptr;
+    *tNextShowHookPtr = aShowHook;
+}
+
+/*
+ * Can be called for a hook, which is not in the list
+ */
+void NeoPixel::removeShowHook(NeoPixelShowHook *aShowHook) {
+    NeoPixelShowHook **tNextShowHookPtr = &FirstShowHook;
+    while (*tNextShowHookPtr != nullptr) {
+        if (*tNextShowHookPtr == aShowHook) {
+            *tNextShowHookPtr = aShowHook->NextShowHook;
+            return;
+        }
+        tNextShowHookPtr = &(*tNextShowHookPtr)->NextShowHook;
+    }
+}
+
+/*
+ * Calls all hooks with the object, whose pixel buffer is sent. A hook may remove itself.
+ */
+void NeoPixel::callShowHooks(NeoPixel *aNeoPixel) {
+    NeoPixelShowHook *tShowHook = FirstShowHook;
+    while (tShowHook != nullptr) {
+        NeoPixelShowHook *tNextShowHook = tShowHook->NextShowHook;
+        tShowHook->ShowHookFunction(tShowHook, aNeoPixel);
+        tShowHook = tNextShowHook;
+    }
+}
+#endif
+
 /*
  * Handles the PIXEL_FLAG_DISABLE_SHOW_OF_PARENT_PIXEL_OBJECT flag
+ * If the pixel buffer was freed by NeoPatterns::beginStreaming(), the pixels are computed and sent by StreamingShowFunction.
  */
 void NeoPixel::show() {
     if (PixelFlags & PIXEL_FLAG_IS_PARTIAL_NEOPIXEL) {
@@ -269,7 +381,8 @@ void NeoPixel::show() {
             Serial.print(F("Parent.show, brightness="));
             Serial.println(Brightness);
 #endif
-            ParentNeoPixelObject->Adafruit_NeoPixel::show();
+            // The parent calls the show hooks and handles streaming, indexed and crossfade output
+            ParentNeoPixelObject->show();
         }
     } else {
 #if defined(LOCAL_TRACE)
@@ -277,10 +390,658 @@ void NeoPixel::show() {
         Serial.print(F("Show, brightness="));
         Serial.println(Brightness);
 #endif
+#if defined(ENABLE_STREAMING_OUTPUT)
+#  if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+        if (pixels == nullptr && numLEDs != 0 && IndexBuffer == nullptr && StreamingShowFunction != nullptr) {
+#  else
+        if (pixels == nullptr && numLEDs != 0 && StreamingShowFunction != nullptr) {
+#  endif
+            StreamingShowFunction(this);
+            return;
+        }
+#endif
+#if defined(ENABLE_CROSSFADE_TRANSITION)
+        if (CrossfadeBuffer != nullptr && showCrossfade()) {
+            return;
+        }
+#endif
+#if defined(_SUPPORT_SHOW_HOOK)
+        callShowHooks(this);
+#endif
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+        if (IndexBuffer != nullptr) {
+            showIndexed();
+            return;
+        }
+#endif
+#if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+        showAndMeasure();
+#else
         Adafruit_NeoPixel::show();
+#endif
+    }
+}
+
+/*
+ * @return true if show() sends the pixel buffer as it is, i.e. no streaming output, indexed pixel buffer or crossfade transition is active.
+ * Used by NeoPixelParallelGroup, which sends the pixel buffers of its strips itself.
+ */
+bool NeoPixel::isPixelBufferSentByShow() {
+#if defined(ENABLE_CROSSFADE_TRANSITION)
+    if (CrossfadeBuffer != nullptr) {
+        return false;
+    }
+#endif
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+    if (IndexBuffer != nullptr) {
+        return false;
+    }
+#endif
+    return _HAS_PIXEL_BUFFER;
+}
+
+/*
+ * Time base for all NeoPatterns schedules.
+ * Returns millis() plus the milliseconds, which millis() missed while interrupts were disabled by show().
+ */
+unsigned long NeoPixel::getCompensatedMillis() {
+#if defined(SUPPORT_SHOW_TIME_COMPENSATION) && !defined(_CORRECT_ARDUINO_MILLIS)
+    return millis() + MillisMissedByShow;
+#else
+    return millis();
+#endif
+}
+
+#if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+/*
+ * Calls Adafruit_NeoPixel::show() and measures its duration.
+ * On most platforms interrupts are disabled during show(), so millis() and micros() miss all but one timer interrupt,
+ * e.g. around 8 ms for 300 pixel. The real duration is at least the time for sending the data,
+ * which is 10 us per byte at 800 kHz. The missed time is this duration minus the measured micros().
+ * For platforms, which do not block interrupts, e.g. ESP32, the measured micros() are greater and nothing is missed.
+ */
+void NeoPixel::showAndMeasure() {
+    unsigned long tStartMicros = micros();
+    Adafruit_NeoPixel::show();
+    unsigned long tShowMicros = micros() - tStartMicros;
+
+#if defined(NEO_KHZ400)
+    uint32_t tMinimumShowMicros = (uint32_t) numBytes * (is800KHz ? 10 : 20);
+#else
+    uint32_t tMinimumShowMicros = (uint32_t) numBytes * 10;
+#endif
+    if (tShowMicros < tMinimumShowMicros) {
+        addMicrosMissedByShow(tMinimumShowMicros - tShowMicros);
+        tShowMicros = tMinimumShowMicros;
+    }
+    setShowDurationMicros(tShowMicros);
+#if defined(LOCAL_DEBUG)
+    printPin(&Serial);
+    Serial.print(F("Show took "));
+    Serial.print(tShowMicros);
+    Serial.print(F(" us, missed millis="));
+    Serial.println(MillisMissedByShow);
+#endif
+}
+
+/*
+ * Credits the microseconds, which millis() missed during a show(), to the time base of the schedules
+ */
+void NeoPixel::addMicrosMissedByShow(uint32_t aMissedMicros) {
+    uint32_t tMissedMicros = MicrosMissedByShowRemainder + aMissedMicros;
+    if (tMissedMicros >= 1000) {
+        uint32_t tMissedMillis = tMissedMicros / 1000;
+        tMissedMicros -= tMissedMillis * 1000;
+#  if defined(_CORRECT_ARDUINO_MILLIS)
+        uint8_t tOldSREG = SREG;
+        cli();
+        timer0_millis += tMissedMillis;
+        SREG = tOldSREG;
+#  else
+        MillisMissedByShow += tMissedMillis;
+#  endif
+    }
+    MicrosMissedByShowRemainder = tMissedMicros;
+}
+
+/*
+ * Long strips require more than 65 ms for show(), so the value is saturated at 0xFFFF
+ */
+void NeoPixel::setShowDurationMicros(uint32_t aShowMicros) {
+    ShowDurationMicros = (aShowMicros > 0xFFFF) ? 0xFFFF : aShowMicros;
+}
+
+/*
+ * @return the measured duration of the last show() of the parent (or this) object, 0 if show() was not yet called
+ */
+uint16_t NeoPixel::getShowDurationMicros() {
+    return ParentNeoPixelObject->ShowDurationMicros;
+}
+#endif
+
+#if defined(_SUPPORT_BIT_SLICE_OUTPUT)
+/*
+ * Sends aNumberOfBitSlices bits to all pins of aPinMask at the same time. Each byte of aBitSlices contains one bit for each pin.
+ * A pin stays high for a 1 bit, if its bit is set in the slice.
+ * Interrupts must be disabled by the caller.
+ * 20 cycles per bit at 16 MHz = 1.25 us.
+ * All pins are high for 6 cycles = 375 ns for a 0 bit and 13 cycles = 812 ns for a 1 bit.
+ */
+void NeoPixel::sendBitSlices(volatile uint8_t *aPortOutputRegister, uint8_t aPinMask, uint8_t *aBitSlices,
+        uint16_t aNumberOfBitSlices) {
+    uint8_t tHigh = *aPortOutputRegister | aPinMask;
+    uint8_t tLow = *aPortOutputRegister & ~aPinMask;
+    uint8_t tData;
+    asm volatile(
+            "1:"                            "\n\t"
+            "st   %a[port], %[high]"        "\n\t" // 2  all pins high
+            "ld   %[data], %a[slice]+"      "\n\t" // 2
+            "or   %[data], %[low]"          "\n\t" // 1
+            "nop"                           "\n\t" // 1
+            "st   %a[port], %[data]"        "\n\t" // 2  pins with 0 bit low
+            "rjmp .+0"                      "\n\t" // 2
+            "rjmp .+0"                      "\n\t" // 2
+            "nop"                           "\n\t" // 1
+            "st   %a[port], %[low]"         "\n\t" // 2  all pins low
+            "sbiw %[count], 1"              "\n\t" // 2
+            "nop"                           "\n\t" // 1
+            "brne 1b"                       "\n\t" // 2
+            : [slice] "+x" (aBitSlices), [count] "+w" (aNumberOfBitSlices), [data] "=&r" (tData)
+            : [port] "z" (aPortOutputRegister), [high] "r" (tHigh), [low] "r" (tLow)
+            : "memory" // aBitSlices may have been written just before, and the port is written
+    );
+}
+#endif
+
+#if defined(_SUPPORT_FRAME_TIMING)
+/*
+ * Measures a frame, which is sent with interrupts disabled and whose pixels are computed between sending them,
+ * like for showStreaming() and showIndexed(). The computing time is not known, so showAndMeasure() cannot be used.
+ * Must be called after cli(), pollFrameTiming() must be called after each pixel and endFrameTiming() before interrupts are enabled again.
+ * With the Arduino timer 0, the overflows, which millis() would miss, are counted and cleared by pollFrameTiming()
+ * and credited by endFrameTiming(). Therefore computing and sending one pixel must take less than 1024 us.
+ */
+void NeoPixel::startFrameTiming(FrameTimingStruct *aFrameTiming) {
+#  if defined(TIFR0)
+    uint8_t tTimerCount = TCNT0;
+    aFrameTiming->StartTimerCount = tTimerCount;
+    // Same check as in micros(), a pending overflow with count 255 just happened after reading TCNT0
+    aFrameTiming->OverflowWasPending = ((TIFR0 & _BV(TOV0)) && tTimerCount < 255);
+    aFrameTiming->NumberOfOverflows = 0;
+#  else
+    aFrameTiming->StartMicros = micros();
+#  endif
+}
+
+void NeoPixel::pollFrameTiming(FrameTimingStruct *aFrameTiming) {
+#  if defined(TIFR0)
+    if (TIFR0 & _BV(TOV0)) {
+        TIFR0 = _BV(TOV0); // Clear the overflow, so it is not handled by the timer 0 interrupt
+        aFrameTiming->NumberOfOverflows++;
+    }
+#  else
+    (void) aFrameTiming;
+#  endif
+}
+
+/*
+ * Credits the missed time to the schedules and sets the show duration
+ */
+void NeoPixel::endFrameTiming(FrameTimingStruct *aFrameTiming) {
+#  if defined(TIFR0)
+    uint8_t tTimerCount = TCNT0;
+    if ((TIFR0 & _BV(TOV0)) && tTimerCount < 255) {
+        TIFR0 = _BV(TOV0);
+        aFrameTiming->NumberOfOverflows++;
+    }
+    int32_t tTimerTicks = ((int32_t) (aFrameTiming->NumberOfOverflows - aFrameTiming->OverflowWasPending) * 256) + tTimerCount
+            - aFrameTiming->StartTimerCount;
+    // The Arduino core runs timer 0 with prescaler 64 and the millis() interrupt at each overflow
+    addMicrosMissedByShow(aFrameTiming->NumberOfOverflows * clockCyclesToMicroseconds(64 * 256UL));
+    setShowDurationMicros(tTimerTicks * clockCyclesToMicroseconds(64));
+#  else
+    /*
+     * Without timer 0, only the time for sending of 10 us per byte is credited, like for showAndMeasure()
+     */
+    uint32_t tShowMicros = micros() - aFrameTiming->StartMicros;
+    uint32_t tMinimumShowMicros = (uint32_t) numLEDs * BytesPerPixel * 10;
+    if (tShowMicros < tMinimumShowMicros) {
+        addMicrosMissedByShow(tMinimumShowMicros - tShowMicros);
+        tShowMicros = tMinimumShowMicros;
+    }
+    setShowDurationMicros(tShowMicros);
+#  endif
+}
+#endif
+
+/*
+ * Converts each bit of aBytes to one byte, which is aPinMask for a 1 bit and 0 for a 0 bit. MSB first.
+ * Available on all platforms, to be checked by extras/BitSliceCheck on the host.
+ */
+void NeoPixel::convertBytesToBitSlices(uint8_t *aBytes, uint8_t aNumberOfBytes, uint8_t aPinMask, uint8_t *aBitSlices) {
+    for (uint_fast8_t i = 0; i < aNumberOfBytes; i++) {
+        uint8_t tByte = *aBytes++;
+        for (uint_fast8_t j = 0; j < 8; j++) {
+            *aBitSlices++ = (tByte & 0x80) ? aPinMask : 0;
+            tByte <<= 1;
+        }
+    }
+}
+
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+/*
+ * Replaces the pixel buffer by a buffer of palette indexes. The pixel buffer content is lost.
+ * Must be called after begin().
+ * @param aBitsPerPixel - 4 for a palette of 16 colors, 8 for a palette of 256 colors
+ * @return false if not enough memory available, then the pixel buffer is allocated again
+ */
+bool NeoPixel::beginIndexedPixelBuffer(uint8_t aBitsPerPixel) {
+    if ((PixelFlags & PIXEL_FLAG_IS_PARTIAL_NEOPIXEL) || IndexBuffer != nullptr || numLEDs == 0) {
+        return false;
+    }
+    if (aBitsPerPixel != 8) {
+        aBitsPerPixel = 4;
+    }
+    PaletteBitsPerPixel = aBitsPerPixel;
+    uint16_t tNumberOfPaletteEntries = 1 << aBitsPerPixel;
+#if defined(ENABLE_CROSSFADE_TRANSITION)
+    endCrossfade(); // Otherwise showCrossfade() would blend with the freed pixel buffer
+#endif
+    // Free the pixel buffer first, to have its memory available for the index buffer
+    free(pixels);
+    pixels = nullptr;
+    numBytes = 0;
+    PaletteColors = (color32_t*) malloc(tNumberOfPaletteEntries * (sizeof(color32_t) + BytesPerPixel) + getIndexBufferSize());
+    if (PaletteColors == nullptr) {
+        updateLength(numLEDs);
+        return false;
+    }
+    EncodedPalette = (uint8_t*) &PaletteColors[tNumberOfPaletteEntries];
+    IndexBuffer = &EncodedPalette[tNumberOfPaletteEntries * BytesPerPixel];
+    PaletteColors[0] = COLOR32_BLACK;
+    EncodedPaletteBrightness = Brightness;
+    encodePixelColor(EncodedPalette, COLOR32_BLACK);
+    clearIndexedPixelBuffer();
+    return true;
+}
+
+/*
+ * Allocates the pixel buffer again and copies the colors of all pixels to it
+ * @return false if not enough memory available, then the indexed pixel buffer is kept
+ */
+bool NeoPixel::endIndexedPixelBuffer() {
+    if (IndexBuffer == nullptr) {
+        return true;
+    }
+    uint16_t tNumberOfPixels = numLEDs;
+    updateLength(tNumberOfPixels);
+    if (pixels == nullptr) {
+        numLEDs = tNumberOfPixels;
+        return false;
+    }
+    for (uint_fast16_t i = 0; i < numLEDs; i++) {
+        setPixelColor(i, getIndexedPixelColor(i));
+    }
+    free(PaletteColors);
+    PaletteColors = nullptr;
+    IndexBuffer = nullptr;
+    return true;
+}
+
+bool NeoPixel::isIndexed() {
+    return (IndexBuffer != nullptr);
+}
+
+uint16_t NeoPixel::getIndexBufferSize() {
+    if (PaletteBitsPerPixel == 8) {
+        return numLEDs;
+    }
+    return (numLEDs + 1) / 2;
+}
+
+/*
+ * Sets all pixels to palette entry 0, which is black, and frees all other palette entries
+ */
+void NeoPixel::clearIndexedPixelBuffer() {
+    memset(IndexBuffer, 0, getIndexBufferSize());
+    NumberOfPaletteColors = 1;
+    LastPaletteIndex = 0;
+    PaletteIsFull = false;
+}
+
+/*
+ * Returns the palette index of aColor. If aColor is not in the palette, it is stored in a free entry.
+ * If there is no free entry, the index of the nearest palette color is returned.
+ */
+uint8_t NeoPixel::getPaletteIndex(color32_t aColor) {
+    if (aColor == COLOR32_BLACK) {
+        return 0; // Free entries are black too
+    }
+    if (PaletteColors[LastPaletteIndex] == aColor) {
+        return LastPaletteIndex;
+    }
+    uint_fast16_t tNumberOfPaletteColors = NumberOfPaletteColors;
+    for (uint_fast16_t i = 0; i < tNumberOfPaletteColors; i++) {
+        if (PaletteColors[i] == aColor) {
+            LastPaletteIndex = i;
+            return i;
+        }
+    }
+
+    uint8_t tPaletteIndex = 0;
+    if (tNumberOfPaletteColors < (1U << PaletteBitsPerPixel)) {
+        tPaletteIndex = tNumberOfPaletteColors;
+        NumberOfPaletteColors = tNumberOfPaletteColors + 1;
+    } else {
+        /*
+         * Palette is full, look for an entry released by releaseUnusedPaletteEntries(), which is black.
+         * The index buffer is scanned only once until the next show() or clear(), otherwise many new colors would require numLEDs * new colors steps.
+         */
+        if (!PaletteIsFull) {
+            releaseUnusedPaletteEntries();
+            PaletteIsFull = true;
+        }
+        for (uint_fast16_t i = 1; i < tNumberOfPaletteColors; i++) {
+            if (PaletteColors[i] == COLOR32_BLACK) {
+                tPaletteIndex = i;
+                break;
+            }
+        }
+        if (tPaletteIndex == 0) {
+            /*
+             * No free entry, take the nearest color
+             */
+            uint16_t tMinimumDistance = 0xFFFF;
+            for (uint_fast16_t i = 0; i < tNumberOfPaletteColors; i++) {
+                color32_t tPaletteColor = PaletteColors[i];
+                uint16_t tDistance = abs((int16_t) getRedPart(tPaletteColor) - getRedPart(aColor))
+                        + abs((int16_t) getGreenPart(tPaletteColor) - getGreenPart(aColor))
+                        + abs((int16_t) getBluePart(tPaletteColor) - getBluePart(aColor));
+#if defined(_SUPPORT_RGBW)
+                tDistance += abs((int16_t) getWhitePart(tPaletteColor) - getWhitePart(aColor));
+#endif
+                if (tDistance < tMinimumDistance) {
+                    tMinimumDistance = tDistance;
+                    tPaletteIndex = i;
+                }
+            }
+            LastPaletteIndex = tPaletteIndex;
+            return tPaletteIndex;
+        }
+    }
+    setPaletteColor(tPaletteIndex, aColor);
+    LastPaletteIndex = tPaletteIndex;
+    return tPaletteIndex;
+}
+
+/*
+ * Sets all palette entries, which are not used by any pixel, to black, which marks them as free.
+ * Requires one pass over the index buffer.
+ */
+void NeoPixel::releaseUnusedPaletteEntries() {
+    uint8_t tUsedEntries[256 / 8];
+    memset(tUsedEntries, 0, sizeof(tUsedEntries));
+    for (uint_fast16_t i = 0; i < numLEDs; i++) {
+        uint8_t tPaletteIndex = getPixelPaletteIndex(i);
+        tUsedEntries[tPaletteIndex >> 3] |= 1 << (tPaletteIndex & 0x07);
+    }
+    for (uint_fast16_t i = 1; i < NumberOfPaletteColors; i++) {
+        if ((tUsedEntries[i >> 3] & (1 << (i & 0x07))) == 0) {
+            PaletteColors[i] = COLOR32_BLACK;
+        }
+    }
+#if defined(LOCAL_DEBUG)
+    printPin(&Serial);
+    Serial.println(F("Unused palette entries released"));
+#endif
+}
+
+/*
+ * Changes the color of all pixels using this palette entry
+ */
+void NeoPixel::setPaletteColor(uint8_t aPaletteIndex, color32_t aColor) {
+    if (Brightness != EncodedPaletteBrightness) {
+        encodePalette(); // Keep all entries encoded with the same brightness
+    }
+    PaletteColors[aPaletteIndex] = aColor;
+    encodePixelColor(&EncodedPalette[aPaletteIndex * BytesPerPixel], aColor);
+}
+
+/*
+ * Applies the current Brightness to all used palette entries.
+ * This replaces the brightness computation for each pixel.
+ */
+void NeoPixel::encodePalette() {
+    EncodedPaletteBrightness = Brightness;
+    for (uint_fast16_t i = 0; i < NumberOfPaletteColors; i++) {
+        encodePixelColor(&EncodedPalette[i * BytesPerPixel], PaletteColors[i]);
+    }
+}
+
+void NeoPixel::setPixelPaletteIndex(uint16_t aPixelIndex, uint8_t aPaletteIndex) {
+    if (PaletteBitsPerPixel == 8) {
+        IndexBuffer[aPixelIndex] = aPaletteIndex;
+    } else {
+        uint8_t *tIndexPtr = &IndexBuffer[aPixelIndex / 2];
+        if (aPixelIndex & 0x01) {
+            *tIndexPtr = (*tIndexPtr & 0xF0) | aPaletteIndex;
+        } else {
+            *tIndexPtr = (*tIndexPtr & 0x0F) | (aPaletteIndex << 4);
+        }
     }
 }
 
+uint8_t NeoPixel::getPixelPaletteIndex(uint16_t aPixelIndex) {
+    if (PaletteBitsPerPixel == 8) {
+        return IndexBuffer[aPixelIndex];
+    }
+    uint8_t tIndexes = IndexBuffer[aPixelIndex / 2];
+    if (aPixelIndex & 0x01) {
+        return tIndexes & 0x0F;
+    }
+    return tIndexes >> 4;
+}
+
+/*
+ * Checks for valid pixel index / skips invalid ones. Does nothing if not in indexed mode.
+ */
+void NeoPixel::setIndexedPixelColor(uint16_t aPixelIndex, color32_t aColor) {
+    if (IndexBuffer != nullptr && aPixelIndex < numLEDs) {
+        setPixelPaletteIndex(aPixelIndex, getPaletteIndex(aColor));
+    }
+}
+
+/*
+ * @return the palette color of the pixel, i.e. without Brightness applied. Black if not in indexed mode.
+ */
+color32_t NeoPixel::getIndexedPixelColor(uint16_t aPixelIndex) {
+    if (IndexBuffer == nullptr || aPixelIndex >= numLEDs) {
+        return COLOR32_BLACK;
+    }
+    return PaletteColors[getPixelPaletteIndex(aPixelIndex)];
+}
+
+/*
+ * Expands the palette indexes to the encoded palette entries while sending.
+ * On AVR with 16 MHz, each pixel is sent directly from the encoded palette, so no pixel buffer is required.
+ * Interrupts are disabled for the whole frame like for showStreaming(), so no interrupt service routine can extend
+ * the gap between two pixels, and the missed millis() are credited to the schedules.
+ * On other platforms, the pixels are expanded into a temporary pixel buffer, which is allocated only during Adafruit_NeoPixel::show().
+ * If it cannot be allocated, the strip keeps the last frame.
+ */
+void NeoPixel::showIndexed() {
+    if (Brightness != EncodedPaletteBrightness) {
+        encodePalette();
+    }
+    PaletteIsFull = false; // Pixels may be changed for the next frame, so a full palette may then have unused entries
+
+#if defined(_SUPPORT_BIT_SLICE_OUTPUT)
+    uint8_t tBitSlices[8 * 4]; // One byte for each bit of the encoded pixel
+    uint8_t tPaletteIndex = getPixelPaletteIndex(0);
+    convertBytesToBitSlices(&EncodedPalette[tPaletteIndex * BytesPerPixel], BytesPerPixel, pinMask, tBitSlices);
+
+    while (!canShow()) {
+        ; // Wait for reset / latch time of the last show()
+    }
+    uint8_t tOldSREG = SREG;
+    cli();
+#  if defined(_SUPPORT_FRAME_TIMING)
+    FrameTimingStruct tFrameTiming;
+    startFrameTiming(&tFrameTiming);
+#  endif
+    for (uint_fast16_t i = 0; i < numLEDs; i++) {
+        uint8_t tNewPaletteIndex = getPixelPaletteIndex(i);
+        if (tNewPaletteIndex != tPaletteIndex) {
+            tPaletteIndex = tNewPaletteIndex;
+            convertBytesToBitSlices(&EncodedPalette[tPaletteIndex * BytesPerPixel], BytesPerPixel, pinMask, tBitSlices);
+        }
+        sendBitSlices(port, pinMask, tBitSlices, BytesPerPixel * 8);
+#  if defined(_SUPPORT_FRAME_TIMING)
+        pollFrameTiming(&tFrameTiming);
+#  endif
+    }
+#  if defined(_SUPPORT_FRAME_TIMING)
+    endFrameTiming(&tFrameTiming);
+#  endif
+    SREG = tOldSREG;
+    endTime = micros();
+
+#else
+    uint16_t tNumberOfBytes = numLEDs * BytesPerPixel;
+    uint8_t *tPixels = (uint8_t*) malloc(tNumberOfBytes);
+    if (tPixels == nullptr) {
+        return;
+    }
+    for (uint_fast16_t i = 0; i < numLEDs; i++) {
+        memcpy(&tPixels[i * BytesPerPixel], &EncodedPalette[getPixelPaletteIndex(i) * BytesPerPixel], BytesPerPixel);
+    }
+    pixels = tPixels;
+    numBytes = tNumberOfBytes;
+#  if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+    showAndMeasure();
+#  else
+    Adafruit_NeoPixel::show();
+#  endif
+    free(tPixels);
+    pixels = nullptr;
+    numBytes = 0;
+#endif
+}
+#endif // defined(ENABLE_INDEXED_PIXEL_BUFFER)
+
+#if defined(ENABLE_CROSSFADE_TRANSITION)
+/*
+ * Releases the buffers of a running transition, especially the scratch pool
+ */
+NeoPixel::~NeoPixel() {
+    endCrossfade();
+}
+
+/*
+ * Hides Adafruit_NeoPixel::updateLength(), since the buffers of a running transition have the size of the old pixel buffer
+ */
+void NeoPixel::updateLength(uint16_t aNumberOfPixels) {
+    endCrossfade();
+    Adafruit_NeoPixel::updateLength(aNumberOfPixels);
+}
+
+/*
+ * Keeps the currently shown frame as outgoing frame for a transition of aDurationMillis.
+ * A running transition is restarted with its last blended frame as outgoing frame.
+ * @return false if not supported for this object or no memory available. Then the next show() is a hard cut.
+ */
+bool NeoPixel::startCrossfade(uint16_t aDurationMillis) {
+    if ((PixelFlags & PIXEL_FLAG_IS_PARTIAL_NEOPIXEL) || !_HAS_PIXEL_BUFFER || numBytes == 0 || aDurationMillis == 0) {
+        return false;
+    }
+#  if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+    if (IndexBuffer != nullptr) {
+        return false;
+    }
+#  endif
+    if (CrossfadeBuffer != nullptr) {
+        memcpy(CrossfadeBuffer, &CrossfadeBuffer[numBytes], numBytes);
+    } else {
+#  if defined(NEOPIXEL_CROSSFADE_SCRATCH_POOL_SIZE)
+        if (CrossfadeScratchPoolIsUsed || (2 * numBytes) > NEOPIXEL_CROSSFADE_SCRATCH_POOL_SIZE) {
+            return false;
+        }
+        CrossfadeScratchPoolIsUsed = true;
+        CrossfadeBuffer = CrossfadeScratchPool;
+#  else
+        CrossfadeBuffer = (uint8_t*) malloc(2 * numBytes);
+        if (CrossfadeBuffer == nullptr) {
+            return false;
+        }
+#  endif
+        memcpy(CrossfadeBuffer, pixels, numBytes);
+        memcpy(&CrossfadeBuffer[numBytes], pixels, numBytes); // In case startCrossfade() is called again before the next show()
+    }
+    CrossfadeDurationMillis = aDurationMillis;
+    CrossfadeStartMillis = getCompensatedMillis();
+    LastCrossfadeShowMillis = CrossfadeStartMillis;
+    return true;
+}
+
+/*
+ * Releases the buffers of the transition. The next show() sends the pixel buffer.
+ */
+void NeoPixel::endCrossfade() {
+    if (CrossfadeBuffer == nullptr) {
+        return;
+    }
+#  if defined(NEOPIXEL_CROSSFADE_SCRATCH_POOL_SIZE)
+    CrossfadeScratchPoolIsUsed = false;
+#  else
+    free(CrossfadeBuffer);
+#  endif
+    CrossfadeBuffer = nullptr;
+}
+
+bool NeoPixel::isCrossfadeActive() {
+    return (CrossfadeBuffer != nullptr);
+}
+
+/*
+ * Blends the encoded bytes of the outgoing frame and of the pixel buffer with an 8 bit alpha, which rises linearly
+ * over CrossfadeDurationMillis, and sends the result. Blending the encoded bytes requires no decoding or Brightness handling.
+ * The pixel buffer is not modified, since patterns like Stripes or Twinkle read their last frame.
+ * @return false if the transition has ended, then the pixel buffer must be sent as usual.
+ */
+bool NeoPixel::showCrossfade() {
+    unsigned long tMillis = getCompensatedMillis();
+    unsigned long tElapsedMillis = tMillis - CrossfadeStartMillis;
+    if (tElapsedMillis >= CrossfadeDurationMillis) {
+        endCrossfade();
+        return false;
+    }
+    LastCrossfadeShowMillis = tMillis;
+
+    uint16_t tAlpha = (tElapsedMillis << 8) / CrossfadeDurationMillis; // Weight of the pixel buffer, 0 to 255
+    uint16_t tOutgoingAlpha = 256 - tAlpha;
+    uint8_t *tOutgoingPtr = CrossfadeBuffer;
+    uint8_t *tBlendedPtr = &CrossfadeBuffer[numBytes];
+    uint8_t *tPixelPtr = pixels;
+    for (uint_fast16_t i = 0; i < numBytes; i++) {
+        *tBlendedPtr++ = ((*tPixelPtr++ * tAlpha) + (*tOutgoingPtr++ * tOutgoingAlpha)) >> 8;
+    }
+
+    // Send the blended frame like showIndexed() does
+    uint8_t *tPixels = pixels;
+    pixels = &CrossfadeBuffer[numBytes];
+#  if defined(_SUPPORT_SHOW_HOOK)
+    callShowHooks(this);
+#  endif
+#  if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+    showAndMeasure();
+#  else
+    Adafruit_NeoPixel::show();
+#  endif
+    pixels = tPixels;
+    return true;
+}
+#endif // defined(ENABLE_CROSSFADE_TRANSITION)
+
 uint8_t NeoPixel::getBytesPerPixel() {
     return BytesPerPixel;
 }
@@ -310,6 +1071,25 @@ void NeoPixel::setPixelOffsetForPartialNeoPixel(uint16_t aPixelOffset) {
     }
 }
 
+/*
+ * Sets offset and length of a partial NeoPixel object. The region is clipped to the parent pixel buffer.
+ * Used by PatternSegment to share one partial NeoPatterns object for multiple segments.
+ */
+void NeoPixel::setPixelRegionForPartialNeoPixel(uint16_t aPixelOffset, uint16_t aNumberOfPixels) {
+    if (PixelFlags & PIXEL_FLAG_IS_PARTIAL_NEOPIXEL) {
+        uint16_t tParentNumberOfPixels = ParentNeoPixelObject->numLEDs;
+        if (aPixelOffset > tParentNumberOfPixels) {
+            aPixelOffset = tParentNumberOfPixels;
+        }
+        if (aNumberOfPixels > tParentNumberOfPixels - aPixelOffset) {
+            aNumberOfPixels = tParentNumberOfPixels - aPixelOffset;
+        }
+        PixelOffset = aPixelOffset;
+        numLEDs = aNumberOfPixels;
+        numBytes = aNumberOfPixels * BytesPerPixel;
+    }
+}
+
 /*
  *
  * Free old pixel buffer and set new value.
@@ -345,6 +1125,12 @@ void NeoPixel::restorePixelBuffer(uint8_t *aPixelBufferPointerSource) {
  * Clear allPixels
  */
 void NeoPixel::clear(void) {
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+    if (IndexBuffer != nullptr) {
+        clearIndexedPixelBuffer();
+        return;
+    }
+#endif
     memset(pixels + (BytesPerPixel * PixelOffset), 0, numBytes);
 }
 
@@ -357,6 +1143,14 @@ void NeoPixel::clearAndShow(void) {
  * Requires 50 bytes program memory, but is faster than using setPixelColor()
  */
 void NeoPixel::clearPixel(uint16_t aPixelIndex) {
+    if (!_HAS_PIXEL_BUFFER) {
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+        if (IndexBuffer != nullptr && aPixelIndex < numLEDs) {
+            setPixelPaletteIndex(aPixelIndex, 0);
+        }
+#endif
+        return;
+    }
     if (aPixelIndex < numLEDs) {
         aPixelIndex += PixelOffset; // added line to support offsets
     }
@@ -453,6 +1247,12 @@ void NeoPixel::setBrightnessNonZeroMode(bool aEnableBrightnessNonZeroMode) {
  * Checks for valid pixel index / skips invalid ones
  */
 void NeoPixel::setPixelColor(uint16_t aPixelIndex, uint8_t aRed, uint8_t aGreen, uint8_t aBlue) {
+    if (!_HAS_PIXEL_BUFFER) {
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+        setIndexedPixelColor(aPixelIndex, Color(aRed, aGreen, aBlue));
+#endif
+        return;
+    }
 #if defined(LOCAL_TRACE)
     printPin(&Serial);
     Serial.print(F("Pixel="));
@@ -528,6 +1328,12 @@ void NeoPixel::setPixelColor(uint16_t aPixelIndex, uint8_t aRed, uint8_t aGreen,
 
 #if defined(_SUPPORT_RGBW)
 void NeoPixel::setPixelColor(uint16_t aPixelIndex, uint8_t aRed, uint8_t aGreen, uint8_t aBlue, uint8_t aWhite) {
+    if (!_HAS_PIXEL_BUFFER) {
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+        setIndexedPixelColor(aPixelIndex, Color(aRed, aGreen, aBlue, aWhite));
+#endif
+        return;
+    }
 #if defined(LOCAL_TRACE)
     printPin(&Serial);
     Serial.print(F("Pixel="));
@@ -609,6 +1415,12 @@ void NeoPixel::setPixelColor(uint16_t aPixelIndex, uint8_t aRed, uint8_t aGreen,
  * Version with rounded brightness computation and special non zero brightness mode
  */
 void NeoPixel::setPixelColor(uint16_t aPixelIndex, color32_t aColor) {
+    if (!_HAS_PIXEL_BUFFER) {
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+        setIndexedPixelColor(aPixelIndex, aColor);
+#endif
+        return;
+    }
 
 //    if(aColor == 0) {
 //        // is faster and adds 78 bytes for clearPixel function
@@ -617,11 +1429,6 @@ void NeoPixel::setPixelColor(uint16_t aPixelIndex, color32_t aColor) {
     if (aPixelIndex < numLEDs) {
         aPixelIndex += PixelOffset; // support offsets, no check for overflow
 
-        uint8_t tRed = (uint8_t) (aColor >> 16);
-        uint8_t tGreen = (uint8_t) (aColor >> 8);
-        uint8_t tBlue = (uint8_t) aColor;
-        uint8_t *tPixelPtr = &pixels[aPixelIndex * BytesPerPixel];
-
 #if defined(LOCAL_TRACE)
         printPin(&Serial);
         Serial.print(F("Pixel="));
@@ -633,81 +1440,104 @@ void NeoPixel::setPixelColor(uint16_t aPixelIndex, color32_t aColor) {
         Serial.print(F(" Brightness=0x"));
         Serial.println(Brightness);
 #endif
+        encodePixelColor(&pixels[aPixelIndex * BytesPerPixel], aColor);
+    }
+}
+
+/*
+ * Writes the color with the current brightness in the byte order of the pixel type to aPixelPtr.
+ * aPixelPtr can point to a pixel of the pixel buffer or to a buffer of encoded pixels used by setEncodedPixelColor().
+ */
+void NeoPixel::encodePixelColor(uint8_t *aPixelPtr, color32_t aColor) {
+    uint8_t tRed = (uint8_t) (aColor >> 16);
+    uint8_t tGreen = (uint8_t) (aColor >> 8);
+    uint8_t tBlue = (uint8_t) aColor;
 
 #if defined(SUPPORT_BRIGHTNESS)
-        uint8_t tBrightness = Brightness;
+    uint8_t tBrightness = Brightness;
 #  if defined(SUPPORT_NO_ZERO_BRIGHTNESS)
-        uint8_t tMaxOffset;
+    uint8_t tMaxOffset;
 #  endif
 #endif
 
 #if defined(_SUPPORT_RGBW)
-        uint8_t tWhite;
-        if (BytesPerPixel == 4) {
-            tWhite = (uint8_t) (aColor >> 24);
+    uint8_t tWhite;
+    if (BytesPerPixel == 4) {
+        tWhite = (uint8_t) (aColor >> 24);
 #if defined(SUPPORT_BRIGHTNESS)
-            if (tBrightness != MAX_BRIGHTNESS) {
-                tWhite = (tWhite * tBrightness) >> 8;
-            }
-#endif
-            tPixelPtr[wOffset] = tWhite;
+        if (tBrightness != MAX_BRIGHTNESS) {
+            tWhite = (tWhite * tBrightness) >> 8;
         }
 #endif
+        aPixelPtr[wOffset] = tWhite;
+    }
+#endif
 
 #if defined(SUPPORT_BRIGHTNESS)
-        // brightness check and multiplication adds 68 (132 with RGBW) bytes
-        if (tBrightness != MAX_BRIGHTNESS) {
+    // brightness check and multiplication adds 68 (132 with RGBW) bytes
+    if (tBrightness != MAX_BRIGHTNESS) {
 #  if defined(SUPPORT_NO_ZERO_BRIGHTNESS)
-            // searching tMaxOffset and checking for zero below, costs another 54 (84 with RGBW) bytes
-            tMaxOffset = bOffset;
-            uint8_t tMax = tBlue;
-            if (tGreen > tMax) {
-                // Here green is brighter than blue, set maximum to green
-                tMax = tGreen;
-                tMaxOffset = gOffset;
-            }
+        // searching tMaxOffset and checking for zero below, costs another 54 (84 with RGBW) bytes
+        tMaxOffset = bOffset;
+        uint8_t tMax = tBlue;
+        if (tGreen > tMax) {
+            // Here green is brighter than blue, set maximum to green
+            tMax = tGreen;
+            tMaxOffset = gOffset;
+        }
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
 #    if defined(_SUPPORT_RGBW)
-            if (BytesPerPixel == 4 && tWhite > tMax) {
-                tMax = tWhite;
-                tMaxOffset = wOffset;
-            }
+        if (BytesPerPixel == 4 && tWhite > tMax) {
+            tMax = tWhite;
+            tMaxOffset = wOffset;
+        }
 #    endif
-            if (tRed > tMax) {
-                tMaxOffset = rOffset;
-            }
-#  endif
-            // Compute brightness with rounding, here tBrightness is < 0xFF :-)
-            tRed = ((tRed * tBrightness) + 0x80) >> 8;
-            tGreen = ((tGreen * tBrightness) + 0x80) >> 8;
-            tBlue = ((tBlue * tBrightness) + 0x80) >> 8;
+        if (tRed > tMax) {
+            tMaxOffset = rOffset;
         }
+#  endif
+        // Compute brightness with rounding, here tBrightness is < 0xFF :-)
+        tRed = ((tRed * tBrightness) + 0x80) >> 8;
+        tGreen = ((tGreen * tBrightness) + 0x80) >> 8;
+        tBlue = ((tBlue * tBrightness) + 0x80) >> 8;
+    }
 #endif // defined(SUPPORT_BRIGHTNESS)
-        tPixelPtr[rOffset] = tRed;
-        tPixelPtr[gOffset] = tGreen;
-        tPixelPtr[bOffset] = tBlue;
+    aPixelPtr[rOffset] = tRed;
+    aPixelPtr[gOffset] = tGreen;
+    aPixelPtr[bOffset] = tBlue;
 
 #if defined(SUPPORT_BRIGHTNESS) && defined(SUPPORT_NO_ZERO_BRIGHTNESS)
-        if ((PixelFlags & PIXEL_FLAG_USE_NON_ZERO_BRIGHTNESS) && tBrightness != 0 && aColor != 0) {
+    if ((PixelFlags & PIXEL_FLAG_USE_NON_ZERO_BRIGHTNESS) && tBrightness != 0 && aColor != 0) {
 #  if defined(_SUPPORT_RGBW)
-            if (tRed == 0 && tGreen == 0 && tBlue == 0 && (BytesPerPixel != 4 || (BytesPerPixel == 4 && tWhite == 0))) {
+        if (tRed == 0 && tGreen == 0 && tBlue == 0 && (BytesPerPixel != 4 || (BytesPerPixel == 4 && tWhite == 0))) {
 #  else
-            if (tRed == 0 && tGreen == 0 && tBlue == 0) {
+        if (tRed == 0 && tGreen == 0 && tBlue == 0) {
 #  endif
 #if defined(LOCAL_TRACE)
-                printPin(&Serial);
-                Serial.print(F("MaxOffset="));
-                Serial.println(tMaxOffset);
+            printPin(&Serial);
+            Serial.print(F("MaxOffset="));
+            Serial.println(tMaxOffset);
 #endif
-                // avoid that pixel is completely off, but prefer blue if it has the same value as one of the other colors
-                // I.e. white (x,x,x) changes to blue (0,0,1) if brightness is too low.
-                tPixelPtr[tMaxOffset] = 1; // tMaxOffset is set here since if tBrightness = 255 and aColor != 0 then is one of red or green or blue != 0
+            // avoid that pixel is completely off, but prefer blue if it has the same value as one of the other colors
+            // I.e. white (x,x,x) changes to blue (0,0,1) if brightness is too low.
+            aPixelPtr[tMaxOffset] = 1; // tMaxOffset is set here since if tBrightness = 255 and aColor != 0 then is one of red or green or blue != 0
 #pragma GCC diagnostic pop
 
-            }
         }
+    }
 #endif
+}
+
+/*
+ * Copies the pixel, which was encoded by encodePixelColor(), to the pixel buffer.
+ */
+void NeoPixel::setEncodedPixelColor(uint16_t aPixelIndex, uint8_t *aEncodedPixelPtr) {
+    if (!_HAS_PIXEL_BUFFER) {
+        return;
+    }
+    if (aPixelIndex < numLEDs) {
+        memcpy(&pixels[(aPixelIndex + PixelOffset) * BytesPerPixel], aEncodedPixelPtr, BytesPerPixel);
     }
 }
 
@@ -766,16 +1596,8 @@ void NeoPixel::addPixelColor(uint16_t aPixelIndex, uint8_t aRed, uint8_t aGreen,
 
 // Set all pixels to a color (synchronously)
 void NeoPixel::setColor(color32_t aColor) {
-// This is faster but costs 94 bytes, or 54 bytes program memory if DO_NOT_SUPPORT_RGBW is defined
-    if (BytesPerPixel == 3) {
-        setPixelColor(0, aColor);
-        memcpy(&pixels[(PixelOffset + 1) * 3], &pixels[PixelOffset * 3], (numLEDs - 1) * 3);
-    } else {
-        // if DO_NOT_SUPPORT_RGBW is defined, this code is removed by the compiler :-)
-        for (uint_fast16_t i = 0; i < numLEDs; i++) {
-            setPixelColor(i, aColor);
-        }
-    }
+    setPixelColor(0, aColor);
+    replicatePeriod(1);
 }
 // deprecated
 void NeoPixel::ColorSet(color32_t aColor) {
@@ -790,10 +1612,52 @@ void NeoPixel::fillRegion(color32_t aColor, uint16_t aRegionStartIndext, uint16_
     }
 }
 
+/*
+ * Copies the first aPeriodPixels pixels repeatedly over the rest of the pixels.
+ * The already filled part is doubled by each memcpy, so it requires only log2(numLEDs / aPeriodPixels) memcpy calls.
+ */
+void NeoPixel::replicatePeriod(uint16_t aPeriodPixels) {
+    if (!_HAS_PIXEL_BUFFER) {
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+        if (IndexBuffer != nullptr) {
+            for (uint_fast16_t i = aPeriodPixels; i < numLEDs; i++) {
+                setPixelPaletteIndex(i, getPixelPaletteIndex(i - aPeriodPixels));
+            }
+        }
+#endif
+        return;
+    }
+    if (aPeriodPixels == 0) {
+        return;
+    }
+    uint8_t *tPixelPtr = &pixels[PixelOffset * BytesPerPixel];
+    uint16_t tTotalBytes = numLEDs * BytesPerPixel;
+    uint16_t tFilledBytes = aPeriodPixels * BytesPerPixel;
+    while (tFilledBytes < tTotalBytes) {
+        uint16_t tBytesToCopy = tFilledBytes; // source and target do not overlap
+        if (tBytesToCopy > tTotalBytes - tFilledBytes) {
+            tBytesToCopy = tTotalBytes - tFilledBytes;
+        }
+        memcpy(tPixelPtr + tFilledBytes, tPixelPtr, tBytesToCopy);
+        tFilledBytes += tBytesToCopy;
+    }
+}
+
 /*
  * Does no parameter checking!
  */
 void NeoPixel::copyRegion(uint16_t aSourcePixelIndex, uint16_t aTargetPixelIndex, uint16_t aLength, bool aDoReverseCopy) {
+    if (!_HAS_PIXEL_BUFFER) {
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+        if (IndexBuffer != nullptr) {
+            for (uint_fast16_t i = 0; i < aLength; i++) {
+                setPixelPaletteIndex(aDoReverseCopy ? aTargetPixelIndex - i : aTargetPixelIndex + i,
+                        getPixelPaletteIndex(aSourcePixelIndex + i));
+            }
+        }
+#endif
+        return;
+    }
     uint8_t *tSourcePixelPtr = &pixels[aSourcePixelIndex * BytesPerPixel];
     uint8_t *tTargetPixelPtr = &pixels[aTargetPixelIndex * BytesPerPixel];
     for (uint_fast16_t i = 0; i < aLength; i++) {
@@ -815,6 +1679,12 @@ void NeoPixel::copyRegion(uint16_t aSourcePixelIndex, uint16_t aTargetPixelIndex
     }
 }
 color32_t NeoPixel::getPixelColor(uint16_t aPixelIndex) {
+    if (!_HAS_PIXEL_BUFFER) {
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+        return getIndexedPixelColor(aPixelIndex);
+#endif
+        return 0;
+    }
     uint8_t *tPixelPointer = &pixels[(aPixelIndex + PixelOffset) * BytesPerPixel];
     if (BytesPerPixel == 3) {
         return (uint32_t) tPixelPointer[rOffset] << 16 | (uint32_t) tPixelPointer[gOffset] << 8 | tPixelPointer[bOffset];
@@ -827,6 +1697,12 @@ color32_t NeoPixel::getPixelColor(uint16_t aPixelIndex) {
 
 // Set 50% dimmed value of current color
 void NeoPixel::dimPixelColor(uint16_t aPixelIndex) {
+    if (!_HAS_PIXEL_BUFFER) {
+#if defined(ENABLE_INDEXED_PIXEL_BUFFER)
+        setIndexedPixelColor(aPixelIndex, dimColor(getIndexedPixelColor(aPixelIndex)));
+#endif
+        return;
+    }
     uint8_t *tPixelPointer = &pixels[(aPixelIndex + PixelOffset) * BytesPerPixel];
     for (uint_fast8_t i = 0; i < BytesPerPixel; ++i) {
         *tPixelPointer = *tPixelPointer >> 1;
@@ -1063,6 +1939,9 @@ uint8_t Blue(color32_t color) {
 uint16_t NeoPixel::getAndAdjustActualNeopixelLenghtSimple() {
     return 0;
 }
+uint16_t NeoPixel::getAndAdjustActualNeopixelLenghtBisection() {
+    return 0;
+}
 #else
 /*
  * !!! #include "ADCUtils.hpp" must be before #include "NeoPatterns.hpp" !!!
@@ -1160,6 +2039,86 @@ uint16_t NeoPixel::getAndAdjustActualNeopixelLenghtSimple() {
     }
     return 0;
 }
+
+/*
+ * !!! #include "ADCUtils.hpp" must be before #include "NeoPatterns.hpp" !!!
+ *
+ * Like getAndAdjustActualNeopixelLenghtSimple(), but halves the search window with each test,
+ * so it requires only log2(numLEDs) + 1 show() instead of up to numLEDs / 4 + 36.
+ * E.g. 9 show() instead of up to 111 for a 300 pixel strip.
+ *
+ * Each test lights PIXELS_FOR_BISECTION_LENGTH_DETECTION pixels starting at the middle of the window.
+ * A voltage drop means, that at least one of them is connected, so the strip is longer than the middle.
+ * Thus a dead pixel in the middle of the strip, which still forwards the data, does not shorten the detected length.
+ * A pixel which does not forward the data is detected as end of the strip.
+ * The length is rounded up to the next even number like for getAndAdjustActualNeopixelLenghtSimple().
+ *
+ * @return  The actual (even) length of the strip
+ *          0 if length could not be determined
+ */
+#  if !defined(PIXELS_FOR_BISECTION_LENGTH_DETECTION)
+#define PIXELS_FOR_BISECTION_LENGTH_DETECTION   4 // Number of pixels lit for one test. Must be greater than the number of adjacent dead pixels to tolerate.
+#  endif
+uint16_t NeoPixel::getAndAdjustActualNeopixelLenghtBisection() {
+
+    /*
+     * First set ADC reference and channel and clear strip
+     */
+    getVCCVoltageMillivoltSimple(); // to set ADC channel and reference
+    clear();
+    show();
+    delay(50);
+    uint16_t tStartMillivolt = getVCCVoltageMillivoltSimple(); // it is faster to use this simple version
+#  if defined(LOCAL_INFO)
+    Serial.print(F("Start VCC="));
+    Serial.print(tStartMillivolt);
+    Serial.println(" mV");
+#  endif
+
+    /*
+     * The actual length is always in the range from tMinimumLength to tMaximumLength
+     */
+    uint16_t tMinimumLength = 0;
+    uint16_t tMaximumLength = numLEDs;
+    while (tMinimumLength < tMaximumLength) {
+        uint16_t tTestIndex = tMinimumLength + ((tMaximumLength - tMinimumLength) / 2);
+        uint16_t tTestEndIndex = tTestIndex + PIXELS_FOR_BISECTION_LENGTH_DETECTION;
+        if (tTestEndIndex > tMaximumLength) {
+            tTestEndIndex = tMaximumLength;
+        }
+        clear();
+        for (uint16_t i = tTestIndex; i < tTestEndIndex; ++i) {
+            setPixelColor(i, COLOR32_WHITE);
+        }
+        show();
+        delay(4);
+        uint16_t tCurrentMillivolt = getVCCVoltageMillivoltSimple();
+#  if defined(LOCAL_DEBUG)
+        Serial.print(F("Test index="));
+        Serial.print(tTestIndex);
+        Serial.print(F(" VCC="));
+        Serial.print(tCurrentMillivolt);
+        Serial.println(" mV");
+#  endif
+        if (tCurrentMillivolt < tStartMillivolt - DELTA_MILLIVOLT_FOR_PIXEL_DETECTION) {
+            tMinimumLength = tTestIndex + 1; // Pixel at tTestIndex or above is connected
+        } else {
+            tMaximumLength = tTestIndex; // No pixel at tTestIndex or above is connected
+        }
+    }
+    clear();
+    show();
+
+    // update length to next even number like getAndAdjustActualNeopixelLenghtSimple(), but not above the current length
+    uint16_t tActualNeopixelLength = (tMinimumLength + 1) & ~0x01;
+    if (tActualNeopixelLength > numLEDs) {
+        tActualNeopixelLength = numLEDs;
+    }
+    if (tActualNeopixelLength != 0) {
+        updateLength(tActualNeopixelLength);
+    }
+    return tActualNeopixelLength;
+}
 #endif
 
 /*
@@ -0,0 +1,93 @@
+/*
+ * NeoPixelParallelGroup.h
+ *
+ *  SUMMARY
+ *  Sends the pixel buffers of up to 8 NeoPixel objects, which are connected to pins of the same AVR port, in one pass.
+ *  The bytes of all strips are transposed into a bit slice buffer, where each byte contains one bit of each strip.
+ *  The wire time is then the time of the longest strip instead of the sum of all strips.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+/*
+ * Usage:
+ * NeoPatterns Bar16 = NeoPatterns(16, 4, NEO_GRB + NEO_KHZ800);
+ * NeoPatterns Bar24 = NeoPatterns(24, 3, NEO_GRB + NEO_KHZ800);
+ * NeoPixelParallelGroup ParallelStrips;
+ * ...
+ * Bar16.begin();
+ * Bar24.begin();
+ * ParallelStrips.addNeoPixel(&Bar16);
+ * ParallelStrips.addNeoPixel(&Bar24);
+ * ParallelStrips.begin(); // must be called after all strips are added and have their final length
+ * ...
+ * bool tMustShow = Bar16.updateOrRedraw(DO_NO_REDRAW_IF_NO_UPDATE);
+ * tMustShow |= Bar24.updateOrRedraw(DO_NO_REDRAW_IF_NO_UPDATE);
+ * if (tMustShow) {
+ *     ParallelStrips.show();
+ * }
+ *
+ * Parallel output requires an AVR with 16 MHz, 800 kHz strips and all pins on the same port, e.g. pin 0 to 7 on an Uno.
+ * Otherwise show() calls show() of all strips one after the other. This is also done while a strip has streaming output,
+ * an indexed pixel buffer or an active crossfade transition.
+ */
+
+#ifndef _NEOPIXEL_PARALLEL_GROUP_H
+#define _NEOPIXEL_PARALLEL_GROUP_H
+
+#include "NeoPixel.h"
+
+#define NEOPIXEL_PARALLEL_GROUP_MAX_SIZE    8 // One lane for each bit of the port
+
+#if defined(_SUPPORT_BIT_SLICE_OUTPUT)
+#define _SUPPORT_PARALLEL_OUTPUT
+#endif
+
+void transposeLaneBytesToBitSlices(const uint8_t *aLaneBytes, uint8_t *aBitSlices);
+
+/*
+ * SIZE = 28 bytes on AVR
+ */
+class NeoPixelParallelGroup {
+public:
+    NeoPixelParallelGroup();
+    bool addNeoPixel(NeoPixel *aNeoPixel);
+    bool begin();
+    void end();
+    bool isParallel();
+    bool canSendBitSlices();
+
+    void encodeBitSlices(uint8_t *aBitSliceBuffer);
+    void show();
+
+    NeoPixel *NeoPixelObjects[NEOPIXEL_PARALLEL_GROUP_MAX_SIZE];
+    uint8_t NumberOfNeoPixelObjects;
+    uint8_t LaneMask;                   // Bit n is set, if lane n is used. Lane n is bit n of the port.
+    uint16_t MaximumNumberOfBytes;      // Number of bytes of the longest strip, computed by begin()
+    uint8_t *BitSliceBuffer;            // 8 * MaximumNumberOfBytes bytes, nullptr if parallel output is not possible
+#if defined(_SUPPORT_PARALLEL_OUTPUT)
+    volatile uint8_t *PortOutputRegister; // nullptr if pins are on different ports
+    unsigned long LastShowEndMicros;    // For the reset / latch time of 300 us between two show()
+#endif
+};
+
+#endif // _NEOPIXEL_PARALLEL_GROUP_H
@@ -0,0 +1,272 @@
+/*
+ * NeoPixelParallelGroup.hpp
+ *
+ *  SUMMARY
+ *  Sends the pixel buffers of up to 8 NeoPixel objects, which are connected to pins of the same AVR port, in one pass.
+ *  The bytes of all strips are transposed into a bit slice buffer, where each byte contains one bit of each strip.
+ *  The wire time is then the time of the longest strip instead of the sum of all strips.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _NEOPIXEL_PARALLEL_GROUP_HPP
+#define _NEOPIXEL_PARALLEL_GROUP_HPP
+
+#include <Arduino.h>
+
+#include "NeoPixelParallelGroup.h"
+
+// include sources
+#include "NeoPixel.hpp"
+
+// This block must be located after the includes of other *.hpp files
+//#define LOCAL_INFO  // This enables info output only for this file
+//#define LOCAL_DEBUG // This enables debug output only for this file - only for development
+#include "LocalDebugLevelStart.h"
+
+/*
+ * Transposes one byte of each of the 8 lanes into 8 bit slices.
+ * aBitSlices[0] contains the MSB of all lanes, which is sent first, aBitSlices[7] contains the LSB.
+ * Bit n of each slice belongs to lane n.
+ * The lane bytes are kept in registers and only shifts by one are used, since they are cheap on AVR.
+ */
+#define _SHIFT_MSB_INTO_SLICE(aLaneByte) tSlice = (tSlice << 1) | (aLaneByte >> 7); aLaneByte <<= 1
+void transposeLaneBytesToBitSlices(const uint8_t *aLaneBytes, uint8_t *aBitSlices) {
+    uint8_t tLane0 = aLaneBytes[0];
+    uint8_t tLane1 = aLaneBytes[1];
+    uint8_t tLane2 = aLaneBytes[2];
+    uint8_t tLane3 = aLaneBytes[3];
+    uint8_t tLane4 = aLaneBytes[4];
+    uint8_t tLane5 = aLaneBytes[5];
+    uint8_t tLane6 = aLaneBytes[6];
+    uint8_t tLane7 = aLaneBytes[7];
+    for (uint_fast8_t tSliceIndex = 0; tSliceIndex < 8; ++tSliceIndex) {
+        uint8_t tSlice = 0;
+        // Start with the highest lane, it ends up in bit 7 after 8 shifts
+        _SHIFT_MSB_INTO_SLICE(tLane7);
+        _SHIFT_MSB_INTO_SLICE(tLane6);
+        _SHIFT_MSB_INTO_SLICE(tLane5);
+        _SHIFT_MSB_INTO_SLICE(tLane4);
+        _SHIFT_MSB_INTO_SLICE(tLane3);
+        _SHIFT_MSB_INTO_SLICE(tLane2);
+        _SHIFT_MSB_INTO_SLICE(tLane1);
+        _SHIFT_MSB_INTO_SLICE(tLane0);
+        aBitSlices[tSliceIndex] = tSlice;
+    }
+}
+
+NeoPixelParallelGroup::NeoPixelParallelGroup() { // @suppress("Class members should be properly initialized")
+    NumberOfNeoPixelObjects = 0;
+    LaneMask = 0;
+    MaximumNumberOfBytes = 0;
+    BitSliceBuffer = nullptr;
+#if defined(_SUPPORT_PARALLEL_OUTPUT)
+    PortOutputRegister = nullptr;
+    LastShowEndMicros = 0;
+#endif
+}
+
+/*
+ * Adds a (not partial) NeoPixel object to the group.
+ * On AVR its lane is the bit of its pin in the port, otherwise the index in the group.
+ * If the pin is not on the same port as the pins of the other objects, the group is still usable, but not parallel.
+ * @return false if group is full, the lane is already used or the object is a partial NeoPixel object
+ */
+bool NeoPixelParallelGroup::addNeoPixel(NeoPixel *aNeoPixel) {
+    if (NumberOfNeoPixelObjects >= NEOPIXEL_PARALLEL_GROUP_MAX_SIZE || (aNeoPixel->PixelFlags & PIXEL_FLAG_IS_PARTIAL_NEOPIXEL)) {
+        return false;
+    }
+#if defined(_SUPPORT_PARALLEL_OUTPUT)
+    uint8_t tPin = aNeoPixel->getPin();
+    uint8_t tLaneMask = digitalPinToBitMask(tPin);
+    volatile uint8_t *tPortOutputRegister = portOutputRegister(digitalPinToPort(tPin));
+    if (LaneMask & tLaneMask) {
+        return false;
+    }
+    if (NumberOfNeoPixelObjects == 0) {
+        PortOutputRegister = tPortOutputRegister;
+    } else if (PortOutputRegister != tPortOutputRegister) {
+        PortOutputRegister = nullptr; // pins are on different ports
+    }
+#  if defined(NEO_KHZ400)
+    if ((aNeoPixel->getType() & 0x100) == 0) {
+        PortOutputRegister = nullptr; // 400 kHz pixel, see getType()
+    }
+#  endif
+#else
+    uint8_t tLaneMask = 1 << NumberOfNeoPixelObjects;
+#endif
+    LaneMask |= tLaneMask;
+    NeoPixelObjects[NumberOfNeoPixelObjects++] = aNeoPixel;
+    return true;
+}
+
+/*
+ * Allocates the bit slice buffer for the longest strip, if parallel output is possible.
+ * Must be called again, if a strip length changes.
+ * @return false if parallel output is possible, but not enough memory is available.
+ */
+bool NeoPixelParallelGroup::begin() {
+    end();
+    MaximumNumberOfBytes = 0;
+    for (uint_fast8_t i = 0; i < NumberOfNeoPixelObjects; ++i) {
+        uint16_t tNumberOfBytes = NeoPixelObjects[i]->numPixels() * NeoPixelObjects[i]->getBytesPerPixel();
+        if (MaximumNumberOfBytes < tNumberOfBytes) {
+            MaximumNumberOfBytes = tNumberOfBytes;
+        }
+    }
+#if defined(_SUPPORT_PARALLEL_OUTPUT)
+    if (PortOutputRegister != nullptr && MaximumNumberOfBytes != 0) {
+        BitSliceBuffer = (uint8_t*) malloc(MaximumNumberOfBytes * 8);
+        if (BitSliceBuffer == nullptr) {
+            return false;
+        }
+    }
+#endif
+#if defined(LOCAL_INFO)
+    Serial.print(F("Parallel group with "));
+    Serial.print(NumberOfNeoPixelObjects);
+    Serial.print(F(" strips, lane mask=0x"));
+    Serial.print(LaneMask, HEX);
+    if (isParallel()) {
+        Serial.print(F(", buffer size="));
+        Serial.println(MaximumNumberOfBytes * 8);
+    } else {
+        Serial.println(F(", no parallel output possible"));
+    }
+#endif
+    return true;
+}
+
+void NeoPixelParallelGroup::end() {
+    free(BitSliceBuffer);
+    BitSliceBuffer = nullptr;
+}
+
+bool NeoPixelParallelGroup::isParallel() {
+    return BitSliceBuffer != nullptr;
+}
+
+/*
+ * Fills aBitSliceBuffer with the transposed pixel bytes of all strips.
+ * Strips shorter than MaximumNumberOfBytes get 0 bytes, i.e. their data line stays low after their last bit.
+ * @param aBitSliceBuffer - Must have 8 * MaximumNumberOfBytes bytes
+ */
+void NeoPixelParallelGroup::encodeBitSlices(uint8_t *aBitSliceBuffer) {
+    uint8_t tLaneBytes[8];
+    uint8_t *tLanePixelBufferPointers[8];
+    uint16_t tLaneNumberOfBytes[8];
+
+    for (uint_fast8_t tLane = 0; tLane < 8; ++tLane) {
+        tLaneNumberOfBytes[tLane] = 0;
+    }
+    for (uint_fast8_t i = 0; i < NumberOfNeoPixelObjects; ++i) {
+        NeoPixel *tNeoPixel = NeoPixelObjects[i];
+#if defined(_SUPPORT_PARALLEL_OUTPUT)
+        uint8_t tLane = __builtin_ctz(digitalPinToBitMask(tNeoPixel->getPin()));
+#else
+        uint8_t tLane = i;
+#endif
+        tLanePixelBufferPointers[tLane] = tNeoPixel->getPixels();
+        tLaneNumberOfBytes[tLane] = tNeoPixel->numPixels() * tNeoPixel->getBytesPerPixel();
+    }
+
+    for (uint16_t tByteIndex = 0; tByteIndex < MaximumNumberOfBytes; ++tByteIndex) {
+        for (uint_fast8_t tLane = 0; tLane < 8; ++tLane) {
+            if (tByteIndex < tLaneNumberOfBytes[tLane]) {
+                tLaneBytes[tLane] = tLanePixelBufferPointers[tLane][tByteIndex];
+            } else {
+                tLaneBytes[tLane] = 0;
+            }
+        }
+        transposeLaneBytesToBitSlices(tLaneBytes, aBitSliceBuffer);
+        aBitSliceBuffer += 8;
+    }
+}
+
+/*
+ * @return true if all strips can be sent by the bit slices of their pixel buffers
+ */
+bool NeoPixelParallelGroup::canSendBitSlices() {
+    if (BitSliceBuffer == nullptr) {
+        return false;
+    }
+    for (uint_fast8_t i = 0; i < NumberOfNeoPixelObjects; ++i) {
+        if (!NeoPixelObjects[i]->isPixelBufferSentByShow()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Sends all strips in one pass, if parallel output is possible.
+ * Otherwise, or if a strip has streaming output, an indexed pixel buffer or an active crossfade transition,
+ * it calls show() of each strip.
+ * The show hooks are called for each strip, like show() of the strip does.
+ */
+void NeoPixelParallelGroup::show() {
+#if defined(_SUPPORT_PARALLEL_OUTPUT)
+    if (canSendBitSlices()) {
+#  if defined(_SUPPORT_SHOW_HOOK)
+        for (uint_fast8_t i = 0; i < NumberOfNeoPixelObjects; ++i) {
+            NeoPixel::callShowHooks(NeoPixelObjects[i]);
+        }
+#  endif
+        encodeBitSlices(BitSliceBuffer);
+
+        while ((micros() - LastShowEndMicros) < 300) {
+            ; // Wait for reset / latch time of the last show()
+        }
+
+#  if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+        unsigned long tStartMicros = micros();
+#  endif
+        uint8_t tOldSREG = SREG;
+        cli();
+        NeoPixel::sendBitSlices(PortOutputRegister, LaneMask, BitSliceBuffer, MaximumNumberOfBytes * 8);
+        SREG = tOldSREG;
+        LastShowEndMicros = micros();
+#  if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+        /*
+         * Interrupts were disabled for 10 us per byte of the longest strip, see NeoPixel::showAndMeasure()
+         */
+        uint32_t tShowMicros = LastShowEndMicros - tStartMicros;
+        uint32_t tMinimumShowMicros = (uint32_t) MaximumNumberOfBytes * 10;
+        if (tShowMicros < tMinimumShowMicros) {
+            NeoPixel::addMicrosMissedByShow(tMinimumShowMicros - tShowMicros);
+            tShowMicros = tMinimumShowMicros;
+        }
+        for (uint_fast8_t i = 0; i < NumberOfNeoPixelObjects; ++i) {
+            NeoPixelObjects[i]->setShowDurationMicros(tShowMicros);
+        }
+#  endif
+        return;
+    }
+#endif
+    for (uint_fast8_t i = 0; i < NumberOfNeoPixelObjects; ++i) {
+        NeoPixelObjects[i]->show();
+    }
+}
+
+#include "LocalDebugLevelEnd.h"
+#endif // _NEOPIXEL_PARALLEL_GROUP_HPP
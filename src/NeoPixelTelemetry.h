@@ -0,0 +1,124 @@
+/*
+ * NeoPixelTelemetry.h
+ *
+ *  SUMMARY
+ *  Sends the frames shown by one NeoPixel object as compact binary stream, e.g. over Serial for host visualization
+ *  with extras/TelemetryViewer.py. In contrast to printContent(), it does not stall the render loop,
+ *  since only as many bytes are written, as the output can take without blocking.
+ *  Frames are delta compressed, COBS framed and contain the timing of the frame.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+/*
+ * Usage:
+ * #define ENABLE_NEOPIXEL_TELEMETRY
+ * #include "NeoPatterns.hpp"
+ * #include "NeoPixelTelemetry.hpp"
+ * NeoPixelTelemetry Telemetry;
+ * ...
+ * Serial.begin(500000);
+ * Telemetry.begin(&Bar16, &Serial);
+ * ...
+ * loop() {
+ *     Bar16.update();
+ *     Telemetry.poll(); // Continues sending the current frame
+ * }
+ *
+ * Each show() of the NeoPixel object captures a frame, if the last frame is completely sent. Otherwise the frame is skipped.
+ * The output must support availableForWrite(), like HardwareSerial. Do not print other text to this output.
+ * The shown pixel buffer content is sent, i.e. with Brightness applied and in the byte order of the strip.
+ * NeoPixelTelemetry is a show hook, so it can be used together with NeoAnimationRecorder.
+ *
+ * Frame format before COBS encoding, all 16 and 32 bit values are little endian:
+ * Offset Size  Content
+ *  0      1    NEOPIXEL_TELEMETRY_KEYFRAME or NEOPIXEL_TELEMETRY_DELTA_FRAME
+ *  1      1    Sequence number, incremented for each sent frame
+ *  2      2    Number of pixels
+ *  4      1    Bytes per pixel
+ *  5      1    Brightness
+ *  6      4    Time of show() in milliseconds, see getCompensatedMillis()
+ * 10      2    Duration of the last show() in microseconds, 0 if SUPPORT_SHOW_TIME_COMPENSATION is disabled
+ * 12      2    Number of frames skipped since the last sent frame
+ * 14      2    Duration of encoding this frame in microseconds
+ * 16      n    Keyframe: all pixel bytes.
+ *              Delta frame: records of number of unchanged pixels (1 byte), number of changed pixels n (1 byte)
+ *              and n * bytes per pixel bytes. The pixels after the last record are unchanged.
+ * 16+n    1    XOR of all previous bytes
+ * The frame is COBS encoded, i.e. it contains no 0 byte, and terminated by a 0 byte.
+ * A delta frame is relative to the last sent frame. Keyframes are sent every KeyframeInterval frames
+ * and if the delta frame would be longer than the keyframe.
+ */
+
+#ifndef _NEOPIXEL_TELEMETRY_H
+#define _NEOPIXEL_TELEMETRY_H
+
+#include "NeoPixel.h"
+
+#define NEOPIXEL_TELEMETRY_KEYFRAME     0x4B // 'K'
+#define NEOPIXEL_TELEMETRY_DELTA_FRAME  0x44 // 'D'
+#define NEOPIXEL_TELEMETRY_HEADER_SIZE  16
+#define NEOPIXEL_TELEMETRY_MAX_RUN      0xFF // Maximum number of pixels of one delta record
+#define NEOPIXEL_TELEMETRY_COBS_MAX_BLOCK_LENGTH    254
+
+#define NEOPIXEL_TELEMETRY_DEFAULT_KEYFRAME_INTERVAL    32
+
+// Values for SendState
+#define NEOPIXEL_TELEMETRY_IDLE         0
+#define NEOPIXEL_TELEMETRY_SEND_CODE    1 // Next is the COBS code byte of a block
+#define NEOPIXEL_TELEMETRY_SEND_DATA    2
+#define NEOPIXEL_TELEMETRY_SEND_END     3 // Next is the terminating 0 byte
+
+class NeoPixelTelemetry: public NeoPixelShowHook {
+public:
+    NeoPixelTelemetry();
+    bool begin(NeoPixel *aNeoPixel, Print *aOutput, uint8_t aKeyframeInterval = NEOPIXEL_TELEMETRY_DEFAULT_KEYFRAME_INTERVAL);
+    void end();
+
+    static void captureShownFrame(NeoPixelShowHook *aShowHook, NeoPixel *aNeoPixel);
+    void captureFrame();
+    uint16_t encodeFrame(bool aIsKeyframe);
+    bool poll();
+
+    NeoPixel *TelemetryNeoPixel;    // The object, whose buffer is shown, i.e. the parent of a partial NeoPixel object
+    Print *Output;
+    uint8_t *LastFrame;             // Pixel bytes of the last sent frame, for delta frames
+    uint8_t *FrameBuffer;           // The frame, which is currently sent
+    uint16_t FrameBufferSize;       // Size of a keyframe
+    uint16_t FrameLength;
+    uint16_t FramePosition;         // Next byte of FrameBuffer to send
+    uint8_t BlockRemaining;         // Bytes of the current COBS block to send
+    bool BlockEndsWithZero;         // The current COBS block replaces a 0 byte of FrameBuffer
+    uint8_t SendState;
+    uint8_t Sequence;
+    uint8_t KeyframeInterval;       // 0 = only the first frame is a keyframe
+    uint8_t FramesSinceKeyframe;
+    uint16_t NumberOfSkippedFrames; // Since the last sent frame
+
+    /*
+     * Statistics
+     */
+    uint32_t NumberOfSentFrames;
+    uint32_t NumberOfSentBytes;     // Including COBS overhead
+};
+
+#endif // _NEOPIXEL_TELEMETRY_H
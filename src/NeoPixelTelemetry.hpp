@@ -0,0 +1,283 @@
+/*
+ * NeoPixelTelemetry.hpp
+ *
+ *  SUMMARY
+ *  Sends the frames shown by one NeoPixel object as compact binary stream, e.g. over Serial for host visualization
+ *  with extras/TelemetryViewer.py. In contrast to printContent(), it does not stall the render loop,
+ *  since only as many bytes are written, as the output can take without blocking.
+ *  Frames are delta compressed, COBS framed and contain the timing of the frame.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _NEOPIXEL_TELEMETRY_HPP
+#define _NEOPIXEL_TELEMETRY_HPP
+
+#include <Arduino.h>
+
+#include "NeoPixelTelemetry.h"
+
+#if !defined(ENABLE_NEOPIXEL_TELEMETRY)
+#error NeoPixelTelemetry requires ENABLE_NEOPIXEL_TELEMETRY to be defined before including NeoPixel.hpp or NeoPatterns.hpp
+#endif
+
+// include sources
+#include "NeoPixel.hpp"
+
+// This block must be located after the includes of other *.hpp files
+//#define LOCAL_INFO  // This enables info output only for this file
+//#define LOCAL_DEBUG // This enables debug output only for this file - only for development
+#include "LocalDebugLevelStart.h"
+
+NeoPixelTelemetry::NeoPixelTelemetry() { // @suppress("Class members should be properly initialized")
+    TelemetryNeoPixel = nullptr;
+    LastFrame = nullptr;
+    FrameBuffer = nullptr;
+    SendState = NEOPIXEL_TELEMETRY_IDLE;
+}
+
+/*
+ * Allocates the buffers and sends all frames shown by aNeoPixel to aOutput.
+ * @param aNeoPixel - For a partial NeoPixel object, the frames of its parent are sent.
+ * @param aKeyframeInterval - A keyframe is sent every aKeyframeInterval frames, to enable a viewer to start at any time.
+ * @return false if not enough memory or aNeoPixel has no pixel buffer.
+ */
+bool NeoPixelTelemetry::begin(NeoPixel *aNeoPixel, Print *aOutput, uint8_t aKeyframeInterval) {
+    end();
+    TelemetryNeoPixel = aNeoPixel->ParentNeoPixelObject;
+    if (TelemetryNeoPixel->getPixels() == nullptr) {
+        return false;
+    }
+    uint16_t tNumberOfBytes = TelemetryNeoPixel->numPixels() * TelemetryNeoPixel->getBytesPerPixel();
+    FrameBufferSize = NEOPIXEL_TELEMETRY_HEADER_SIZE + tNumberOfBytes + 1;
+    LastFrame = (uint8_t*) malloc(tNumberOfBytes);
+    FrameBuffer = (uint8_t*) malloc(FrameBufferSize);
+    if (LastFrame == nullptr || FrameBuffer == nullptr) {
+        end();
+        return false;
+    }
+    Output = aOutput;
+    KeyframeInterval = aKeyframeInterval;
+    FramesSinceKeyframe = 0;
+    Sequence = 0;
+    NumberOfSkippedFrames = 0;
+    NumberOfSentFrames = 0;
+    NumberOfSentBytes = 0;
+    NeoPixel::addShowHook(this, &captureShownFrame);
+    return true;
+}
+
+void NeoPixelTelemetry::end() {
+    NeoPixel::removeShowHook(this);
+    free(LastFrame);
+    LastFrame = nullptr;
+    free(FrameBuffer);
+    FrameBuffer = nullptr;
+    SendState = NEOPIXEL_TELEMETRY_IDLE;
+}
+
+/*
+ * Called by NeoPixel::show() as show hook
+ */
+void NeoPixelTelemetry::captureShownFrame(NeoPixelShowHook *aShowHook, NeoPixel *aNeoPixel) {
+    NeoPixelTelemetry *tTelemetry = static_cast<NeoPixelTelemetry*>(aShowHook);
+    if (tTelemetry->TelemetryNeoPixel == aNeoPixel) {
+        tTelemetry->captureFrame();
+    }
+}
+
+/*
+ * Encodes the current pixel buffer content, if the last frame is completely sent, and starts sending it.
+ */
+void NeoPixelTelemetry::captureFrame() {
+    if (SendState != NEOPIXEL_TELEMETRY_IDLE) {
+        if (NumberOfSkippedFrames < 0xFFFF) {
+            NumberOfSkippedFrames++;
+        }
+        poll();
+        return;
+    }
+    if (TelemetryNeoPixel->getPixels() == nullptr
+            || NEOPIXEL_TELEMETRY_HEADER_SIZE + TelemetryNeoPixel->numPixels() * TelemetryNeoPixel->getBytesPerPixel() + 1
+                    != FrameBufferSize) {
+        return; // Pixel buffer was freed e.g. by beginStreaming() or length was changed since begin()
+    }
+    unsigned long tStartMicros = micros();
+    bool tIsKeyframe = (NumberOfSentFrames == 0 || (KeyframeInterval != 0 && FramesSinceKeyframe >= KeyframeInterval));
+    FrameLength = encodeFrame(tIsKeyframe);
+    if (FrameLength == 0) {
+        // Delta frame would be longer than keyframe
+        tIsKeyframe = true;
+        FrameLength = encodeFrame(true);
+    }
+    FramesSinceKeyframe = tIsKeyframe ? 1 : FramesSinceKeyframe + 1;
+
+    uint16_t tEncodeMicros = micros() - tStartMicros;
+    FrameBuffer[14] = tEncodeMicros;
+    FrameBuffer[15] = tEncodeMicros >> 8;
+    uint8_t tChecksum = 0;
+    for (uint16_t i = 0; i < FrameLength - 1; ++i) {
+        tChecksum ^= FrameBuffer[i];
+    }
+    FrameBuffer[FrameLength - 1] = tChecksum;
+
+    NumberOfSkippedFrames = 0;
+    Sequence++;
+    NumberOfSentFrames++;
+    FramePosition = 0;
+    SendState = NEOPIXEL_TELEMETRY_SEND_CODE;
+    poll();
+}
+
+/*
+ * Fills FrameBuffer with header and pixel data and stores the pixel data in LastFrame.
+ * The checksum and the encoding duration are set by captureFrame().
+ * @return length of frame including checksum or 0 if the delta frame does not fit into FrameBuffer
+ */
+uint16_t NeoPixelTelemetry::encodeFrame(bool aIsKeyframe) {
+    uint8_t *tPixels = TelemetryNeoPixel->getPixels();
+    uint16_t tNumberOfPixels = TelemetryNeoPixel->numPixels();
+    uint8_t tBytesPerPixel = TelemetryNeoPixel->getBytesPerPixel();
+    uint16_t tNumberOfBytes = tNumberOfPixels * tBytesPerPixel;
+
+    uint8_t *tFramePtr = FrameBuffer;
+    *tFramePtr++ = aIsKeyframe ? NEOPIXEL_TELEMETRY_KEYFRAME : NEOPIXEL_TELEMETRY_DELTA_FRAME;
+    *tFramePtr++ = Sequence;
+    *tFramePtr++ = tNumberOfPixels;
+    *tFramePtr++ = tNumberOfPixels >> 8;
+    *tFramePtr++ = tBytesPerPixel;
+    *tFramePtr++ = TelemetryNeoPixel->Brightness;
+    unsigned long tMillis = NeoPixel::getCompensatedMillis();
+    *tFramePtr++ = tMillis;
+    *tFramePtr++ = tMillis >> 8;
+    *tFramePtr++ = tMillis >> 16;
+    *tFramePtr++ = tMillis >> 24;
+#if defined(SUPPORT_SHOW_TIME_COMPENSATION)
+    uint16_t tShowMicros = TelemetryNeoPixel->ShowDurationMicros;
+#else
+    uint16_t tShowMicros = 0;
+#endif
+    *tFramePtr++ = tShowMicros;
+    *tFramePtr++ = tShowMicros >> 8;
+    *tFramePtr++ = NumberOfSkippedFrames;
+    *tFramePtr++ = NumberOfSkippedFrames >> 8;
+    tFramePtr += 2; // Encoding duration
+
+    if (aIsKeyframe) {
+        memcpy(tFramePtr, tPixels, tNumberOfBytes);
+        tFramePtr += tNumberOfBytes;
+    } else {
+        uint8_t *tFrameEndPtr = &FrameBuffer[FrameBufferSize - 1]; // Last byte is reserved for checksum
+        uint16_t tPixelIndex = 0;
+        while (tPixelIndex < tNumberOfPixels) {
+            /*
+             * Count unchanged and then changed pixels
+             */
+            uint8_t tNumberOfUnchangedPixels = 0;
+            while (tPixelIndex < tNumberOfPixels && tNumberOfUnchangedPixels < NEOPIXEL_TELEMETRY_MAX_RUN
+                    && memcmp(&tPixels[tPixelIndex * tBytesPerPixel], &LastFrame[tPixelIndex * tBytesPerPixel], tBytesPerPixel) == 0) {
+                tNumberOfUnchangedPixels++;
+                tPixelIndex++;
+            }
+            if (tPixelIndex >= tNumberOfPixels) {
+                break; // Unchanged pixels at the end are not sent
+            }
+            uint16_t tFirstChangedByte = tPixelIndex * tBytesPerPixel;
+            uint8_t tNumberOfChangedPixels = 0;
+            while (tPixelIndex < tNumberOfPixels && tNumberOfChangedPixels < NEOPIXEL_TELEMETRY_MAX_RUN
+                    && memcmp(&tPixels[tPixelIndex * tBytesPerPixel], &LastFrame[tPixelIndex * tBytesPerPixel], tBytesPerPixel) != 0) {
+                tNumberOfChangedPixels++;
+                tPixelIndex++;
+            }
+            uint16_t tNumberOfChangedBytes = tNumberOfChangedPixels * tBytesPerPixel;
+            if (tFramePtr + 2 + tNumberOfChangedBytes > tFrameEndPtr) {
+                return 0;
+            }
+            *tFramePtr++ = tNumberOfUnchangedPixels;
+            *tFramePtr++ = tNumberOfChangedPixels;
+            memcpy(tFramePtr, &tPixels[tFirstChangedByte], tNumberOfChangedBytes);
+            tFramePtr += tNumberOfChangedBytes;
+        }
+    }
+    memcpy(LastFrame, tPixels, tNumberOfBytes);
+    return (tFramePtr - FrameBuffer) + 1;
+}
+
+/*
+ * Writes as many bytes of the current frame, as the output can take without blocking.
+ * The frame is COBS encoded while writing, so no buffer for the encoded frame is required.
+ * Must be called in loop() to send the rest of a frame, which did not fit into the output buffer at show().
+ * @return true if a frame is still to be sent
+ */
+bool NeoPixelTelemetry::poll() {
+    int tAvailableForWrite = Output->availableForWrite();
+    while (SendState != NEOPIXEL_TELEMETRY_IDLE && tAvailableForWrite > 0) {
+        if (SendState == NEOPIXEL_TELEMETRY_SEND_CODE) {
+            /*
+             * The code byte is the distance to the next 0 byte, which is replaced
+             */
+            uint8_t tBlockLength = 0;
+            while (tBlockLength < NEOPIXEL_TELEMETRY_COBS_MAX_BLOCK_LENGTH && FramePosition + tBlockLength < FrameLength
+                    && FrameBuffer[FramePosition + tBlockLength] != 0) {
+                tBlockLength++;
+            }
+            BlockEndsWithZero = (tBlockLength < NEOPIXEL_TELEMETRY_COBS_MAX_BLOCK_LENGTH
+                    && FramePosition + tBlockLength < FrameLength);
+            BlockRemaining = tBlockLength;
+            Output->write(tBlockLength + 1);
+            tAvailableForWrite--;
+            NumberOfSentBytes++;
+            SendState = NEOPIXEL_TELEMETRY_SEND_DATA;
+
+        } else if (SendState == NEOPIXEL_TELEMETRY_SEND_DATA) {
+            uint8_t tBytesToWrite = BlockRemaining;
+            if (tBytesToWrite > tAvailableForWrite) {
+                tBytesToWrite = tAvailableForWrite;
+            }
+            Output->write(&FrameBuffer[FramePosition], tBytesToWrite);
+            FramePosition += tBytesToWrite;
+            BlockRemaining -= tBytesToWrite;
+            tAvailableForWrite -= tBytesToWrite;
+            NumberOfSentBytes += tBytesToWrite;
+            if (BlockRemaining == 0) {
+                if (BlockEndsWithZero) {
+                    FramePosition++; // Skip the 0 byte and start a new block, even if it was the last byte
+                    SendState = NEOPIXEL_TELEMETRY_SEND_CODE;
+                } else if (FramePosition >= FrameLength) {
+                    SendState = NEOPIXEL_TELEMETRY_SEND_END;
+                } else {
+                    SendState = NEOPIXEL_TELEMETRY_SEND_CODE; // Block of maximum length
+                }
+            }
+
+        } else {
+            Output->write((uint8_t) 0);
+            tAvailableForWrite--;
+            NumberOfSentBytes++;
+            SendState = NEOPIXEL_TELEMETRY_IDLE;
+        }
+    }
+    return SendState != NEOPIXEL_TELEMETRY_IDLE;
+}
+
+#include "LocalDebugLevelEnd.h"
+#endif // _NEOPIXEL_TELEMETRY_HPP
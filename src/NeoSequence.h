@@ -0,0 +1,167 @@
+/*
+ * NeoSequence.h
+ *
+ *  SUMMARY
+ *  Bytecode for pattern sequences, which are stored in PROGMEM and run by NeoPatterns::startSequence().
+ *  A sequence replaces a hand-written OnPatternComplete handler with static state variables, like allPatternsRandomHandler().
+ *  It supports loops, jumps and random choice and requires only the 14 bytes of sequence state in RAM,
+ *  regardless of the length of the sequence.
+ *  This file and NeoSequence.hpp do not depend on Arduino, so a sequence can be checked on the host
+ *  with extras/SequenceValidator, which also computes the runtime of the sequence.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+/*
+ * Usage:
+ * #define ENABLE_NEOPATTERNS_SEQUENCER
+ * #include "NeoPatterns.hpp"
+ * const uint8_t ShowSequence[] PROGMEM = {
+ *     SEQUENCE_LOOP(3),
+ *         SEQUENCE_RANDOM_ONE_OF(2),
+ *             SEQUENCE_FIRE(100, 30, DIRECTION_UP),
+ *             SEQUENCE_RAINBOW_CYCLE(20, DIRECTION_UP, 1),
+ *         SEQUENCE_DELAY(500),
+ *     SEQUENCE_END_LOOP,
+ *     SEQUENCE_END };
+ * ...
+ * Bar16.startSequence(ShowSequence); // Replaces OnPatternComplete while the sequence is running
+ *
+ * Each step starts with its opcode byte, followed by the parameters of the step. All 16 and 32 bit values are little endian.
+ * A pattern step has the pattern number as opcode and the parameters of the pattern function in the order of the function,
+ * e.g. SEQUENCE_COLOR_WIPE(aColor, aIntervalMillis, aDoNotClearBefore, aDirection) calls ColorWipe() with these parameters.
+ * The next step is started by the completion callback of the pattern.
+ * Control steps are executed immediately:
+ * SEQUENCE_LOOP(n)           Runs the steps up to the matching SEQUENCE_END_LOOP n times, 0 = endless. Up to SEQUENCE_MAX_LOOP_DEPTH levels.
+ * SEQUENCE_JUMP(n)           Continues with step n. The first step of the sequence is step 0.
+ *                            All loops are left, so the target must not be inside a loop.
+ * SEQUENCE_RANDOM_ONE_OF(n)  Runs one of the next n steps, which must be pattern or jump steps, and continues after them.
+ * SEQUENCE_CROSSFADE(ms)     Crossfades to the next pattern, if ENABLE_CROSSFADE_TRANSITION is defined.
+ * SEQUENCE_END               Ends the sequence.
+ * Patterns, which are not enabled, are skipped. PROCESS_SELECTIVE, the user patterns, PLAY_ANIMATION,
+ * SERIAL_INGEST and the matrix patterns are not supported, but any pattern can be registered with ENABLE_PATTERN_REGISTRY
+ * and started by SEQUENCE_REGISTERED_PATTERN(n).
+ */
+
+#ifndef _NEO_SEQUENCE_H
+#define _NEO_SEQUENCE_H
+
+#if defined(ARDUINO)
+#include <Arduino.h> // for PROGMEM and pgm_read_byte()
+#else
+#include <stdint.h>
+#  if !defined(PROGMEM)
+#define PROGMEM
+#  endif
+#  if !defined(pgm_read_byte)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#  endif
+#endif
+
+#if !defined(SEQUENCE_MAX_LOOP_DEPTH)
+#define SEQUENCE_MAX_LOOP_DEPTH     3 // Requires 3 bytes RAM per level and object
+#endif
+#define SEQUENCE_MAX_CONTROL_STEPS  32 // Maximum number of control steps executed without starting a pattern, protects against empty endless loops
+
+/*
+ * Opcodes of the pattern steps are the pattern numbers of NeoPatterns.h
+ */
+#define SEQUENCE_OPCODE_END                 0x00
+#define SEQUENCE_OPCODE_RAINBOW_CYCLE       1  // PATTERN_RAINBOW_CYCLE
+#define SEQUENCE_OPCODE_COLOR_WIPE          2  // PATTERN_COLOR_WIPE
+#define SEQUENCE_OPCODE_FADE                3  // PATTERN_FADE
+#define SEQUENCE_OPCODE_DELAY               4  // PATTERN_DELAY
+#define SEQUENCE_OPCODE_SCANNER_EXTENDED    5  // PATTERN_SCANNER_EXTENDED
+#define SEQUENCE_OPCODE_STRIPES             6  // PATTERN_STRIPES
+#define SEQUENCE_OPCODE_FLASH               7  // PATTERN_FLASH
+#define SEQUENCE_OPCODE_HEARTBEAT           9  // PATTERN_HEARTBEAT
+#define SEQUENCE_OPCODE_FIRE               10  // PATTERN_FIRE
+#define SEQUENCE_OPCODE_TWINKLE            11  // PATTERN_TWINKLE
+#define SEQUENCE_OPCODE_BOUNCING_BALL      12  // PATTERN_BOUNCING_BALL
+#define SEQUENCE_OPCODE_EMBER              13  // PATTERN_EMBER
+#define SEQUENCE_OPCODE_LOOP               0x40
+#define SEQUENCE_OPCODE_END_LOOP           0x41
+#define SEQUENCE_OPCODE_JUMP               0x42
+#define SEQUENCE_OPCODE_RANDOM_ONE_OF      0x43
+#define SEQUENCE_OPCODE_CROSSFADE          0x44
+#define SEQUENCE_OPCODE_REGISTERED_FIRST   0x80 // PATTERN_REGISTERED_FIRST
+#define SEQUENCE_OPCODE_REGISTERED_LAST    0xFE // PATTERN_REGISTERED_LAST
+
+/*
+ * Macros to write a sequence as initializer of a const uint8_t array
+ */
+#define SEQUENCE_UINT8(aValue)  (uint8_t) (aValue)
+#define SEQUENCE_UINT16(aValue) (uint8_t) ((aValue) & 0xFF), (uint8_t) (((aValue) >> 8) & 0xFF)
+#define SEQUENCE_COLOR(aColor)  (uint8_t) ((aColor) & 0xFF), (uint8_t) (((aColor) >> 8) & 0xFF), \
+    (uint8_t) (((aColor) >> 16) & 0xFF), (uint8_t) (((aColor) >> 24) & 0xFF)
+
+#define SEQUENCE_END            SEQUENCE_OPCODE_END
+#define SEQUENCE_LOOP(aNumberOfRuns)        SEQUENCE_OPCODE_LOOP, SEQUENCE_UINT8(aNumberOfRuns)
+#define SEQUENCE_END_LOOP       SEQUENCE_OPCODE_END_LOOP
+#define SEQUENCE_JUMP(aStepIndex)           SEQUENCE_OPCODE_JUMP, SEQUENCE_UINT8(aStepIndex)
+#define SEQUENCE_RANDOM_ONE_OF(aNumberOfSteps)  SEQUENCE_OPCODE_RANDOM_ONE_OF, SEQUENCE_UINT8(aNumberOfSteps)
+#define SEQUENCE_CROSSFADE(aDurationMillis) SEQUENCE_OPCODE_CROSSFADE, SEQUENCE_UINT16(aDurationMillis)
+#define SEQUENCE_REGISTERED_PATTERN(aRegistryIndex) SEQUENCE_UINT8(SEQUENCE_OPCODE_REGISTERED_FIRST + (aRegistryIndex))
+
+#define SEQUENCE_RAINBOW_CYCLE(aIntervalMillis, aDirection, aRepetitions) SEQUENCE_OPCODE_RAINBOW_CYCLE, \
+    SEQUENCE_UINT8(aIntervalMillis), SEQUENCE_UINT8(aDirection), SEQUENCE_UINT8(aRepetitions)
+#define SEQUENCE_COLOR_WIPE(aColor, aIntervalMillis, aDoNotClearBefore, aDirection) SEQUENCE_OPCODE_COLOR_WIPE, \
+    SEQUENCE_COLOR(aColor), SEQUENCE_UINT16(aIntervalMillis), SEQUENCE_UINT8(aDoNotClearBefore), SEQUENCE_UINT8(aDirection)
+#define SEQUENCE_FADE(aColorStart, aColorEnd, aNumberOfSteps, aIntervalMillis) SEQUENCE_OPCODE_FADE, \
+    SEQUENCE_COLOR(aColorStart), SEQUENCE_COLOR(aColorEnd), SEQUENCE_UINT16(aNumberOfSteps), SEQUENCE_UINT16(aIntervalMillis)
+#define SEQUENCE_DELAY(aMillis) SEQUENCE_OPCODE_DELAY, SEQUENCE_UINT16(aMillis)
+#define SEQUENCE_SCANNER_EXTENDED(aColor, aLength, aIntervalMillis, aNumberOfBouncings, aMode, aDirection) \
+    SEQUENCE_OPCODE_SCANNER_EXTENDED, SEQUENCE_COLOR(aColor), SEQUENCE_UINT8(aLength), SEQUENCE_UINT16(aIntervalMillis), \
+    SEQUENCE_UINT16(aNumberOfBouncings), SEQUENCE_UINT8(aMode), SEQUENCE_UINT8(aDirection)
+#define SEQUENCE_STRIPES(aColor1, aLength1, aColor2, aLength2, aNumberOfSteps, aIntervalMillis, aDirection) \
+    SEQUENCE_OPCODE_STRIPES, SEQUENCE_COLOR(aColor1), SEQUENCE_UINT8(aLength1), SEQUENCE_COLOR(aColor2), SEQUENCE_UINT8(aLength2), \
+    SEQUENCE_UINT16(aNumberOfSteps), SEQUENCE_UINT16(aIntervalMillis), SEQUENCE_UINT8(aDirection)
+#define SEQUENCE_FLASH(aColor1, aIntervalMillisColor1, aColor2, aIntervalMillisColor2, aRepetitions, aDoEndWithBlack) \
+    SEQUENCE_OPCODE_FLASH, SEQUENCE_COLOR(aColor1), SEQUENCE_UINT16(aIntervalMillisColor1), SEQUENCE_COLOR(aColor2), \
+    SEQUENCE_UINT16(aIntervalMillisColor2), SEQUENCE_UINT16(aRepetitions), SEQUENCE_UINT8(aDoEndWithBlack)
+#define SEQUENCE_HEARTBEAT(aColor, aIntervalMillis, aRepetitions, aDoNotClearAfter) SEQUENCE_OPCODE_HEARTBEAT, \
+    SEQUENCE_COLOR(aColor), SEQUENCE_UINT16(aIntervalMillis), SEQUENCE_UINT16(aRepetitions), SEQUENCE_UINT8(aDoNotClearAfter)
+#define SEQUENCE_FIRE(aNumberOfSteps, aIntervalMillis, aDirection) SEQUENCE_OPCODE_FIRE, \
+    SEQUENCE_UINT16(aNumberOfSteps), SEQUENCE_UINT16(aIntervalMillis), SEQUENCE_UINT8(aDirection)
+#define SEQUENCE_TWINKLE(aColorSpecial, aAverageNumberOfActivePixel, aIntervalMillis, aRepetitions, aDoNotClearBefore) \
+    SEQUENCE_OPCODE_TWINKLE, SEQUENCE_COLOR(aColorSpecial), SEQUENCE_UINT8(aAverageNumberOfActivePixel), \
+    SEQUENCE_UINT16(aIntervalMillis), SEQUENCE_UINT16(aRepetitions), SEQUENCE_UINT8(aDoNotClearBefore)
+#define SEQUENCE_BOUNCING_BALL(aColor, aIndexOfTopPixel, aIntervalMillis, aPercentageOfLossAtBounce, aDirection) \
+    SEQUENCE_OPCODE_BOUNCING_BALL, SEQUENCE_COLOR(aColor), SEQUENCE_UINT16(aIndexOfTopPixel), SEQUENCE_UINT16(aIntervalMillis), \
+    SEQUENCE_UINT8(aPercentageOfLossAtBounce), SEQUENCE_UINT8(aDirection)
+#define SEQUENCE_EMBER(aMinHeatValue, aMaxHeatValue, aMode, aIncreaseIntervalFactor, aNumberOfDecreasingSteps, aIntervalMillis) \
+    SEQUENCE_OPCODE_EMBER, SEQUENCE_UINT8(aMinHeatValue), SEQUENCE_UINT8(aMaxHeatValue), SEQUENCE_UINT8(aMode), \
+    SEQUENCE_UINT8(aIncreaseIntervalFactor), SEQUENCE_UINT16(aNumberOfDecreasingSteps), SEQUENCE_UINT16(aIntervalMillis)
+
+struct SequenceLoopStruct {
+    uint16_t StartOffset;       // Offset of the first step after SEQUENCE_LOOP
+    uint8_t RemainingRuns;      // 0 for endless
+};
+
+uint8_t getSequenceStepLength(uint8_t aOpcode);
+bool isSequencePatternStep(uint8_t aOpcode);
+uint16_t readSequenceUInt16(const uint8_t *aParameterPGM);
+uint32_t readSequenceUInt32(const uint8_t *aParameterPGM);
+int16_t getSequenceStepOffset(const uint8_t *aSequencePGM, uint8_t aStepIndex);
+uint16_t skipSequenceSteps(const uint8_t *aSequencePGM, uint16_t aOffset, uint8_t aNumberOfSteps);
+
+#endif // _NEO_SEQUENCE_H
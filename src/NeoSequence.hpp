@@ -0,0 +1,119 @@
+/*
+ * NeoSequence.hpp
+ *
+ *  Functions to parse the sequence bytecode, used by NeoPatterns::startSequence() and extras/SequenceValidator.
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+#ifndef _NEO_SEQUENCE_HPP
+#define _NEO_SEQUENCE_HPP
+
+#include "NeoSequence.h"
+
+/*
+ * @return Length of the step including the opcode, 0 for an unknown opcode
+ */
+uint8_t getSequenceStepLength(uint8_t aOpcode) {
+    if (aOpcode >= SEQUENCE_OPCODE_REGISTERED_FIRST && aOpcode <= SEQUENCE_OPCODE_REGISTERED_LAST) {
+        return 1;
+    }
+    switch (aOpcode) {
+    case SEQUENCE_OPCODE_END:
+    case SEQUENCE_OPCODE_END_LOOP:
+        return 1;
+    case SEQUENCE_OPCODE_LOOP:
+    case SEQUENCE_OPCODE_JUMP:
+    case SEQUENCE_OPCODE_RANDOM_ONE_OF:
+        return 2;
+    case SEQUENCE_OPCODE_CROSSFADE:
+    case SEQUENCE_OPCODE_DELAY:
+        return 3;
+    case SEQUENCE_OPCODE_RAINBOW_CYCLE:
+        return 4;
+    case SEQUENCE_OPCODE_FIRE:
+        return 6;
+    case SEQUENCE_OPCODE_COLOR_WIPE:
+    case SEQUENCE_OPCODE_EMBER:
+        return 9;
+    case SEQUENCE_OPCODE_HEARTBEAT:
+        return 10;
+    case SEQUENCE_OPCODE_TWINKLE:
+    case SEQUENCE_OPCODE_BOUNCING_BALL:
+        return 11;
+    case SEQUENCE_OPCODE_SCANNER_EXTENDED:
+        return 12;
+    case SEQUENCE_OPCODE_FADE:
+        return 13;
+    case SEQUENCE_OPCODE_STRIPES:
+    case SEQUENCE_OPCODE_FLASH:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+/*
+ * @return true if the step starts a pattern and the sequence continues at the completion of the pattern
+ */
+bool isSequencePatternStep(uint8_t aOpcode) {
+    return (aOpcode != SEQUENCE_OPCODE_END && aOpcode < SEQUENCE_OPCODE_LOOP) || aOpcode >= SEQUENCE_OPCODE_REGISTERED_FIRST;
+}
+
+/*
+ * Parameters are read byte by byte, since they are not aligned
+ */
+uint16_t readSequenceUInt16(const uint8_t *aParameterPGM) {
+    return pgm_read_byte(aParameterPGM) | (pgm_read_byte(aParameterPGM + 1) << 8);
+}
+
+uint32_t readSequenceUInt32(const uint8_t *aParameterPGM) {
+    return readSequenceUInt16(aParameterPGM) | ((uint32_t) readSequenceUInt16(aParameterPGM + 2) << 16);
+}
+
+/*
+ * @return Offset of step aStepIndex or -1 if the sequence ends before
+ */
+int16_t getSequenceStepOffset(const uint8_t *aSequencePGM, uint8_t aStepIndex) {
+    uint16_t tOffset = 0;
+    for (uint8_t i = 0; i < aStepIndex; ++i) {
+        uint8_t tOpcode = pgm_read_byte(&aSequencePGM[tOffset]);
+        if (tOpcode == SEQUENCE_OPCODE_END || getSequenceStepLength(tOpcode) == 0) {
+            return -1;
+        }
+        tOffset += getSequenceStepLength(tOpcode);
+    }
+    return tOffset;
+}
+
+/*
+ * @return Offset of the step after aNumberOfSteps steps starting at aOffset. Stops at SEQUENCE_END and unknown opcodes.
+ */
+uint16_t skipSequenceSteps(const uint8_t *aSequencePGM, uint16_t aOffset, uint8_t aNumberOfSteps) {
+    for (uint8_t i = 0; i < aNumberOfSteps; ++i) {
+        uint8_t tOpcode = pgm_read_byte(&aSequencePGM[aOffset]);
+        if (tOpcode == SEQUENCE_OPCODE_END || getSequenceStepLength(tOpcode) == 0) {
+            break;
+        }
+        aOffset += getSequenceStepLength(tOpcode);
+    }
+    return aOffset;
+}
+
+#endif // _NEO_SEQUENCE_HPP
@@ -0,0 +1,136 @@
+/*
+ * PatternSegment.h
+ *
+ *  SUMMARY
+ *  Lightweight segments of one NeoPatterns strip, each running its own pattern.
+ *  A segment stores only its pixel region and its pattern state.
+ *  For drawing, the state is loaded into one shared partial NeoPatterns object, the renderer,
+ *  which borrows pixel buffer and show() of the parent NeoPixel object.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+/*
+ * Usage:
+ * NeoPatterns Bar60 = NeoPatterns(60, PIN_NEOPIXEL, NEO_GRB + NEO_KHZ800);
+ * NeoPatterns SegmentRenderer = NeoPatterns(&Bar60, 0, 60, DISABLE_CALLING_SHOW_OF_PARENT);
+ * PatternSegment Segment1 = PatternSegment(&SegmentRenderer, 0, 6, &SegmentHandler);
+ * ...
+ * Segment1.select()->ColorWipe(COLOR32_GREEN_QUARTER, 80);
+ * ...
+ * if (updateAllPatternSegments()) {
+ *     Bar60.show();
+ * }
+ *
+ * Inside the callback, the completed segment is selected, so the NeoPatterns pointer passed to the callback
+ * can be used to start its next pattern. PatternSegment::SelectedPatternSegment is the completed segment.
+ * Do not select other segments inside the callback.
+ */
+
+#ifndef _PATTERN_SEGMENT_H
+#define _PATTERN_SEGMENT_H
+
+#include "NeoPatterns.h"
+
+/*
+ * SIZE = 50 bytes on AVR with default options, compared to 76 bytes for a NeoPatterns object
+ */
+class PatternSegment {
+public:
+    PatternSegment();
+    PatternSegment(NeoPatterns *aRendererNeoPatterns, uint16_t aPixelOffset, uint16_t aNumberOfPixels,
+            void (*aPatternCompletionCallback)(NeoPatterns*) = nullptr);
+    void init(NeoPatterns *aRendererNeoPatterns, uint16_t aPixelOffset, uint16_t aNumberOfPixels,
+            void (*aPatternCompletionCallback)(NeoPatterns*) = nullptr);
+    void _insertIntoPatternSegmentsList();
+
+    NeoPatterns* select();
+    void loadState();
+    void storeState();
+
+    bool isActive();
+    bool update();
+    void stop();
+
+    NeoPatterns *RendererNeoPatterns; // The partial NeoPatterns object, which draws the pattern of the selected segment
+    uint16_t PixelOffset;           // Offset of the segment on the parent pixel buffer
+    uint16_t NumberOfPixels;
+
+    /*
+     * Pattern state, copied from and to the renderer by storeState() and loadState()
+     */
+    uint8_t ActivePattern;
+    uint8_t TimingFlags;            // PIXEL_FLAGS_TIMING_MASK part of PixelFlags
+    uint16_t Interval;
+    unsigned long lastUpdate;
+    int16_t TotalStepCounter;
+    int16_t Index;
+    color32_t Color1;
+    int8_t Direction;
+    uint8_t PatternFlags;
+    decltype(NeoPatterns::ByteValue1) ByteValue1;
+    decltype(NeoPatterns::ByteValue2) ByteValue2;
+    decltype(NeoPatterns::LongValue1) LongValue1;
+    decltype(NeoPatterns::LongValue2) LongValue2;
+    decltype(NeoPatterns::Pointer1) Pointer1;
+    void (*OnPatternComplete)(NeoPatterns*);
+    uint16_t Repetitions;
+    void (*NextOnPatternCompleteHandler)(NeoPatterns*);
+#if defined(SUPPORT_TIMING_POLICIES)
+    uint8_t IntervalFraction;
+    uint8_t IntervalFractionSum;
+#endif
+#if defined(ENABLE_NEOPATTERNS_RENDER_AT)
+    int16_t StartTotalStepCounter;
+    int16_t StartIndex;
+    uint16_t StartNumberOfBouncings;
+    int8_t StartDirection;
+#endif
+#if defined(ENABLE_PATTERN_TWINKLE)
+    struct SparklePixelStruct *SparklePixelArrayPtr;
+#endif
+#if defined(ENABLE_PATTERN_PROCESS_SELECTIVE)
+    uint8_t *SelectionMaskPtr;
+#endif
+#if defined(ENABLE_SCANNER_EXTENDED_TAIL_CACHE)
+    uint8_t *TailCachePtr;
+    uint8_t TailCacheSize;
+    uint8_t TailCacheLength;
+    uint8_t TailCacheBrightness;
+#endif
+#if defined(_SUPPORT_EXTENDED_PATTERN_STATE)
+    ExtendedPatternStateStruct ExtendedState;
+#endif
+
+    /*
+     * List of all PatternSegments
+     */
+    PatternSegment *NextPatternSegmentObject;
+
+    static PatternSegment *FirstPatternSegmentObject;
+    static PatternSegment *SelectedPatternSegment; // The segment, whose state is currently loaded in its renderer
+};
+
+bool updateAllPatternSegments();
+void stopAllPatternSegments();
+
+#endif // _PATTERN_SEGMENT_H
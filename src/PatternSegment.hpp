@@ -0,0 +1,292 @@
+/*
+ * PatternSegment.hpp
+ *
+ *  SUMMARY
+ *  Lightweight segments of one NeoPatterns strip, each running its own pattern.
+ *  A segment stores only its pixel region and its pattern state.
+ *  For drawing, the state is loaded into one shared partial NeoPatterns object, the renderer,
+ *  which borrows pixel buffer and show() of the parent NeoPixel object.
+ *
+ *  You need to install "Adafruit NeoPixel" library under "Tools -> Manage Libraries..." or "Ctrl+Shift+I" -> use "neoPixel" as filter string
+ *
+ *  Copyright (C) 2026  Armin Joachimsmeyer
+ *  armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of NeoPatterns https://github.com/ArminJo/NeoPatterns.
+ *
+ *  NeoPatterns is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+
+#ifndef _PATTERN_SEGMENT_HPP
+#define _PATTERN_SEGMENT_HPP
+
+#include <Arduino.h>
+
+#include "PatternSegment.h"
+
+// include sources
+#include "NeoPatterns.hpp"
+
+// This block must be located after the includes of other *.hpp files
+//#define LOCAL_INFO  // This enables info output only for this file
+//#define LOCAL_DEBUG // This enables debug output only for this file - only for development
+//#define LOCAL_TRACE // This enables trace output only for this file - only for development
+#include "LocalDebugLevelStart.h"
+
+PatternSegment *PatternSegment::FirstPatternSegmentObject = nullptr;
+PatternSegment *PatternSegment::SelectedPatternSegment = nullptr;
+
+PatternSegment::PatternSegment() { // @suppress("Class members should be properly initialized")
+    init(nullptr, 0, 0);
+}
+
+/*
+ * The renderer is not accessed here, so segments can be constructed before their renderer
+ */
+PatternSegment::PatternSegment(NeoPatterns *aRendererNeoPatterns, uint16_t aPixelOffset, uint16_t aNumberOfPixels, // @suppress("Class members should be properly initialized")
+        void (*aPatternCompletionCallback)(NeoPatterns*)) {
+    init(aRendererNeoPatterns, aPixelOffset, aNumberOfPixels, aPatternCompletionCallback);
+}
+
+/*
+ * @param aRendererNeoPatterns - A partial NeoPatterns object, which is shared by all segments of the parent NeoPixel object
+ *                               and draws the pattern of the selected segment.
+ */
+void PatternSegment::init(NeoPatterns *aRendererNeoPatterns, uint16_t aPixelOffset, uint16_t aNumberOfPixels,
+        void (*aPatternCompletionCallback)(NeoPatterns*)) {
+    RendererNeoPatterns = aRendererNeoPatterns;
+    PixelOffset = aPixelOffset;
+    NumberOfPixels = aNumberOfPixels;
+    OnPatternComplete = aPatternCompletionCallback;
+    ActivePattern = PATTERN_NONE;
+    TimingFlags = 0;
+    LongValue1.PixelHeatArrayPtr = nullptr;
+#if defined(SUPPORT_TIMING_POLICIES)
+    IntervalFraction = 0;
+    IntervalFractionSum = 0;
+#endif
+#if defined(ENABLE_PATTERN_TWINKLE)
+    SparklePixelArrayPtr = nullptr;
+#endif
+#if defined(ENABLE_PATTERN_PROCESS_SELECTIVE)
+    SelectionMaskPtr = nullptr;
+#endif
+#if defined(ENABLE_SCANNER_EXTENDED_TAIL_CACHE)
+    TailCachePtr = nullptr;
+    TailCacheSize = 0;
+#endif
+#if defined(ENABLE_STREAMING_OUTPUT)
+    ExtendedState.StreamingShowIsPending = false;
+#endif
+#if defined(ENABLE_NEOPATTERNS_SEQUENCER)
+    ExtendedState.SequencePGM = nullptr;
+#endif
+    if (SelectedPatternSegment == this) {
+        SelectedPatternSegment = nullptr; // Do not store the old state of the renderer into the new one
+    }
+    _insertIntoPatternSegmentsList();
+}
+
+/*
+ * Insert "this" at the end of the NextPatternSegmentObject list, if not already contained
+ * init() may be called again for an already constructed segment
+ */
+void PatternSegment::_insertIntoPatternSegmentsList() {
+    PatternSegment *tNextObjectPointer = FirstPatternSegmentObject;
+    if (tNextObjectPointer == nullptr) {
+        NextPatternSegmentObject = nullptr;
+        FirstPatternSegmentObject = this;
+    } else {
+        while (true) {
+            if (tNextObjectPointer == this) {
+                return;
+            }
+            if (tNextObjectPointer->NextPatternSegmentObject == nullptr) {
+                break;
+            }
+            tNextObjectPointer = tNextObjectPointer->NextPatternSegmentObject;
+        }
+        NextPatternSegmentObject = nullptr;
+        tNextObjectPointer->NextPatternSegmentObject = this;
+    }
+}
+
+/*
+ * Stores the state of the previously selected segment and loads the state and pixel region of this segment into the renderer.
+ * @return The renderer, which can then be used to start a new pattern for this segment, e.g. Segment1.select()->ColorWipe(...);
+ */
+NeoPatterns* PatternSegment::select() {
+    if (SelectedPatternSegment != this) {
+        if (SelectedPatternSegment != nullptr) {
+            SelectedPatternSegment->storeState();
+        }
+        loadState();
+        SelectedPatternSegment = this;
+    }
+    return RendererNeoPatterns;
+}
+
+/*
+ * Copy pixel region and pattern state of this segment to the renderer
+ */
+void PatternSegment::loadState() {
+    NeoPatterns *tRenderer = RendererNeoPatterns;
+    tRenderer->setPixelRegionForPartialNeoPixel(PixelOffset, NumberOfPixels);
+    tRenderer->PixelFlags = (tRenderer->PixelFlags & ~PIXEL_FLAGS_TIMING_MASK) | TimingFlags;
+    tRenderer->ActivePattern = ActivePattern;
+    tRenderer->Interval = Interval;
+    tRenderer->lastUpdate = lastUpdate;
+    tRenderer->TotalStepCounter = TotalStepCounter;
+    tRenderer->Index = Index;
+    tRenderer->Color1 = Color1;
+    tRenderer->Direction = Direction;
+    tRenderer->PatternFlags = PatternFlags;
+    tRenderer->ByteValue1 = ByteValue1;
+    tRenderer->ByteValue2 = ByteValue2;
+    tRenderer->LongValue1 = LongValue1;
+    tRenderer->LongValue2 = LongValue2;
+    tRenderer->Pointer1 = Pointer1;
+    tRenderer->OnPatternComplete = OnPatternComplete;
+    tRenderer->Repetitions = Repetitions;
+    tRenderer->NextOnPatternCompleteHandler = NextOnPatternCompleteHandler;
+#if defined(SUPPORT_TIMING_POLICIES)
+    tRenderer->IntervalFraction = IntervalFraction;
+    tRenderer->IntervalFractionSum = IntervalFractionSum;
+#endif
+#if defined(ENABLE_NEOPATTERNS_RENDER_AT)
+    tRenderer->StartTotalStepCounter = StartTotalStepCounter;
+    tRenderer->StartIndex = StartIndex;
+    tRenderer->StartNumberOfBouncings = StartNumberOfBouncings;
+    tRenderer->StartDirection = StartDirection;
+#endif
+#if defined(ENABLE_PATTERN_TWINKLE)
+    tRenderer->SparklePixelArrayPtr = SparklePixelArrayPtr;
+#endif
+#if defined(ENABLE_PATTERN_PROCESS_SELECTIVE)
+    tRenderer->SelectionMaskPtr = SelectionMaskPtr;
+#endif
+#if defined(ENABLE_SCANNER_EXTENDED_TAIL_CACHE)
+    tRenderer->TailCachePtr = TailCachePtr;
+    tRenderer->TailCacheSize = TailCacheSize;
+    tRenderer->TailCacheLength = TailCacheLength;
+    tRenderer->TailCacheBrightness = TailCacheBrightness;
+#endif
+#if defined(_SUPPORT_EXTENDED_PATTERN_STATE)
+    tRenderer->ExtendedState = ExtendedState;
+#endif
+}
+
+/*
+ * Copy pattern state from the renderer to this segment
+ */
+void PatternSegment::storeState() {
+    NeoPatterns *tRenderer = RendererNeoPatterns;
+    TimingFlags = tRenderer->PixelFlags & PIXEL_FLAGS_TIMING_MASK;
+    ActivePattern = tRenderer->ActivePattern;
+    Interval = tRenderer->Interval;
+    lastUpdate = tRenderer->lastUpdate;
+    TotalStepCounter = tRenderer->TotalStepCounter;
+    Index = tRenderer->Index;
+    Color1 = tRenderer->Color1;
+    Direction = tRenderer->Direction;
+    PatternFlags = tRenderer->PatternFlags;
+    ByteValue1 = tRenderer->ByteValue1;
+    ByteValue2 = tRenderer->ByteValue2;
+    LongValue1 = tRenderer->LongValue1;
+    LongValue2 = tRenderer->LongValue2;
+    Pointer1 = tRenderer->Pointer1;
+    OnPatternComplete = tRenderer->OnPatternComplete;
+    Repetitions = tRenderer->Repetitions;
+    NextOnPatternCompleteHandler = tRenderer->NextOnPatternCompleteHandler;
+#if defined(SUPPORT_TIMING_POLICIES)
+    IntervalFraction = tRenderer->IntervalFraction;
+    IntervalFractionSum = tRenderer->IntervalFractionSum;
+#endif
+#if defined(ENABLE_NEOPATTERNS_RENDER_AT)
+    StartTotalStepCounter = tRenderer->StartTotalStepCounter;
+    StartIndex = tRenderer->StartIndex;
+    StartNumberOfBouncings = tRenderer->StartNumberOfBouncings;
+    StartDirection = tRenderer->StartDirection;
+#endif
+#if defined(ENABLE_PATTERN_TWINKLE)
+    SparklePixelArrayPtr = tRenderer->SparklePixelArrayPtr;
+#endif
+#if defined(ENABLE_PATTERN_PROCESS_SELECTIVE)
+    SelectionMaskPtr = tRenderer->SelectionMaskPtr;
+#endif
+#if defined(ENABLE_SCANNER_EXTENDED_TAIL_CACHE)
+    TailCachePtr = tRenderer->TailCachePtr;
+    TailCacheSize = tRenderer->TailCacheSize;
+    TailCacheLength = tRenderer->TailCacheLength;
+    TailCacheBrightness = tRenderer->TailCacheBrightness;
+#endif
+#if defined(_SUPPORT_EXTENDED_PATTERN_STATE)
+    ExtendedState = tRenderer->ExtendedState;
+#endif
+}
+
+bool PatternSegment::isActive() {
+    if (SelectedPatternSegment == this) {
+        return RendererNeoPatterns->ActivePattern != PATTERN_NONE;
+    }
+    return ActivePattern != PATTERN_NONE;
+}
+
+void PatternSegment::stop() {
+    if (SelectedPatternSegment == this) {
+        RendererNeoPatterns->ActivePattern = PATTERN_NONE;
+    }
+    ActivePattern = PATTERN_NONE;
+}
+
+/*
+ * Updates the pattern of the segment if its update interval has expired. The state is only loaded into the renderer, if an update is due.
+ * !!! update() does NOT show the pattern, this must be done manually by calling show() of the parent after all segments are updated. !!!
+ * @return true if update has happened to signal that a show() is required.
+ */
+bool PatternSegment::update() {
+    if (SelectedPatternSegment != this
+            && (ActivePattern == PATTERN_NONE || (long) (NeoPixel::getCompensatedMillis() - lastUpdate) <= (long) Interval)) {
+        return false;
+    }
+    NeoPatterns *tRenderer = select();
+    if (tRenderer->ActivePattern == PATTERN_NONE) {
+        return false;
+    }
+    return tRenderer->updateOrRedraw(DO_NO_REDRAW_IF_NO_UPDATE);
+}
+
+/*
+ * Updates all segments.
+ * @return true if at least one segment was updated and show() of the parent is required.
+ */
+bool updateAllPatternSegments() {
+    bool tMustShow = false;
+    for (PatternSegment *tNextObjectPointer = PatternSegment::FirstPatternSegmentObject; tNextObjectPointer != nullptr;
+            tNextObjectPointer = tNextObjectPointer->NextPatternSegmentObject) {
+        tMustShow |= tNextObjectPointer->update();
+    }
+    return tMustShow;
+}
+
+void stopAllPatternSegments() {
+    for (PatternSegment *tNextObjectPointer = PatternSegment::FirstPatternSegmentObject; tNextObjectPointer != nullptr;
+            tNextObjectPointer = tNextObjectPointer->NextPatternSegmentObject) {
+        tNextObjectPointer->stop();
+    }
+}
+
+#include "LocalDebugLevelEnd.h"
+#endif // _PATTERN_SEGMENT_HPP